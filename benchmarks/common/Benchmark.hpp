@@ -0,0 +1,48 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace Benchmark
+{
+    // Runs fn `warmup` times untimed, then `iterations` times timed.
+    // Returns the median run in milliseconds; the median ignores scheduler hiccups.
+    template <typename Fn>
+    double MeasureMs(Fn &&fn, int iterations = 10, int warmup = 2)
+    {
+        for (int i = 0; i < warmup; ++i)
+            fn();
+
+        std::vector<double> samples;
+        samples.reserve(iterations);
+        for (int i = 0; i < iterations; ++i)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            fn();
+            const auto end = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+
+        std::ranges::sort(samples);
+        return samples[samples.size() / 2];
+    }
+
+    inline void PrintTitle(const char *title)
+    {
+        std::printf("\n== %s ==\n", title);
+    }
+
+    // Thread sweeps report speedups; past the machine's hardware threads they only show overhead.
+    inline void PrintHardwareThreads(const unsigned maxThreads)
+    {
+        const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+        std::printf("%u hardware threads\n", hardware);
+        if (maxThreads > hardware)
+        {
+            std::printf("rows above %u threads are oversubscribed: they measure overhead, not speedup\n", hardware);
+        }
+    }
+}
@@ -0,0 +1,119 @@
+// CoroutineScheduler::Update with a large population of live coroutines, each
+// looping on a wait of one to ten seconds. Waits the scheduler understands
+// (WaitForSeconds, WaitForFrames) sit in its heaps until due; a wait it can
+// only poll is checked every frame, which was the cost of every wait before.
+// Usage: CoroutineSchedulerBenchmark [coroutines] [gameObjects]
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <engine/GameObjectScene.hpp>
+#include <engine/scheduling/CoroutineScheduler.hpp>
+
+#include "Benchmark.hpp"
+
+using namespace N2Engine;
+using namespace N2Engine::Scheduling;
+
+namespace
+{
+    constexpr double FrameSeconds = 1.0 / 60.0;
+
+    uint64_t resumes = 0;
+
+    // The same countdown as WaitForSeconds, without the Schedule() that lets it be parked
+    class PolledSeconds
+    {
+    public:
+        explicit PolledSeconds(const double seconds) : _remaining{seconds} {}
+        bool Wait()
+        {
+            _remaining -= FrameSeconds;
+            return _remaining > 0.0;
+        }
+
+    private:
+        double _remaining;
+    };
+
+    float Interval(const size_t index)
+    {
+        return 1.f + static_cast<float>(index % 901) * 0.01f;
+    }
+
+    std::generator<ICoroutineWait> Sleeper(const float seconds)
+    {
+        while (true)
+        {
+            ++resumes;
+            co_yield WaitForSeconds(seconds);
+        }
+    }
+
+    std::generator<ICoroutineWait> FrameSleeper(const uint32_t frames)
+    {
+        while (true)
+        {
+            ++resumes;
+            co_yield WaitForFrames(frames);
+        }
+    }
+
+    std::generator<ICoroutineWait> PolledSleeper(const float seconds)
+    {
+        while (true)
+        {
+            ++resumes;
+            co_yield PolledSeconds(seconds);
+        }
+    }
+
+    template <typename Start>
+    void Run(const char *name, const size_t coroutines, const std::vector<GameObject::Ptr> &gameObjects, Start start)
+    {
+        CoroutineScheduler scheduler{nullptr};
+        for (size_t i = 0; i < coroutines; ++i)
+        {
+            start(scheduler, gameObjects[i % gameObjects.size()].get(), i);
+        }
+        // The first frame runs everything to its first wait
+        scheduler.Update(FrameSeconds);
+
+        resumes = 0;
+        const double ms = Benchmark::MeasureMs([&] { scheduler.Update(FrameSeconds); }, 120, 0);
+        std::printf("%18s %12zu %10zu %12.3f %14.1f\n", name, scheduler.GetCoroutineCount(), scheduler.GetPolledCount(), ms,
+                    static_cast<double>(resumes) / 120.0);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const size_t coroutines = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    const int objectCount = argc > 2 ? std::atoi(argv[2]) : 1000;
+
+    auto scene = Scene::Create("CoroutineSchedulerBenchmark");
+    std::vector<GameObject::Ptr> gameObjects;
+    for (int i = 0; i < objectCount; ++i)
+    {
+        gameObjects.push_back(GameObject::Create("Runner"));
+    }
+    scene->AddRootGameObjects(gameObjects);
+    scene->ProcessAttachQueue();
+
+    Benchmark::PrintTitle("CoroutineScheduler::Update, waits of 1-10 s at 60 fps");
+    std::printf("%18s %12s %10s %12s %14s\n", "wait", "coroutines", "polled", "ms/frame", "resumes/frame");
+    Run("WaitForSeconds", coroutines, gameObjects, [](CoroutineScheduler &scheduler, GameObject *gameObject, const size_t i)
+    {
+        scheduler.StartCoroutine(gameObject, Sleeper(Interval(i)));
+    });
+    Run("WaitForFrames", coroutines, gameObjects, [](CoroutineScheduler &scheduler, GameObject *gameObject, const size_t i)
+    {
+        scheduler.StartCoroutine(gameObject, FrameSleeper(static_cast<uint32_t>(Interval(i) * 60.f)));
+    });
+    Run("polled", coroutines, gameObjects, [](CoroutineScheduler &scheduler, GameObject *gameObject, const size_t i)
+    {
+        scheduler.StartCoroutine(gameObject, PolledSleeper(Interval(i)));
+    });
+    return 0;
+}
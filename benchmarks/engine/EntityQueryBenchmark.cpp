@@ -0,0 +1,105 @@
+// Integrating velocities into positions: per-GameObject heap components
+// against an archetype query over SoA chunks, serial and parallel.
+// Usage: EntityQueryBenchmark [entities] [threads]
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <engine/GameObjectScene.hpp>
+#include <engine/ecs/EntityStore.hpp>
+#include <engine/scheduling/JobSystem.hpp>
+
+#include "Benchmark.hpp"
+
+using namespace N2Engine;
+
+namespace
+{
+    struct Position
+    {
+        float x = 0.f, y = 0.f, z = 0.f;
+    };
+
+    struct Velocity
+    {
+        float x = 0.f, y = 0.f, z = 0.f;
+    };
+
+    class Mover final : public Component
+    {
+    public:
+        explicit Mover(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "Mover"; }
+
+        Position position;
+        Velocity velocity;
+    };
+
+    constexpr float Step = 1.f / 60.f;
+
+    void Integrate(Position &position, const Velocity &velocity)
+    {
+        position.x += velocity.x * Step;
+        position.y += velocity.y * Step;
+        position.z += velocity.z * Step;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const int entities = argc > 1 ? std::atoi(argv[1]) : 200000;
+    const unsigned threads = argc > 2 ? (unsigned)std::atoi(argv[2]) : 0;
+    Scheduling::JobSystem::Instance().Initialize(threads);
+
+    std::vector<GameObject::Ptr> gameObjects;
+    std::vector<Mover*> movers;
+    ECS::EntityStore store;
+    for (int i = 0; i < entities; ++i)
+    {
+        const Velocity velocity{(float)(i % 7), 1.f, -(float)(i % 3)};
+        auto gameObject = GameObject::Create("Mover");
+        movers.push_back(gameObject->AddComponent<Mover>());
+        movers.back()->velocity = velocity;
+        gameObjects.push_back(std::move(gameObject));
+
+        store.Create(Position{}, velocity);
+    }
+
+    auto query = store.Query<Position, const Velocity>();
+    auto checksum = [&](bool components)
+    {
+        double sum = 0.0;
+        if (components)
+        {
+            for (const Mover *mover : movers)
+                sum += mover->position.x + mover->position.z;
+        }
+        else
+        {
+            query.ForEach([&](const Position &position, const Velocity &) { sum += position.x + position.z; });
+        }
+        return sum;
+    };
+
+    Benchmark::PrintTitle("Entity query iteration");
+    std::printf("%d entities, %zu archetypes\n", entities, store.GetArchetypeCount());
+    std::printf("%20s %12s %10s\n", "storage", "ms/pass", "identical");
+
+    const double componentMs = Benchmark::MeasureMs([&]
+    {
+        for (Mover *mover : movers)
+            Integrate(mover->position, mover->velocity);
+    }, 50, 5);
+    const double reference = checksum(true);
+    std::printf("%20s %12.3f %10s\n", "GameObject heap", componentMs, "yes");
+
+    // Same pass count on every storage, so the positions must match exactly
+    const double queryMs = Benchmark::MeasureMs([&] { query.ForEach(Integrate); }, 50, 5);
+    std::printf("%20s %12.3f %10s\n", "archetype SoA", queryMs, checksum(false) == reference ? "yes" : "NO");
+
+    query.ForEach([](Position &position, const Velocity &) { position = {}; });
+    const double parallelMs = Benchmark::MeasureMs([&] { query.ParallelForEach(Integrate, threads); }, 50, 5);
+    std::printf("%20s %12.3f %10s\n", "archetype parallel", parallelMs, checksum(false) == reference ? "yes" : "NO");
+    return 0;
+}
@@ -0,0 +1,168 @@
+// Serial frames (simulate, then render on the same thread) against the
+// PipelinedRenderer at depths 2 and 3, with and without dropping late frames.
+// The backend stands in for a GPU: each Present blocks for the render time
+// without using the CPU, the way a driver waits on the swap chain. Simulation
+// spins on the CPU. Reports frames simulated per second (dropped frames are
+// simulated but never drawn) and the latency from the end of a frame's
+// simulation to its Present.
+// Usage: FramePipelineBenchmark [simulateMs] [renderMs] [frames] [drawsPerFrame]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <engine/rendering/PipelinedRenderer.hpp>
+
+#include "Benchmark.hpp"
+
+using namespace N2Engine::Rendering;
+using namespace Renderer::Common;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    class GpuRenderer final : public IRenderer
+    {
+    public:
+        explicit GpuRenderer(const double renderMs) : _renderTime{std::chrono::duration<double, std::milli>(renderMs)} {}
+
+        bool Initialize(GLFWwindow *, uint32_t, uint32_t) override { return true; }
+        void Shutdown() override {}
+        void Resize(uint32_t, uint32_t) override {}
+        void Clear(float, float, float, float) override {}
+        void BeginFrame() override {}
+        void EndFrame() override {}
+        void Present() override { std::this_thread::sleep_for(_renderTime); }
+
+        IShader* CreateShaderProgram(const char *, const char *) override { return nullptr; }
+        void UseShaderProgram(IShader *) override {}
+        bool DestroyShaderProgram(ShaderHandle) override { return true; }
+        bool IsValidShader(ShaderHandle) const override { return false; }
+        IMesh* CreateMesh(const MeshData &) override { return nullptr; }
+        void DestroyMesh(MeshHandle) override {}
+        ITexture* CreateTexture(const uint8_t *, uint32_t, uint32_t, uint32_t) override { return nullptr; }
+        void DestroyTexture(TextureHandle) override {}
+        IMaterial* CreateMaterial(IShader *) override { return nullptr; }
+        IMaterial* CreateMaterial(IShader *, ITexture *) override { return nullptr; }
+        void DestroyMaterial(MaterialHandle) override {}
+
+        void SetViewProjection(const float *, const float *) override {}
+        void UpdateSceneLighting(const SceneLightingData &, const N2Engine::Math::Vector3 &) override {}
+        void DrawMesh(IMesh *, const float *modelMatrix, IMaterial *) override { checksum += modelMatrix[12]; }
+        void DrawMeshInstanced(IMesh *, IMaterial *, std::span<const float[16]>) override {}
+        void DrawObjects(const std::vector<RenderObject> &) override {}
+        void OnResize(int, int) override {}
+
+        IShader* GetStandardUnlitShader() const override { return nullptr; }
+        IShader* GetStandardLitShader() const override { return nullptr; }
+        void ReadFramebuffer(std::uint8_t *, int, int) const override {}
+        void SetWireframe(bool) override {}
+        const char* GetRendererName() const override { return "Simulated GPU"; }
+
+        double checksum = 0.0;
+
+    private:
+        std::chrono::duration<double, std::milli> _renderTime;
+    };
+
+    void Simulate(const double ms)
+    {
+        const auto until = Clock::now() + std::chrono::duration<double, std::milli>(ms);
+        while (Clock::now() < until)
+        {
+        }
+    }
+
+    struct Result
+    {
+        double framesPerSecond;
+        double averageLatencyMs;
+        double maxLatencyMs;
+        uint64_t dropped;
+    };
+
+    // Returns the latency of the serial frame: Present returns once the frame is on screen
+    double RunFrame(IRenderer &renderer, const double simulateMs, const int draws)
+    {
+        Simulate(simulateMs);
+        const auto recorded = Clock::now();
+        float model[16]{};
+        renderer.BeginFrame();
+        renderer.Clear(0.f, 0.f, 0.f, 1.f);
+        for (int i = 0; i < draws; ++i)
+        {
+            model[12] = static_cast<float>(i);
+            renderer.DrawMesh(nullptr, model, nullptr);
+        }
+        renderer.EndFrame();
+        renderer.Present();
+        return std::chrono::duration<double, std::milli>(Clock::now() - recorded).count();
+    }
+
+    Result RunSerial(const double simulateMs, const double renderMs, const int frames, const int draws)
+    {
+        GpuRenderer renderer{renderMs};
+        double totalLatencyMs = 0.0;
+        double maxLatencyMs = 0.0;
+        const auto start = Clock::now();
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            const double latencyMs = RunFrame(renderer, simulateMs, draws);
+            totalLatencyMs += latencyMs;
+            maxLatencyMs = std::max(maxLatencyMs, latencyMs);
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        return {frames / seconds, totalLatencyMs / frames, maxLatencyMs, 0};
+    }
+
+    Result RunPipelined(const double simulateMs, const double renderMs, const int frames, const int draws,
+                        const uint32_t depth, const bool dropLateFrames)
+    {
+        PipelinedRenderer renderer{std::make_unique<GpuRenderer>(renderMs), nullptr, depth, dropLateFrames};
+        const auto start = Clock::now();
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            RunFrame(renderer, simulateMs, draws);
+        }
+        renderer.Flush();
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        const FramePipelineStats stats = renderer.GetStats();
+        return {frames / seconds, stats.averageLatencyMs, stats.maxLatencyMs, stats.framesDropped};
+    }
+
+    void Print(const char *name, const Result &result)
+    {
+        std::printf("%-22s %12.1f %14.2f %12.2f %9llu\n", name, result.framesPerSecond, result.averageLatencyMs,
+                    result.maxLatencyMs, (unsigned long long)result.dropped);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const double simulateMs = argc > 1 ? std::atof(argv[1]) : 8.0;
+    const double renderMs = argc > 2 ? std::atof(argv[2]) : 8.0;
+    const int frames = argc > 3 ? std::atoi(argv[3]) : 120;
+    const int draws = argc > 4 ? std::atoi(argv[4]) : 2000;
+
+    Benchmark::PrintTitle("Frame pipelining");
+    std::printf("%.1f ms simulation, %.1f ms render, %d frames of %d draws\n", simulateMs, renderMs, frames, draws);
+    std::printf("%-22s %12s %14s %12s %9s\n", "", "frames/s", "avg latency ms", "max latency", "dropped");
+    Print("serial", RunSerial(simulateMs, renderMs, frames, draws));
+    Print("pipelined, depth 2", RunPipelined(simulateMs, renderMs, frames, draws, 2, false));
+    Print("pipelined, depth 3", RunPipelined(simulateMs, renderMs, frames, draws, 3, false));
+    Print("depth 3, drop late", RunPipelined(simulateMs, renderMs, frames, draws, 3, true));
+
+    // Rendering slower than simulation: depth adds queued frames, dropping keeps latency down
+    Benchmark::PrintTitle("Render-bound");
+    std::printf("%.1f ms simulation, %.1f ms render\n", simulateMs / 2, renderMs * 2);
+    std::printf("%-22s %12s %14s %12s %9s\n", "", "frames/s", "avg latency ms", "max latency", "dropped");
+    Print("serial", RunSerial(simulateMs / 2, renderMs * 2, frames, draws));
+    Print("pipelined, depth 3", RunPipelined(simulateMs / 2, renderMs * 2, frames, draws, 3, false));
+    Print("depth 3, drop late", RunPipelined(simulateMs / 2, renderMs * 2, frames, draws, 3, true));
+    return 0;
+}
@@ -0,0 +1,98 @@
+// Application::Simulate throughput: a scene of moving agents, each with a
+// fixed-step speed change and a timer, run for a number of fixed ticks with
+// no window, renderer or clock. The same scene is simulated twice to show
+// the runs match.
+// Usage: HeadlessSimulationBenchmark [gameObjects] [ticks]
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <engine/Application.hpp>
+#include <engine/GameObjectScene.hpp>
+#include <engine/Positionable.hpp>
+#include <engine/Time.hpp>
+
+#include "Benchmark.hpp"
+
+using namespace N2Engine;
+
+namespace
+{
+    class Agent final : public Component
+    {
+    public:
+        explicit Agent(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "Agent"; }
+
+        void OnUpdate() override
+        {
+            Positionable *positionable = GetGameObject().GetPositionable();
+            positionable->SetPosition(positionable->GetPosition() + Math::Vector3{speed * Time::GetDeltaTime(), 0.f, 0.f});
+
+            sincePulse += Time::GetDeltaTime();
+            if (sincePulse >= 0.5f)
+            {
+                sincePulse -= 0.5f;
+                ++pulses;
+            }
+        }
+
+        void OnFixedUpdate() override { speed += 0.01f; }
+
+        float speed = 1.f;
+        float sincePulse = 0.f;
+        uint64_t pulses = 0;
+    };
+
+    std::unique_ptr<Scene> BuildScene(const std::string &name, const int objects)
+    {
+        auto scene = Scene::Create(name);
+        for (int i = 0; i < objects; ++i)
+        {
+            auto gameObject = GameObject::Create("Agent");
+            gameObject->CreatePositionable();
+            gameObject->GetPositionable()->SetPosition(Math::Vector3{0.f, static_cast<float>(i), 0.f});
+            gameObject->AddComponent<Agent>();
+            scene->AddRootGameObject(gameObject);
+        }
+        return scene;
+    }
+
+    // Sums what the simulation left behind; equal checksums mean equal runs
+    double Checksum(const Scene &scene)
+    {
+        double sum = 0.0;
+        for (const Agent *agent : scene.FindObjectsByType<Agent>())
+        {
+            sum += agent->GetGameObject().GetPositionable()->GetPosition().x + static_cast<double>(agent->pulses);
+        }
+        return sum;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const int objects = argc > 1 ? std::atoi(argv[1]) : 10000;
+    const uint64_t ticks = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 3000;
+
+    Application &app = Application::GetInstance();
+    app.Init({
+        .projectPath = "",
+        .physicsBackend = Config::ApplicationOptions::PhysicsBackend::PHYSX,
+        .renderBackend = Config::ApplicationOptions::RenderBackend::SOFTWARE,
+        .simulationOnly = true,
+    });
+
+    Benchmark::PrintTitle("Headless fixed-step simulation");
+    std::printf("%d GameObjects, %llu ticks of %.3f s\n", objects, (unsigned long long)ticks, Time::GetFixedUnscaledDeltaTime());
+    std::printf("%8s %12s %14s %12s %18s\n", "run", "ticks/s", "simulated s", "wall s", "checksum");
+    for (const char *name : {"first", "second"})
+    {
+        SceneManager::AddScene(BuildScene(name, objects), true);
+        SceneManager::ProcessAnyPendingSceneChange();
+        const SimulationStats stats = app.Simulate(ticks);
+        std::printf("%8s %12.0f %14.2f %12.3f %18.4f\n", name, stats.ticksPerSecond, stats.simulatedSeconds,
+                    stats.wallSeconds, Checksum(SceneManager::GetCurSceneRef()));
+    }
+    return 0;
+}
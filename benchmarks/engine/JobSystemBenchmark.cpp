@@ -0,0 +1,126 @@
+// The job system against the per-call std::jthread spawning it replaced:
+// a small ParallelFor run every frame, ParallelFor scaling over a large
+// array, the cost of one tiny job, and a chain of dependent fan-out stages.
+// Usage: JobSystemBenchmark [elements] [maxThreads]
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include <engine/scheduling/JobSystem.hpp>
+
+#include "Benchmark.hpp"
+
+using namespace N2Engine::Scheduling;
+
+namespace
+{
+    void Work(std::vector<float> &values, const size_t begin, const size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            values[i] = std::sqrt(values[i] * values[i] + 1.f) * 0.5f;
+        }
+    }
+
+    // What TransformHierarchy and EntityQuery did before: fresh threads on every call
+    void SpawnedParallelFor(std::vector<float> &values, const unsigned threadCount)
+    {
+        const size_t piece = (values.size() + threadCount - 1) / threadCount;
+        std::vector<std::jthread> workers;
+        for (unsigned t = 1; t < threadCount; ++t)
+        {
+            workers.emplace_back([&values, t, piece]
+            {
+                Work(values, std::min(values.size(), t * piece), std::min(values.size(), (t + 1) * piece));
+            });
+        }
+        Work(values, 0, std::min(values.size(), piece));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const size_t elements = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+    const unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    const unsigned maxThreads = argc > 2 ? (unsigned)std::atoi(argv[2]) : hardwareThreads;
+    JobSystem &jobs = JobSystem::Instance();
+
+    std::vector<float> values(elements, 1.f);
+    std::vector<float> small(16384, 1.f);
+    Benchmark::PrintHardwareThreads(maxThreads);
+
+    Benchmark::PrintTitle("Per-frame ParallelFor over 16k elements");
+    std::printf("%8s %16s %16s\n", "threads", "jthreads ms", "job system ms");
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        jobs.Initialize(threads);
+        const double spawnedMs = Benchmark::MeasureMs([&] { SpawnedParallelFor(small, threads); }, 200, 20);
+        const double jobMs = Benchmark::MeasureMs([&]
+        {
+            jobs.ParallelFor(small.size(), small.size() / threads, [&](size_t begin, size_t end) { Work(small, begin, end); });
+        }, 200, 20);
+        std::printf("%8u %16.4f %16.4f\n", threads, spawnedMs, jobMs);
+    }
+
+    Benchmark::PrintTitle("ParallelFor scaling");
+    std::printf("%zu elements\n", elements);
+    std::printf("%8s %12s %10s\n", "threads", "ms/pass", "speedup");
+    double serialMs = 0.0;
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        jobs.Initialize(threads);
+        const double ms = Benchmark::MeasureMs([&]
+        {
+            jobs.ParallelFor(values.size(), 4096, [&](size_t begin, size_t end) { Work(values, begin, end); });
+        });
+        serialMs = threads == 1 ? ms : serialMs;
+        std::printf("%8u %12.3f %10.2f\n", threads, ms, serialMs / ms);
+    }
+
+    jobs.Initialize(maxThreads);
+    Benchmark::PrintTitle("Job overhead and dependencies");
+    constexpr int TinyJobs = 100000;
+    std::atomic<int> sink{0};
+    const double tinyMs = Benchmark::MeasureMs([&]
+    {
+        JobCounter counter;
+        for (int i = 0; i < TinyJobs; ++i)
+        {
+            jobs.Submit([&sink] { sink.fetch_add(1, std::memory_order_relaxed); }, &counter);
+        }
+        jobs.Wait(counter);
+    }, 10, 2);
+    std::printf("%32s %10.3f us/job\n", "submit + run one tiny job", tinyMs * 1000.0 / TinyJobs);
+
+    // Each stage fans out once the previous one has finished
+    constexpr int Stages = 100;
+    constexpr int JobsPerStage = 64;
+    const double chainMs = Benchmark::MeasureMs([&]
+    {
+        std::vector<JobCounter> stages(Stages);
+        for (int i = 0; i < JobsPerStage; ++i)
+        {
+            jobs.Submit([&sink] { sink.fetch_add(1, std::memory_order_relaxed); }, &stages[0]);
+        }
+        for (int s = 1; s < Stages; ++s)
+        {
+            for (int i = 0; i < JobsPerStage; ++i)
+            {
+                jobs.SubmitAfter(stages[s - 1], [&sink] { sink.fetch_add(1, std::memory_order_relaxed); }, &stages[s]);
+            }
+        }
+        jobs.Wait(stages.back());
+    }, 10, 2);
+    std::printf("%32s %10.3f ms\n", "100 dependent stages of 64 jobs", chainMs);
+
+    const JobSystemStats stats = jobs.GetStats();
+    std::printf("\n%u threads, %llu jobs run, %llu stolen\n",
+                stats.threadCount, (unsigned long long)stats.executed, (unsigned long long)stats.stolen);
+    jobs.Shutdown();
+    return 0;
+}
@@ -0,0 +1,126 @@
+// Projectile-style churn: waves of GameObjects with two components spawned and
+// released every frame, and the same block churn on a raw ObjectPool against
+// the global allocator, with a random half of each wave freed out of order.
+// Usage: ObjectPoolBenchmark [perWave] [waves]
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <engine/GameObjectScene.hpp>
+#include <engine/memory/ObjectPool.hpp>
+
+#include "Benchmark.hpp"
+
+using namespace N2Engine;
+
+namespace
+{
+    class Projectile final : public Component
+    {
+    public:
+        explicit Projectile(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "Projectile"; }
+
+        float velocity[3] = {};
+        float lifetime = 0.f;
+    };
+
+    class Trail final : public Component
+    {
+    public:
+        explicit Trail(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "Trail"; }
+
+        float points[32] = {};
+    };
+
+    // Frees a random half, refills it, then frees everything: the order a mixed despawn leaves behind
+    template <typename Allocate, typename Free>
+    void Churn(std::vector<void*> &blocks, const std::vector<size_t> &order, Allocate &&allocate, Free &&free)
+    {
+        for (void *&block : blocks)
+        {
+            block = allocate();
+        }
+        for (size_t i = 0; i < order.size() / 2; ++i)
+        {
+            free(blocks[order[i]]);
+            blocks[order[i]] = allocate();
+        }
+        for (const size_t i : order)
+        {
+            free(blocks[i]);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const int perWave = argc > 1 ? std::atoi(argv[1]) : 10000;
+    const int waves = argc > 2 ? std::atoi(argv[2]) : 10;
+
+    Benchmark::PrintTitle("Pooled GameObjects and Components");
+    std::printf("%d GameObjects per wave, %d waves per run\n", perWave, waves);
+    std::printf("%28s %12s\n", "", "ms/wave");
+
+    std::vector<GameObject::Ptr> wave;
+    wave.reserve(perWave);
+    const double spawnMs = Benchmark::MeasureMs([&]
+    {
+        for (int w = 0; w < waves; ++w)
+        {
+            for (int i = 0; i < perWave; ++i)
+            {
+                GameObject::Ptr gameObject = GameObject::Create("Projectile");
+                gameObject->AddComponent<Projectile>();
+                gameObject->AddComponent<Trail>();
+                wave.push_back(std::move(gameObject));
+            }
+            wave.clear();
+        }
+    }) / waves;
+    std::printf("%28s %12.3f\n", "spawn + despawn", spawnMs);
+
+    std::vector<size_t> order(perWave);
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        order[i] = i;
+    }
+    std::ranges::shuffle(order, std::mt19937{5});
+    std::vector<void*> blocks(perWave);
+
+    const double globalMs = Benchmark::MeasureMs([&]
+    {
+        for (int w = 0; w < waves; ++w)
+        {
+            Churn(blocks, order,
+                  [] { return ::operator new(sizeof(Trail)); },
+                  [](void *block) { ::operator delete(block); });
+        }
+    }) / waves;
+    std::printf("%28s %12.3f\n", "global new/delete churn", globalMs);
+
+    Memory::ObjectPool pool{"Benchmark", sizeof(Trail)};
+    const double pooledMs = Benchmark::MeasureMs([&]
+    {
+        for (int w = 0; w < waves; ++w)
+        {
+            Churn(blocks, order,
+                  [&] { return pool.Allocate(); },
+                  [&](void *block) { pool.Deallocate(block); });
+        }
+    }) / waves;
+    std::printf("%28s %12.3f\n", "ObjectPool churn", pooledMs);
+
+    std::printf("\n%18s %8s %8s %8s %8s %8s\n", "pool", "block", "live", "free", "peak", "slabs");
+    for (const Memory::PoolStats &stats : Memory::ObjectPools::Instance().GetStats())
+    {
+        std::printf("%18s %8zu %8zu %8zu %8zu %8zu\n",
+                    stats.name.c_str(), stats.blockSize, stats.live, stats.free, stats.highWater, stats.slabs);
+    }
+    return 0;
+}
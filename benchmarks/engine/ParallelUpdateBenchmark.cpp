@@ -0,0 +1,141 @@
+// Scene::Update with component types that opt into worker-thread updates
+// against the same work declared serial: a ParallelSafe type, and two types
+// with non-conflicting write sets sharing one stage. Also the cost of the
+// race detector. Speedups need as many cores as threads.
+// Usage: ParallelUpdateBenchmark [gameObjects] [workPerUpdate] [maxThreads]
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include <engine/GameObjectScene.hpp>
+#include <engine/scheduling/JobSystem.hpp>
+
+#include "Benchmark.hpp"
+
+using namespace N2Engine;
+
+namespace
+{
+    int workPerUpdate = 64;
+
+    float Simulate(float value)
+    {
+        for (int i = 0; i < workPerUpdate; ++i)
+        {
+            value = std::sqrt(value * value + 1.f) * 0.5f;
+        }
+        return value;
+    }
+
+    class SerialAgent final : public Component
+    {
+    public:
+        explicit SerialAgent(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "SerialAgent"; }
+        void OnUpdate() override { state = Simulate(state); }
+
+        float state = 1.f;
+    };
+
+    class ParallelAgent final : public Component
+    {
+    public:
+        static constexpr bool ParallelSafe = true;
+
+        explicit ParallelAgent(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "ParallelAgent"; }
+        void OnUpdate() override { state = Simulate(state); }
+
+        float state = 1.f;
+    };
+
+    struct Steering {};
+    struct Animation {};
+
+    class Steerer final : public Component
+    {
+    public:
+        using WriteSet = ComponentAccessSet<Steering>;
+
+        explicit Steerer(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "Steerer"; }
+        void OnUpdate() override { state = Simulate(state); }
+
+        float state = 1.f;
+    };
+
+    class Animator final : public Component
+    {
+    public:
+        using WriteSet = ComponentAccessSet<Animation>;
+
+        explicit Animator(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "Animator"; }
+        void OnUpdate() override { state = Simulate(state); }
+
+        float state = 1.f;
+    };
+
+    template <typename... Ts>
+    std::unique_ptr<Scene> BuildScene(const int objects)
+    {
+        auto scene = Scene::Create("ParallelUpdateBenchmark");
+        scene->SetRaceDetection(false);
+        for (int i = 0; i < objects; ++i)
+        {
+            auto gameObject = GameObject::Create("Agent");
+            (gameObject->AddComponent<Ts>(), ...);
+            scene->AddRootGameObject(gameObject);
+        }
+        scene->ProcessAttachQueue();
+        return scene;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const int objects = argc > 1 ? std::atoi(argv[1]) : 20000;
+    workPerUpdate = argc > 2 ? std::atoi(argv[2]) : 64;
+    const unsigned maxThreads = argc > 3 ? (unsigned)std::atoi(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+    Scheduling::JobSystem &jobs = Scheduling::JobSystem::Instance();
+
+    const auto serial = BuildScene<SerialAgent>(objects);
+    const auto parallel = BuildScene<ParallelAgent>(objects);
+    const auto serialPair = BuildScene<SerialAgent, SerialAgent>(objects);
+    const auto declared = BuildScene<Steerer, Animator>(objects);
+    Benchmark::PrintHardwareThreads(maxThreads);
+
+    Benchmark::PrintTitle("Scene::Update, one type");
+    std::printf("%d GameObjects, %d steps of work per update\n", objects, workPerUpdate);
+    std::printf("%8s %12s %14s %10s\n", "threads", "serial ms", "parallel ms", "speedup");
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        jobs.Initialize(threads);
+        const double serialMs = Benchmark::MeasureMs([&] { serial->Update(); });
+        const double parallelMs = Benchmark::MeasureMs([&] { parallel->Update(); });
+        std::printf("%8u %12.3f %14.3f %10.2f\n", threads, serialMs, parallelMs, serialMs / parallelMs);
+    }
+
+    Benchmark::PrintTitle("Scene::Update, two types with disjoint write sets");
+    std::printf("%8s %12s %14s %10s\n", "threads", "serial ms", "declared ms", "speedup");
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        jobs.Initialize(threads);
+        const double serialMs = Benchmark::MeasureMs([&] { serialPair->Update(); });
+        const double declaredMs = Benchmark::MeasureMs([&] { declared->Update(); });
+        std::printf("%8u %12.3f %14.3f %10.2f\n", threads, serialMs, declaredMs, serialMs / declaredMs);
+    }
+
+    jobs.Initialize(maxThreads);
+    Benchmark::PrintTitle("Race detection");
+    const double plainMs = Benchmark::MeasureMs([&] { declared->Update(); });
+    declared->SetRaceDetection(true);
+    const double checkedMs = Benchmark::MeasureMs([&] { declared->Update(); });
+    std::printf("%24s %10.3f ms\n%24s %10.3f ms\n", "declared, unchecked", plainMs, "declared, race detection", checkedMs);
+    jobs.Shutdown();
+    return 0;
+}
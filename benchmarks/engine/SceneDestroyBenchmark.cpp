@@ -0,0 +1,108 @@
+// Mass despawn in one frame: every child of a crowded container, every other
+// root of a flat scene, and a whole subtree at once, each GameObject carrying
+// an updating component. Only Scene::ProcessDestroyed is timed.
+// Usage: SceneDestroyBenchmark [count] [runs]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <engine/GameObjectScene.hpp>
+
+#include "Benchmark.hpp"
+
+using namespace N2Engine;
+
+namespace
+{
+    class Enemy final : public Component
+    {
+    public:
+        explicit Enemy(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "Enemy"; }
+        void OnUpdate() override { ++ticks; }
+
+        int ticks = 0;
+    };
+
+    GameObject::Ptr Spawn(const char *name)
+    {
+        auto gameObject = GameObject::Create(name);
+        gameObject->AddComponent<Enemy>();
+        return gameObject;
+    }
+
+    // Median time of ProcessDestroyed over fresh scenes; setup queues the frame's destructions
+    template <typename Setup>
+    double MeasureDespawnMs(const int runs, Setup &&setup)
+    {
+        std::vector<double> samples;
+        for (int i = 0; i < runs; ++i)
+        {
+            auto scene = Scene::Create("Despawn");
+            setup(*scene);
+            scene->ProcessAttachQueue();
+
+            const auto start = std::chrono::steady_clock::now();
+            scene->ProcessDestroyed();
+            const auto end = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        std::ranges::sort(samples);
+        return samples[samples.size() / 2];
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const int count = argc > 1 ? std::atoi(argv[1]) : 10000;
+    const int runs = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    Benchmark::PrintTitle("Mass despawn in Scene::ProcessDestroyed");
+    std::printf("%d GameObjects per scene, median of %d runs\n", count, runs);
+    std::printf("%32s %12s\n", "", "ms/frame");
+
+    std::vector<GameObject::Ptr> spawned;
+    const double childrenMs = MeasureDespawnMs(runs, [&](Scene &scene)
+    {
+        auto container = GameObject::Create("Container");
+        scene.AddRootGameObject(container);
+        for (int i = 0; i < count; ++i)
+        {
+            auto child = Spawn("Child");
+            container->AddChild(child, false);
+            child->Destroy();
+        }
+    });
+    std::printf("%32s %12.3f\n", "every child of one container", childrenMs);
+
+    const double rootsMs = MeasureDespawnMs(runs, [&](Scene &scene)
+    {
+        spawned.clear();
+        for (int i = 0; i < count; ++i)
+        {
+            spawned.push_back(Spawn("Root"));
+        }
+        scene.AddRootGameObjects(spawned);
+        for (int i = 0; i < count; i += 2)
+        {
+            spawned[i]->Destroy();
+        }
+    });
+    std::printf("%32s %12.3f\n", "every other root", rootsMs);
+
+    const double subtreeMs = MeasureDespawnMs(runs, [&](Scene &scene)
+    {
+        auto container = GameObject::Create("Container");
+        scene.AddRootGameObject(container);
+        for (int i = 0; i < count; ++i)
+        {
+            container->AddChild(Spawn("Child"), false);
+        }
+        container->Destroy();
+    });
+    std::printf("%32s %12.3f\n", "one container and its children", subtreeMs);
+    return 0;
+}
@@ -0,0 +1,93 @@
+// Walking every GameObject of a large scene: the recursive std::function walk
+// with shared_ptr copies that TraverseAll used before, against the visitor
+// Traverse, the GameObjects range and GetAllGameObjects.
+// Usage: SceneTraversalBenchmark [nodes] [fanout]
+
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+#include <engine/GameObjectScene.hpp>
+
+#include "Benchmark.hpp"
+
+using namespace N2Engine;
+
+namespace
+{
+    // The previous TraverseAll: recursion taking shared_ptr and std::function by value
+    void TraverseRecursive(std::shared_ptr<GameObject> gameObject,
+                           std::function<void(std::shared_ptr<GameObject>)> callback)
+    {
+        callback(gameObject);
+        for (const auto &child : gameObject->GetChildren())
+        {
+            TraverseRecursive(child, callback);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const int nodes = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    const int fanout = argc > 2 ? std::atoi(argv[2]) : 8;
+
+    // Breadth-first fill so every parent gets fanout children
+    auto scene = Scene::Create("Traversal");
+    std::vector<GameObject::Ptr> created;
+    created.reserve(nodes);
+    created.push_back(GameObject::Create("Root"));
+    for (int i = 1; i < nodes; ++i)
+    {
+        auto gameObject = GameObject::Create("Node");
+        created[(i - 1) / fanout]->AddChild(gameObject, false);
+        created.push_back(std::move(gameObject));
+    }
+    scene->AddRootGameObject(created.front());
+    const GameObject::Ptr root = created.front();
+    created.clear();
+
+    Benchmark::PrintTitle("Scene traversal");
+    std::printf("%d GameObjects, fanout %d\n", nodes, fanout);
+    std::printf("%28s %12s %12s\n", "", "ms/walk", "visited");
+
+    size_t visited = 0;
+    const double recursiveMs = Benchmark::MeasureMs([&]
+    {
+        visited = 0;
+        TraverseRecursive(root, [&](const std::shared_ptr<GameObject> &) { ++visited; });
+    });
+    std::printf("%28s %12.3f %12zu\n", "recursive shared_ptr walk", recursiveMs, visited);
+
+    const double wrapperMs = Benchmark::MeasureMs([&]
+    {
+        visited = 0;
+        scene->TraverseAll([&](const std::shared_ptr<GameObject> &) { ++visited; });
+    });
+    std::printf("%28s %12.3f %12zu\n", "TraverseAll", wrapperMs, visited);
+
+    const double visitorMs = Benchmark::MeasureMs([&]
+    {
+        visited = 0;
+        scene->Traverse([&](const GameObject &) { ++visited; });
+    });
+    std::printf("%28s %12.3f %12zu\n", "Traverse", visitorMs, visited);
+
+    const double rangeMs = Benchmark::MeasureMs([&]
+    {
+        visited = 0;
+        for ([[maybe_unused]] GameObject &gameObject : scene->GameObjects())
+        {
+            ++visited;
+        }
+    });
+    std::printf("%28s %12.3f %12zu\n", "GameObjects range", rangeMs, visited);
+
+    const double collectMs = Benchmark::MeasureMs([&]
+    {
+        visited = scene->GetAllGameObjects().size();
+    });
+    std::printf("%28s %12.3f %12zu\n", "GetAllGameObjects", collectMs, visited);
+    return 0;
+}
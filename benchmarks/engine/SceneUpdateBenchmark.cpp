@@ -0,0 +1,104 @@
+// Scene::Update throughput with many components, most of which never
+// override OnUpdate, against the previous dispatch: a std::function visiting
+// every component with a virtual OnUpdate call and activity checks.
+// Usage: SceneUpdateBenchmark [gameObjects] [tickingEvery]
+
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+#include <engine/GameObjectScene.hpp>
+
+#include "Benchmark.hpp"
+
+using namespace N2Engine;
+
+namespace
+{
+    class Spinner final : public Component
+    {
+    public:
+        explicit Spinner(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "Spinner"; }
+        void OnUpdate() override { angle += 0.25f; ++ticks; }
+
+        float angle = 0.f;
+        uint64_t ticks = 0;
+    };
+
+    // Plain data components: no lifecycle hooks
+    template <int N>
+    class Passive final : public Component
+    {
+    public:
+        explicit Passive(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "Passive"; }
+
+        float data[4] = {};
+    };
+
+    // The dispatch Scene::Update used before per-type hook lists
+    void LegacyUpdate(const std::vector<Component*> &components)
+    {
+        const std::function<void(Component *)> callback = [](Component *component) { component->OnUpdate(); };
+        for (const auto &c : components)
+        {
+            if (c->GetGameObject().IsActiveInHierarchy() && c->IsActive())
+            {
+                callback(c);
+            }
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const int objects = argc > 1 ? std::atoi(argv[1]) : 50000;
+    const int tickingEvery = argc > 2 ? std::atoi(argv[2]) : 4;
+
+    auto scene = Scene::Create("SceneUpdateBenchmark");
+    std::vector<Component*> components;
+    std::vector<Spinner*> spinners;
+    for (int i = 0; i < objects; ++i)
+    {
+        auto gameObject = GameObject::Create("Object");
+        components.push_back(gameObject->AddComponent<Passive<0>>());
+        components.push_back(gameObject->AddComponent<Passive<1>>());
+        components.push_back(gameObject->AddComponent<Passive<2>>());
+        if (i % tickingEvery == 0)
+        {
+            spinners.push_back(gameObject->AddComponent<Spinner>());
+            components.push_back(spinners.back());
+        }
+        scene->AddRootGameObject(gameObject);
+    }
+    scene->ProcessAttachQueue();
+
+    auto totalTicks = [&]
+    {
+        uint64_t total = 0;
+        for (const Spinner *spinner : spinners)
+            total += spinner->ticks;
+        return total;
+    };
+
+    Benchmark::PrintTitle("Scene update dispatch");
+    std::printf("%d game objects, %zu components, %zu override OnUpdate\n", objects, components.size(), spinners.size());
+    std::printf("%16s %12s %14s\n", "dispatch", "ms/update", "ticks/update");
+
+    for (const bool legacy : {true, false})
+    {
+        const uint64_t before = totalTicks();
+        const double ms = Benchmark::MeasureMs([&]
+        {
+            if (legacy)
+                LegacyUpdate(components);
+            else
+                scene->Update();
+        }, 50, 5);
+        std::printf("%16s %12.3f %14.0f\n", legacy ? "all, virtual" : "per-type lists", ms,
+                    (double)(totalTicks() - before) / 55.0);
+    }
+    return 0;
+}
@@ -0,0 +1,134 @@
+// Proximity queries over a scene of moving objects: a TraverseAll scan, as
+// gameplay code did before, against the scene's spatial index, including the
+// per-frame refit that keeps the index in step with the transforms.
+// Usage: SpatialIndexBenchmark [objects] [queries] [moving%]
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <engine/GameObjectScene.hpp>
+#include <engine/Positionable.hpp>
+#include <engine/TransformHierarchy.hpp>
+#include <engine/spatial/SpatialIndex.hpp>
+
+#include "Benchmark.hpp"
+
+using namespace N2Engine;
+using Math::Vector3;
+
+int main(int argc, char **argv)
+{
+    const int objects = argc > 1 ? std::atoi(argv[1]) : 100000;
+    const int queries = argc > 2 ? std::atoi(argv[2]) : 100;
+    const int movingPercent = argc > 3 ? std::atoi(argv[3]) : 100;
+
+    Positionable::Matrix4::InitializeSIMD();
+
+    // Objects spread over a 1 km cube, each drifting with its own velocity
+    std::mt19937 rng{42};
+    std::uniform_real_distribution<float> coordinate{-500.f, 500.f};
+    std::uniform_real_distribution<float> speed{-0.1f, 0.1f};
+    auto scene = Scene::Create("Spatial");
+    auto root = GameObject::Create("Root");
+    std::vector<GameObject::Ptr> movers;
+    std::vector<Vector3> velocities;
+    for (int i = 0; i < objects; ++i)
+    {
+        auto gameObject = GameObject::Create("Object");
+        gameObject->CreatePositionable();
+        gameObject->GetPositionable()->SetLocalPosition({coordinate(rng), coordinate(rng), coordinate(rng)});
+        root->AddChild(gameObject, false);
+        if (i % 100 < movingPercent)
+        {
+            movers.push_back(gameObject);
+            velocities.push_back(Vector3{speed(rng), speed(rng), speed(rng)});
+        }
+    }
+    scene->AddRootGameObject(root);
+
+    std::vector<Vector3> centers;
+    for (int q = 0; q < queries; ++q)
+    {
+        centers.push_back(Vector3{coordinate(rng), coordinate(rng), coordinate(rng)});
+    }
+    constexpr float radius = 25.f;
+
+    Spatial::SpatialIndex &index = scene->GetSpatialIndex();
+    auto moveAll = [&]
+    {
+        for (size_t i = 0; i < movers.size(); ++i)
+        {
+            Positionable *positionable = movers[i]->GetPositionable();
+            positionable->SetLocalPosition(positionable->GetLocalPosition() + velocities[i]);
+        }
+        scene->GetTransformHierarchy().UpdateWorldTransforms();
+    };
+
+    Benchmark::PrintTitle("Spatial index queries");
+    std::printf("%d objects, %zu moving, %d sphere queries of radius %.0f per frame\n", objects, movers.size(),
+                queries, radius);
+    std::printf("%24s %12s %12s\n", "", "ms/frame", "found");
+
+    size_t scanFound = 0;
+    const double scanMs = Benchmark::MeasureMs([&]
+    {
+        scanFound = 0;
+        for (const Vector3 &center : centers)
+        {
+            scene->TraverseAll([&](const std::shared_ptr<GameObject> &gameObject)
+            {
+                if (const Positionable *positionable = gameObject->GetPositionable();
+                    positionable && (positionable->GetPosition() - center).LengthSquared() <= radius * radius)
+                {
+                    ++scanFound;
+                }
+            });
+        }
+    }, 5, 1);
+    std::printf("%24s %12.3f %12zu\n", "TraverseAll scan", scanMs, scanFound);
+
+    size_t treeFound = 0;
+    std::vector<GameObject*> found;
+    const double queryMs = Benchmark::MeasureMs([&]
+    {
+        treeFound = 0;
+        for (const Vector3 &center : centers)
+        {
+            found.clear();
+            index.QuerySphere(center, radius, found);
+            treeFound += found.size();
+        }
+    }, 20, 2);
+    std::printf("%24s %12.3f %12zu\n", "index queries", queryMs, treeFound);
+
+    // The cost a moving scene pays every frame to keep queries exact
+    const double moveMs = Benchmark::MeasureMs(moveAll, 20, 2);
+    std::printf("%24s %12.3f\n", "move + world pass", moveMs);
+
+    size_t reinserted = 0;
+    int frames = 0;
+    const double refitMs = Benchmark::MeasureMs([&]
+    {
+        moveAll();
+        reinserted += index.Refit();
+        ++frames;
+    }, 20, 2);
+    std::printf("%24s %12.3f %12zu reinserted/frame, tree height %d\n", "move + pass + refit", refitMs,
+                reinserted / frames, index.GetTree().GetHeight());
+
+    size_t nearestFound = 0;
+    const double nearestMs = Benchmark::MeasureMs([&]
+    {
+        nearestFound = 0;
+        for (const Vector3 &center : centers)
+        {
+            found.clear();
+            index.QueryNearest(center, 8, found);
+            nearestFound += found.size();
+        }
+    }, 20, 2);
+    std::printf("%24s %12.3f %12zu\n", "index 8-nearest", nearestMs, nearestFound);
+    return 0;
+}
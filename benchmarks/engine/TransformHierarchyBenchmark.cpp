@@ -0,0 +1,148 @@
+// World transforms of skeleton-like rigs whose roots move every frame: the
+// recursive walk the GameObject tree implied before (dirty marking through
+// GetChildren, then parent-combined transforms) against the flat hierarchy
+// pass, serial and threaded.
+// Usage: TransformHierarchyBenchmark [characters] [bones] [threads]
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <engine/GameObjectScene.hpp>
+#include <engine/Positionable.hpp>
+#include <engine/TransformHierarchy.hpp>
+#include <engine/scheduling/JobSystem.hpp>
+
+#include "Benchmark.hpp"
+
+using namespace N2Engine;
+
+namespace
+{
+    // The previous Positionable: mark every descendant, then combine each node with its parent
+    // (without building matrices, so this flatters the recursive walk)
+    void MarkRecursive(const GameObject &gameObject, std::vector<uint8_t> &dirty, size_t &visited)
+    {
+        ++visited;
+        dirty.push_back(1);
+        for (const auto &child : gameObject.GetChildren())
+        {
+            MarkRecursive(*child, dirty, visited);
+        }
+    }
+
+    void CombineRecursive(const GameObject &gameObject, const Transform &parentWorld, double &checksum)
+    {
+        Transform world = Transform::Combine(parentWorld, gameObject.GetPositionable()->GetLocalTransform());
+        checksum += world.GetPosition().x;
+        for (const auto &child : gameObject.GetChildren())
+        {
+            CombineRecursive(*child, world, checksum);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const int characters = argc > 1 ? std::atoi(argv[1]) : 1000;
+    const int bones = argc > 2 ? std::atoi(argv[2]) : 200;
+    const unsigned threads = argc > 3 ? (unsigned)std::atoi(argv[3]) : 0;
+    Scheduling::JobSystem::Instance().Initialize(threads);
+
+    Positionable::Matrix4::InitializeSIMD();
+
+    // Chains of ten bones, each branching off a bone of the previous chain
+    auto scene = Scene::Create("TransformHierarchyBenchmark");
+    std::vector<GameObject::Ptr> roots;
+    std::vector<GameObject::Ptr> leaves;
+    for (int c = 0; c < characters; ++c)
+    {
+        std::vector<GameObject::Ptr> rig;
+        for (int b = 0; b < bones; ++b)
+        {
+            auto bone = GameObject::Create("Bone");
+            bone->CreatePositionable();
+            bone->GetPositionable()->SetLocalPosition({0.f, 0.1f, 0.f});
+            bone->GetPositionable()->SetLocalRotation(Math::Quaternion::FromEulerAngles(0.f, 0.f, 0.05f));
+            if (b > 0)
+            {
+                rig[b % 10 ? b - 1 : b / 2]->AddChild(bone, false);
+            }
+            rig.push_back(std::move(bone));
+        }
+        scene->AddRootGameObject(rig.front());
+        roots.push_back(rig.front());
+        leaves.push_back(rig.back());
+    }
+
+    TransformHierarchy &hierarchy = scene->GetTransformHierarchy();
+    hierarchy.UpdateWorldTransforms();
+
+    int frame = 0;
+    auto moveRoots = [&]
+    {
+        ++frame;
+        for (int c = 0; c < characters; ++c)
+        {
+            roots[c]->GetPositionable()->SetLocalPosition({(float)c, std::sin(frame * 0.1f), 0.f});
+        }
+    };
+
+    Benchmark::PrintTitle("Transform hierarchy update");
+    std::printf("%d characters x %d bones, %zu nodes\n", characters, bones, hierarchy.GetNodeCount());
+    std::printf("%20s %12s %10s\n", "update", "ms/frame", "identical");
+
+    double legacySum = 0.0;
+    std::vector<uint8_t> dirty;
+    frame = 0;
+    const double legacyMs = Benchmark::MeasureMs([&]
+    {
+        moveRoots();
+        dirty.clear();
+        legacySum = 0.0;
+        size_t visited = 0;
+        for (const auto &root : roots)
+        {
+            MarkRecursive(*root, dirty, visited);
+            CombineRecursive(*root, Transform::Identity(), legacySum);
+        }
+    }, 20, 2);
+    std::printf("%20s %12.3f %10s\n", "recursive walk", legacyMs, "yes");
+
+    auto leafChecksum = [&]
+    {
+        double sum = 0.0;
+        for (const auto &leaf : leaves)
+            sum += leaf->GetPositionable()->GetPosition().x;
+        return sum;
+    };
+    double legacyLeaves = 0.0;
+    for (const auto &leaf : leaves)
+    {
+        // Same frame as the last recursive pass
+        Transform world = leaf->GetPositionable()->GetLocalTransform();
+        for (auto parent = leaf->GetParent(); parent; parent = parent->GetParent())
+            world = Transform::Combine(parent->GetPositionable()->GetLocalTransform(), world);
+        legacyLeaves += world.GetPosition().x;
+    }
+
+    // Every measurement replays the same frames, so the leaves must land on the recursive result
+    auto flatPass = [&](unsigned threadCount)
+    {
+        frame = 0;
+        return Benchmark::MeasureMs([&]
+        {
+            moveRoots();
+            hierarchy.UpdateWorldTransforms(threadCount);
+        }, 20, 2);
+    };
+    auto identical = [&] { return std::fabs(leafChecksum() - legacyLeaves) < 1e-2 * characters ? "yes" : "NO"; };
+
+    const double serialMs = flatPass(1);
+    std::printf("%20s %12.3f %10s\n", "flat pass", serialMs, identical());
+
+    const double parallelMs = flatPass(threads);
+    std::printf("%20s %12.3f %10s\n", "flat pass threaded", parallelMs, identical());
+    return 0;
+}
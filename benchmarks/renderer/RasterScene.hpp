@@ -0,0 +1,161 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <renderer/common/Renderer.hpp>
+
+// Shared scene setup for the software rasterizer benchmarks: a field of lit,
+// unlit and textured spheres in front of a large textured backdrop sphere.
+namespace Benchmark
+{
+    inline Renderer::Common::MeshData MakeSphere(int latSegments, int lonSegments, float radius)
+    {
+        constexpr float pi = 3.14159265358979f;
+        Renderer::Common::MeshData data;
+        for (int lat = 0; lat <= latSegments; ++lat)
+        {
+            const float theta = (float)lat * pi / (float)latSegments;
+            for (int lon = 0; lon <= lonSegments; ++lon)
+            {
+                const float phi = (float)lon * 2.f * pi / (float)lonSegments;
+                const float x = std::cos(phi) * std::sin(theta);
+                const float y = std::cos(theta);
+                const float z = std::sin(phi) * std::sin(theta);
+
+                Renderer::Common::Vertex v{};
+                v.position[0] = x * radius; v.position[1] = y * radius; v.position[2] = z * radius;
+                v.normal[0] = x; v.normal[1] = y; v.normal[2] = z;
+                v.texCoord[0] = (float)lon / (float)lonSegments;
+                v.texCoord[1] = (float)lat / (float)latSegments;
+                v.color[0] = v.color[1] = v.color[2] = v.color[3] = 1.f;
+                data.vertices.push_back(v);
+            }
+        }
+        for (int lat = 0; lat < latSegments; ++lat)
+        {
+            for (int lon = 0; lon < lonSegments; ++lon)
+            {
+                const uint32_t a = lat * (lonSegments + 1) + lon;
+                const uint32_t b = a + lonSegments + 1;
+                data.indices.insert(data.indices.end(), {a, a + 1, b, b, a + 1, b + 1});
+            }
+        }
+        return data;
+    }
+
+    // Row-major, matching the renderer's convention.
+    inline std::array<float, 16> Identity()
+    {
+        return {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+    }
+
+    inline std::array<float, 16> Translation(float x, float y, float z)
+    {
+        auto m = Identity();
+        m[3] = x; m[7] = y; m[11] = z;
+        return m;
+    }
+
+    inline std::array<float, 16> Perspective(float fovY, float aspect, float zNear, float zFar)
+    {
+        const float f = 1.f / std::tan(fovY * 0.5f);
+        std::array<float, 16> m{};
+        m[0] = f / aspect;
+        m[5] = f;
+        m[10] = (zFar + zNear) / (zNear - zFar);
+        m[11] = 2.f * zFar * zNear / (zNear - zFar);
+        m[14] = -1.f;
+        return m;
+    }
+
+    class RasterScene
+    {
+    public:
+        void Create(Renderer::Common::IRenderer &renderer, int sphereCount, uint32_t width, uint32_t height)
+        {
+            std::vector<uint8_t> texels(64 * 64 * 4);
+            for (int i = 0; i < 64 * 64; ++i)
+            {
+                const int x = i % 64, y = i / 64;
+                texels[i * 4 + 0] = (uint8_t)(x * 4);
+                texels[i * 4 + 1] = (uint8_t)(y * 4);
+                texels[i * 4 + 2] = ((x / 8 + y / 8) & 1) ? 255 : 32;
+                texels[i * 4 + 3] = 255;
+            }
+            m_texture = renderer.CreateTexture(texels.data(), 64, 64, 4);
+
+            const auto sphere = MakeSphere(16, 32, 1.f);
+            const auto backdrop = MakeSphere(32, 64, 6.f);
+            m_sphere = renderer.CreateMesh(sphere);
+            m_backdrop = renderer.CreateMesh(backdrop);
+            m_sphereTriangles = sphere.indices.size() / 3;
+            m_backdropTriangles = backdrop.indices.size() / 3;
+
+            m_materials[0] = renderer.CreateMaterial(renderer.GetStandardUnlitShader());
+            m_materials[1] = renderer.CreateMaterial(renderer.GetStandardLitShader());
+            m_materials[2] = renderer.CreateMaterial(renderer.GetStandardUnlitShader(), m_texture);
+            m_materials[3] = renderer.CreateMaterial(renderer.GetStandardLitShader(), m_texture);
+            m_materials[0]->SetColor("uAlbedo", 1.f, 0.5f, 0.2f, 1.f);
+            m_materials[1]->SetColor("uAlbedo", 0.3f, 0.8f, 0.5f, 1.f);
+
+            std::mt19937 rng(1234);
+            std::uniform_real_distribution<float> unit(-1.f, 1.f);
+            m_models.clear();
+            for (int i = 0; i < sphereCount; ++i)
+                m_models.push_back(Translation(unit(rng) * 8.f, unit(rng) * 6.f, -6.f + unit(rng) * 5.5f));
+
+            m_view = Translation(0.f, 0.f, -2.f);
+            m_proj = Perspective(1.f, (float)width / (float)height, 0.1f, 100.f);
+
+            m_lighting.ambientColor = N2Engine::Math::Vector3(0.1f, 0.1f, 0.1f);
+            Renderer::Common::DirectionalLightData sun{};
+            sun.direction = N2Engine::Math::Vector3(-0.3f, -1.f, -0.5f);
+            sun.color = N2Engine::Math::Vector3(1.f, 1.f, 1.f);
+            sun.intensity = 1.f;
+            m_lighting.directionalLights.push_back(sun);
+            Renderer::Common::PointLightData lamp{};
+            lamp.position = N2Engine::Math::Vector3(2.f, 2.f, -3.f);
+            lamp.color = N2Engine::Math::Vector3(1.f, 0.5f, 0.5f);
+            lamp.intensity = 2.f;
+            lamp.range = 10.f;
+            lamp.attenuation = 1.f;
+            m_lighting.pointLights.push_back(lamp);
+        }
+
+        void Draw(Renderer::Common::IRenderer &renderer) const
+        {
+            renderer.Clear(0.1f, 0.2f, 0.3f, 1.f);
+            renderer.BeginFrame();
+            renderer.SetViewProjection(m_view.data(), m_proj.data());
+            renderer.UpdateSceneLighting(m_lighting, N2Engine::Math::Vector3(0.f, 0.f, 2.f));
+
+            const auto backdrop = Translation(0.f, 0.f, -14.f);
+            renderer.DrawMesh(m_backdrop, backdrop.data(), m_materials[3]);
+            for (size_t i = 0; i < m_models.size(); ++i)
+                renderer.DrawMesh(m_sphere, m_models[i].data(), m_materials[i % m_materials.size()]);
+
+            renderer.EndFrame();
+            renderer.Present();
+        }
+
+        // Triangles submitted per Draw call.
+        [[nodiscard]] size_t GetTriangleCount() const
+        {
+            return m_backdropTriangles + m_sphereTriangles * m_models.size();
+        }
+
+    private:
+        Renderer::Common::ITexture *m_texture = nullptr;
+        Renderer::Common::IMesh *m_sphere = nullptr;
+        Renderer::Common::IMesh *m_backdrop = nullptr;
+        std::array<Renderer::Common::IMaterial *, 4> m_materials{};
+        std::vector<std::array<float, 16>> m_models;
+        size_t m_sphereTriangles = 0, m_backdropTriangles = 0;
+        std::array<float, 16> m_view{}, m_proj{};
+        Renderer::Common::SceneLightingData m_lighting;
+    };
+}
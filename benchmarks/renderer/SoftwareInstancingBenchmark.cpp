@@ -0,0 +1,96 @@
+// Main-thread submission cost of many identical meshes through DrawMesh
+// versus one DrawMeshInstanced call, plus the full frame time of each.
+// Usage: SoftwareInstancingBenchmark [width] [height] [instances]
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <renderer/software/SoftwareRenderer.hpp>
+
+#include "Benchmark.hpp"
+#include "RasterScene.hpp"
+
+int main(int argc, char **argv)
+{
+    const uint32_t width = argc > 1 ? (uint32_t)std::atoi(argv[1]) : 1920;
+    const uint32_t height = argc > 2 ? (uint32_t)std::atoi(argv[2]) : 1080;
+    const int instances = argc > 3 ? std::atoi(argv[3]) : 50000;
+
+    Renderer::Software::SoftwareRenderer renderer;
+    if (!renderer.Initialize(nullptr, width, height))
+    {
+        std::fprintf(stderr, "Failed to initialize the software renderer\n");
+        return 1;
+    }
+
+    auto *mesh = renderer.CreateMesh(Benchmark::MakeSphere(4, 8, 0.05f));
+    auto *material = renderer.CreateMaterial(renderer.GetStandardUnlitShader());
+    material->SetColor("uAlbedo", 0.9f, 0.6f, 0.2f, 1.f);
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> unit(-1.f, 1.f);
+    const auto storage = std::make_unique<float[][16]>(instances);
+    const std::span<const float[16]> models(storage.get(), (size_t)instances);
+    for (int i = 0; i < instances; ++i)
+    {
+        const auto m = Benchmark::Translation(unit(rng) * 12.f, unit(rng) * 7.f, -20.f + unit(rng) * 5.f);
+        std::memcpy(storage[i], m.data(), sizeof(storage[i]));
+    }
+
+    const auto view = Benchmark::Identity();
+    const auto proj = Benchmark::Perspective(1.f, (float)width / (float)height, 0.1f, 100.f);
+
+    auto submit = [&](bool instanced)
+    {
+        if (instanced)
+        {
+            renderer.DrawMeshInstanced(mesh, material, models);
+            return;
+        }
+        for (const auto &model : models)
+            renderer.DrawMesh(mesh, model, material);
+    };
+
+    Benchmark::PrintTitle("Software instanced draws");
+    std::printf("%ux%u, %d instances, %u raster threads\n", width, height, instances, renderer.GetRasterThreadCount());
+    std::printf("%10s %12s %12s %10s\n", "submit", "submit ms", "frame ms", "identical");
+
+    std::vector<uint8_t> reference(width * height * 4), pixels(width * height * 4);
+    bool haveReference = false;
+    for (const bool instanced : {false, true})
+    {
+        // Submission alone: the queue is dropped by the next BeginFrame.
+        const double submitMs = Benchmark::MeasureMs([&]
+        {
+            renderer.BeginFrame();
+            submit(instanced);
+        }, 20, 3);
+
+        const double frameMs = Benchmark::MeasureMs([&]
+        {
+            renderer.Clear(0.1f, 0.2f, 0.3f, 1.f);
+            renderer.BeginFrame();
+            renderer.SetViewProjection(view.data(), proj.data());
+            submit(instanced);
+            renderer.EndFrame();
+            renderer.Present();
+        }, 10, 2);
+
+        renderer.ReadFramebuffer(pixels.data(), (int)width, (int)height);
+        if (!haveReference)
+        {
+            reference = pixels;
+            haveReference = true;
+        }
+        std::printf("%10s %12.2f %12.2f %10s\n", instanced ? "instanced" : "per draw", submitMs, frameMs,
+                    pixels == reference ? "yes" : "NO");
+    }
+
+    renderer.Shutdown();
+    return 0;
+}
@@ -0,0 +1,62 @@
+// Frame time of the software rasterizer with and without hierarchical-Z
+// occlusion culling, plus how much of the scene each setting culled.
+// Usage: SoftwareRasterOcclusionBenchmark [width] [height] [spheres] [threads]
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <renderer/software/SoftwareRenderer.hpp>
+
+#include "Benchmark.hpp"
+#include "RasterScene.hpp"
+
+using Renderer::Software::SoftwareRenderer;
+using Renderer::Software::SWFrameStats;
+
+int main(int argc, char **argv)
+{
+    const uint32_t width = argc > 1 ? (uint32_t)std::atoi(argv[1]) : 1920;
+    const uint32_t height = argc > 2 ? (uint32_t)std::atoi(argv[2]) : 1080;
+    const int spheres = argc > 3 ? std::atoi(argv[3]) : 2000;
+    const uint32_t threads = argc > 4 ? (uint32_t)std::atoi(argv[4]) : 0;
+
+    SoftwareRenderer renderer;
+    if (!renderer.Initialize(nullptr, width, height))
+    {
+        std::fprintf(stderr, "Failed to initialize the software renderer\n");
+        return 1;
+    }
+    renderer.SetRasterThreadCount(threads);
+
+    Benchmark::RasterScene scene;
+    scene.Create(renderer, spheres, width, height);
+
+    Benchmark::PrintTitle("Software raster occlusion culling");
+    std::printf("%ux%u, %d spheres, %u raster threads\n", width, height, spheres, renderer.GetRasterThreadCount());
+    std::printf("%10s %12s %10s %14s %14s %14s %10s\n",
+                "culling", "ms/frame", "speedup", "draws culled", "tris culled", "tris raster", "identical");
+
+    std::vector<uint8_t> reference(width * height * 4), pixels(width * height * 4);
+    double baseline = 0.0;
+    for (const bool culling : {false, true})
+    {
+        renderer.SetOcclusionCulling(culling);
+        const double ms = Benchmark::MeasureMs([&] { scene.Draw(renderer); }, 20, 3);
+        const SWFrameStats stats = renderer.GetFrameStats();
+
+        renderer.ReadFramebuffer(pixels.data(), (int)width, (int)height);
+        if (baseline == 0.0)
+        {
+            baseline = ms;
+            reference = pixels;
+        }
+        std::printf("%10s %12.2f %9.2fx %8u/%-5u %14u %14u %10s\n", culling ? "on" : "off", ms, baseline / ms,
+                    stats.drawsOutsideFrustum + stats.drawsOccluded, stats.drawsSubmitted,
+                    stats.trianglesOccluded, stats.trianglesRasterized,
+                    pixels == reference ? "yes" : "NO");
+    }
+
+    renderer.Shutdown();
+    return 0;
+}
@@ -0,0 +1,60 @@
+// Frame time of the software rasterizer as the raster thread count grows.
+// Usage: SoftwareRasterScalingBenchmark [width] [height] [spheres]
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include <renderer/software/SoftwareRenderer.hpp>
+
+#include "Benchmark.hpp"
+#include "RasterScene.hpp"
+
+int main(int argc, char **argv)
+{
+    const uint32_t width = argc > 1 ? (uint32_t)std::atoi(argv[1]) : 1920;
+    const uint32_t height = argc > 2 ? (uint32_t)std::atoi(argv[2]) : 1080;
+    const int spheres = argc > 3 ? std::atoi(argv[3]) : 2000;
+
+    Renderer::Software::SoftwareRenderer renderer;
+    if (!renderer.Initialize(nullptr, width, height))
+    {
+        std::fprintf(stderr, "Failed to initialize the software renderer\n");
+        return 1;
+    }
+
+    Benchmark::RasterScene scene;
+    scene.Create(renderer, spheres, width, height);
+
+    std::vector<uint32_t> threadCounts;
+    const uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (uint32_t n = 1; n < hardwareThreads; n *= 2)
+        threadCounts.push_back(n);
+    threadCounts.push_back(hardwareThreads);
+
+    Benchmark::PrintTitle("Software raster thread scaling");
+    std::printf("%ux%u, %d spheres\n", width, height, spheres);
+    std::printf("%8s %12s %10s %10s\n", "threads", "ms/frame", "speedup", "identical");
+
+    std::vector<uint8_t> reference(width * height * 4), pixels(width * height * 4);
+    double baseline = 0.0;
+    for (const uint32_t threads : threadCounts)
+    {
+        renderer.SetRasterThreadCount(threads);
+        const double ms = Benchmark::MeasureMs([&] { scene.Draw(renderer); }, 20, 3);
+
+        renderer.ReadFramebuffer(pixels.data(), (int)width, (int)height);
+        if (baseline == 0.0)
+        {
+            baseline = ms;
+            reference = pixels;
+        }
+        std::printf("%8u %12.2f %9.2fx %10s\n", threads, ms, baseline / ms,
+                    pixels == reference ? "yes" : "NO");
+    }
+
+    renderer.Shutdown();
+    return 0;
+}
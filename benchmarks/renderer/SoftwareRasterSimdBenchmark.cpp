@@ -0,0 +1,69 @@
+// Triangle throughput of the software rasterizer's scalar, SSE4.1 and AVX2
+// inner loops. Runs on a single raster thread so only the inner loop differs.
+// Usage: SoftwareRasterSimdBenchmark [width] [height] [spheres]
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <renderer/software/SoftwareRenderer.hpp>
+
+#include "Benchmark.hpp"
+#include "RasterScene.hpp"
+
+using Renderer::Software::SWRasterPath;
+using Renderer::Software::SoftwareRenderer;
+
+int main(int argc, char **argv)
+{
+    const uint32_t width = argc > 1 ? (uint32_t)std::atoi(argv[1]) : 1920;
+    const uint32_t height = argc > 2 ? (uint32_t)std::atoi(argv[2]) : 1080;
+    const int spheres = argc > 3 ? std::atoi(argv[3]) : 2000;
+
+    SoftwareRenderer renderer;
+    if (!renderer.Initialize(nullptr, width, height))
+    {
+        std::fprintf(stderr, "Failed to initialize the software renderer\n");
+        return 1;
+    }
+    renderer.SetRasterThreadCount(1);
+
+    Benchmark::RasterScene scene;
+    scene.Create(renderer, spheres, width, height);
+
+    Benchmark::PrintTitle("Software raster inner loop");
+    std::printf("%ux%u, %zu triangles/frame\n", width, height, scene.GetTriangleCount());
+    std::printf("%8s %12s %14s %10s %10s\n", "path", "ms/frame", "Mtris/sec", "speedup", "identical");
+
+    const struct { SWRasterPath path; const char *name; } paths[] = {
+        {SWRasterPath::Scalar, "scalar"},
+        {SWRasterPath::SSE41, "sse4.1"},
+        {SWRasterPath::AVX2, "avx2"},
+    };
+
+    std::vector<uint8_t> reference(width * height * 4), pixels(width * height * 4);
+    double baseline = 0.0;
+    for (const auto &[path, name] : paths)
+    {
+        if (!renderer.SetRasterPath(path))
+        {
+            std::printf("%8s %12s\n", name, "unsupported");
+            continue;
+        }
+
+        const double ms = Benchmark::MeasureMs([&] { scene.Draw(renderer); }, 20, 3);
+        renderer.ReadFramebuffer(pixels.data(), (int)width, (int)height);
+        if (baseline == 0.0)
+        {
+            baseline = ms;
+            reference = pixels;
+        }
+
+        const double trianglesPerSecond = (double)scene.GetTriangleCount() / (ms / 1000.0);
+        std::printf("%8s %12.2f %14.2f %9.2fx %10s\n", name, ms, trianglesPerSecond / 1e6, baseline / ms,
+                    pixels == reference ? "yes" : "NO");
+    }
+
+    renderer.Shutdown();
+    return 0;
+}
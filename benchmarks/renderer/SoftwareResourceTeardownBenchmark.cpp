@@ -0,0 +1,125 @@
+// Cost of creating and destroying many meshes and materials in the software
+// renderer, destroyed in creation order, in reverse and shuffled. For
+// comparison the old storage (a vector searched and erased per destroy) is
+// simulated up to a size limit, since it is quadratic.
+// Usage: SoftwareResourceTeardownBenchmark [legacyLimit]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <renderer/software/SoftwareRenderer.hpp>
+
+#include "Benchmark.hpp"
+
+using Renderer::Common::IMaterial;
+using Renderer::Common::IMesh;
+using Renderer::Software::SoftwareRenderer;
+
+namespace
+{
+    enum class Order { Forward, Reverse, Shuffled };
+
+    const char *OrderName(Order order)
+    {
+        return order == Order::Forward ? "forward" : order == Order::Reverse ? "reverse" : "shuffled";
+    }
+
+    template <typename T>
+    void Arrange(std::vector<T> &items, Order order)
+    {
+        if (order == Order::Reverse)
+            std::ranges::reverse(items);
+        else if (order == Order::Shuffled)
+            std::ranges::shuffle(items, std::mt19937(1234));
+    }
+
+    template <typename Fn>
+    double TimeMs(Fn &&fn)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // The storage DestroyMesh used before slot maps: find_if + erase from the middle.
+    double LegacyTeardownMs(size_t count, Order order)
+    {
+        std::vector<std::unique_ptr<int>> owned;
+        std::vector<int*> handles;
+        for (size_t i = 0; i < count; ++i)
+        {
+            owned.push_back(std::make_unique<int>((int)i));
+            handles.push_back(owned.back().get());
+        }
+        Arrange(handles, order);
+        return TimeMs([&]
+        {
+            for (int *handle : handles)
+            {
+                if (const auto it = std::ranges::find_if(owned, [handle](const auto &p) { return p.get() == handle; });
+                    it != owned.end())
+                    owned.erase(it);
+            }
+        });
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const size_t legacyLimit = argc > 1 ? (size_t)std::atoll(argv[1]) : 100000;
+
+    SoftwareRenderer renderer;
+    if (!renderer.Initialize(nullptr, 64, 64))
+    {
+        std::fprintf(stderr, "Failed to initialize the software renderer\n");
+        return 1;
+    }
+    auto *shader = renderer.GetStandardUnlitShader();
+    const Renderer::Common::MeshData empty;
+
+    Benchmark::PrintTitle("Software resource teardown");
+    std::printf("%10s %10s %12s %14s %16s %12s\n", "resources", "order", "create ms", "destroy ms",
+                "ns per destroy", "legacy ms");
+
+    for (const size_t count : {size_t{10000}, size_t{100000}, size_t{1000000}})
+    {
+        for (const Order order : {Order::Forward, Order::Reverse, Order::Shuffled})
+        {
+            std::vector<IMesh*> meshes(count);
+            std::vector<IMaterial*> materials(count);
+            const double createMs = TimeMs([&]
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    meshes[i] = renderer.CreateMesh(empty);
+                    materials[i] = renderer.CreateMaterial(shader);
+                }
+            });
+
+            Arrange(meshes, order);
+            Arrange(materials, order);
+            const double destroyMs = TimeMs([&]
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    renderer.DestroyMaterial(materials[i]->GetHandle());
+                    renderer.DestroyMesh(meshes[i]->GetHandle());
+                }
+            });
+
+            char legacy[32] = "-";
+            if (count <= legacyLimit)   // one simulated set, counted for meshes and materials
+                std::snprintf(legacy, sizeof(legacy), "%.2f", 2.0 * LegacyTeardownMs(count, order));
+            std::printf("%10zu %10s %12.2f %14.2f %16.1f %12s\n", count, OrderName(order), createMs, destroyMs,
+                        destroyMs * 1e6 / (2.0 * (double)count), legacy);
+        }
+    }
+
+    renderer.Shutdown();
+    return 0;
+}
@@ -0,0 +1,89 @@
+// Frame time of the software rasterizer per texture filter, for a field of
+// distant (minified) textured spheres and for one close (magnified) sphere.
+// Usage: SoftwareTextureFilterBenchmark [width] [height] [spheres] [textureSize]
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <renderer/software/SoftwareRenderer.hpp>
+
+#include "Benchmark.hpp"
+#include "RasterScene.hpp"
+
+using Renderer::Software::SoftwareRenderer;
+using Renderer::Software::SWTextureFilter;
+
+int main(int argc, char **argv)
+{
+    const uint32_t width = argc > 1 ? (uint32_t)std::atoi(argv[1]) : 1920;
+    const uint32_t height = argc > 2 ? (uint32_t)std::atoi(argv[2]) : 1080;
+    const int spheres = argc > 3 ? std::atoi(argv[3]) : 2000;
+    const uint32_t textureSize = argc > 4 ? (uint32_t)std::atoi(argv[4]) : 2048;
+
+    SoftwareRenderer renderer;
+    if (!renderer.Initialize(nullptr, width, height))
+    {
+        std::fprintf(stderr, "Failed to initialize the software renderer\n");
+        return 1;
+    }
+
+    std::vector<uint8_t> texels((size_t)textureSize * textureSize * 4);
+    for (size_t i = 0; i < (size_t)textureSize * textureSize; ++i)
+    {
+        const uint32_t x = (uint32_t)(i % textureSize), y = (uint32_t)(i / textureSize);
+        texels[i * 4 + 0] = (uint8_t)x;
+        texels[i * 4 + 1] = (uint8_t)y;
+        texels[i * 4 + 2] = ((x ^ y) & 1) ? 255 : 0;
+        texels[i * 4 + 3] = 255;
+    }
+    auto *texture = renderer.CreateTexture(texels.data(), textureSize, textureSize, 4);
+    auto *material = renderer.CreateMaterial(renderer.GetStandardUnlitShader(), texture);
+    auto *sphere = renderer.CreateMesh(Benchmark::MakeSphere(16, 32, 1.f));
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> unit(-1.f, 1.f);
+    std::vector<std::array<float, 16>> far;
+    for (int i = 0; i < spheres; ++i)
+        far.push_back(Benchmark::Translation(unit(rng) * 24.f, unit(rng) * 14.f, -40.f + unit(rng) * 5.f));
+    const std::vector<std::array<float, 16>> near = {Benchmark::Translation(0.f, 0.f, -1.2f)};
+
+    const auto view = Benchmark::Identity();
+    const auto proj = Benchmark::Perspective(1.f, (float)width / (float)height, 0.1f, 100.f);
+    auto draw = [&](const std::vector<std::array<float, 16>> &models)
+    {
+        renderer.Clear(0.1f, 0.2f, 0.3f, 1.f);
+        renderer.BeginFrame();
+        renderer.SetViewProjection(view.data(), proj.data());
+        for (const auto &model : models)
+            renderer.DrawMesh(sphere, model.data(), material);
+        renderer.EndFrame();
+        renderer.Present();
+    };
+
+    Benchmark::PrintTitle("Software texture filtering");
+    std::printf("%ux%u, %ux%u texture, %u raster threads\n", width, height, textureSize, textureSize,
+                renderer.GetRasterThreadCount());
+    std::printf("%12s %10s %12s %10s\n", "scene", "filter", "ms/frame", "vs nearest");
+
+    const char *filterNames[] = {"nearest", "bilinear", "trilinear"};
+    for (const bool minified : {true, false})
+    {
+        const auto &models = minified ? far : near;
+        double baseline = 0.0;
+        for (const SWTextureFilter filter :
+             {SWTextureFilter::Nearest, SWTextureFilter::Bilinear, SWTextureFilter::Trilinear})
+        {
+            renderer.SetTextureFilter(filter);
+            const double ms = Benchmark::MeasureMs([&] { draw(models); }, 20, 3);
+            if (baseline == 0.0) baseline = ms;
+            std::printf("%12s %10s %12.2f %9.2fx\n", minified ? "minified" : "magnified",
+                        filterNames[(int)filter], ms, ms / baseline);
+        }
+    }
+
+    renderer.Shutdown();
+    return 0;
+}
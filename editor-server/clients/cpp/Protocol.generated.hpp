@@ -26,6 +26,7 @@ enum class CommandType : uint8_t
     GetAllEntities = 0x34,
     CreateScript = 0x40,
     RescanAssets = 0x41,
+    GetAllocatorStats = 0x50,
     Shutdown = 0xFF,
 };
 
@@ -40,6 +41,7 @@ enum class ResponseType : uint8_t
     EntityCreated = 0x06,
     SceneData = 0x07,
     ScriptData = 0x08,
+    AllocatorStats = 0x09,
 };
 
 // Custom types
@@ -56,6 +58,16 @@ struct EntityInfo
     std::string name;
 };
 
+struct PoolInfo
+{
+    std::string name;
+    uint32_t blockSize;
+    uint32_t live;
+    uint32_t free;
+    uint32_t highWater;
+    uint32_t slabs;
+};
+
 // Command request structures
 struct SetViewportSizeCmd
 {
@@ -156,4 +168,10 @@ struct ScriptDataData
     std::string scriptTemplate;
 };
 
+struct AllocatorStatsData
+{
+    uint32_t count;
+    std::vector<PoolInfo> pools;
+};
+
 } // namespace N2Engine::Editor::Protocol
\ No newline at end of file
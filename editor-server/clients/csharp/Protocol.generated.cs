@@ -21,6 +21,7 @@ namespace N2Engine.Editor.Protocol
         GetAllEntities = 0x34,
         CreateScript = 0x40,
         RescanAssets = 0x41,
+        GetAllocatorStats = 0x50,
         Shutdown = 0xFF,
     }
 
@@ -35,6 +36,7 @@ namespace N2Engine.Editor.Protocol
         EntityCreated = 0x06,
         SceneData = 0x07,
         ScriptData = 0x08,
+        AllocatorStats = 0x09,
     }
 
     public struct vec3
@@ -50,6 +52,16 @@ namespace N2Engine.Editor.Protocol
         public string Name;
     }
 
+    public struct PoolInfo
+    {
+        public string Name;
+        public uint Blocksize;
+        public uint Live;
+        public uint Free;
+        public uint Highwater;
+        public uint Slabs;
+    }
+
     public struct SetViewportSizeRequest
     {
         public int Width;
@@ -148,4 +160,10 @@ namespace N2Engine.Editor.Protocol
         public string Scripttemplate;
     }
 
+    public struct AllocatorStatsResponse
+    {
+        public uint Count;
+        public PoolInfo[] Pools;
+    }
+
 }
\ No newline at end of file
@@ -11,6 +11,15 @@ export interface EntityInfo {
   name: string;
 }
 
+export interface PoolInfo {
+  name: string;
+  blockSize: number;
+  live: number;
+  free: number;
+  highWater: number;
+  slabs: number;
+}
+
 export const CommandType = {
   RenderFrame: 0x01,
   SetViewportSize: 0x02,
@@ -28,6 +37,7 @@ export const CommandType = {
   GetAllEntities: 0x34,
   CreateScript: 0x40,
   RescanAssets: 0x41,
+  GetAllocatorStats: 0x50,
   Shutdown: 0xFF,
 } as const;
 
@@ -43,6 +53,7 @@ export const ResponseType = {
   EntityCreated: 0x06,
   SceneData: 0x07,
   ScriptData: 0x08,
+  AllocatorStats: 0x09,
 } as const;
 
 export type ResponseType = typeof ResponseType[keyof typeof ResponseType];
@@ -127,3 +138,8 @@ export interface EntityListResponse {
 export interface ScriptDataResponse {
   scriptTemplate: string;
 }
+
+export interface AllocatorStatsResponse {
+  count: number;
+  pools: PoolInfo[];
+}
@@ -48,6 +48,7 @@ namespace N2Engine::Editor
         void HandleCreateScript(int clientSocket, const std::vector<uint8_t> &payload);
         std::string GenerateScriptTemplate(const std::string& scriptName);
         void HandleRescanAssets(int clientSocket);
+        void HandleGetAllocatorStats(int clientSocket);
 
         // Script Generation
         static std::string FillTemplate(std::string templ, const std::string &className);
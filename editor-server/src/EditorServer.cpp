@@ -5,6 +5,7 @@
 #include "engine/GameObjectScene.hpp"
 #include "engine/Positionable.hpp"
 #include "engine/io/ResourceLoader.hpp"
+#include "engine/memory/ObjectPool.hpp"
 #include "engine/sceneManagement/SceneManager.hpp"
 
 #include "editor-server/EditorServer.hpp"
@@ -214,6 +215,9 @@ namespace N2Engine::Editor
         case CommandType::RescanAssets:
             HandleRescanAssets(clientSocket);
             break;
+        case CommandType::GetAllocatorStats:
+            HandleGetAllocatorStats(clientSocket);
+            break;
         default:
             Logger::Warn("Unknown command: " + std::to_string(commandType));
             BufferWriter response;
@@ -524,18 +528,22 @@ namespace N2Engine::Editor
         }
 
         Scene &scene = SceneManager::GetCurSceneRef();
-        auto gameObjects = scene.GetAllGameObjects();
-        Logger::Info("HandleGetAllEntities: Found " + std::to_string(gameObjects.size()) + " game objects");
+
+        // Written while walking the scene; the count goes in front once known
+        BufferWriter entries;
+        uint32_t count = 0;
+        scene.Traverse([&](const GameObject &go)
+        {
+            entries.WriteString(go.GetUUID().ToString());
+            entries.WriteString(go.GetName());
+            ++count;
+        });
+        Logger::Info("HandleGetAllEntities: Found " + std::to_string(count) + " game objects");
 
         // Build payload
         BufferWriter payload;
-        payload.WriteU32(static_cast<uint32_t>(gameObjects.size()));
-
-        for (const auto &go : gameObjects)
-        {
-            payload.WriteString(go->GetUUID().ToString());
-            payload.WriteString(go->GetName());
-        }
+        payload.WriteU32(count);
+        payload.WriteBytes(entries.Data());
 
         response.WriteU8(static_cast<uint8_t>(ResponseType::EntityList));
         response.WriteU32(static_cast<uint32_t>(payload.Size()));
@@ -700,6 +708,29 @@ return {C}
         SendResponse(clientSocket, {response.Data().begin(), response.Data().end()});
     }
 
+    void EditorServer::HandleGetAllocatorStats(int clientSocket)
+    {
+        const std::vector<Memory::PoolStats> pools = Memory::ObjectPools::Instance().GetStats();
+
+        BufferWriter payload;
+        payload.WriteU32(static_cast<uint32_t>(pools.size()));
+        for (const Memory::PoolStats &pool : pools)
+        {
+            payload.WriteString(pool.name);
+            payload.WriteU32(static_cast<uint32_t>(pool.blockSize));
+            payload.WriteU32(static_cast<uint32_t>(pool.live));
+            payload.WriteU32(static_cast<uint32_t>(pool.free));
+            payload.WriteU32(static_cast<uint32_t>(pool.highWater));
+            payload.WriteU32(static_cast<uint32_t>(pool.slabs));
+        }
+
+        BufferWriter response;
+        response.WriteU8(static_cast<uint8_t>(ResponseType::AllocatorStats));
+        response.WriteU32(static_cast<uint32_t>(payload.Size()));
+        response.WriteBytes(payload.Data());
+        SendResponse(clientSocket, {response.Data().begin(), response.Data().end()});
+    }
+
     bool EditorServer::Send(int socket, const void *data, size_t size)
     {
         size_t sent = 0;
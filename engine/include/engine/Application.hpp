@@ -1,8 +1,11 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 
 #include "engine/config/ApplicationOptions.hpp"
+#include "engine/FrameLoop.hpp"
 #include "engine/sceneManagement/SceneManager.hpp"
 #include "engine/Window.hpp"
 #include "engine/Camera.hpp"
@@ -18,11 +21,15 @@ namespace N2Engine
         Window _window;
         std::unique_ptr<Camera> _mainCamera;
         std::unique_ptr<Physics::IPhysicsBackend> _3DphysicsBackend = nullptr;
+        FrameLoop _frameLoop;
+        // Written by Quit, which game code may call from a job
+        std::atomic<bool> _quitRequested = false;
 
     private:
         Application() = default;
         void Render();
-        void PhysicsUpdate(const Scene &scene) const;
+        // Tells the scene, stops the job system and exits the process; main thread only
+        [[noreturn]] void Exit();
 
     public:
         Application(const Application &) = delete;
@@ -35,6 +42,20 @@ namespace N2Engine
         void Run();
         void RenderEditorFrame();
 
+        /**
+         * Runs the current scene's frame loop on virtual time, as fast as it goes; see FrameLoop::Simulate.
+         * Nothing is drawn and no events are polled. Quit during a simulation ends it after the
+         * current tick instead of exiting.
+         */
+        SimulationStats Simulate(uint64_t ticks);
+        // One tick of Simulate; false when Quit was called during it, and the caller should stop stepping
+        bool Step();
+
+        /**
+         * Exits the application. Inside a Simulate or Step tick it only stops the simulation.
+         * Called from a job, it asks Run to exit after the current frame, since shutting the job
+         * system down from one of its own workers cannot join it.
+         */
         static void Quit();
 
         [[nodiscard]] Camera* GetMainCamera() const;
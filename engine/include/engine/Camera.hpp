@@ -23,6 +23,12 @@ namespace N2Engine
         [[nodiscard]] Math::Vector3 GetExtents() const;
         // Get corner point (0-7, where bits represent min/max for each axis)
         [[nodiscard]] Math::Vector3 GetCorner(int index) const;
+        // Smallest box holding this one after an affine transform
+        [[nodiscard]] BoundingBox Transformed(const Matrix4 &matrix) const;
+        // Smallest box holding both
+        [[nodiscard]] BoundingBox Merged(const BoundingBox &other) const;
+
+        bool operator==(const BoundingBox &other) const { return min == other.min && max == other.max; }
     };
 
     struct Frustum
@@ -30,6 +36,8 @@ namespace N2Engine
         Math::Vector4 planes[6]; // left, right, bottom, top, near, far
 
         [[nodiscard]] bool IsVisible(const BoundingBox &bbox) const;
+        // True when the whole box is inside every plane
+        [[nodiscard]] bool Contains(const BoundingBox &bbox) const;
     };
 
     class Camera
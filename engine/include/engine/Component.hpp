@@ -1,7 +1,11 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <new>
 #include <nlohmann/json.hpp>
 #include "engine/base/Asset.hpp"
+#include "engine/ComponentFamilies.hpp"
 #include "engine/physics/PhysicsTypes.hpp"
 
 namespace N2Engine
@@ -19,14 +23,43 @@ namespace N2Engine
         friend class GameObject;
         friend class Scene;
 
+    private:
+        // Where its scene holds it, so removal goes straight to its entries instead of searching
+        struct SceneSlots
+        {
+            static constexpr uint32_t None = UINT32_MAX;
+
+            // The scene the slots below belong to
+            const Scene *scene = nullptr;
+            uint32_t attachQueue = None;
+            uint32_t components = None;
+            uint32_t byType = None;
+            // Per ComponentHook: which of the hook's lists holds it, and where
+            std::array<uint32_t, 4> hookLists{None, None, None, None};
+            std::array<uint32_t, 4> hookPositions{None, None, None, None};
+        };
+
+        // When its scene attached it, counting from the scene's first attach
+        uint64_t _attachOrder = 0;
+        SceneSlots _sceneSlots;
+
     protected:
         GameObject &_gameObject;
         bool _isMarkedForDestruction = false;
         bool _isActive = true;
+        // Set by the owning GameObject from the concrete type
+        ComponentFamilyMask _families = 0;
 
         explicit Component(GameObject &gameObject);
 
     public:
+        // Components live in size-class pools (see Memory::ObjectPools); over-aligned types skip them
+        static void *operator new(std::size_t size);
+        static void *operator new(std::size_t size, std::align_val_t alignment);
+        static void *operator new(std::size_t, void *place) noexcept { return place; }
+        static void operator delete(void *block, std::size_t size);
+        static void operator delete(void *block, std::size_t size, std::align_val_t alignment);
+
         [[nodiscard]] GameObject& GetGameObject() const;
 
         // Serialization interface
@@ -70,6 +103,8 @@ namespace N2Engine
         [[nodiscard]] bool IsDestroyed() const;
         [[nodiscard]] bool IsActive() const;
         void SetActive(bool active);
+        // The ComponentFamilies this component belongs to
+        [[nodiscard]] ComponentFamilyMask GetFamilies() const { return _families; }
 
         static constexpr bool IsSingleton = false;
     };
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace N2Engine
+{
+    class IRenderable;
+    namespace Physics { class ICollider; }
+    namespace Rendering { class Light; }
+
+    using ComponentFamilyMask = uint32_t;
+
+    /**
+     * Interfaces the engine looks up on GameObjects every frame.
+     * A component's membership is worked out from its concrete type when it is added,
+     * so finding them later is a bit test rather than a dynamic_cast.
+     */
+    template <typename... Families>
+    struct ComponentFamilyList
+    {
+        static_assert(sizeof...(Families) <= 32, "ComponentFamilyMask holds 32 families");
+
+        template <typename T>
+        static constexpr bool Contains = (std::is_same_v<T, Families> || ...);
+
+        template <typename T>
+            requires Contains<T>
+        static constexpr ComponentFamilyMask Bit()
+        {
+            ComponentFamilyMask bit = 1;
+            (void)((std::is_same_v<T, Families> || (bit <<= 1, false)) || ...);
+            return bit;
+        }
+
+        // The families are only declared here; T is complete, which is all is_base_of needs
+        template <typename T>
+        static constexpr ComponentFamilyMask MaskOf()
+        {
+            return ((std::is_base_of_v<Families, T> ? Bit<Families>() : 0) | ... | 0);
+        }
+
+        // For components created by type name, where only the instance is known.
+        // Needs every family defined where it is called.
+        template <typename C>
+        static ComponentFamilyMask MaskOfInstance(const C &component)
+        {
+            return ((dynamic_cast<const Families*>(&component) != nullptr ? Bit<Families>() : 0) | ... | 0);
+        }
+    };
+
+    using ComponentFamilies = ComponentFamilyList<IRenderable, Physics::ICollider, Rendering::Light>;
+
+    template <typename T>
+    concept ComponentFamily = ComponentFamilies::Contains<T>;
+}
@@ -0,0 +1,246 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include "engine/ComponentConcepts.hpp"
+#include "engine/GameObject.hpp"
+
+namespace N2Engine
+{
+    /**
+     * Per-frame lifecycle hooks the scene dispatches from per-type component lists
+     */
+    enum class ComponentHook : uint8_t
+    {
+        Update,
+        FixedUpdate,
+        LateUpdate,
+        ApplicationQuit
+    };
+
+    inline constexpr size_t ComponentHookCount = 4;
+
+    // Calls one hook on every active component of an array holding a single concrete type
+    using ComponentHookRunner = void (*)(std::span<Component *const> components);
+
+    /**
+     * Types a component's OnUpdate, OnFixedUpdate and OnLateUpdate read or write on its own
+     * GameObject, beyond the component itself. Any type can name a resource:
+     *
+     *     using ReadSet = ComponentAccessSet<Positionable>;
+     *     using WriteSet = ComponentAccessSet<Rigidbody>;
+     *
+     * Read-only types are looked up as GetComponent<const T>. World transforms are resolved
+     * before a parallel stage and frozen while it runs, so Positionable can be read there but
+     * not written: a type writing it updates serially.
+     */
+    template <typename... Ts>
+    struct ComponentAccessSet
+    {
+        static std::vector<std::type_index> TypeIndices() { return {std::type_index(typeid(Ts))...}; }
+    };
+
+    /**
+     * How the scene may spread a type's update hooks over the job system.
+     * A type declaring `static constexpr bool ParallelSafe = true` only touches its own
+     * GameObject and does not move it, so its components update on worker threads, one type
+     * at a time. A type declaring a ReadSet or WriteSet also updates in parallel, and alongside
+     * neighbouring types whose sets do not conflict with it. Structural changes from either go through
+     * the scene's SceneCommandBuffer. Derived types inherit the declarations.
+     */
+    enum class ComponentParallelism : uint8_t
+    {
+        Serial,
+        Parallel,
+        Declared
+    };
+
+    /**
+     * The hooks a component type overrides, each with its runner.
+     * A null runner means the type keeps Component's empty default and is never visited.
+     */
+    struct ComponentTypeHooks
+    {
+        std::array<ComponentHookRunner, ComponentHookCount> runners{};
+        ComponentParallelism parallelism = ComponentParallelism::Serial;
+        // Declared types only, sorted. Writes excludes the type itself, which conflicts through writesSelf
+        std::vector<std::type_index> reads;
+        std::vector<std::type_index> writes;
+        std::vector<std::type_index> writesSelf;
+
+        [[nodiscard]] ComponentHookRunner Get(ComponentHook hook) const { return runners[static_cast<size_t>(hook)]; }
+
+        // Whether two declared types may update at the same time
+        [[nodiscard]] bool ConflictsWith(const ComponentTypeHooks &other) const
+        {
+            const auto overlaps = [](const std::vector<std::type_index> &a, const std::vector<std::type_index> &b)
+            {
+                return std::ranges::any_of(a, [&b](const std::type_index &type) { return std::ranges::binary_search(b, type); });
+            };
+            const auto touches = [&](const ComponentTypeHooks &hooks, const std::vector<std::type_index> &written)
+            {
+                return overlaps(written, hooks.reads) || overlaps(written, hooks.writes) || overlaps(written, hooks.writesSelf);
+            };
+            return touches(other, writes) || touches(other, writesSelf) || touches(*this, other.writes) ||
+                   touches(*this, other.writesSelf);
+        }
+    };
+
+    namespace Detail
+    {
+        // &T::OnX names Component::OnX exactly when T does not override it. An override
+        // that is not publicly accessible fails the requirement and counts as overridden.
+        template <typename T>
+        concept InheritsOnUpdate = requires { { &T::OnUpdate } -> std::same_as<void (Component::*)()>; };
+        template <typename T>
+        concept InheritsOnFixedUpdate = requires { { &T::OnFixedUpdate } -> std::same_as<void (Component::*)()>; };
+        template <typename T>
+        concept InheritsOnLateUpdate = requires { { &T::OnLateUpdate } -> std::same_as<void (Component::*)()>; };
+        template <typename T>
+        concept InheritsOnApplicationQuit = requires { { &T::OnApplicationQuit } -> std::same_as<void (Component::*)()>; };
+
+        template <typename T>
+        concept DeclaresParallelSafe = requires { { T::ParallelSafe } -> std::convertible_to<bool>; } && T::ParallelSafe;
+        template <typename T>
+        concept DeclaresAccessSets = requires { typename T::ReadSet; } || requires { typename T::WriteSet; };
+
+        template <typename T>
+        std::vector<std::type_index> SortedAccessSet()
+        {
+            std::vector<std::type_index> types = T::TypeIndices();
+            std::ranges::sort(types);
+            return types;
+        }
+
+        // The lists hold exactly T, so a qualified call is safe and lets the compiler inline it.
+        // Component itself (the fallback for unregistered types) dispatches virtually.
+        template <typename T>
+        concept QualifiedCallable = !std::is_same_v<T, Component>;
+
+        template <typename T>
+        void CallOnUpdate(Component *c)
+        {
+            if constexpr (QualifiedCallable<T> && requires(T *t) { t->T::OnUpdate(); }) static_cast<T*>(c)->T::OnUpdate();
+            else c->OnUpdate();
+        }
+
+        template <typename T>
+        void CallOnFixedUpdate(Component *c)
+        {
+            if constexpr (QualifiedCallable<T> && requires(T *t) { t->T::OnFixedUpdate(); }) static_cast<T*>(c)->T::OnFixedUpdate();
+            else c->OnFixedUpdate();
+        }
+
+        template <typename T>
+        void CallOnLateUpdate(Component *c)
+        {
+            if constexpr (QualifiedCallable<T> && requires(T *t) { t->T::OnLateUpdate(); }) static_cast<T*>(c)->T::OnLateUpdate();
+            else c->OnLateUpdate();
+        }
+
+        template <typename T>
+        void CallOnApplicationQuit(Component *c)
+        {
+            if constexpr (QualifiedCallable<T> && requires(T *t) { t->T::OnApplicationQuit(); }) static_cast<T*>(c)->T::OnApplicationQuit();
+            else c->OnApplicationQuit();
+        }
+
+        template <void (*Call)(Component *)>
+        void RunActive(std::span<Component *const> components)
+        {
+            for (Component *component : components)
+            {
+                // Null: removed while this hook was running
+                if (component && component->IsActive() && component->GetGameObject().IsActiveInHierarchy())
+                {
+                    Call(component);
+                }
+            }
+        }
+    }
+
+    // Every hook through a virtual call; used for types the registry has not seen
+    inline ComponentTypeHooks MakeVirtualComponentHooks()
+    {
+        ComponentTypeHooks hooks;
+        hooks.runners[static_cast<size_t>(ComponentHook::Update)] = &Detail::RunActive<&Detail::CallOnUpdate<Component>>;
+        hooks.runners[static_cast<size_t>(ComponentHook::FixedUpdate)] = &Detail::RunActive<&Detail::CallOnFixedUpdate<Component>>;
+        hooks.runners[static_cast<size_t>(ComponentHook::LateUpdate)] = &Detail::RunActive<&Detail::CallOnLateUpdate<Component>>;
+        hooks.runners[static_cast<size_t>(ComponentHook::ApplicationQuit)] = &Detail::RunActive<&Detail::CallOnApplicationQuit<Component>>;
+        return hooks;
+    }
+
+    template <DerivedFromComponent T>
+    ComponentTypeHooks MakeComponentTypeHooks()
+    {
+        ComponentTypeHooks hooks;
+        if constexpr (!Detail::InheritsOnUpdate<T>)
+            hooks.runners[static_cast<size_t>(ComponentHook::Update)] = &Detail::RunActive<&Detail::CallOnUpdate<T>>;
+        if constexpr (!Detail::InheritsOnFixedUpdate<T>)
+            hooks.runners[static_cast<size_t>(ComponentHook::FixedUpdate)] = &Detail::RunActive<&Detail::CallOnFixedUpdate<T>>;
+        if constexpr (!Detail::InheritsOnLateUpdate<T>)
+            hooks.runners[static_cast<size_t>(ComponentHook::LateUpdate)] = &Detail::RunActive<&Detail::CallOnLateUpdate<T>>;
+        if constexpr (!Detail::InheritsOnApplicationQuit<T>)
+            hooks.runners[static_cast<size_t>(ComponentHook::ApplicationQuit)] = &Detail::RunActive<&Detail::CallOnApplicationQuit<T>>;
+
+        if constexpr (Detail::DeclaresAccessSets<T>)
+        {
+            hooks.parallelism = ComponentParallelism::Declared;
+            if constexpr (requires { typename T::ReadSet; })
+                hooks.reads = Detail::SortedAccessSet<typename T::ReadSet>();
+            if constexpr (requires { typename T::WriteSet; })
+                hooks.writes = Detail::SortedAccessSet<typename T::WriteSet>();
+            hooks.writesSelf = {std::type_index(typeid(T))};
+        }
+        else if constexpr (Detail::DeclaresParallelSafe<T>)
+        {
+            hooks.parallelism = ComponentParallelism::Parallel;
+        }
+        return hooks;
+    }
+
+    /**
+     * Hook tables of every component type created through AddComponent or the ComponentRegistry.
+     * Types created any other way fall back to virtual calls for every hook.
+     */
+    class ComponentHookRegistry
+    {
+    private:
+        std::unordered_map<std::type_index, ComponentTypeHooks> _types;
+        ComponentTypeHooks _fallback = MakeVirtualComponentHooks();
+
+        ComponentHookRegistry() = default;
+
+    public:
+        static ComponentHookRegistry &Instance()
+        {
+            static ComponentHookRegistry instance;
+            return instance;
+        }
+
+        ComponentHookRegistry(const ComponentHookRegistry &) = delete;
+        ComponentHookRegistry &operator=(const ComponentHookRegistry &) = delete;
+
+        template <DerivedFromComponent T>
+        void Register()
+        {
+            // Once per type; AddComponent calls this on every add
+            static const bool registered = _types.try_emplace(std::type_index(typeid(T)), MakeComponentTypeHooks<T>()).second;
+            (void)registered;
+        }
+
+        [[nodiscard]] const ComponentTypeHooks &Get(const std::type_index &type) const
+        {
+            const auto it = _types.find(type);
+            return it != _types.end() ? it->second : _fallback;
+        }
+    };
+}
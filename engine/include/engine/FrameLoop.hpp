@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+namespace N2Engine
+{
+    class Scene;
+
+    namespace Physics
+    {
+        class IPhysicsBackend;
+    }
+
+    // What a Simulate call ran
+    struct SimulationStats
+    {
+        uint64_t ticks = 0;
+        double simulatedSeconds = 0.0; // virtual, unscaled
+        double wallSeconds = 0.0;
+        double ticksPerSecond = 0.0;   // of wall time
+    };
+
+    /**
+     * The phases of a frame over one scene, apart from input and drawing. Application drives it
+     * from Run and Simulate; it needs no window, scripting or physics backend of its own, so a
+     * scene can be stepped on its own.
+     */
+    class FrameLoop
+    {
+    public:
+        // Stepped once per fixed step around FixedUpdate; null runs FixedUpdate alone
+        void SetPhysicsBackend(Physics::IPhysicsBackend *physics) { _physics = physics; }
+
+        // One frame of frameTime seconds, Time already advanced. draw runs once world transforms are resolved
+        void RunFrame(Scene *scene, double frameTime, const std::function<void()> &draw = {});
+
+        // Advances Time by exactly one fixed step and runs a frame of it without drawing; false when stopped during it
+        bool Step(Scene *scene);
+
+        /**
+         * Steps up to ticks times on virtual time, as fast as it goes, so physics steps once per tick
+         * and runs repeat exactly. currentScene is asked for the scene before every tick.
+         */
+        SimulationStats Simulate(uint64_t ticks, const std::function<Scene*()> &currentScene);
+
+        // Ends the Step running on any thread after its current tick; false when no loop is stepping
+        static bool StopStepping();
+
+    private:
+        void PhysicsUpdate(Scene &scene) const;
+
+        static inline std::atomic<FrameLoop*> s_stepping = nullptr;
+
+        Physics::IPhysicsBackend *_physics = nullptr;
+        double _fixedTimestepAccumulator = 0.0;
+        // Written by StopStepping, which game code may call from a job
+        std::atomic<bool> _stopped = false;
+    };
+}
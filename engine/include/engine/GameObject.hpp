@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <vector>
@@ -7,6 +8,7 @@
 #include <typeindex>
 #include <generator>
 #include <optional>
+#include <iterator>
 
 #include <nlohmann/json.hpp>
 
@@ -16,6 +18,7 @@
 #include "engine/scheduling/Coroutine.hpp"
 
 #include "engine/ComponentConcepts.hpp"
+#include "engine/ComponentFamilies.hpp"
 
 namespace N2Engine::Math
 {
@@ -30,6 +33,79 @@ namespace N2Engine
     class Positionable;
     class ReferenceResolver;
 
+    namespace Spatial
+    {
+        class SpatialIndex;
+    }
+
+    /**
+     * The components of one GameObject that are a T, in the order they were added.
+     * Reads the GameObject's storage in place: adding or removing components invalidates it.
+     */
+    template <DerivedFromComponent T>
+    class ComponentView
+    {
+    public:
+        using StorageIterator = std::vector<std::unique_ptr<Component>>::const_iterator;
+
+        class Iterator
+        {
+        public:
+            using value_type = T*;
+            using difference_type = std::ptrdiff_t;
+
+            Iterator() = default;
+            Iterator(const StorageIterator it, const StorageIterator end) : _it{it}, _end{end} { SkipMismatches(); }
+
+            T* operator*() const { return static_cast<T*>(_it->get()); }
+            Iterator& operator++()
+            {
+                ++_it;
+                SkipMismatches();
+                return *this;
+            }
+            Iterator operator++(int)
+            {
+                Iterator previous = *this;
+                ++*this;
+                return previous;
+            }
+            bool operator==(std::default_sentinel_t) const { return _it == _end; }
+
+        private:
+            StorageIterator _it;
+            StorageIterator _end;
+
+            void SkipMismatches()
+            {
+                while (_it != _end && !Matches(**_it))
+                {
+                    ++_it;
+                }
+            }
+
+            static bool Matches(const Component &component)
+            {
+                if constexpr (ComponentFamily<T>)
+                    return (component.GetFamilies() & ComponentFamilies::Bit<T>()) != 0;
+                else if constexpr (std::is_final_v<T>)
+                    return typeid(component) == typeid(T);
+                else
+                    return dynamic_cast<const T*>(&component) != nullptr;
+            }
+        };
+
+        ComponentView(const StorageIterator begin, const StorageIterator end) : _begin{begin}, _end{end} {}
+
+        [[nodiscard]] Iterator begin() const { return Iterator{_begin, _end}; }
+        [[nodiscard]] std::default_sentinel_t end() const { return {}; }
+        [[nodiscard]] bool empty() const { return begin() == end(); }
+
+    private:
+        StorageIterator _begin;
+        StorageIterator _end;
+    };
+
     /**
      * Container class for Components
      * Unlike Unity, may or may not have a transform/positionable
@@ -37,9 +113,12 @@ namespace N2Engine
     class GameObject final : public Base::Asset, public std::enable_shared_from_this<GameObject>
     {
         friend class Scene;
+        friend class Spatial::SpatialIndex;
 
     public:
         using Ptr = std::shared_ptr<GameObject>;
+        // Name of the pool Create allocates from
+        static constexpr const char *PoolName = "GameObject";
         using WeakPtr = std::weak_ptr<GameObject>;
 
     private:
@@ -47,6 +126,8 @@ namespace N2Engine
         bool _isActive = true;
         std::optional<Math::UUID> _prefabReference;
         bool _isMarkedForDestruction = false;
+        // Collected by the scene's current destruction batch
+        bool _isPendingPurge = false;
         mutable bool _activeInHierarchyCached = true;
         mutable bool _activeInHierarchyDirty = true;
 
@@ -57,16 +138,29 @@ namespace N2Engine
         // Component system
         std::vector<std::unique_ptr<Component>> _components;
         std::unordered_map<std::type_index, Component*> _componentMap;
+        // Union of the components' families, so a GameObject without any is skipped at once
+        ComponentFamilyMask _componentFamilies = 0;
 
         // Transform is special - always present for positioned objects
         std::shared_ptr<Transform> _transform;
 
         Scene *_scene = nullptr;
+        // Position among the scene's roots; only meaningful while the scene's slot there holds this object
+        size_t _rootIndex = SIZE_MAX;
+        // The scene whose lookup indices hold this object, while it is part of its hierarchy
+        Scene *_indexedIn = nullptr;
+
+        // Entry in the scene's spatial index while positioned inside a scene
+        Spatial::SpatialIndex *_spatialIndex = nullptr;
+        uint32_t _spatialEntry = 0;
 
         // Private methods
         void UpdateActiveInHierarchyCache() const;
         void NotifyActiveChanged() const;
         void SetScene(Scene *scene);
+        void LeaveSceneIndices();
+        void StoreComponent(std::unique_ptr<Component> component, ComponentFamilyMask families);
+        void RefreshComponentFamilies();
         void Purge();
 
     public:
@@ -74,10 +168,13 @@ namespace N2Engine
         static Ptr Create(const std::string &name = "GameObject");
         GameObject();
         explicit GameObject(std::string name);
+        ~GameObject() override;
 
         // Basic properties
         const std::string& GetName() const { return _name; }
-        void SetName(const std::string &name) { _name = name; }
+        void SetName(const std::string &name);
+        // Hides Asset::SetUUID so the scene's UUID index follows the change
+        void SetUUID(const Math::UUID &uuid);
 
         // Active state management
         bool IsActive() const { return _isActive; }
@@ -114,11 +211,13 @@ namespace N2Engine
         template <DerivedFromComponent T>
         T* AddComponent();
 
+        // From a parallel update, GetComponent<const T> reaches a ReadSet type; a non-const lookup counts as a write
         template <DerivedFromComponent T>
         T* GetComponent() const;
 
+        // Allocation free; ComponentFamilies match by bit, other types by dynamic_cast
         template <DerivedFromComponent T>
-        std::vector<T*> GetComponents() const;
+        ComponentView<T> GetComponents() const;
 
         template <DerivedFromComponent T>
         bool HasComponent() const;
@@ -18,10 +18,11 @@ namespace N2Engine
             }
         }
 
+        ComponentHookRegistry::Instance().Register<T>();
         auto component = std::make_unique<T>(*this);
 
         _componentMap[typeIndex] = component.get();
-        _components.push_back(std::move(component));
+        StoreComponent(std::move(component), ComponentFamilies::MaskOf<T>());
 
         // if GO has already been added to scene and this component is new
         if (_scene != nullptr && SceneManager::GetCurSceneIndex() != -1)
@@ -37,6 +38,7 @@ namespace N2Engine
     T* GameObject::GetComponent() const
     {
         const auto typeIndex = std::type_index(typeid(T));
+        UpdateRaceDetector::RecordAccess(*this, typeIndex, !std::is_const_v<T>);
         if (const auto it = _componentMap.find(typeIndex); it != _componentMap.end())
         {
             return static_cast<T*>(it->second);
@@ -45,19 +47,16 @@ namespace N2Engine
     }
 
     template <DerivedFromComponent T>
-    std::vector<T*> GameObject::GetComponents() const
+    ComponentView<T> GameObject::GetComponents() const
     {
-        std::vector<T*> result;
-        result.reserve(_components.size()); // Optimize for common case
-
-        for (const auto &component : _components)
+        if constexpr (ComponentFamily<T>)
         {
-            if (T *castedComponent = dynamic_cast<T*>(component.get()))
+            if ((_componentFamilies & ComponentFamilies::Bit<T>()) == 0)
             {
-                result.push_back(castedComponent);
+                return ComponentView<T>{_components.end(), _components.end()};
             }
         }
-        return result;
+        return ComponentView<T>{_components.begin(), _components.end()};
     }
 
     template <DerivedFromComponent T>
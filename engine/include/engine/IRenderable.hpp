@@ -1,20 +1,73 @@
 #pragma once
 
+#include <cstdint>
+
 #include <renderer/common/Renderer.hpp>
+#include "engine/Camera.hpp"
 #include "engine/serialization/ComponentSerializer.hpp"
 
 namespace N2Engine
 {
+    namespace Rendering
+    {
+        class InstanceBatcher;
+    }
+
     /**
      * An interface for components which should render to the screen
      */
     class IRenderable : public SerializableComponent
     {
         using SerializableComponent::SerializableComponent;
+        friend class Scene;
 
     public:
         virtual void Render(Renderer::Common::IRenderer *renderer) = 0;
         virtual void InitializeRenderResources(Renderer::Common::IRenderer *renderer) = 0;
         virtual void CleanupRenderResources(Renderer::Common::IRenderer *renderer) = 0;
+
+        /**
+         * Opt-in batching: add this frame's instance to the batcher and return true,
+         * and the scene draws it together with others sharing its mesh and material.
+         * Returning false (the default) draws the component through Render().
+         */
+        virtual bool CollectInstance(Renderer::Common::IRenderer *renderer, Rendering::InstanceBatcher &batcher)
+        {
+            return false;
+        }
+
+        /**
+         * Local-space box around everything Render() draws, used for frustum culling.
+         * Returning false (the default) means the renderable is never culled.
+         */
+        virtual bool GetLocalBounds(BoundingBox &bounds) const
+        {
+            return false;
+        }
+
+        /**
+         * World-space bounds, recomputed only when the world transform or the local
+         * bounds changed since the last call. False if the renderable has no bounds.
+         */
+        bool GetWorldBounds(BoundingBox &bounds);
+
+        /**
+         * Static renderables are culled through a bounding volume hierarchy the scene
+         * rebuilds only when the set of static renderables changes: moving one leaves
+         * it culled at its old bounds until SetStatic is called again.
+         */
+        void SetStatic(bool isStatic);
+        [[nodiscard]] bool IsStatic() const { return _isStatic; }
+
+    private:
+        BoundingBox _localBounds;
+        BoundingBox _worldBounds;
+        uint32_t _worldVersion = 0;
+        bool _hasWorldBounds = false;
+        bool _worldBoundsValid = false;
+
+        bool _isStatic = false;
+        // The scene's static hierarchy build this renderable was placed in, 0 for none
+        uint32_t _staticBuild = 0;
     };
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <nlohmann/json.hpp>
 
 #include "engine/Transform.hpp"
+#include "engine/TransformHierarchy.hpp"
 
 namespace N2Engine
 {
@@ -18,45 +19,42 @@ namespace N2Engine
 
     /**
      * Handles spatial transformation for GameObjects that need positioning.
-     * Uses lazy evaluation and dirty flagging for optimal performance.
+     * A handle to a node of its scene's TransformHierarchy, which stores the local and world
+     * transforms and resolves world transforms lazily per dirty subtree.
      */
     class Positionable
     {
+        friend class TransformHierarchy;
+
     public:
         using Matrix4 = Math::Matrix<float, 4, 4>;
 
     private:
-        // Only store local transform - global is calculated on demand
-        Transform _localTransform;
+        TransformHierarchy *_hierarchy;
+        TransformHierarchy::NodeIndex _node;
         GameObject &_gameObject;
 
         mutable Physics::Rigidbody* _attachedRigidbody = nullptr;
 
-        // Cached global transform with dirty tracking
-        mutable Transform _cachedGlobalTransform;
-        mutable bool _globalTransformDirty = true;
-        mutable bool _globalTransformValid = false;
-
-        // Hierarchy change detection
-        mutable uint32_t _hierarchyVersion = 0;
-        mutable uint32_t _cachedHierarchyVersion = 0;
-
         // Internal methods
         void MarkGlobalTransformDirty() const;
-        void MarkChildrenGlobalTransformDirty() const;
-        void UpdateGlobalTransform() const;
-        Transform CalculateGlobalTransform() const;
+        Transform &EditLocalTransform();
         Positionable* GetParentPositionable() const;
 
         void NotifyPhysicsComponents() const;
 
     public:
         explicit Positionable(GameObject &gameObject);
+        ~Positionable();
 
-        // Local transform access (stored directly)
-        Math::Vector3 GetLocalPosition() const { return _localTransform.GetPosition(); }
-        Math::Quaternion GetLocalRotation() const { return _localTransform.GetRotation(); }
-        Math::Vector3 GetLocalScale() const { return _localTransform.GetScale(); }
+        // The hierarchy keeps a pointer to its owner
+        Positionable(const Positionable &) = delete;
+        Positionable& operator=(const Positionable &) = delete;
+
+        // Local transform access
+        Math::Vector3 GetLocalPosition() const { return GetLocalTransform().GetPosition(); }
+        Math::Quaternion GetLocalRotation() const { return GetLocalTransform().GetRotation(); }
+        Math::Vector3 GetLocalScale() const { return GetLocalTransform().GetScale(); }
 
         void SetLocalPosition(const Math::Vector3 &position);
         void SetLocalRotation(const Math::Quaternion &rotation);
@@ -89,6 +87,8 @@ namespace N2Engine
         const Transform &GetGlobalTransform() const;
         Matrix4 GetLocalToWorldMatrix() const;
         Matrix4 GetWorldToLocalMatrix() const;
+        // Resolves the world transform; the result changes whenever that transform was recomputed
+        uint32_t GetWorldVersion() const;
 
         // Utility methods
         Math::Vector3 TransformPoint(const Math::Vector3 &point) const;
@@ -100,8 +100,13 @@ namespace N2Engine
         nlohmann::json Serialize() const;
         void Deserialize(const nlohmann::json &j);
 
-        // Hierarchy change notification
+        // Hierarchy change notification: re-links the node under the parent's Positionable
         void OnHierarchyChanged() const;
+        // Scene change notification: moves the node into the new scene's hierarchy
+        void OnSceneChanged();
+
+        // Called by physics components that mirror this transform into a body
+        void MarkPhysicsBound() const;
 
         // Debug/Editor support
         bool IsGlobalTransformDirty() const;
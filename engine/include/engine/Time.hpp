@@ -4,10 +4,12 @@
 namespace N2Engine
 {
     class Application;
+    class FrameLoop;
 
     class Time
     {
         friend class Application;
+        friend class FrameLoop;
 
         using TimePoint = std::chrono::high_resolution_clock::time_point;
 
@@ -26,7 +28,10 @@ namespace N2Engine
         static TimePoint lastFrameTime;
 
         static void Init();
+        // Advances by the wall-clock time since the last call
         static void Update();
+        // Advances by a given step instead of the clock, for simulation on virtual time
+        static void Advance(double unscaledDelta);
 
     public:
         static float GetDeltaTime();
@@ -9,6 +9,7 @@ namespace N2Engine
     class Transform
     {
         friend class Positionable;
+        friend class TransformHierarchy;
         using Matrix4 = Math::Matrix<float, 4, 4>;
 
     private:
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "engine/Transform.hpp"
+
+namespace N2Engine
+{
+    class Positionable;
+
+    /**
+     * Local and world transforms of every Positionable in flat arrays kept in hierarchy
+     * pre-order: a parent precedes its children and each subtree is one contiguous range.
+     * Setting a local transform only flags its node. World transforms are resolved per
+     * dirty subtree on read, or for everything in one top-down pass per frame that splits
+     * top-level subtrees across threads.
+     * Structural changes that cannot keep the order in place defer a single O(n) reorder
+     * to the next pass; until then reads walk the parent chain.
+     *
+     * Every Scene owns one for the GameObjects in it; GameObjects outside any scene share
+     * Detached(). A Positionable's node moves along when its GameObject changes scene. Reads
+     * resolve dirty nodes in place, so a hierarchy is single-threaded: only the thread running
+     * its scene reads or changes it, except between BeginParallelReads and EndParallelReads,
+     * when world transforms are resolved and frozen and any thread may read them.
+     */
+    class TransformHierarchy
+    {
+    public:
+        using NodeIndex = uint32_t;
+        static constexpr NodeIndex InvalidNode = std::numeric_limits<NodeIndex>::max();
+
+        // Holds the transforms of GameObjects that belong to no scene
+        static TransformHierarchy &Detached();
+
+        TransformHierarchy() = default;
+        TransformHierarchy(const TransformHierarchy &) = delete;
+        TransformHierarchy &operator=(const TransformHierarchy &) = delete;
+
+        // New root node; indices move when the hierarchy reorders and are written back to the owner
+        NodeIndex CreateNode(Positionable *owner);
+        void DestroyNode(NodeIndex node);
+        // Moves node of from, with its local transform, into a new root node here and repoints its owner
+        void Adopt(TransformHierarchy &from, NodeIndex node);
+        // Moves every node into to, keeping parents linked, and repoints their owners
+        void MoveNodesTo(TransformHierarchy &to);
+        void SetParent(NodeIndex node, NodeIndex parent);
+        [[nodiscard]] NodeIndex GetParent(NodeIndex node) const { return _parents[node]; }
+
+        [[nodiscard]] const Transform &GetLocal(NodeIndex node) const { return _locals[node]; }
+        // Callers that change the returned transform must MarkDirty the node
+        [[nodiscard]] Transform &EditLocal(NodeIndex node) { return _locals[node]; }
+        void MarkDirty(NodeIndex node);
+
+        [[nodiscard]] bool IsWorldDirty(NodeIndex node) const;
+        // Valid until the next structural change
+        const Transform &GetWorld(NodeIndex node);
+        // Changes whenever the node's world transform is recomputed; resolve it with GetWorld first
+        [[nodiscard]] uint32_t GetWorldVersion(NodeIndex node) const { return _worldVersions[node]; }
+
+        // Nodes whose owners forward world changes to physics bodies
+        void MarkPhysicsBound(NodeIndex node) { _physicsBound[node] = 1; }
+        [[nodiscard]] bool IsPhysicsBound(NodeIndex node) const { return _physicsBound[node] != 0; }
+
+        // Resolves every dirty subtree in up to threadCount job system pieces; 0 picks one per few thousand nodes.
+        // Returns how many physics bound nodes it notified.
+        size_t UpdateWorldTransforms(unsigned threadCount = 0);
+
+        // Resolves every dirty subtree, then makes GetWorld read-only until EndParallelReads.
+        // Reading a node dirtied in between, or changing the hierarchy at all, asserts.
+        void BeginParallelReads();
+        void EndParallelReads();
+        [[nodiscard]] bool IsInParallelReads() const { return _parallelReads; }
+
+        [[nodiscard]] size_t GetNodeCount() const { return _owners.size() - _deadCount; }
+        [[nodiscard]] bool IsOrdered() const { return _ordered; }
+
+    private:
+        // Recomputes the stale nodes of [first, last) top-down. first must be a root or have a
+        // clean parent; other nodes whose parent lies before the range are left for their own reads
+        void RecomputeRange(NodeIndex first, NodeIndex last, std::vector<Positionable*> &notify);
+        const Transform &ResolveChain(NodeIndex node);
+        void Rebuild();
+        void Notify(const std::vector<Positionable*> &notify) const;
+        // Asserts that the calling thread may change the hierarchy now
+        void CheckWritable() const;
+
+        std::vector<Transform> _locals;
+        std::vector<Transform> _worlds;
+        std::vector<NodeIndex> _parents;
+        std::vector<uint32_t> _subtreeSizes;
+        std::vector<uint8_t> _dirty;
+        std::vector<uint8_t> _recomputed;
+        std::vector<uint32_t> _worldVersions;
+        // _changes when ResolveChain last resolved the node; while it still matches, the chain is unchanged
+        std::vector<uint64_t> _resolvedAt;
+        std::vector<uint8_t> _physicsBound;
+        std::vector<Positionable*> _owners;
+
+        std::vector<NodeIndex> _chain;
+        // Bumped by every MarkDirty
+        uint64_t _changes = 0;
+        size_t _deadCount = 0;
+        // Nodes sitting inside the range of a subtree they no longer belong to
+        size_t _slack = 0;
+        bool _ordered = true;
+        bool _hasDirty = false;
+        bool _parallelReads = false;
+    };
+}
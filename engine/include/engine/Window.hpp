@@ -8,6 +8,7 @@
 #include <math/VectorN.hpp>
 
 #include "engine/config/ApplicationOptions.hpp"
+#include "engine/rendering/PipelinedRenderer.hpp"
 #include "engine/common/Color.hpp"
 
 namespace N2Engine
@@ -46,11 +47,16 @@ namespace N2Engine
     private:
         GLFWwindow *_window;
         std::unique_ptr<Renderer::Common::IRenderer> _renderer;
+        // Set when frames render on their own thread; it then wraps the backend in _renderer
+        Rendering::PipelinedRenderer *_framePipeline{nullptr};
         std::unique_ptr<Input::InputSystem> _inputSystem;
         std::string _title{"N2Engine Application"};
         WindowMode _windowMode{WindowMode::Windowed};
         WindowData windowData{};
+        bool _closeRequested{false};
 
+        void InitHeadless(const Config::ApplicationOptions &options);
+        void StartFramePipeline(const Config::ApplicationOptions &options);
         static void FramebufferSizeCallback(GLFWwindow *window, int width, int height);
         void OnWindowResize(int width, int height);
 
@@ -63,10 +69,15 @@ namespace N2Engine
 
         void InitWindow(const Config::ApplicationOptions &options);
         [[nodiscard]] bool ShouldClose() const;
+        void RequestClose();
+        // No GLFW window exists (headless software rendering).
+        [[nodiscard]] bool IsHeadless() const { return _window == nullptr; }
         void PollEvents();
         void Shutdown();
         void Clear();
         [[nodiscard]] Renderer::Common::IRenderer* GetRenderer() const;
+        // Null unless ApplicationOptions::framePipelineDepth is above 1
+        [[nodiscard]] Rendering::PipelinedRenderer* GetFramePipeline() const { return _framePipeline; }
         [[nodiscard]] Input::InputSystem* GetInputSystem() const;
 
         [[nodiscard]] Vector2i GetWindowDimensions() const;
@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <cstdint>
 
 namespace N2Engine::Config
 {
@@ -21,5 +22,23 @@ namespace N2Engine::Config
         PhysicsBackend physicsBackend;
         RenderBackend renderBackend;
         bool isHeadless = false;
+        // Headless SOFTWARE rendering creates no window and never initializes GLFW;
+        // frames render into the CPU framebuffer at this size. Other backends still
+        // need a GL/Vulkan surface, so headless only hides their window.
+        uint32_t headlessWidth = 1280;
+        uint32_t headlessHeight = 720;
+        // No window, renderer or GLFW whatever the backends: the application is driven by
+        // Application::Simulate / Step on virtual time, for servers and regression runs.
+        bool simulationOnly = false;
+        // Software backend only: threads rasterizing each frame. 0 = one per hardware thread.
+        uint32_t softwareRasterThreads = 0;
+        // Threads running engine jobs (Scheduling::JobSystem), the main thread included. 0 = one per hardware thread.
+        uint32_t jobThreads = 0;
+        // Frames in flight. 1 renders on the main thread after each update; 2 or 3 record
+        // each frame and render it on a separate thread while the next one simulates.
+        uint32_t framePipelineDepth = 1;
+        // With framePipelineDepth above 1: a render thread that falls behind skips to the
+        // newest finished frame instead of drawing every one.
+        bool dropLateFrames = false;
     };
 }
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "engine/ecs/EntityStore.hpp"
+#include "engine/scheduling/JobSystem.hpp"
+
+namespace N2Engine::ECS
+{
+    namespace Detail
+    {
+        // Data columns hold the values, bridged columns hold pointers to the owned objects
+        template <typename T>
+        using ColumnPointer = std::conditional_t<DataComponent<std::remove_const_t<T>>, T *, T *const *>;
+
+        template <typename T>
+        T &Element(ColumnPointer<T> column, size_t row)
+        {
+            if constexpr (DataComponent<std::remove_const_t<T>>)
+            {
+                return column[row];
+            }
+            else
+            {
+                return *column[row];
+            }
+        }
+
+        template <typename... Ts>
+        inline constexpr bool DistinctTypes = true;
+        template <typename T, typename... Rest>
+        inline constexpr bool DistinctTypes<T, Rest...> =
+            (!std::is_same_v<std::remove_const_t<T>, std::remove_const_t<Rest>> && ...) && DistinctTypes<Rest...>;
+    }
+
+    // One chunk of a query's matches: its entities and one column per queried type
+    template <typename... Ts>
+    class QueryChunk
+    {
+    public:
+        using Columns = std::tuple<Detail::ColumnPointer<Ts>...>;
+
+        QueryChunk(std::span<const Entity> entities, const Columns &columns) : _entities(entities), _columns(columns) {}
+
+        [[nodiscard]] size_t Size() const { return _entities.size(); }
+        [[nodiscard]] std::span<const Entity> GetEntities() const { return _entities; }
+
+        // std::span<T> for data components, std::span<T *const> for bridged ones
+        template <typename T>
+        [[nodiscard]] auto GetColumn() const
+        {
+            const auto column = std::get<Detail::ColumnPointer<T>>(_columns);
+            return std::span(column, Size());
+        }
+
+        // Calls fn(Ts &...) or fn(Entity, Ts &...) for every row
+        template <typename F>
+        void ForEach(F &fn) const
+        {
+            std::apply([&](const auto... columns)
+            {
+                for (size_t row = 0; row < _entities.size(); ++row)
+                {
+                    if constexpr (std::is_invocable_v<F &, Entity, Ts &...>)
+                    {
+                        fn(_entities[row], Detail::Element<Ts>(columns, row)...);
+                    }
+                    else
+                    {
+                        fn(Detail::Element<Ts>(columns, row)...);
+                    }
+                }
+            }, _columns);
+        }
+
+    private:
+        std::span<const Entity> _entities;
+        Columns _columns;
+    };
+
+    /**
+     * Every entity holding at least the queried types, visited chunk by chunk in storage order.
+     * Matching archetypes are cached and picked up incrementally as the store creates more.
+     * The store must not change structurally (create, destroy, add, remove) while iterating.
+     */
+    template <typename... Ts>
+    class EntityQuery
+    {
+        static_assert(sizeof...(Ts) > 0, "Query at least one component type");
+        static_assert(Detail::DistinctTypes<Ts...>, "Query component types must be distinct");
+
+    public:
+        using Chunk = QueryChunk<Ts...>;
+
+        explicit EntityQuery(EntityStore &store)
+            : _store(&store), _types{ComponentTypes::Id<std::remove_const_t<Ts>>()...}
+        {
+            for (const ComponentTypeId type : _types)
+            {
+                _required.set(type);
+            }
+        }
+
+        template <typename F>
+        void ForEach(F &&fn)
+        {
+            ForEachChunk([&fn](const Chunk &chunk) { chunk.ForEach(fn); });
+        }
+
+        template <typename F>
+        void ForEachChunk(F &&fn)
+        {
+            Refresh();
+            for (const Match &match : _matches)
+            {
+                for (size_t i = 0; i < match.archetype->GetChunkCount(); ++i)
+                {
+                    const ECS::Chunk &chunk = match.archetype->GetChunk(i);
+                    if (chunk.Size() > 0)
+                    {
+                        fn(MakeChunk(match, chunk));
+                    }
+                }
+            }
+        }
+
+        /**
+         * Hands whole chunks to the job system; fn runs concurrently for different chunks
+         * and must only touch the rows it is given. threadCount caps the threads taking part;
+         * 0 lets every job system thread in.
+         */
+        template <typename F>
+        void ParallelForEachChunk(F &&fn, unsigned threadCount = 0)
+        {
+            std::vector<Chunk> chunks;
+            ForEachChunk([&chunks](const Chunk &chunk) { chunks.push_back(chunk); });
+
+            // One piece per allowed thread, or as the job system splits it
+            const size_t grain = threadCount == 0 ? 1 : (chunks.size() + threadCount - 1) / threadCount;
+            Scheduling::JobSystem::Instance().ParallelForEach(std::span<const Chunk>{chunks}, grain, fn);
+        }
+
+        template <typename F>
+        void ParallelForEach(F &&fn, unsigned threadCount = 0)
+        {
+            ParallelForEachChunk([&fn](const Chunk &chunk) { chunk.ForEach(fn); }, threadCount);
+        }
+
+        [[nodiscard]] size_t Count()
+        {
+            Refresh();
+            size_t count = 0;
+            for (const Match &match : _matches)
+            {
+                count += match.archetype->GetEntityCount();
+            }
+            return count;
+        }
+
+    private:
+        struct Match
+        {
+            const Archetype *archetype;
+            std::array<int, sizeof...(Ts)> columns;
+        };
+
+        void Refresh()
+        {
+            const auto archetypes = _store->GetArchetypes();
+            for (; _scanned < archetypes.size(); ++_scanned)
+            {
+                const Archetype &archetype = *archetypes[_scanned];
+                if ((archetype.GetMask() & _required) != _required)
+                {
+                    continue;
+                }
+
+                Match match{&archetype, {}};
+                for (size_t i = 0; i < _types.size(); ++i)
+                {
+                    match.columns[i] = archetype.FindColumn(_types[i]);
+                }
+                _matches.push_back(match);
+            }
+        }
+
+        Chunk MakeChunk(const Match &match, const ECS::Chunk &chunk) const
+        {
+            return [&]<size_t... I>(std::index_sequence<I...>)
+            {
+                return Chunk(chunk.entities, typename Chunk::Columns{
+                    reinterpret_cast<Detail::ColumnPointer<Ts>>(match.archetype->GetColumn(chunk, match.columns[I]))...});
+            }(std::index_sequence_for<Ts...>{});
+        }
+
+        EntityStore *_store;
+        std::array<ComponentTypeId, sizeof...(Ts)> _types;
+        ComponentMask _required;
+        std::vector<Match> _matches;
+        size_t _scanned = 0;
+    };
+}
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace N2Engine
+{
+    class Component;
+    class GameObject;
+}
+
+namespace N2Engine::ECS
+{
+    // Index into the store's entity records plus the generation of the record when the
+    // handle was issued; destroying an entity bumps it so stale handles stop resolving.
+    struct Entity
+    {
+        uint32_t index = std::numeric_limits<uint32_t>::max();
+        uint32_t generation = 0;
+
+        [[nodiscard]] bool IsNull() const { return index == std::numeric_limits<uint32_t>::max(); }
+        bool operator==(const Entity &) const = default;
+    };
+
+    inline constexpr size_t MaxComponentTypes = 256;
+    inline constexpr size_t ChunkBytes = 16 * 1024;
+
+    using ComponentTypeId = uint32_t;
+    using ComponentMask = std::bitset<MaxComponentTypes>;
+
+    /**
+     * Plain data stored by value in chunk columns and moved between archetypes with memcpy.
+     * Any other type (Component subclasses, Positionable) stays owned by its GameObject and
+     * is bridged: the column holds a pointer and queries hand out a reference to the object.
+     */
+    template <typename T>
+    concept DataComponent = std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T> &&
+                            alignof(T) <= alignof(std::max_align_t);
+
+    template <typename T>
+    concept BridgedComponent = std::is_class_v<T> && !DataComponent<T>;
+
+    struct ComponentTypeInfo
+    {
+        std::type_index type;
+        uint32_t size;
+        uint32_t alignment;
+        bool bridged;
+    };
+
+    /**
+     * Process-wide ids for the types stored in entity stores.
+     * Bridged components register under their dynamic type, so a query for a base class
+     * does not match entities holding a derived one.
+     */
+    class ComponentTypes
+    {
+    public:
+        static ComponentTypeId Register(std::type_index type, uint32_t size, uint32_t alignment, bool bridged);
+        [[nodiscard]] static ComponentTypeInfo Get(ComponentTypeId id);
+
+        template <typename T>
+        static ComponentTypeId Id()
+        {
+            static const ComponentTypeId id = DataComponent<T>
+                ? Register(typeid(T), sizeof(T), alignof(T), false)
+                : Register(typeid(T), sizeof(T *), alignof(T *), true);
+            return id;
+        }
+
+        static ComponentTypeId BridgedId(std::type_index type)
+        {
+            return Register(type, sizeof(void *), alignof(void *), true);
+        }
+    };
+
+    // Rows of one archetype: a fixed-size block with one tightly packed column per type
+    struct Chunk
+    {
+        std::unique_ptr<std::max_align_t[]> data;
+        std::vector<Entity> entities;
+
+        [[nodiscard]] uint32_t Size() const { return static_cast<uint32_t>(entities.size()); }
+    };
+
+    /**
+     * Every entity with exactly one set of component types.
+     * All chunks but the last are full, so iteration touches only live rows.
+     */
+    class Archetype
+    {
+    public:
+        explicit Archetype(const ComponentMask &mask);
+
+        [[nodiscard]] const ComponentMask &GetMask() const { return _mask; }
+        [[nodiscard]] std::span<const ComponentTypeId> GetTypes() const { return _types; }
+        [[nodiscard]] uint32_t GetChunkCapacity() const { return _chunkCapacity; }
+        [[nodiscard]] size_t GetChunkCount() const { return _chunks.size(); }
+        [[nodiscard]] Chunk &GetChunk(size_t index) const { return *_chunks[index]; }
+        [[nodiscard]] size_t GetEntityCount() const;
+
+        // Column position of a type, or -1 when the archetype does not hold it
+        [[nodiscard]] int FindColumn(ComponentTypeId type) const;
+
+        [[nodiscard]] std::byte *GetColumn(const Chunk &chunk, size_t column) const
+        {
+            return reinterpret_cast<std::byte *>(chunk.data.get()) + _offsets[column];
+        }
+
+    private:
+        friend class EntityStore;
+
+        ComponentMask _mask;
+        std::vector<ComponentTypeId> _types;
+        std::vector<uint32_t> _sizes;
+        std::vector<uint32_t> _offsets;
+        uint32_t _chunkCapacity = 1;
+        std::vector<std::unique_ptr<Chunk>> _chunks;
+    };
+
+    template <typename... Ts>
+    class EntityQuery;
+
+    /**
+     * Opt-in archetype storage for data-oriented systems.
+     * Entities are grouped by component set into structure-of-arrays chunks; adding or
+     * removing a type moves the entity's row to the matching archetype.
+     * Pointers returned by Get are invalidated by any structural change.
+     */
+    class EntityStore
+    {
+    public:
+        EntityStore();
+        ~EntityStore();
+        EntityStore(EntityStore &&) noexcept;
+        EntityStore &operator=(EntityStore &&) noexcept;
+
+        EntityStore(const EntityStore &) = delete;
+        EntityStore &operator=(const EntityStore &) = delete;
+
+        Entity Create();
+
+        // Creates the entity straight in the archetype of Ts, without intermediate moves
+        template <DataComponent... Ts>
+        Entity Create(const Ts &... values)
+        {
+            ComponentMask mask;
+            (mask.set(ComponentTypes::Id<Ts>()), ...);
+            const Entity entity = CreateIn(GetOrCreateArchetype(mask));
+            (std::memcpy(Locate(entity, ComponentTypes::Id<Ts>()), &values, sizeof(Ts)), ...);
+            return entity;
+        }
+
+        // An entity bridging the GameObject's Positionable and every component it holds now
+        Entity CreateFor(GameObject &gameObject);
+
+        bool Destroy(Entity entity);
+        [[nodiscard]] bool IsAlive(Entity entity) const;
+
+        template <DataComponent T>
+        T *Add(Entity entity, const T &value = {})
+        {
+            std::byte *slot = AddType(entity, ComponentTypes::Id<T>());
+            if (!slot)
+            {
+                return nullptr;
+            }
+            std::memcpy(slot, &value, sizeof(T));
+            return reinterpret_cast<T *>(slot);
+        }
+
+        template <BridgedComponent T>
+        bool Bridge(Entity entity, T *object)
+        {
+            return object && BridgeType(entity, ComponentTypes::Id<T>(), object);
+        }
+
+        // Bridges a component under its dynamic type
+        bool Bridge(Entity entity, Component *component);
+        bool Unbridge(Entity entity, Component *component);
+
+        template <typename T>
+        bool Remove(Entity entity)
+        {
+            return RemoveType(entity, ComponentTypes::Id<T>());
+        }
+
+        template <typename T>
+        [[nodiscard]] T *Get(Entity entity) const
+        {
+            std::byte *slot = Locate(entity, ComponentTypes::Id<T>());
+            if (!slot)
+            {
+                return nullptr;
+            }
+            if constexpr (DataComponent<T>)
+            {
+                return reinterpret_cast<T *>(slot);
+            }
+            else
+            {
+                return *reinterpret_cast<T **>(slot);
+            }
+        }
+
+        template <typename T>
+        [[nodiscard]] bool Has(Entity entity) const
+        {
+            return Locate(entity, ComponentTypes::Id<T>()) != nullptr;
+        }
+
+        template <typename... Ts>
+        [[nodiscard]] EntityQuery<Ts...> Query()
+        {
+            return EntityQuery<Ts...>(*this);
+        }
+
+        [[nodiscard]] size_t GetEntityCount() const { return _entityCount; }
+        [[nodiscard]] size_t GetArchetypeCount() const { return _archetypes.size(); }
+        [[nodiscard]] std::span<const std::unique_ptr<Archetype>> GetArchetypes() const { return _archetypes; }
+
+        void Clear();
+
+    private:
+        struct EntityRecord
+        {
+            Archetype *archetype = nullptr;
+            uint32_t chunk = 0;
+            uint32_t row = 0;
+            uint32_t generation = 0;
+        };
+
+        Entity CreateIn(Archetype &archetype);
+        const EntityRecord *Resolve(Entity entity) const;
+        Archetype &GetOrCreateArchetype(const ComponentMask &mask);
+
+        std::byte *AddType(Entity entity, ComponentTypeId type);
+        bool BridgeType(Entity entity, ComponentTypeId type, void *object);
+        bool RemoveType(Entity entity, ComponentTypeId type);
+        std::byte *Locate(Entity entity, ComponentTypeId type) const;
+
+        // Moves an entity's row to another archetype, copying the columns both share
+        void MoveEntity(Entity entity, Archetype &target);
+        void AppendRow(Archetype &archetype, Entity entity);
+        void RemoveRow(Archetype &archetype, uint32_t chunk, uint32_t row);
+
+        std::vector<EntityRecord> _records;
+        std::vector<uint32_t> _freeRecords;
+        std::vector<std::unique_ptr<Archetype>> _archetypes;
+        std::unordered_map<ComponentMask, Archetype *> _archetypesByMask;
+        Archetype *_emptyArchetype = nullptr;
+        size_t _entityCount = 0;
+    };
+}
+
+#include "engine/ecs/EntityQuery.hpp"
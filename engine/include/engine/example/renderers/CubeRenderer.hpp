@@ -15,7 +15,7 @@ namespace N2Engine::Example
         friend class PolygonRenderer;
 
     private:
-        void CreateMesh(Renderer::Common::IRenderer* renderer)
+        [[nodiscard]] Renderer::Common::MeshData CreateMeshData() const
         {
             // Create cube mesh (unit cube, 24 vertices for proper normals)
             Renderer::Common::MeshData cubeData;
@@ -78,8 +78,12 @@ namespace N2Engine::Example
                 20, 21, 22, 20, 22, 23
             };
 
-            _mesh = renderer->CreateMesh(cubeData);
-            _material = renderer->CreateMaterial(_shader, nullptr);
+            return cubeData;
+        }
+
+        [[nodiscard]] std::string GetMeshKey() const
+        {
+            return "Cube";
         }
 
     public:
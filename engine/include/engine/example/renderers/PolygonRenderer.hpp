@@ -7,6 +7,8 @@
 
 #include "engine/Component.hpp"
 #include "engine/IRenderable.hpp"
+#include "engine/rendering/InstanceBatcher.hpp"
+#include "engine/rendering/SharedMeshRegistry.hpp"
 #include "engine/common/Color.hpp"
 #include "engine/common/ScriptUtils.hpp"
 #include "engine/GameObjectScene.hpp"
@@ -15,6 +17,8 @@
 #include "engine/serialization/MathSerialization.hpp"
 
 #include <concepts>
+#include <cstring>
+#include <string>
 #include <type_traits>
 
 namespace N2Engine::Example
@@ -28,18 +32,24 @@ namespace N2Engine::Example
      * - Compile-time type safety
      *
      * Derived classes must implement:
-     * - CreateMesh(Renderer::Common::IRenderer* renderer)
+     * - CreateMeshData() const
+     * - GetMeshKey() const: identifies the generated mesh (type and parameters)
      * - GetTypeName() const
      *
+     * Meshes and materials come from the SharedMeshRegistry: every renderer
+     * with the same mesh key shares one IMesh, and those with the same color
+     * also share a material, so the scene draws them as one instanced batch.
+     *
      * @tparam Derived The derived renderer class (e.g., QuadRenderer)
      *
      * Example:
      * @code
      * class QuadRenderer final : public PolygonRenderer<QuadRenderer> {
      * protected:
-     *     void CreateMesh(Renderer::Common::IRenderer* renderer) {
+     *     Renderer::Common::MeshData CreateMeshData() const {
      *         // Generate quad mesh...
      *     }
+     *     std::string GetMeshKey() const { return "Quad"; }
      * };
      * @endcode
      */
@@ -56,6 +66,7 @@ namespace N2Engine::Example
 
         // Rendering properties (common to all polygon renderers)
         Common::Color _color{Common::Color::White};
+        Common::Color _materialColor{Common::Color::White}; // color _material was acquired with
         Math::Vector3 _size{Math::Vector3::One};
 
     public:
@@ -78,65 +89,55 @@ namespace N2Engine::Example
                 return;
             }
 
-            // Compile-time check that Derived implements CreateMesh
+            // Compile-time check that Derived implements the mesh hooks
             // This fires when Derived is complete, giving a clear error message
-            static_assert(requires(Derived& d, Renderer::Common::IRenderer* r) {
-                { d.CreateMesh(r) } -> std::same_as<void>;
-            }, "Derived class must implement: void CreateMesh(Renderer::Common::IRenderer*)");
+            static_assert(requires(const Derived& d) {
+                { d.CreateMeshData() } -> std::same_as<Renderer::Common::MeshData>;
+                { d.GetMeshKey() } -> std::convertible_to<std::string>;
+            }, "Derived class must implement: MeshData CreateMeshData() const and std::string GetMeshKey() const");
 
             _cachedRenderer = renderer;
             _shader = renderer->GetStandardUnlitShader();
 
-            // CRTP: Static dispatch to derived class's CreateMesh
-            static_cast<Derived*>(this)->CreateMesh(renderer);
-            
+            // CRTP: the mesh is only generated if no other renderer has built it yet
+            auto &registry = Rendering::SharedMeshRegistry::Instance();
+            const auto *derived = static_cast<const Derived*>(this);
+            _mesh = registry.AcquireMesh(renderer, derived->GetMeshKey(), [derived] { return derived->CreateMeshData(); });
+            _material = registry.AcquireMaterial(renderer, _shader, _color);
+            _materialColor = _color;
+
             _resourcesInitialized = true;
         }
 
         void Render(Renderer::Common::IRenderer* renderer) override
         {
-            if (!renderer)
+            Positionable::Matrix4 finalMatrix;
+            if (!PrepareDraw(renderer, finalMatrix))
             {
                 return;
             }
 
-            // Initialize resources if not already done
-            if (!_resourcesInitialized)
-            {
-                InitializeRenderResources(renderer);
-                if (!_resourcesInitialized)
-                {
-                    return;
-                }
-            }
+            // Pass the final matrix to the renderer
+            renderer->DrawMesh(_mesh, finalMatrix.Data(), _material);
+        }
 
-            if (_mesh == nullptr)
+        bool CollectInstance(Renderer::Common::IRenderer* renderer, Rendering::InstanceBatcher& batcher) override
+        {
+            Positionable::Matrix4 finalMatrix;
+            if (PrepareDraw(renderer, finalMatrix))
             {
-                return;
+                std::memcpy(batcher.Add(_mesh, _material), finalMatrix.Data(), 16 * sizeof(float));
             }
+            return true; // nothing to draw is still handled
+        }
 
-            const GameObject& gameObject = GetGameObject();
-            const Positionable* positionable = gameObject.GetPositionable();
-            if (!positionable)
-                return;
-
-            // Get the world transform matrix (this handles hierarchy automatically)
-            const Positionable::Matrix4 worldMatrix = positionable->GetLocalToWorldMatrix();
-
-            // Apply the polygon's size scaling to the transform
-            Positionable::Matrix4 scaleMatrix{Positionable::Matrix4::identity()};
-            scaleMatrix(0, 0) = _size.x;
-            scaleMatrix(1, 1) = _size.y;
-            scaleMatrix(2, 2) = _size.z;
-
-            // Combine: finalMatrix = worldMatrix * scaleMatrix
-            Positionable::Matrix4 finalMatrix = worldMatrix * scaleMatrix;
-
-            // Set color uniform
-            _material->SetColor("uAlbedo", _color.r, _color.g, _color.b, _color.a);
-
-            // Pass the final matrix to the renderer
-            renderer->DrawMesh(_mesh, finalMatrix.Data(), _material);
+        // Every generated mesh fits the unit box around the origin before _size scales it
+        bool GetLocalBounds(BoundingBox& bounds) const override
+        {
+            bounds = BoundingBox{
+                Math::Vector3{-0.5f * _size.x, -0.5f * _size.y, -0.5f * _size.z},
+                Math::Vector3{0.5f * _size.x, 0.5f * _size.y, 0.5f * _size.z}};
+            return true;
         }
 
         void CleanupRenderResources(Renderer::Common::IRenderer* renderer) override
@@ -144,23 +145,21 @@ namespace N2Engine::Example
             if (!_resourcesInitialized || !renderer)
                 return;
 
+            auto &registry = Rendering::SharedMeshRegistry::Instance();
             if (_mesh != nullptr)
             {
-                renderer->DestroyMesh(_mesh);
+                registry.ReleaseMesh(renderer, _mesh);
                 _mesh = nullptr;
             }
 
             if (_material != nullptr)
             {
-                renderer->DestroyMaterial(_material);
+                registry.ReleaseMaterial(renderer, _material);
                 _material = nullptr;
             }
 
-            if (_shader != nullptr)
-            {
-                renderer->DestroyShaderProgram(_shader);
-                _shader = nullptr;
-            }
+            // The standard shader belongs to the renderer, not to this component
+            _shader = nullptr;
 
             _resourcesInitialized = false;
         }
@@ -173,5 +172,63 @@ namespace N2Engine::Example
         [[nodiscard]] const Math::Vector3& GetSize() const { return _size; }
 
         static constexpr bool IsSingleton = false;
+
+    private:
+        // Shared by Render and CollectInstance: lazily acquires resources, picks the
+        // material for the current color and computes the model matrix. False if
+        // there is nothing to draw.
+        bool PrepareDraw(Renderer::Common::IRenderer* renderer, Positionable::Matrix4& finalMatrix)
+        {
+            if (!renderer)
+            {
+                return false;
+            }
+
+            // Initialize resources if not already done
+            if (!_resourcesInitialized)
+            {
+                InitializeRenderResources(renderer);
+                if (!_resourcesInitialized)
+                {
+                    return false;
+                }
+            }
+
+            if (_mesh == nullptr)
+            {
+                return false;
+            }
+
+            // Shared materials have a fixed color: switch materials when ours changes
+            if (_color != _materialColor)
+            {
+                auto &registry = Rendering::SharedMeshRegistry::Instance();
+                registry.ReleaseMaterial(renderer, _material);
+                _material = registry.AcquireMaterial(renderer, _shader, _color);
+                _materialColor = _color;
+            }
+            if (_material == nullptr)
+            {
+                return false;
+            }
+
+            const GameObject& gameObject = GetGameObject();
+            const Positionable* positionable = gameObject.GetPositionable();
+            if (!positionable)
+                return false;
+
+            // Get the world transform matrix (this handles hierarchy automatically)
+            const Positionable::Matrix4 worldMatrix = positionable->GetLocalToWorldMatrix();
+
+            // Apply the polygon's size scaling to the transform
+            Positionable::Matrix4 scaleMatrix{Positionable::Matrix4::identity()};
+            scaleMatrix(0, 0) = _size.x;
+            scaleMatrix(1, 1) = _size.y;
+            scaleMatrix(2, 2) = _size.z;
+
+            // Combine: finalMatrix = worldMatrix * scaleMatrix
+            finalMatrix = worldMatrix * scaleMatrix;
+            return true;
+        }
     };
 }
\ No newline at end of file
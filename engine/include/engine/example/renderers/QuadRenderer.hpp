@@ -15,7 +15,7 @@ namespace N2Engine::Example
         friend class PolygonRenderer;
 
     private:
-        void CreateMesh(Renderer::Common::IRenderer* renderer)
+        [[nodiscard]] Renderer::Common::MeshData CreateMeshData() const
         {
             // Create a simple quad (two triangles forming a square)
             Renderer::Common::MeshData quadData;
@@ -37,8 +37,12 @@ namespace N2Engine::Example
             // Two triangles: (0,1,2) and (0,2,3)
             quadData.indices = {0, 1, 2, 0, 2, 3};
 
-            _mesh = renderer->CreateMesh(quadData);
-            _material = renderer->CreateMaterial(_shader, nullptr);
+            return quadData;
+        }
+
+        [[nodiscard]] std::string GetMeshKey() const
+        {
+            return "Quad";
         }
 
     public:
@@ -23,7 +23,7 @@ namespace N2Engine::Example
         uint32_t _latitudeSegments = 16; // Rings (vertical)
         uint32_t _longitudeSegments = 32; // Slices (horizontal)
 
-        void CreateMesh(Renderer::Common::IRenderer *renderer)
+        [[nodiscard]] Renderer::Common::MeshData CreateMeshData() const
         {
             // Generate UV sphere using parametric equations
             Renderer::Common::MeshData sphereData;
@@ -99,8 +99,12 @@ namespace N2Engine::Example
                 }
             }
 
-            _mesh = renderer->CreateMesh(sphereData);
-            _material = renderer->CreateMaterial(_shader, nullptr);
+            return sphereData;
+        }
+
+        [[nodiscard]] std::string GetMeshKey() const
+        {
+            return "Sphere " + std::to_string(_latitudeSegments) + "x" + std::to_string(_longitudeSegments);
         }
 
     public:
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace N2Engine::Memory
+{
+    struct PoolStats
+    {
+        std::string name;
+        size_t blockSize = 0;
+        size_t live = 0;
+        size_t free = 0;
+        size_t highWater = 0;
+        size_t slabs = 0;
+    };
+
+    /**
+     * Fixed-size blocks carved out of slabs that are kept for the life of the program.
+     * Freed blocks go on an intrusive free list and are handed out again before the pool grows,
+     * so objects that come and go every frame reuse the same memory.
+     */
+    class ObjectPool
+    {
+    public:
+        // Blocks are aligned to this; larger alignments are not pooled
+        static constexpr size_t Alignment = alignof(std::max_align_t);
+
+        ObjectPool(std::string name, size_t blockSize);
+
+        ObjectPool(const ObjectPool &) = delete;
+        ObjectPool &operator=(const ObjectPool &) = delete;
+
+        [[nodiscard]] void *Allocate();
+        void Deallocate(void *block);
+
+        [[nodiscard]] PoolStats GetStats() const;
+
+    private:
+        struct FreeBlock
+        {
+            FreeBlock *next;
+        };
+
+        mutable std::mutex _mutex;
+        std::string _name;
+        size_t _blockSize;
+        size_t _blocksPerSlab;
+        std::vector<std::unique_ptr<std::byte[]>> _slabs;
+        FreeBlock *_freeList = nullptr;
+        size_t _live = 0;
+        size_t _free = 0;
+        size_t _highWater = 0;
+
+        void Grow();
+    };
+
+    /**
+     * Every pool in the engine: one per pooled type and one per component size class.
+     * Pools are never destroyed, so objects released during static destruction still find theirs.
+     */
+    class ObjectPools
+    {
+    public:
+        // Component sizes are rounded up to a multiple of this to pick their pool
+        static constexpr size_t SizeClassGranularity = 16;
+        // Anything larger goes to the global allocator
+        static constexpr size_t MaxPooledSize = 1024;
+
+        static ObjectPools &Instance();
+
+        ObjectPools(const ObjectPools &) = delete;
+        ObjectPools &operator=(const ObjectPools &) = delete;
+
+        // A pool of its own, for one type
+        ObjectPool &Create(std::string name, size_t blockSize);
+
+        // Shared by every component whose size rounds up to the same class
+        [[nodiscard]] void *AllocateComponent(size_t size);
+        void DeallocateComponent(void *block, size_t size);
+
+        [[nodiscard]] std::vector<PoolStats> GetStats() const;
+        void LogStats() const;
+
+    private:
+        static constexpr size_t SizeClassCount = MaxPooledSize / SizeClassGranularity;
+
+        mutable std::mutex _mutex;
+        std::vector<std::unique_ptr<ObjectPool>> _pools;
+        // Filled in on first use and read without the lock afterwards
+        std::array<std::atomic<ObjectPool*>, SizeClassCount> _componentPools{};
+
+        ObjectPools() = default;
+
+        ObjectPool &ComponentPool(size_t size);
+    };
+
+    /**
+     * Standard allocator handing out single objects from a pool of their own, named after Owner.
+     * Lets std::allocate_shared place an object and its control block in one pooled block.
+     */
+    template <typename T, typename Owner = T>
+    class PoolAllocator
+    {
+    public:
+        using value_type = T;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = PoolAllocator<U, Owner>;
+        };
+
+        PoolAllocator() = default;
+
+        template <typename U>
+        PoolAllocator(const PoolAllocator<U, Owner> &) noexcept {}
+
+        T *allocate(const size_t count)
+        {
+            if (count != 1 || alignof(T) > ObjectPool::Alignment)
+            {
+                return std::allocator<T>{}.allocate(count);
+            }
+            return static_cast<T*>(Pool().Allocate());
+        }
+
+        void deallocate(T *object, const size_t count)
+        {
+            if (count != 1 || alignof(T) > ObjectPool::Alignment)
+            {
+                std::allocator<T>{}.deallocate(object, count);
+                return;
+            }
+            Pool().Deallocate(object);
+        }
+
+        template <typename U>
+        bool operator==(const PoolAllocator<U, Owner> &) const noexcept { return true; }
+
+    private:
+        static ObjectPool &Pool()
+        {
+            static ObjectPool &pool = ObjectPools::Instance().Create(Owner::PoolName, sizeof(T));
+            return pool;
+        }
+    };
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "engine/Camera.hpp"
+
+namespace N2Engine::Rendering
+{
+    /**
+     * Bounding volume hierarchy over a fixed set of boxes, built by median splits
+     * along the longest axis. Frustum queries skip subtrees outside the view and
+     * accept subtrees entirely inside it without testing their boxes, so the
+     * number of tests grows with what is visible rather than with the set.
+     */
+    class BoundsBvh
+    {
+    public:
+        // Items are reported by their index in bounds
+        void Build(const std::vector<BoundingBox> &bounds);
+        void Clear();
+
+        /**
+         * Calls fn(index) for every box intersecting the frustum.
+         * @return the number of node and box bounds tested
+         */
+        template <typename Fn>
+        size_t Query(const Frustum &frustum, Fn &&fn) const;
+
+        [[nodiscard]] size_t GetItemCount() const { return _items.size(); }
+        [[nodiscard]] size_t GetNodeCount() const { return _nodes.size(); }
+
+    private:
+        static constexpr uint32_t LeafSize = 4;
+        // Median splits keep the depth near log2(items / LeafSize)
+        static constexpr size_t MaxDepth = 64;
+
+        struct Node
+        {
+            BoundingBox bounds;
+            uint32_t firstItem;  // the subtree's items are _items[firstItem, firstItem + itemCount)
+            uint32_t itemCount;
+            uint32_t rightChild; // 0 for leaves; the left child always follows its parent
+        };
+
+        uint32_t BuildNode(const std::vector<BoundingBox> &bounds, uint32_t first, uint32_t count);
+
+        std::vector<Node> _nodes;
+        std::vector<uint32_t> _items;
+        std::vector<BoundingBox> _itemBounds;
+    };
+
+    template <typename Fn>
+    size_t BoundsBvh::Query(const Frustum &frustum, Fn &&fn) const
+    {
+        if (_nodes.empty())
+        {
+            return 0;
+        }
+
+        size_t tests = 0;
+        uint32_t stack[MaxDepth];
+        size_t top = 0;
+        stack[top++] = 0;
+        while (top > 0)
+        {
+            const Node &node = _nodes[stack[--top]];
+            ++tests;
+            if (!frustum.IsVisible(node.bounds))
+            {
+                continue;
+            }
+            if (frustum.Contains(node.bounds))
+            {
+                for (uint32_t i = node.firstItem; i < node.firstItem + node.itemCount; ++i)
+                {
+                    fn(_items[i]);
+                }
+                continue;
+            }
+            if (node.rightChild == 0)
+            {
+                // A leaf straddling a plane: test its boxes one by one
+                for (uint32_t i = node.firstItem; i < node.firstItem + node.itemCount; ++i)
+                {
+                    ++tests;
+                    if (frustum.IsVisible(_itemBounds[_items[i]]))
+                    {
+                        fn(_items[i]);
+                    }
+                }
+                continue;
+            }
+            stack[top++] = node.rightChild;
+            stack[top++] = static_cast<uint32_t>(&node - _nodes.data()) + 1;
+        }
+        return tests;
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include <renderer/common/Renderer.hpp>
+
+namespace N2Engine::Rendering
+{
+    /**
+     * Collects draws by (mesh, material) so each group is submitted as a
+     * single IRenderer::DrawMeshInstanced call. Storage is kept between frames.
+     */
+    class InstanceBatcher
+    {
+    public:
+        /**
+         * Adds one instance to the batch for this mesh and material.
+         * @return where to write the instance's row-major model matrix (16 floats)
+         */
+        float* Add(Renderer::Common::IMesh *mesh, Renderer::Common::IMaterial *material);
+
+        /**
+         * Issues one instanced draw per non-empty batch, then empties the batches.
+         * Batches that received no instances this frame are dropped.
+         */
+        void Flush(Renderer::Common::IRenderer *renderer);
+
+        [[nodiscard]] size_t GetBatchCount() const { return _batches.size(); }
+
+    private:
+        struct Batch
+        {
+            Renderer::Common::IMesh *mesh;
+            Renderer::Common::IMaterial *material;
+            std::vector<std::array<float, 16>> matrices;
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(const std::pair<const void*, const void*> &key) const noexcept;
+        };
+
+        std::vector<Batch> _batches;
+        std::unordered_map<std::pair<const void*, const void*>, size_t, KeyHash> _batchIndex;
+        size_t _lastBatch = 0; // consecutive instances usually share a batch
+    };
+}
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <renderer/common/Renderer.hpp>
+#include <renderer/common/SlotMap.hpp>
+
+#include "engine/rendering/RenderSnapshot.hpp"
+
+namespace N2Engine::Rendering
+{
+    struct FramePipelineStats
+    {
+        uint64_t framesPresented = 0;
+        uint64_t framesDropped = 0;
+        // From the first call recorded for a frame to its Present returning on the render thread
+        double averageLatencyMs = 0.0;
+        double maxLatencyMs = 0.0;
+        // Replay and Present on the render thread, per presented frame
+        double averageRenderMs = 0.0;
+        // Time the simulating thread spent waiting for a free snapshot
+        double simulationWaitMs = 0.0;
+    };
+
+    /**
+     * What PipelinedRenderer::CreateMaterial hands out: the simulating thread's copy of a
+     * backend material. Draws record its values into the snapshot, and replay writes them
+     * back into the backend material, so changes made while earlier frames render never
+     * reach them.
+     */
+    class PipelinedMaterial final : public Renderer::Common::IMaterial
+    {
+    public:
+        explicit PipelinedMaterial(Renderer::Common::IMaterial &backend);
+
+        void SetInt(const std::string &name, int value) override;
+        void SetFloat(const std::string &name, float value) override;
+        void SetVec2(const std::string &name, float x, float y) override;
+        void SetVec2(const std::string &name, Math::Vector2 &value) override;
+        void SetVec3(const std::string &name, float x, float y, float z) override;
+        void SetVec3(const std::string &name, Math::Vector3 &value) override;
+        void SetVec4(const std::string &name, float x, float y, float z, float w) override;
+        void SetVec4(const std::string &name, Math::Vector4 &value) override;
+        void SetColor(const std::string &name, float r, float g, float b, float a) override;
+        void SetTexture(Renderer::Common::ITexture *texture) override { _texture = texture; }
+
+        [[nodiscard]] Renderer::Common::MaterialParameterBlock& GetParameters() override { return _parameters; }
+        [[nodiscard]] const Renderer::Common::MaterialParameterBlock& GetParameters() const override { return _parameters; }
+
+        [[nodiscard]] Renderer::Common::IShader* GetShader() const override { return _shader; }
+        [[nodiscard]] Renderer::Common::ITexture* GetTexture() const override { return _texture; }
+        [[nodiscard]] bool IsValid() const override { return _valid; }
+
+        // Only the render thread may touch it
+        [[nodiscard]] Renderer::Common::IMaterial* GetBackend() const { return _backend; }
+
+    private:
+        friend class PipelinedRenderer;
+
+        Renderer::Common::IMaterial *_backend;
+        Renderer::Common::IShader *_shader;
+        Renderer::Common::ITexture *_texture;
+        bool _valid;
+        Renderer::Common::MaterialParameterBlock _parameters;
+        // The DrawObjects call that last recorded it
+        uint64_t _recordedCall = 0;
+    };
+
+    /**
+     * Drives another renderer from a render thread of its own. Frames are recorded into
+     * RenderSnapshots and replayed there, so frame N renders while frame N+1 simulates.
+     * Depth snapshots exist: one being recorded and the rest queued or rendering, which
+     * bounds how far simulation runs ahead. With dropLateFrames a render thread that falls
+     * behind skips to the newest queued frame instead.
+     *
+     * Every call reaching the wrapped renderer runs on the render thread, in submission
+     * order. Creating resources or reading them back waits for the frames queued before;
+     * destroying them waits until the frame releasing them has been drawn. Materials are
+     * PipelinedMaterials, whose values each draw copies. The window's GL context, when
+     * there is one, is current on the render thread while it runs.
+     */
+    class PipelinedRenderer final : public Renderer::Common::IRenderer
+    {
+    public:
+        PipelinedRenderer(std::unique_ptr<IRenderer> renderer, GLFWwindow *contextWindow,
+                          uint32_t depth, bool dropLateFrames);
+        ~PipelinedRenderer() override;
+
+        PipelinedRenderer(const PipelinedRenderer &) = delete;
+        PipelinedRenderer &operator=(const PipelinedRenderer &) = delete;
+
+        [[nodiscard]] FramePipelineStats GetStats() const;
+        void LogStats() const;
+        [[nodiscard]] uint32_t GetDepth() const { return static_cast<uint32_t>(_snapshots.size()); }
+        // Waits for every submitted frame to be on screen
+        void Flush();
+
+        bool Initialize(GLFWwindow *windowHandle, uint32_t width, uint32_t height) override;
+        void Shutdown() override;
+        void Resize(uint32_t width, uint32_t height) override;
+        void Clear(float r, float g, float b, float a) override;
+
+        void BeginFrame() override;
+        void EndFrame() override;
+        void Present() override;
+
+        Renderer::Common::IShader* CreateShaderProgram(const char *vertexSource, const char *fragmentSource) override;
+        void UseShaderProgram(Renderer::Common::IShader *shader) override;
+        bool DestroyShaderProgram(Renderer::Common::ShaderHandle shader) override;
+        bool IsValidShader(Renderer::Common::ShaderHandle shader) const override;
+
+        Renderer::Common::IMesh* CreateMesh(const Renderer::Common::MeshData &meshData) override;
+        void DestroyMesh(Renderer::Common::MeshHandle mesh) override;
+        Renderer::Common::ITexture* CreateTexture(const uint8_t *data, uint32_t width, uint32_t height,
+                                                  uint32_t channels) override;
+        void DestroyTexture(Renderer::Common::TextureHandle texture) override;
+        Renderer::Common::IMaterial* CreateMaterial(Renderer::Common::IShader *shader) override;
+        Renderer::Common::IMaterial* CreateMaterial(Renderer::Common::IShader *shader,
+                                                    Renderer::Common::ITexture *texture) override;
+        void DestroyMaterial(Renderer::Common::MaterialHandle material) override;
+
+        void SetViewProjection(const float *view, const float *projection) override;
+        void UpdateSceneLighting(const Renderer::Common::SceneLightingData &lighting,
+                                 const Math::Vector3 &cameraPosition) override;
+        void DrawMesh(Renderer::Common::IMesh *mesh, const float *modelMatrix,
+                      Renderer::Common::IMaterial *material) override;
+        void DrawMeshInstanced(Renderer::Common::IMesh *mesh, Renderer::Common::IMaterial *material,
+                               std::span<const float[16]> modelMatrices) override;
+        void DrawObjects(const std::vector<Renderer::Common::RenderObject> &objects) override;
+        void OnResize(int width, int height) override;
+
+        [[nodiscard]] Renderer::Common::IShader* GetStandardUnlitShader() const override;
+        [[nodiscard]] Renderer::Common::IShader* GetStandardLitShader() const override;
+
+        void ReadFramebuffer(std::uint8_t *buffer, int width, int height) const override;
+
+        void SetWireframe(bool enabled) override;
+        [[nodiscard]] const char* GetRendererName() const override;
+
+    private:
+        // A recorded frame, or a call to run on the render thread between frames
+        struct WorkItem
+        {
+            RenderSnapshot *snapshot = nullptr;
+            std::function<void()> task;
+        };
+
+        std::unique_ptr<IRenderer> _renderer;
+        GLFWwindow *_contextWindow;
+        bool _dropLateFrames;
+
+        Renderer::Common::SlotMap<PipelinedMaterial> _materials;
+        uint64_t _drawObjectsCalls = 0;
+
+        std::vector<std::unique_ptr<RenderSnapshot>> _snapshots;
+        std::vector<RenderSnapshot*> _free;
+        // Owned by the simulating thread until Present hands it over
+        RenderSnapshot *_recording = nullptr;
+        uint64_t _nextFrame = 0;
+
+        mutable std::mutex _mutex;
+        mutable std::condition_variable _workReady;
+        mutable std::condition_variable _workDone;
+        mutable std::deque<WorkItem> _work;
+        // Submitted work items the render thread has finished
+        mutable uint64_t _submitted = 0;
+        mutable uint64_t _completed = 0;
+        bool _running = false;
+        std::thread _thread;
+
+        FramePipelineStats _stats;
+        double _totalLatencyMs = 0.0;
+        double _totalRenderMs = 0.0;
+
+        RenderSnapshot &Recording();
+        Renderer::Common::IMaterial* WrapMaterial(const std::function<Renderer::Common::IMaterial*()> &create);
+        // The PipelinedMaterial behind material, or nullptr for null and foreign materials
+        [[nodiscard]] PipelinedMaterial* FindMaterial(const Renderer::Common::IMaterial *material) const;
+        // Index of material's values in the recording snapshot, or NoMaterial for null and foreign materials
+        uint32_t RecordMaterial(RenderSnapshot &snapshot, Renderer::Common::IMaterial *material);
+        void Submit(WorkItem item) const;
+        // Runs fn on the render thread after everything submitted so far, and waits for it
+        void RunOnRenderThread(std::function<void()> fn) const;
+        void Retire(RenderSnapshot::RetiredResource resource);
+        void Stop();
+        void RenderLoop();
+        void RenderSnapshotItem(RenderSnapshot &snapshot, bool skip);
+    };
+}
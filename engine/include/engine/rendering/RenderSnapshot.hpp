@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <variant>
+#include <vector>
+
+#include <renderer/common/Renderer.hpp>
+
+namespace N2Engine::Rendering
+{
+    /**
+     * One frame's renderer calls, recorded in order with everything they point at copied:
+     * view and projection, lighting, model matrices, draw lists and the material values each
+     * draw used. Resources the frame released are destroyed only after it has been drawn.
+     * Storage is kept when a snapshot is cleared, so recycled snapshots stop allocating once
+     * they have seen a full frame.
+     */
+    struct RenderSnapshot
+    {
+        using Clock = std::chrono::steady_clock;
+
+        struct ClearCommand
+        {
+            float r, g, b, a;
+        };
+
+        // matrices[first] is the view, matrices[first + 1] the projection
+        struct ViewProjectionCommand
+        {
+            uint32_t first;
+        };
+
+        struct LightingCommand
+        {
+            uint32_t index;
+        };
+
+        struct ShaderCommand
+        {
+            Renderer::Common::IShader *shader;
+        };
+
+        struct WireframeCommand
+        {
+            bool enabled;
+        };
+
+        static constexpr uint32_t NoMaterial = UINT32_MAX;
+
+        // A material as a draw saw it: its values are parameters[firstParameter, + parameterCount)
+        struct MaterialState
+        {
+            Renderer::Common::IMaterial *material;
+            Renderer::Common::ITexture *texture;
+            uint32_t firstParameter;
+            uint32_t parameterCount;
+        };
+
+        // One DrawMesh, or a DrawMeshInstanced, over count matrices from first; material indexes materials
+        struct DrawCommand
+        {
+            Renderer::Common::IMesh *mesh;
+            uint32_t material;
+            uint32_t first;
+            uint32_t count;
+            bool instanced;
+        };
+
+        // The objects' materials are materials[firstMaterial, + materialCount)
+        struct DrawObjectsCommand
+        {
+            uint32_t first;
+            uint32_t count;
+            uint32_t firstMaterial;
+            uint32_t materialCount;
+        };
+
+        struct BeginFrameCommand {};
+        struct EndFrameCommand {};
+
+        using Command = std::variant<ClearCommand, ViewProjectionCommand, LightingCommand, ShaderCommand,
+                                     WireframeCommand, DrawCommand, DrawObjectsCommand, BeginFrameCommand,
+                                     EndFrameCommand>;
+        using RetiredResource = std::variant<Renderer::Common::MeshHandle, Renderer::Common::MaterialHandle,
+                                             Renderer::Common::TextureHandle, Renderer::Common::ShaderHandle>;
+
+        struct Lighting
+        {
+            Renderer::Common::SceneLightingData data;
+            Math::Vector3 cameraPosition;
+        };
+
+        std::vector<Command> commands;
+        std::vector<std::array<float, 16>> matrices;
+        std::vector<Renderer::Common::RenderObject> objects;
+        std::vector<MaterialState> materials;
+        std::vector<Renderer::Common::MaterialParameter> parameters;
+        std::vector<Lighting> lighting;
+        std::vector<RetiredResource> retired;
+
+        uint64_t frame = 0;
+        // Set by the first recorded call, when simulation has finished the frame
+        Clock::time_point recordedAt{};
+        // Present was recorded: the frame is complete and goes to the screen
+        bool presented = false;
+
+        void Clear();
+
+        // Copies material's current values and texture; recorded draws point at the backend material instead
+        uint32_t RecordMaterial(const Renderer::Common::IMaterial &material, Renderer::Common::IMaterial *backend);
+
+        /**
+         * Issues the recorded calls to renderer, then Present when the frame was presented.
+         * With drawsToo false only the state changes are applied, for a frame that is skipped.
+         */
+        void Replay(Renderer::Common::IRenderer &renderer, bool drawsToo = true) const;
+        // Destroys the released resources; call once nothing recorded before them can still draw
+        void DestroyRetired(Renderer::Common::IRenderer &renderer);
+
+    private:
+        // Restores a recorded state into its backend material, which the render thread alone touches
+        Renderer::Common::IMaterial* ApplyMaterial(uint32_t index) const;
+    };
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+#include <renderer/common/Renderer.hpp>
+
+#include "engine/common/Color.hpp"
+
+namespace N2Engine::Rendering
+{
+    /**
+     * Reference-counted meshes and flat-color materials shared between renderables.
+     *
+     * Meshes are keyed by generator type and parameters (e.g. "Sphere 16x32"), so
+     * ten thousand cubes hold one IMesh instead of ten thousand copies. Materials
+     * are keyed by shader and color; renderables that share both a mesh and a
+     * material are drawn together by the scene's instance batching.
+     *
+     * Everything is per renderer. Each Acquire adds a reference; the resource is
+     * destroyed through its renderer when the last reference is released.
+     */
+    class SharedMeshRegistry
+    {
+    public:
+        using MeshFactory = std::function<Renderer::Common::MeshData()>;
+
+        static SharedMeshRegistry &Instance()
+        {
+            static SharedMeshRegistry instance;
+            return instance;
+        }
+
+        SharedMeshRegistry(const SharedMeshRegistry &) = delete;
+        SharedMeshRegistry &operator=(const SharedMeshRegistry &) = delete;
+
+        /**
+         * The mesh for this key, built with the factory only on first use.
+         */
+        Renderer::Common::IMesh *AcquireMesh(Renderer::Common::IRenderer *renderer, const std::string &key,
+                                             const MeshFactory &factory);
+        void ReleaseMesh(Renderer::Common::IRenderer *renderer, Renderer::Common::IMesh *mesh);
+
+        /**
+         * A material using the shader with uAlbedo set to the color. Callers must
+         * not change it; acquire another material to change color.
+         */
+        Renderer::Common::IMaterial *AcquireMaterial(Renderer::Common::IRenderer *renderer,
+                                                     Renderer::Common::IShader *shader, const Common::Color &color);
+        void ReleaseMaterial(Renderer::Common::IRenderer *renderer, Renderer::Common::IMaterial *material);
+
+        /**
+         * Drops every entry for a renderer that is shutting down, without
+         * destroying anything through it.
+         */
+        void Forget(Renderer::Common::IRenderer *renderer);
+
+        [[nodiscard]] size_t GetMeshCount() const { return _meshes.size(); }
+        [[nodiscard]] size_t GetMaterialCount() const { return _materials.size(); }
+        [[nodiscard]] size_t GetMeshReferences(const Renderer::Common::IMesh *mesh) const;
+
+    private:
+        SharedMeshRegistry() = default;
+
+        struct MeshKey
+        {
+            Renderer::Common::IRenderer *renderer;
+            std::string key;
+
+            bool operator==(const MeshKey &) const = default;
+        };
+
+        struct MaterialKey
+        {
+            Renderer::Common::IRenderer *renderer;
+            Renderer::Common::IShader *shader;
+            std::array<float, 4> color;
+
+            bool operator==(const MaterialKey &) const = default;
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(const MeshKey &key) const noexcept;
+            size_t operator()(const MaterialKey &key) const noexcept;
+        };
+
+        template <typename Key>
+        struct Entry
+        {
+            Key key;
+            size_t references;
+        };
+
+        std::unordered_map<MeshKey, Renderer::Common::IMesh*, KeyHash> _meshes;
+        std::unordered_map<const Renderer::Common::IMesh*, Entry<MeshKey>> _meshEntries;
+
+        std::unordered_map<MaterialKey, Renderer::Common::IMaterial*, KeyHash> _materials;
+        std::unordered_map<const Renderer::Common::IMaterial*, Entry<MaterialKey>> _materialEntries;
+    };
+}
@@ -1,16 +1,29 @@
 #pragma once
 
+#include <array>
 #include <string>
 #include <memory>
+#include <typeindex>
+#include <unordered_map>
 #include <vector>
 #include <initializer_list>
 #include <functional>
+#include <generator>
 #include <queue>
+#include <span>
 #include <nlohmann/json.hpp>
 
 #include <renderer/common/Renderer.hpp>
 #include "engine/ComponentConcepts.hpp"
+#include "engine/ComponentHooks.hpp"
+#include "engine/common/UUIDHash.hpp"
+#include "engine/sceneManagement/SceneCommandBuffer.hpp"
+#include "engine/sceneManagement/UpdateRaceDetector.hpp"
+#include "engine/ecs/EntityStore.hpp"
 #include "engine/rendering/Light.hpp"
+#include "engine/rendering/InstanceBatcher.hpp"
+#include "engine/rendering/BoundsBvh.hpp"
+#include "engine/spatial/SpatialIndex.hpp"
 #include "engine/base/Asset.hpp"
 
 namespace N2Engine
@@ -22,6 +35,8 @@ namespace N2Engine
 
     class Component;
     class GameObject;
+    class IRenderable;
+    class TransformHierarchy;
 
     class Scene : public Base::Asset
     {
@@ -29,11 +44,82 @@ namespace N2Engine
         friend class Application;
         friend class GameObject;
 
+    public:
+        // Counters of the last Render call
+        struct RenderStats
+        {
+            size_t submitted = 0;         // renderables drawn or batched
+            size_t culled = 0;            // renderables outside the frustum
+            size_t staticRenderables = 0; // renderables culled through the static hierarchy
+            size_t boundsTests = 0;       // frustum tests against renderable or hierarchy bounds
+        };
+
     private:
-        std::vector<std::shared_ptr<GameObject>> _rootGameObjects;
+        // RemoveRootGameObject leaves a null behind so later roots keep their order; the next read compacts
+        mutable std::vector<std::shared_ptr<GameObject>> _rootGameObjects;
+        mutable size_t _rootHoles = 0;
+        // Unordered: a removed component swaps the last one into its slot
         std::vector<Component*> _components;
-        std::queue<Component*> _attachQueue;
+
+        // Per hook, one densely packed list per component type that overrides it
+        struct ComponentHookList
+        {
+            std::type_index type;
+            ComponentHookRunner run;
+            const ComponentTypeHooks *hooks;
+            std::vector<Component*> components;
+            bool hasHoles = false;
+        };
+        std::array<std::vector<ComponentHookList>, ComponentHookCount> _hookLists;
+        // Removed components leave a null in the hook lists and type buckets, which keep their order;
+        // SweepComponentLists closes the holes after each update phase and destruction batch
+        bool _componentListsHaveHoles = false;
+        bool _runningParallelStage = false;
+
+        // Consecutive hook lists run together, serially or spread over the job system. Rebuilt when a list is added
+        struct ComponentHookStage
+        {
+            size_t firstList;
+            size_t listCount;
+            bool parallel;
+        };
+        std::array<std::vector<ComponentHookStage>, ComponentHookCount> _hookStages;
+        std::array<bool, ComponentHookCount> _hookStagesDirty{};
+        std::vector<size_t> _stageOffsets;
+
+        std::unique_ptr<SceneCommandBuffer> _commandBuffer;
+        // Null unless race detection is on
+        std::unique_ptr<UpdateRaceDetector> _raceDetector;
+
+        // Attached in order by ProcessAttachQueue; a component removed before that leaves a null
+        std::vector<Component*> _attachQueue;
         std::vector<Rendering::Light*> _sceneLights;
+        Rendering::InstanceBatcher _instanceBatcher;
+
+        Rendering::BoundsBvh _staticBvh;
+        std::vector<IRenderable*> _staticRenderables;
+        uint32_t _staticBuild = 0;
+        bool _staticRenderablesDirty = false;
+        RenderStats _renderStats;
+
+        // Declared after the roots so it lets go of their GameObjects before they are released
+        Spatial::SpatialIndex _spatialIndex;
+        // Held by pointer: Positionables point at it, and scenes move
+        std::unique_ptr<TransformHierarchy> _transforms;
+
+        ECS::EntityStore _entityStore;
+        std::unordered_map<const GameObject*, ECS::Entity> _gameObjectEntities;
+
+        // Lookup indices, kept current as GameObjects join, leave or are renamed and components attach or go
+        std::unordered_map<Math::UUID, GameObject*, UUIDHash> _gameObjectsByUuid;
+        std::unordered_map<std::string, std::vector<GameObject*>> _gameObjectsByName;
+        struct ComponentBucket
+        {
+            std::vector<Component*> components;
+            bool hasHoles = false;
+        };
+        std::unordered_map<std::type_index, ComponentBucket> _componentsByType;
+        uint64_t _nextAttachOrder = 0;
 
         std::unique_ptr<Scheduling::CoroutineScheduler> _coroutineScheduler;
 
@@ -63,37 +149,90 @@ namespace N2Engine
 
         bool RemoveRootGameObject(std::shared_ptr<GameObject> gameObject);
 
+        // During a parallel update stage the destroy is recorded into the SceneCommandBuffer instead
         bool DestroyGameObject(std::shared_ptr<GameObject> gameObject);
 
         [[nodiscard]] const std::vector<std::shared_ptr<GameObject>>& GetRootGameObjects() const
         {
+            CompactRoots();
             return _rootGameObjects;
         }
 
-        [[nodiscard]] size_t GetRootGameObjectCount() const { return _rootGameObjects.size(); }
+        [[nodiscard]] size_t GetRootGameObjectCount() const { return _rootGameObjects.size() - _rootHoles; }
+
+        /**
+         * Visits every GameObject depth first, parents before children, without recursion,
+         * reference counting or allocation once the per-thread stacks have grown. A visitor
+         * returning bool stops the walk by returning true. It must not add or remove GameObjects.
+         * @return true when the visitor stopped the walk
+         */
+        template <typename Visitor>
+        bool Traverse(Visitor &&visitor, bool onlyActive = false) const;
+
+        // The same walk as a lazy range, for loops that break or hand the sequence on
+        [[nodiscard]] std::generator<GameObject&> GameObjects(bool onlyActive = false) const;
 
+        // Wrappers over Traverse for callers holding shared_ptr visitors; each node costs a reference count
         void TraverseAll(std::function<void(std::shared_ptr<GameObject>)> callback) const;
         void TraverseAllActive(std::function<void(std::shared_ptr<GameObject>)> callback) const;
         bool TraverseUntil(std::function<bool(std::shared_ptr<GameObject>)> callback) const;
 
+        // Hash lookups over the scene's hierarchy; with several of the same name, any one of them
         [[nodiscard]] std::shared_ptr<GameObject> FindGameObject(const std::string &name) const;
+        [[nodiscard]] std::span<GameObject* const> FindGameObjectsByName(const std::string &name) const;
         [[nodiscard]] std::vector<std::shared_ptr<GameObject>> FindGameObjectsByTag(const std::string &tag) const;
         std::shared_ptr<GameObject> FindGameObjectByUUID(Math::UUID uuid);
 
         [[nodiscard]] std::vector<std::shared_ptr<GameObject>> GetAllGameObjects() const;
 
+        // Components of T or any type derived from it, in the order they attached
         template <DerivedFromComponent T>
         T* FindObjectByType(bool includeInactive = true) const;
         template <DerivedFromComponent T>
         std::vector<T*> FindObjectsByType(bool includeInactive = true) const;
 
+        // Opt-in archetype storage: plain-data entities plus GameObjects bridged into it
+        [[nodiscard]] ECS::EntityStore& GetEntityStore() { return _entityStore; }
+        ECS::Entity CreateEntity(GameObject &gameObject);
+        [[nodiscard]] ECS::Entity GetEntity(const GameObject &gameObject) const;
+
+        template <typename... Ts>
+        [[nodiscard]] ECS::EntityQuery<Ts...> Query() { return _entityStore.Query<Ts...>(); }
+
+        /**
+         * Draws every active renderable. With a frustum, renderables whose world bounds
+         * lie outside it are skipped, and static ones are looked up in a bounding volume
+         * hierarchy instead of being tested one by one.
+         */
+        void Render(Renderer::Common::IRenderer *renderer, const Frustum *frustum = nullptr);
+        [[nodiscard]] const RenderStats& GetRenderStats() const { return _renderStats; }
+
+        // Static renderables were added or toggled: rebuild their hierarchy before the next culled render
+        void InvalidateStaticRenderables() { _staticRenderablesDirty = true; }
+
+        // Proximity queries over positioned GameObjects; Refit brings it up to date with their transforms
+        [[nodiscard]] Spatial::SpatialIndex& GetSpatialIndex() { return _spatialIndex; }
+        [[nodiscard]] const Spatial::SpatialIndex& GetSpatialIndex() const { return _spatialIndex; }
+
+        // Local and world transforms of the positioned GameObjects in this scene
+        [[nodiscard]] TransformHierarchy& GetTransformHierarchy() const { return *_transforms; }
+
         [[nodiscard]] Renderer::Common::SceneLightingData CollectLighting() const;
         [[nodiscard]] Scheduling::CoroutineScheduler* GetCoroutineScheduler() const;
 
+        // For AddComponent, Destroy and SetParent from components updating on worker threads
+        [[nodiscard]] SceneCommandBuffer& GetCommandBuffer() const { return *_commandBuffer; }
+
+        // Checks the lookups of parallel update stages against the declared access sets; on by default in debug builds
+        void SetRaceDetection(bool enabled);
+        [[nodiscard]] bool IsRaceDetectionEnabled() const { return _raceDetector != nullptr; }
+        [[nodiscard]] std::span<const ComponentRace> GetDetectedRaces() const;
+
         void ProcessAttachQueue();
-        void Update() const;
-        void FixedUpdate() const;
-        void LateUpdate() const;
+        // Each phase plays the command buffer back once its components have all run
+        void Update();
+        void FixedUpdate();
+        void LateUpdate();
         void AdvanceCoroutines() const;
         void ProcessDestroyed();
         void OnApplicationQuit() const;
@@ -107,20 +246,59 @@ namespace N2Engine
         std::string GetResourceType() const override;
 
     private:
-        void Render(Renderer::Common::IRenderer *renderer);
-        void RenderRecursive(std::shared_ptr<GameObject> gameObject, Renderer::Common::IRenderer *renderer);
-        void TraverseGameObjectRecursive(std::shared_ptr<GameObject> gameObject,
-                                         std::function<void(std::shared_ptr<GameObject>)> callback,
-                                         bool onlyActive = false) const;
-        bool TraverseGameObjectUntil(std::shared_ptr<GameObject> gameObject,
-                                     std::function<bool(std::shared_ptr<GameObject>)> callback) const;
+        // Traversal stacks reused per thread; nested traversals each lease their own
+        class TraversalStack
+        {
+        public:
+            TraversalStack();
+            ~TraversalStack();
+            TraversalStack(const TraversalStack &) = delete;
+            TraversalStack& operator=(const TraversalStack &) = delete;
+
+            std::vector<GameObject*>& Get() const { return *_stack; }
+
+        private:
+            std::vector<GameObject*> *_stack;
+        };
+
+        void RenderHierarchy(Renderer::Common::IRenderer *renderer, const Frustum *frustum);
+        void DrawRenderable(IRenderable *renderable, Renderer::Common::IRenderer *renderer);
+        void RebuildStaticRenderables();
+        // Renderables may have left the scene: only matters when some are in the static hierarchy
+        void OnRenderablesRemoved();
         void AddComponentToAttachQueue(Component *component);
 
-        void OnAllActiveComponents(const std::function<void(Component *)> &callback) const;
+        void RegisterComponentHooks(Component *component);
+        void RemoveComponent(const GameObject &gameObject, Component *component);
+        // Takes component out of the attach queue, _components, the hook lists and its type bucket
+        void ReleaseComponentSlots(Component *component);
+
+        void RegisterGameObject(GameObject &gameObject);
+        void UnregisterGameObject(GameObject &gameObject);
+        void OnGameObjectRenamed(GameObject &gameObject, const std::string &oldName);
+        void IndexComponent(Component *component);
+        void UnindexComponent(Component *component);
+        // Calls visitor(T*) for attached components of type T, in attach order, until it returns true
+        template <DerivedFromComponent T>
+        void VisitObjectsOfType(bool includeInactive, auto &&visitor) const;
+        void RunComponentHook(ComponentHook hook) const;
+        // Runs a per-frame hook stage by stage, then applies the commands recorded meanwhile
+        void RunUpdatePhase(ComponentHook hook);
+        // Drops the null entries removed components left in the hook lists and type buckets
+        void SweepComponentLists();
+        void BuildHookStages(ComponentHook hook);
+        void RunParallelStage(ComponentHook hook, const ComponentHookStage &stage);
+
+        [[nodiscard]] bool IsRoot(const GameObject &gameObject) const;
+        void ReindexRoots(size_t first) const;
+        // Closes the holes RemoveRootGameObject left, in one pass however many there are
+        void CompactRoots() const;
 
-        void MarkHierarchyForDestruction(std::shared_ptr<GameObject> gameObject,
-                                         std::vector<std::shared_ptr<GameObject>> &markedObjects);
-        void CallOnDestroyForGameObject(std::shared_ptr<GameObject> gameObject);
-        void PurgeMarkedGameObject(std::shared_ptr<GameObject> gameObject);
+        // Appends root and its not yet collected descendants, parents before children
+        static void CollectForPurge(std::shared_ptr<GameObject> root, std::vector<std::shared_ptr<GameObject>> &doomed);
+        void CallOnDestroyForGameObject(GameObject &gameObject);
+        void DetachDestroyed(std::span<const std::shared_ptr<GameObject>> doomed);
+        void UnregisterDestroyed(std::span<const std::shared_ptr<GameObject>> doomed);
+        void RemoveDestroyedComponents(std::span<const std::shared_ptr<GameObject>> doomed);
     };
 }
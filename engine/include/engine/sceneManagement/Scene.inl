@@ -1,59 +1,149 @@
 #pragma once
 
+#include <algorithm>
+#include <type_traits>
+
 #include "engine/sceneManagement/Scene.hpp"
 
 namespace N2Engine
 {
-    template <DerivedFromComponent T>
-    T* Scene::FindObjectByType(const bool includeInactive) const
+    template <typename Visitor>
+    bool Scene::Traverse(Visitor &&visitor, const bool onlyActive) const
     {
-        if (_components.empty())
+        const TraversalStack lease;
+        std::vector<GameObject*> &pending = lease.Get();
+        for (auto it = _rootGameObjects.rbegin(); it != _rootGameObjects.rend(); ++it)
         {
-            return nullptr;
+            pending.push_back(it->get());
         }
 
-        for (const auto& component : _components)
+        while (!pending.empty())
         {
-            if (component == nullptr || component->IsDestroyed())
+            GameObject *gameObject = pending.back();
+            pending.pop_back();
+            if (!gameObject || (onlyActive && !gameObject->IsActiveInHierarchy()))
             {
                 continue;
             }
+
+            if constexpr (std::is_same_v<std::invoke_result_t<Visitor&, GameObject&>, bool>)
+            {
+                if (visitor(*gameObject))
+                {
+                    return true;
+                }
+            }
+            else
+            {
+                visitor(*gameObject);
+            }
+
+            // Pushed in reverse so the first child is visited next
+            const auto &children = gameObject->GetChildren();
+            for (auto it = children.rbegin(); it != children.rend(); ++it)
+            {
+                pending.push_back(it->get());
+            }
+        }
+        return false;
+    }
+
+    template <DerivedFromComponent T>
+    void Scene::VisitObjectsOfType(const bool includeInactive, auto &&visitor) const
+    {
+        const auto visit = [&](Component *component)
+        {
+            if (!component || component->IsDestroyed())
+            {
+                return false;
+            }
             if (!includeInactive && (!component->IsActive() || !component->GetGameObject().IsActiveInHierarchy()))
             {
-                continue;
+                return false;
             }
+            // Every component in a bucket has the bucket's exact type
+            return static_cast<bool>(visitor(static_cast<T*>(component)));
+        };
 
-            if (T* casted = dynamic_cast<T*>(component))
+        if constexpr (std::is_final_v<T>)
+        {
+            if (const auto it = _componentsByType.find(std::type_index(typeid(T))); it != _componentsByType.end())
             {
-                return casted;
+                for (Component *component : it->second.components)
+                {
+                    if (visit(component))
+                    {
+                        return;
+                    }
+                }
             }
         }
+        else
+        {
+            // One cast per concrete type decides whether its whole bucket derives from T
+            std::vector<std::pair<const std::vector<Component*>*, size_t>> cursors;
+            for (const auto &[type, bucket] : _componentsByType)
+            {
+                // Removed components leave nulls until the next sweep
+                const auto first = std::ranges::find_if(bucket.components, [](const Component *c) { return c != nullptr; });
+                if (first != bucket.components.end() && dynamic_cast<T*>(*first))
+                {
+                    cursors.emplace_back(&bucket.components, first - bucket.components.begin());
+                }
+            }
 
-        return nullptr;
+            // Each bucket is in attach order; merging them keeps that order whatever the map's
+            while (true)
+            {
+                Component *next = nullptr;
+                size_t *nextCursor = nullptr;
+                for (auto &[bucket, at] : cursors)
+                {
+                    while (at < bucket->size() && !(*bucket)[at])
+                    {
+                        ++at;
+                    }
+                    if (at < bucket->size() && (!next || (*bucket)[at]->_attachOrder < next->_attachOrder))
+                    {
+                        next = (*bucket)[at];
+                        nextCursor = &at;
+                    }
+                }
+                if (!next)
+                {
+                    return;
+                }
+                ++*nextCursor;
+                if (visit(next))
+                {
+                    return;
+                }
+            }
+        }
     }
 
     template <DerivedFromComponent T>
-    std::vector<T*> Scene::FindObjectsByType(const bool includeInactive) const
+    T* Scene::FindObjectByType(const bool includeInactive) const
     {
-        if (_components.empty())
+        T *found = nullptr;
+        VisitObjectsOfType<T>(includeInactive, [&found](T *component)
         {
-            return {};
-        }
+            found = component;
+            return true;
+        });
+        return found;
+    }
 
-        auto validComponents = _components
-            | std::views::filter([includeInactive](const auto& component) {
-                return component != nullptr
-                    && !component->IsDestroyed()
-                    && (includeInactive || (component->IsActive() && component->GetGameObject().IsActiveInHierarchy()));
-            })
-            | std::views::transform([](const auto& component) -> T* {
-                return dynamic_cast<T*>(component);
-            })
-            | std::views::filter([](const T* ptr) {
-                return ptr != nullptr;
-            });
-
-        return {validComponents.begin(), validComponents.end()};
+    template <DerivedFromComponent T>
+    std::vector<T*> Scene::FindObjectsByType(const bool includeInactive) const
+    {
+        std::vector<T*> found;
+        VisitObjectsOfType<T>(includeInactive, [&found](T *component)
+        {
+            found.push_back(component);
+            return false;
+        });
+        return found;
     }
 
     template <>
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "engine/ComponentConcepts.hpp"
+#include "engine/GameObject.hpp"
+
+namespace N2Engine
+{
+    /**
+     * Structural changes recorded while components update on worker threads, applied on the
+     * main thread once the phase is over. Recording is thread safe; commands run in the order
+     * they were recorded, which across worker threads is the order they reached the buffer.
+     * The GameObjects involved are kept alive until then.
+     */
+    class SceneCommandBuffer
+    {
+    public:
+        // configure, when given, runs on the new component right after it is added
+        template <DerivedFromComponent T>
+        void AddComponent(GameObject &gameObject, std::function<void(T&)> configure = {})
+        {
+            Record([target = gameObject.shared_from_this(), configure = std::move(configure)]
+            {
+                if (T *component = target->AddComponent<T>(); component && configure)
+                {
+                    configure(*component);
+                }
+            });
+        }
+
+        template <DerivedFromComponent T>
+        void RemoveComponent(GameObject &gameObject)
+        {
+            Record([target = gameObject.shared_from_this()] { target->RemoveComponent<T>(); });
+        }
+
+        void Destroy(GameObject &gameObject);
+        // A null parent makes the GameObject a root
+        void SetParent(GameObject &child, GameObject *parent, bool keepWorldPosition = true);
+
+        // Runs the recorded commands, then any they recorded themselves
+        void Playback();
+        [[nodiscard]] bool Empty() const;
+
+    private:
+        mutable std::mutex _mutex;
+        std::vector<std::function<void()>> _commands;
+        std::vector<std::function<void()>> _playing;
+
+        void Record(std::function<void()> command);
+    };
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <typeindex>
+#include <unordered_set>
+#include <vector>
+
+#include "engine/ComponentHooks.hpp"
+
+namespace N2Engine
+{
+    class Component;
+    class GameObject;
+
+    enum class ComponentRaceKind : uint8_t
+    {
+        Conflict,        // accessor wrote resource while other touched it on the same GameObject
+        Undeclared,      // accessor reached a type its ReadSet or WriteSet does not name
+        OtherGameObject  // accessor reached into a GameObject other than its own
+    };
+
+    struct ComponentRace
+    {
+        ComponentRaceKind kind;
+        const GameObject *gameObject; // the GameObject resource was looked up on
+        std::type_index resource;
+        std::type_index accessor;
+        std::type_index other;        // the second party of a Conflict; accessor otherwise
+        bool write;
+        ComponentHook hook;
+
+        bool operator==(const ComponentRace &) const = default;
+    };
+
+    /**
+     * Debug check of parallel update stages. While a component runs through Run, the lookups
+     * GameObject::GetComponent and GetPositionable make on its thread are recorded as accesses:
+     * GetComponent<const T> and GetPositionable read, any other lookup writes. At the end of the
+     * stage each access is checked against the sets the component's type declares, and a resource
+     * written by one component and touched by another on the same GameObject is a race.
+     * A ParallelSafe type may touch any type on its own GameObject, but no other GameObject.
+     */
+    class UpdateRaceDetector
+    {
+    public:
+        // Past this, new races are counted but not kept
+        static constexpr size_t MaxRaces = 256;
+
+        // Thread safe; workers run their share of a stage through it, one component at a time
+        void Run(std::span<Component *const> components, ComponentHookRunner run, const ComponentTypeHooks &hooks);
+        // Reports the races among the accesses recorded since the last call, each once
+        void EndStage(ComponentHook hook);
+
+        [[nodiscard]] std::span<const ComponentRace> GetRaces() const { return _races; }
+        [[nodiscard]] size_t GetDroppedRaceCount() const { return _droppedRaces; }
+
+        // Called by GameObject lookups; does nothing unless the calling thread is inside Run
+        static void RecordAccess(const GameObject &gameObject, const std::type_index &resource, const bool write)
+        {
+            if (s_recording)
+            {
+                Add(gameObject, resource, write);
+            }
+        }
+
+    private:
+        struct Access
+        {
+            const GameObject *gameObject;
+            std::type_index resource;
+            const Component *component;
+            const GameObject *owner;
+            const ComponentTypeHooks *hooks;
+            bool write;
+        };
+
+        // What the calling thread's component in Run has looked up so far
+        struct Recording
+        {
+            const Component *component = nullptr;
+            const GameObject *owner = nullptr;
+            const ComponentTypeHooks *hooks = nullptr;
+            std::vector<Access> accesses;
+        };
+
+        struct RaceHash
+        {
+            size_t operator()(const ComponentRace &race) const;
+        };
+
+        static inline thread_local Recording *s_recording = nullptr;
+
+        static void Add(const GameObject &gameObject, const std::type_index &resource, bool write);
+        void Report(const ComponentRace &race, const Component &accessor, const Component &other);
+
+        std::mutex _mutex;
+        std::vector<Access> _accesses;
+        std::vector<ComponentRace> _races;
+        std::unordered_set<ComponentRace, RaceHash> _knownRaces;
+        size_t _droppedRaces = 0;
+    };
+}
@@ -2,16 +2,23 @@
 
 #include <generator>
 #include <optional>
+#include <ranges>
 
 #include "engine/scheduling/CoroutineWait.hpp"
 
 namespace N2Engine::Scheduling
 {
+    class CoroutineScheduler;
+
     class Coroutine
     {
+        friend class CoroutineScheduler;
+
     private:
         bool _isComplete{false};
         std::generator<ICoroutineWait> _gen;
+        // Resumed in place: begin() only starts the generator, later steps advance this
+        std::optional<std::ranges::iterator_t<std::generator<ICoroutineWait>>> _it;
         std::optional<ICoroutineWait> _currentYield;
 
     public:
@@ -24,6 +31,7 @@ namespace N2Engine::Scheduling
 
         bool IsComplete() const;
 
+        // Runs to the next yield; false once the coroutine has finished
         bool MoveNext();
     };
-}
+}
\ No newline at end of file
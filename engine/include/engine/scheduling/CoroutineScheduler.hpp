@@ -1,4 +1,5 @@
 #pragma once
+#include <deque>
 #include <unordered_map>
 #include <vector>
 #include <memory>
@@ -11,15 +12,67 @@ namespace N2Engine
 
     namespace Scheduling
     {
+        /**
+         * Resumes each coroutine only on the frame its wait ends. Coroutines waiting on the frame
+         * count or the clock sit in min-heaps keyed by when they are due and cost nothing until then;
+         * only waits the scheduler cannot see through (WaitUntil, WaitWhile, custom types) are polled.
+         * Coroutines live in slots that are reused once they finish, and heap entries for stopped
+         * coroutines are skipped when they come due rather than searched for.
+         */
         class CoroutineScheduler
         {
         private:
-            std::unordered_map<GameObject*, std::vector<std::unique_ptr<Coroutine>>> _coroutines;
+            static constexpr uint32_t NoSlot = UINT32_MAX;
+
+            struct Slot
+            {
+                std::optional<Coroutine> coroutine;
+                GameObject *gameObject = nullptr;
+                // Bumped when the slot is freed, so tickets for the old coroutine go stale
+                uint32_t generation = 0;
+                // The other coroutines of the same GameObject
+                uint32_t prevOwned = NoSlot;
+                uint32_t nextOwned = NoSlot;
+            };
+
+            struct Ticket
+            {
+                uint32_t slot;
+                uint32_t generation;
+            };
+
+            struct Wakeup
+            {
+                double due;
+                // Start order among wakeups due at the same time
+                uint64_t sequence;
+                Ticket ticket;
+            };
+
+            // Never shrinks, so a Coroutine stays at its address for as long as it runs
+            std::deque<Slot> _slots;
+            std::vector<uint32_t> _freeSlots;
+            std::unordered_map<GameObject*, uint32_t> _firstOwned;
+
+            std::vector<Ticket> _ready;
+            std::vector<Ticket> _resuming;
+            std::vector<Ticket> _polling;
+            std::vector<Wakeup> _frameWakeups;
+            std::vector<Wakeup> _timeWakeups;
+
+            uint64_t _frame = 0;
+            double _time = 0.0;
+            uint64_t _sequence = 0;
+            size_t _liveCount = 0;
+            uint32_t _runningSlot = NoSlot;
+            bool _runningStopped = false;
             Scene *_scene;
 
         public:
             explicit CoroutineScheduler(Scene *scene);
+            // Advances by the scaled frame delta
             void Update();
+            void Update(double deltaSeconds);
 
             Coroutine* StartCoroutine(GameObject *gameObject, std::generator<ICoroutineWait> &&generator);
             bool StopCoroutine(GameObject *gameObject, Coroutine *coroutine);
@@ -31,10 +84,17 @@ namespace N2Engine
             static void StopAllCoroutines(const Scene *curScene, GameObject *gameObject);
             bool RemoveGameObject(GameObject *gameObject);
 
+            [[nodiscard]] size_t GetCoroutineCount() const { return _liveCount; }
+            // Coroutines checked every frame because their wait can only be polled
+            [[nodiscard]] size_t GetPolledCount() const { return _polling.size(); }
+
         private:
-            static bool AdvanceCoroutine(Coroutine *coroutine);
-            void CleanupCompleted(const std::vector<std::pair<GameObject*, Coroutine*>> &coroutinesToRemove);
-            void CleanupInvalid();
+            [[nodiscard]] bool IsLive(const Ticket &ticket) const;
+            void Resume(const Ticket &ticket);
+            void Park(uint32_t slot);
+            void WakeDue(std::vector<Wakeup> &wakeups, double now);
+            void PollWaits();
+            void Release(uint32_t slot);
         };
     }
-}
+}
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <concepts>
 #include <cstdint>
+#include <functional>
 #include <type_traits>
 #include <new>
 #include <cstddef>
@@ -10,20 +12,50 @@ namespace N2Engine
 {
     namespace Scheduling
     {
+        /**
+         * How the scheduler parks a coroutine until its wait is over. Waits it can work out from
+         * the frame count or the clock are resumed when due and never polled; anything else is
+         * polled through Wait() once a frame.
+         */
+        enum class CoroutineWaitKind
+        {
+            Poll,
+            NextFrame,
+            Frames,
+            Seconds,
+            Forever
+        };
+
+        struct CoroutineWaitSchedule
+        {
+            CoroutineWaitKind kind = CoroutineWaitKind::Poll;
+            // Frames or scaled seconds to wait, for those kinds
+            double amount = 0.0;
+        };
+
+        // Wait types that know up front how long they last
+        template <typename T>
+        concept ScheduledCoroutineWait = requires(const T &wait)
+        {
+            { wait.Schedule() } -> std::same_as<CoroutineWaitSchedule>;
+        };
+
         class ICoroutineWait
         {
         private:
-            static constexpr size_t STORAGE_SIZE = 32;
+            static constexpr size_t STORAGE_SIZE = 64;
             static constexpr size_t STORAGE_ALIGN = alignof(std::max_align_t);
 
             alignas(STORAGE_ALIGN) char _storage[STORAGE_SIZE];
-            bool (*_wait_fn)(const void *);
+            bool (*_wait_fn)(void *);
+            CoroutineWaitSchedule (*_schedule_fn)(const void *);
             void (*_destroy_fn)(void *);
             void (*_copy_fn)(void *, const void *);
             void (*_move_fn)(void *, void *);
 
         public:
             template <typename T>
+                requires (!std::same_as<std::decay_t<T>, ICoroutineWait>)
             ICoroutineWait(T &&wait_obj)
             {
                 using DecayedT = std::decay_t<T>;
@@ -32,9 +64,21 @@ namespace N2Engine
 
                 new (_storage) DecayedT(std::forward<T>(wait_obj));
 
-                _wait_fn = [](const void *ptr) -> bool
+                _wait_fn = [](void *ptr) -> bool
+                {
+                    return static_cast<DecayedT *>(ptr)->Wait();
+                };
+
+                _schedule_fn = [](const void *ptr) -> CoroutineWaitSchedule
                 {
-                    return static_cast<const DecayedT *>(ptr)->Wait();
+                    if constexpr (ScheduledCoroutineWait<DecayedT>)
+                    {
+                        return static_cast<const DecayedT *>(ptr)->Schedule();
+                    }
+                    else
+                    {
+                        return {};
+                    }
                 };
 
                 _destroy_fn = [](void *ptr)
@@ -54,13 +98,13 @@ namespace N2Engine
             }
 
             ICoroutineWait(const ICoroutineWait &other)
-                : _wait_fn(other._wait_fn), _destroy_fn(other._destroy_fn), _copy_fn(other._copy_fn), _move_fn(other._move_fn)
+                : _wait_fn(other._wait_fn), _schedule_fn(other._schedule_fn), _destroy_fn(other._destroy_fn), _copy_fn(other._copy_fn), _move_fn(other._move_fn)
             {
                 _copy_fn(_storage, other._storage);
             }
 
             ICoroutineWait(ICoroutineWait &&other) noexcept
-                : _wait_fn(other._wait_fn), _destroy_fn(other._destroy_fn), _copy_fn(other._copy_fn), _move_fn(other._move_fn)
+                : _wait_fn(other._wait_fn), _schedule_fn(other._schedule_fn), _destroy_fn(other._destroy_fn), _copy_fn(other._copy_fn), _move_fn(other._move_fn)
             {
                 _move_fn(_storage, other._storage);
             }
@@ -71,6 +115,7 @@ namespace N2Engine
                 {
                     _destroy_fn(_storage);
                     _wait_fn = other._wait_fn;
+                    _schedule_fn = other._schedule_fn;
                     _destroy_fn = other._destroy_fn;
                     _copy_fn = other._copy_fn;
                     _move_fn = other._move_fn;
@@ -85,6 +130,7 @@ namespace N2Engine
                 {
                     _destroy_fn(_storage);
                     _wait_fn = other._wait_fn;
+                    _schedule_fn = other._schedule_fn;
                     _destroy_fn = other._destroy_fn;
                     _copy_fn = other._copy_fn;
                     _move_fn = other._move_fn;
@@ -102,12 +148,18 @@ namespace N2Engine
             {
                 return _wait_fn(_storage);
             }
+
+            [[nodiscard]] CoroutineWaitSchedule Schedule() const
+            {
+                return _schedule_fn(_storage);
+            }
         };
 
         class WaitForNextFrame
         {
         public:
             bool Wait();
+            [[nodiscard]] CoroutineWaitSchedule Schedule() const;
         };
 
         class WaitForFrames
@@ -119,6 +171,7 @@ namespace N2Engine
         public:
             explicit WaitForFrames(uint32_t frames) : _waitFrames{frames} {}
             bool Wait();
+            [[nodiscard]] CoroutineWaitSchedule Schedule() const;
         };
 
         class WaitForSeconds
@@ -130,12 +183,36 @@ namespace N2Engine
         public:
             explicit WaitForSeconds(float seconds) : _waitSeconds{seconds} {}
             bool Wait();
+            [[nodiscard]] CoroutineWaitSchedule Schedule() const;
         };
 
         class WaitForever
         {
         public:
             bool Wait();
+            [[nodiscard]] CoroutineWaitSchedule Schedule() const;
+        };
+
+        // Resumes on the first frame the predicate returns true; checked once a frame
+        class WaitUntil
+        {
+        private:
+            std::function<bool()> _predicate;
+
+        public:
+            explicit WaitUntil(std::function<bool()> predicate) : _predicate{std::move(predicate)} {}
+            bool Wait();
+        };
+
+        // Resumes on the first frame the predicate returns false; checked once a frame
+        class WaitWhile
+        {
+        private:
+            std::function<bool()> _predicate;
+
+        public:
+            explicit WaitWhile(std::function<bool()> predicate) : _predicate{std::move(predicate)} {}
+            bool Wait();
         };
     }
 }
\ No newline at end of file
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace N2Engine::Scheduling
+{
+    using Job = std::move_only_function<void()>;
+
+    /**
+     * Counts submitted jobs that have not finished yet. Jobs submitted after it
+     * are queued once it drops to zero. Must not be destroyed while it still counts jobs.
+     */
+    class JobCounter
+    {
+        friend class JobSystem;
+
+    public:
+        JobCounter() = default;
+        ~JobCounter();
+
+        JobCounter(const JobCounter &) = delete;
+        JobCounter &operator=(const JobCounter &) = delete;
+
+        [[nodiscard]] bool IsDone() const { return _pending.load(std::memory_order_acquire) == 0; }
+
+    private:
+        std::atomic<uint32_t> _pending{0};
+        // Held across every decrement, so a waiter can tell when the last finisher let go
+        std::mutex _mutex;
+        std::vector<std::pair<Job, JobCounter*>> _continuations;
+    };
+
+    struct JobSystemStats
+    {
+        unsigned threadCount = 0;
+        uint64_t executed = 0;
+        uint64_t stolen = 0;
+    };
+
+    /**
+     * Engine-wide worker threads, each with its own deque: a thread pushes and pops its
+     * own jobs at the back and, when it runs dry, steals the oldest job from another.
+     * The thread that initialized it owns the first deque; other threads outside the pool
+     * share it. Waiting runs jobs on the waiting thread instead of blocking it, so with
+     * no workers everything still completes, on the caller.
+     */
+    class JobSystem
+    {
+    public:
+        // ParallelFor never cuts work into more pieces than this per thread
+        static constexpr size_t MaxPiecesPerThread = 4;
+
+        static JobSystem &Instance();
+
+        JobSystem(const JobSystem &) = delete;
+        JobSystem &operator=(const JobSystem &) = delete;
+
+        // Threads running jobs, the calling thread included; 0 = one per hardware thread. Restarts a running pool.
+        void Initialize(unsigned threadCount = 0);
+        // Runs whatever is still queued, then joins the workers
+        void Shutdown();
+
+        // Worker threads plus the calling thread
+        [[nodiscard]] unsigned GetThreadCount() const { return static_cast<unsigned>(_workers.size()) + 1; }
+        [[nodiscard]] JobSystemStats GetStats() const;
+        // Whether the calling thread is one of this pool's workers rather than the thread that started it
+        [[nodiscard]] bool IsWorkerThread() const;
+
+        // counter, when given, counts the job until it has run
+        void Submit(Job job, JobCounter *counter = nullptr);
+        // Queued once after reaches zero, or now if it already has
+        void SubmitAfter(JobCounter &after, Job job, JobCounter *counter = nullptr);
+        // Runs queued jobs on this thread until counter reaches zero
+        void Wait(JobCounter &counter);
+
+        /**
+         * Calls fn(begin, end) over consecutive ranges covering [0, count), at least grain
+         * long except the last, concurrently, and returns when every range is done.
+         * The calling thread takes the first range.
+         */
+        template <typename F>
+        void ParallelFor(size_t count, size_t grain, F &&fn);
+
+        // fn(item) for every item, items split as ParallelFor splits their indices
+        template <typename T, typename F>
+        void ParallelForEach(std::span<T> items, size_t grain, F &&fn);
+
+    private:
+        struct QueuedJob
+        {
+            Job work;
+            JobCounter *counter;
+        };
+
+        struct alignas(64) WorkerQueue
+        {
+            std::mutex mutex;
+            std::deque<QueuedJob> jobs;
+        };
+
+        std::vector<std::unique_ptr<WorkerQueue>> _queues;
+        std::vector<std::thread> _workers;
+        // Jobs sitting in any queue; sleepers wake when it rises
+        std::atomic<size_t> _queued{0};
+        std::atomic<unsigned> _sleeping{0};
+        std::mutex _sleepMutex;
+        std::condition_variable _wake;
+        bool _running = false;
+        std::atomic<uint64_t> _executed{0};
+        std::atomic<uint64_t> _stolen{0};
+
+        JobSystem();
+
+        void Enqueue(QueuedJob job);
+        // Runs one job from queue home, or one stolen from another queue
+        bool RunOne(size_t home);
+        void Finish(JobCounter *counter);
+        void WorkerLoop(size_t queue);
+        [[nodiscard]] size_t CurrentQueue() const;
+    };
+
+    template <typename F>
+    void JobSystem::ParallelFor(const size_t count, const size_t grain, F &&fn)
+    {
+        const size_t minPiece = std::max<size_t>(grain, 1);
+        const size_t pieces = std::min((count + minPiece - 1) / minPiece, MaxPiecesPerThread * GetThreadCount());
+        if (pieces <= 1 || _workers.empty())
+        {
+            if (count > 0)
+            {
+                fn(size_t{0}, count);
+            }
+            return;
+        }
+
+        const size_t pieceSize = (count + pieces - 1) / pieces;
+        JobCounter counter;
+        for (size_t begin = pieceSize; begin < count; begin += pieceSize)
+        {
+            Submit([&fn, begin, end = std::min(begin + pieceSize, count)] { fn(begin, end); }, &counter);
+        }
+        fn(size_t{0}, pieceSize);
+        Wait(counter);
+    }
+
+    template <typename T, typename F>
+    void JobSystem::ParallelForEach(const std::span<T> items, const size_t grain, F &&fn)
+    {
+        ParallelFor(items.size(), grain, [items, &fn](const size_t begin, const size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                fn(items[i]);
+            }
+        });
+    }
+}
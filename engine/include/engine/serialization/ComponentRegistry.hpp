@@ -5,6 +5,8 @@
 #include <unordered_map>
 #include <functional>
 
+#include "engine/ComponentHooks.hpp"
+
 namespace N2Engine
 {
     class Component;
@@ -92,6 +94,7 @@ namespace N2Engine
     public:
         explicit ComponentRegistrar(const std::string &typeName)
         {
+            ComponentHookRegistry::Instance().Register<T>();
             ComponentRegistry::Instance().Register(
                 typeName,
                 [](GameObject &go) -> std::unique_ptr<Component>
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "engine/Camera.hpp"
+
+namespace N2Engine::Spatial
+{
+    /**
+     * Bounding volume tree over boxes that move. Each proxy stores a box fattened
+     * by a margin and by its predicted motion, so small moves leave the tree
+     * untouched; larger ones reinsert a single leaf. Insertion picks the sibling
+     * with the smallest added surface area and rotations keep the tree balanced.
+     */
+    class DynamicAabbTree
+    {
+    public:
+        static constexpr int32_t NullNode = -1;
+
+        explicit DynamicAabbTree(float margin = 0.1f);
+
+        // Returns a proxy id that stays valid until destroyed
+        int32_t CreateProxy(const BoundingBox &box, uint32_t userData);
+        void DestroyProxy(int32_t proxy);
+
+        /**
+         * Updates a proxy to hold box, fattened along displacement.
+         * @return true when the leaf was reinserted, false when its fat box still fit
+         */
+        bool MoveProxy(int32_t proxy, const BoundingBox &box, const Math::Vector3 &displacement);
+
+        [[nodiscard]] const BoundingBox& GetFatBounds(const int32_t proxy) const { return _nodes[proxy].box; }
+        [[nodiscard]] uint32_t GetUserData(const int32_t proxy) const { return _nodes[proxy].userData; }
+        void SetUserData(const int32_t proxy, const uint32_t userData) { _nodes[proxy].userData = userData; }
+
+        void Clear();
+
+        /**
+         * Calls fn(proxy) for every leaf whose fat box passes overlaps(box); overlaps
+         * is also applied to inner nodes to prune subtrees. fn returns false to stop.
+         * @return the number of boxes tested
+         */
+        template <typename Overlaps, typename Fn>
+        size_t Query(Overlaps &&overlaps, Fn &&fn) const;
+
+        /**
+         * Visits leaves in increasing distance of their fat box from point. fn(proxy)
+         * returns the squared distance beyond which nothing else is wanted, so
+         * subtrees further away than that are never opened.
+         */
+        template <typename Fn>
+        void QueryNearest(const Math::Vector3 &point, Fn &&fn) const;
+
+        [[nodiscard]] size_t GetProxyCount() const { return _proxyCount; }
+        [[nodiscard]] int32_t GetHeight() const { return _root == NullNode ? 0 : _nodes[_root].height; }
+
+        static float DistanceSquared(const BoundingBox &box, const Math::Vector3 &point);
+
+    private:
+        // Balanced trees stay far below this: height grows with log2 of the proxy count
+        static constexpr size_t MaxStack = 256;
+
+        struct Node
+        {
+            BoundingBox box;
+            uint32_t userData = 0;
+            int32_t parent = NullNode; // next free node while on the free list
+            int32_t child1 = NullNode;
+            int32_t child2 = NullNode;
+            int32_t height = -1;       // 0 for leaves, -1 for free nodes
+
+            [[nodiscard]] bool IsLeaf() const { return child1 == NullNode; }
+        };
+
+        int32_t AllocateNode();
+        void FreeNode(int32_t node);
+        void InsertLeaf(int32_t leaf);
+        void RemoveLeaf(int32_t leaf);
+        int32_t Balance(int32_t node);
+        void RefitAncestors(int32_t node);
+        BoundingBox Fatten(const BoundingBox &box, const Math::Vector3 &displacement) const;
+
+        std::vector<Node> _nodes;
+        int32_t _root = NullNode;
+        int32_t _freeList = NullNode;
+        size_t _proxyCount = 0;
+        float _margin;
+    };
+
+    template <typename Overlaps, typename Fn>
+    size_t DynamicAabbTree::Query(Overlaps &&overlaps, Fn &&fn) const
+    {
+        if (_root == NullNode)
+        {
+            return 0;
+        }
+
+        size_t tests = 0;
+        int32_t stack[MaxStack];
+        size_t top = 0;
+        stack[top++] = _root;
+        while (top > 0)
+        {
+            const Node &node = _nodes[stack[--top]];
+            ++tests;
+            if (!overlaps(node.box))
+            {
+                continue;
+            }
+            if (node.IsLeaf())
+            {
+                if (!fn(static_cast<int32_t>(&node - _nodes.data())))
+                {
+                    break;
+                }
+                continue;
+            }
+            stack[top++] = node.child1;
+            stack[top++] = node.child2;
+        }
+        return tests;
+    }
+
+    template <typename Fn>
+    void DynamicAabbTree::QueryNearest(const Math::Vector3 &point, Fn &&fn) const
+    {
+        if (_root == NullNode)
+        {
+            return;
+        }
+
+        // Best-first walk over a min-heap of nodes keyed by squared box distance
+        struct Pending
+        {
+            float distance;
+            int32_t node;
+        };
+        std::vector<Pending> heap;
+        heap.reserve(MaxStack);
+        const auto later = [](const Pending &a, const Pending &b) { return a.distance > b.distance; };
+
+        float limit = std::numeric_limits<float>::max();
+        heap.push_back({DistanceSquared(_nodes[_root].box, point), _root});
+        while (!heap.empty())
+        {
+            std::pop_heap(heap.begin(), heap.end(), later);
+            const Pending next = heap.back();
+            heap.pop_back();
+            if (next.distance > limit)
+            {
+                break;
+            }
+
+            const Node &node = _nodes[next.node];
+            if (node.IsLeaf())
+            {
+                limit = fn(next.node);
+                continue;
+            }
+            for (const int32_t child : {node.child1, node.child2})
+            {
+                if (const float distance = DistanceSquared(_nodes[child].box, point); distance <= limit)
+                {
+                    heap.push_back({distance, child});
+                    std::push_heap(heap.begin(), heap.end(), later);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "engine/Camera.hpp"
+#include "engine/spatial/DynamicAabbTree.hpp"
+
+namespace N2Engine
+{
+    class GameObject;
+}
+
+namespace N2Engine::Spatial
+{
+    /**
+     * Scene-owned proximity index of every positioned GameObject. Objects join
+     * when they enter the scene with a Positionable and leave with it; Refit moves
+     * the ones whose world transform changed since the last call. An object's box
+     * is its first renderable's world bounds, or its world position otherwise.
+     * Queries report inactive objects too, as TraverseAll does.
+     */
+    class SpatialIndex
+    {
+    public:
+        struct RayHit
+        {
+            GameObject *gameObject;
+            float distance; // along the normalized ray to the entry point of the box
+        };
+
+        SpatialIndex() = default;
+        ~SpatialIndex();
+
+        SpatialIndex(SpatialIndex &&other) noexcept;
+        SpatialIndex& operator=(SpatialIndex &&other) noexcept;
+        SpatialIndex(const SpatialIndex &) = delete;
+        SpatialIndex& operator=(const SpatialIndex &) = delete;
+
+        void Insert(GameObject &gameObject);
+        void Remove(GameObject &gameObject);
+        void Clear();
+
+        // Brings boxes up to date with the world transforms, returning how many leaves were reinserted
+        size_t Refit();
+
+        // Each query appends to out; boxes are tested exactly, not just their fattened leaves
+        void QueryBox(const BoundingBox &box, std::vector<GameObject*> &out) const;
+        void QuerySphere(const Math::Vector3 &center, float radius, std::vector<GameObject*> &out) const;
+        // Hits sorted by distance, nearest first
+        void QueryRay(const Math::Vector3 &origin, const Math::Vector3 &direction, float maxDistance,
+                      std::vector<RayHit> &out) const;
+        // Up to k objects sorted by the distance from point to their box, nearest first
+        void QueryNearest(const Math::Vector3 &point, size_t k, std::vector<GameObject*> &out) const;
+
+        [[nodiscard]] size_t GetCount() const { return _entries.size(); }
+        [[nodiscard]] const DynamicAabbTree& GetTree() const { return _tree; }
+
+    private:
+        struct Entry
+        {
+            GameObject *gameObject;
+            int32_t proxy;
+            uint32_t worldVersion;
+            BoundingBox bounds;
+        };
+
+        static BoundingBox ComputeBounds(GameObject &gameObject);
+        void ReleaseAll();
+
+        DynamicAabbTree _tree;
+        std::vector<Entry> _entries; // userData of each proxy is its entry index
+    };
+}
@@ -1,3 +1,4 @@
+#include <format>
 #include <string>
 #include <memory>
 
@@ -5,10 +6,13 @@
 
 #include "engine/Application.hpp"
 #include "engine/Time.hpp"
+#include "engine/TransformHierarchy.hpp"
 #include "engine/Logger.hpp"
 #include "engine/common/ScriptUtils.hpp"
+#include "engine/memory/ObjectPool.hpp"
 #include "engine/sceneManagement/Scene.hpp"
 #include "engine/physics/physx/PhysXBackend.hpp"
+#include "engine/scheduling/JobSystem.hpp"
 #include "engine/scripting/LuaRuntime.hpp"
 
 using namespace N2Engine;
@@ -51,6 +55,7 @@ void Application::Init(const Config::ApplicationOptions &options)
 #endif
     Scripting::LuaRuntime::Instance().Initialize();
     Math::InitializeSIMD();
+    Scheduling::JobSystem::Instance().Initialize(options.jobThreads);
     Time::Init();
     _window.InitWindow(options);
 
@@ -83,6 +88,7 @@ void Application::Init(const Config::ApplicationOptions &options)
     {
         Logger::Error(NAMEOF(options.physicsBackend) + " is not currently supported");
     }
+    _frameLoop.SetPhysicsBackend(_3DphysicsBackend.get());
 
     Logger::Info("3D Physics backend initialized");
 }
@@ -99,7 +105,6 @@ void Application::Init(std::unique_ptr<Scene> &&initialScene)
 
 void Application::Run()
 {
-    double fixedTimestepAccumulator = 0.0;
     // Initialize last frame time for accumulator
     double lastTime = Time::GetUnscaledTime();
 
@@ -112,31 +117,34 @@ void Application::Run()
         const double frameTime = now - lastTime;
         lastTime = now;
 
-        fixedTimestepAccumulator += frameTime;
-        if (SceneManager::GetCurSceneIndex() != -1)
-        {
-            Scene &curScene = SceneManager::GetCurSceneRef();
-            curScene.ProcessAttachQueue();
-
-            while (fixedTimestepAccumulator >= Time::GetFixedUnscaledDeltaTime())
-            {
-                PhysicsUpdate(curScene);
-                fixedTimestepAccumulator -= Time::GetFixedUnscaledDeltaTime();
-            }
-            curScene.Update();
-            curScene.AdvanceCoroutines();
-            curScene.LateUpdate();
-        }
-        Render();
-        if (SceneManager::GetCurSceneIndex() != -1)
+        _frameLoop.RunFrame(SceneManager::GetCurScene(), frameTime, [this] { Render(); });
+        SceneManager::ProcessAnyPendingSceneChange();
+        if (_quitRequested)
         {
-            Scene &curScene = SceneManager::GetCurSceneRef();
-            curScene.ProcessDestroyed();
+            Exit();
         }
-        SceneManager::ProcessAnyPendingSceneChange();
     }
 }
 
+SimulationStats Application::Simulate(const uint64_t ticks)
+{
+    // Scene changes apply between ticks, as they do between frames
+    const SimulationStats stats = _frameLoop.Simulate(ticks, []
+    {
+        SceneManager::ProcessAnyPendingSceneChange();
+        return SceneManager::GetCurScene();
+    });
+    SceneManager::ProcessAnyPendingSceneChange();
+    return stats;
+}
+
+bool Application::Step()
+{
+    const bool running = _frameLoop.Step(SceneManager::GetCurScene());
+    SceneManager::ProcessAnyPendingSceneChange();
+    return running;
+}
+
 void Application::Render()
 {
     auto *renderer = _window.GetRenderer();
@@ -154,7 +162,8 @@ void Application::Render()
         const Renderer::Common::SceneLightingData sceneLightingData = curScene.CollectLighting();
         renderer->UpdateSceneLighting(sceneLightingData, _mainCamera->GetPosition());
 
-        curScene.Render(renderer);
+        const Frustum frustum = _mainCamera->GetViewFrustum();
+        curScene.Render(renderer, &frustum);
     }
 
     renderer->EndFrame();
@@ -162,12 +171,34 @@ void Application::Render()
 }
 
 void Application::Quit()
+{
+    // A server running many simulations keeps going; Step reports the stop after this tick
+    if (FrameLoop::StopStepping())
+    {
+        return;
+    }
+    Application &app = GetInstance();
+    if (Scheduling::JobSystem::Instance().IsWorkerThread())
+    {
+        app._quitRequested = true;
+        return;
+    }
+    app.Exit();
+}
+
+void Application::Exit()
 {
     if (SceneManager::GetCurSceneIndex() != -1)
     {
         const Scene &curScene = SceneManager::GetCurSceneRef();
         curScene.OnApplicationQuit();
     }
+    Scheduling::JobSystem::Instance().Shutdown();
+    Memory::ObjectPools::Instance().LogStats();
+    if (const Rendering::PipelinedRenderer *framePipeline = _window.GetFramePipeline())
+    {
+        framePipeline->LogStats();
+    }
     std::exit(0);
 }
 
@@ -186,25 +217,6 @@ void Application::OnWindowResize(const int width, const int height) const
     }
 }
 
-void Application::PhysicsUpdate(const Scene &scene) const
-{
-    if (_3DphysicsBackend)
-    {
-        _3DphysicsBackend->ApplyPendingChanges();
-        scene.FixedUpdate();
-        _3DphysicsBackend->Update(Time::GetFixedDeltaTime());
-
-        // Sync physics results back to GameObjects
-        _3DphysicsBackend->SyncTransforms();
-        // notify collision events
-        _3DphysicsBackend->ProcessCollisionCallbacks();
-    }
-    else
-    {
-        scene.FixedUpdate();
-    }
-}
-
 Physics::IPhysicsBackend* Application::Get3DPhysicsBackend() const
 {
     return _3DphysicsBackend.get();
@@ -40,6 +40,31 @@ Math::Vector3 BoundingBox::GetCorner(int index) const
         (index & 4) ? max.z : min.z};
 }
 
+BoundingBox BoundingBox::Transformed(const Matrix4 &matrix) const
+{
+    // Each world extent is the local extents weighted by the absolute linear part
+    const Math::Vector3 center = GetCenter();
+    const Math::Vector3 extents = GetExtents();
+    float worldCenter[3];
+    float worldExtents[3];
+    for (int row = 0; row < 3; ++row)
+    {
+        worldCenter[row] = matrix(row, 0) * center.x + matrix(row, 1) * center.y + matrix(row, 2) * center.z + matrix(row, 3);
+        worldExtents[row] = std::abs(matrix(row, 0)) * extents.x + std::abs(matrix(row, 1)) * extents.y +
+                            std::abs(matrix(row, 2)) * extents.z;
+    }
+    return BoundingBox{
+        Math::Vector3{worldCenter[0] - worldExtents[0], worldCenter[1] - worldExtents[1], worldCenter[2] - worldExtents[2]},
+        Math::Vector3{worldCenter[0] + worldExtents[0], worldCenter[1] + worldExtents[1], worldCenter[2] + worldExtents[2]}};
+}
+
+BoundingBox BoundingBox::Merged(const BoundingBox &other) const
+{
+    return BoundingBox{
+        Math::Vector3{std::min(min.x, other.min.x), std::min(min.y, other.min.y), std::min(min.z, other.min.z)},
+        Math::Vector3{std::max(max.x, other.max.x), std::max(max.y, other.max.y), std::max(max.z, other.max.z)}};
+}
+
 bool Frustum::IsVisible(const BoundingBox &bbox) const
 {
     for (int i = 0; i < 6; i++)
@@ -52,6 +77,23 @@ bool Frustum::IsVisible(const BoundingBox &bbox) const
     return true;
 }
 
+bool Frustum::Contains(const BoundingBox &bbox) const
+{
+    for (const auto &plane : planes)
+    {
+        // The vertex furthest against the plane normal must be inside too
+        const Math::Vector3 negativeVertex{
+            (plane.x > 0) ? bbox.min.x : bbox.max.x,
+            (plane.y > 0) ? bbox.min.y : bbox.max.y,
+            (plane.z > 0) ? bbox.min.z : bbox.max.z};
+        if (negativeVertex.x * plane.x + negativeVertex.y * plane.y + negativeVertex.z * plane.z + plane.w < 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 void Camera::SetPosition(const Math::Vector3 &position)
 {
     _position = position;
@@ -0,0 +1,109 @@
+#include <chrono>
+#include <format>
+
+#include "engine/FrameLoop.hpp"
+#include "engine/Time.hpp"
+#include "engine/TransformHierarchy.hpp"
+#include "engine/Logger.hpp"
+#include "engine/physics/IPhysicsBackend.hpp"
+#include "engine/sceneManagement/Scene.hpp"
+
+using namespace N2Engine;
+
+void FrameLoop::RunFrame(Scene *scene, const double frameTime, const std::function<void()> &draw)
+{
+    _fixedTimestepAccumulator += frameTime;
+    if (scene)
+    {
+        scene->ProcessAttachQueue();
+
+        // Against the double step, not the float getter, so a frame of exactly one step runs exactly one
+        while (_fixedTimestepAccumulator >= Time::fixedUnscaledDeltaTime)
+        {
+            PhysicsUpdate(*scene);
+            _fixedTimestepAccumulator -= Time::fixedUnscaledDeltaTime;
+        }
+        scene->Update();
+        scene->AdvanceCoroutines();
+        scene->LateUpdate();
+    }
+    if (scene)
+    {
+        scene->GetTransformHierarchy().UpdateWorldTransforms();
+        // Proximity queries next frame see where objects ended this one
+        scene->GetSpatialIndex().Refit();
+    }
+    if (draw)
+    {
+        draw();
+    }
+    if (scene)
+    {
+        scene->ProcessDestroyed();
+    }
+}
+
+bool FrameLoop::Step(Scene *scene)
+{
+    _stopped = false;
+    s_stepping = this;
+    Time::Advance(Time::fixedUnscaledDeltaTime);
+    RunFrame(scene, Time::fixedUnscaledDeltaTime);
+    s_stepping = nullptr;
+    return !_stopped;
+}
+
+SimulationStats FrameLoop::Simulate(const uint64_t ticks, const std::function<Scene*()> &currentScene)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const double startTime = Time::unscaledTime;
+
+    SimulationStats stats;
+    while (stats.ticks < ticks)
+    {
+        ++stats.ticks;
+        if (!Step(currentScene()))
+        {
+            break;
+        }
+    }
+
+    // Run resumes from now rather than counting the simulation as one long frame
+    Time::lastFrameTime = std::chrono::high_resolution_clock::now();
+    stats.simulatedSeconds = Time::unscaledTime - startTime;
+    stats.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    stats.ticksPerSecond = stats.wallSeconds > 0.0 ? static_cast<double>(stats.ticks) / stats.wallSeconds : 0.0;
+    Logger::Info(std::format("Simulated {} ticks ({:.2f} s) in {:.3f} s: {:.0f} ticks/s",
+                             stats.ticks, stats.simulatedSeconds, stats.wallSeconds, stats.ticksPerSecond));
+    return stats;
+}
+
+bool FrameLoop::StopStepping()
+{
+    FrameLoop *loop = s_stepping.load();
+    if (!loop)
+    {
+        return false;
+    }
+    loop->_stopped = true;
+    return true;
+}
+
+void FrameLoop::PhysicsUpdate(Scene &scene) const
+{
+    if (_physics)
+    {
+        _physics->ApplyPendingChanges();
+        scene.FixedUpdate();
+        _physics->Update(Time::GetFixedDeltaTime());
+
+        // Sync physics results back to GameObjects
+        _physics->SyncTransforms();
+        // notify collision events
+        _physics->ProcessCollisionCallbacks();
+    }
+    else
+    {
+        scene.FixedUpdate();
+    }
+}
@@ -0,0 +1,46 @@
+#include "engine/IRenderable.hpp"
+#include "engine/GameObjectScene.hpp"
+#include "engine/Positionable.hpp"
+
+using namespace N2Engine;
+
+bool IRenderable::GetWorldBounds(BoundingBox &bounds)
+{
+    const Positionable *positionable = GetGameObject().GetPositionable();
+    if (!positionable)
+    {
+        return false;
+    }
+
+    const uint32_t version = positionable->GetWorldVersion();
+    BoundingBox local;
+    const bool hasLocalBounds = GetLocalBounds(local);
+    if (!_worldBoundsValid || version != _worldVersion || hasLocalBounds != _hasWorldBounds ||
+        !(local == _localBounds))
+    {
+        if (hasLocalBounds)
+        {
+            _worldBounds = local.Transformed(positionable->GetLocalToWorldMatrix());
+        }
+        _localBounds = local;
+        _worldVersion = version;
+        _hasWorldBounds = hasLocalBounds;
+        _worldBoundsValid = true;
+    }
+
+    bounds = _worldBounds;
+    return _hasWorldBounds;
+}
+
+void IRenderable::SetStatic(const bool isStatic)
+{
+    if (_isStatic == isStatic)
+    {
+        return;
+    }
+    _isStatic = isStatic;
+    if (Scene *scene = GetGameObject().GetScene())
+    {
+        scene->InvalidateStaticRenderables();
+    }
+}
@@ -11,65 +11,74 @@
 using namespace N2Engine;
 using namespace N2Engine::Math;
 
+namespace
+{
+    TransformHierarchy &HierarchyOf(const GameObject &gameObject)
+    {
+        Scene *scene = gameObject.GetScene();
+        return scene ? scene->GetTransformHierarchy() : TransformHierarchy::Detached();
+    }
+}
+
 Positionable::Positionable(GameObject &gameObject)
-    : _gameObject(gameObject)
+    : _hierarchy(&HierarchyOf(gameObject)), _node(_hierarchy->CreateNode(this)), _gameObject(gameObject)
+{
+    if (const Positionable *parent = GetParentPositionable(); parent && parent->_hierarchy == _hierarchy)
+    {
+        _hierarchy->SetParent(_node, parent->_node);
+    }
+}
+
+Positionable::~Positionable()
+{
+    _hierarchy->DestroyNode(_node);
+}
+
+Transform &Positionable::EditLocalTransform()
 {
-    // Initialize with identity transform
-    _localTransform = Transform::Identity();
+    return _hierarchy->EditLocal(_node);
 }
 
 void Positionable::SetLocalPosition(const Math::Vector3 &position)
 {
-    if (_localTransform.GetPosition() != position)
+    if (Transform &local = EditLocalTransform(); local.GetPosition() != position)
     {
-        _localTransform.SetPosition(position);
+        local.SetPosition(position);
         MarkGlobalTransformDirty();
     }
 }
 
 void Positionable::SetLocalRotation(const Math::Quaternion &rotation)
 {
-    if (_localTransform.GetRotation() != rotation)
+    if (Transform &local = EditLocalTransform(); local.GetRotation() != rotation)
     {
-        _localTransform.SetRotation(rotation);
+        local.SetRotation(rotation);
         MarkGlobalTransformDirty();
     }
 }
 
 void Positionable::SetLocalScale(const Math::Vector3 &scale)
 {
-    if (_localTransform.GetScale() != scale)
+    if (Transform &local = EditLocalTransform(); local.GetScale() != scale)
     {
-        _localTransform.SetScale(scale);
+        local.SetScale(scale);
         MarkGlobalTransformDirty();
     }
 }
 
 Vector3 Positionable::GetPosition() const
 {
-    if (_globalTransformDirty)
-    {
-        UpdateGlobalTransform();
-    }
-    return _cachedGlobalTransform.GetPosition();
+    return GetGlobalTransform().GetPosition();
 }
 
 Quaternion Positionable::GetRotation() const
 {
-    if (_globalTransformDirty)
-    {
-        UpdateGlobalTransform();
-    }
-    return _cachedGlobalTransform.GetRotation();
+    return GetGlobalTransform().GetRotation();
 }
 
 Vector3 Positionable::GetScale() const
 {
-    if (_globalTransformDirty)
-    {
-        UpdateGlobalTransform();
-    }
-    return _cachedGlobalTransform.GetScale();
+    return GetGlobalTransform().GetScale();
 }
 
 void Positionable::SetPosition(const Math::Vector3 &position)
@@ -125,14 +134,15 @@ void Positionable::SetScale(const Math::Vector3 &scale)
 void Positionable::SetLocalPositionAndRotation(const Math::Vector3 &position, const Math::Quaternion &rotation)
 {
     bool changed = false;
-    if (_localTransform.GetPosition() != position)
+    Transform &local = EditLocalTransform();
+    if (local.GetPosition() != position)
     {
-        _localTransform.SetPosition(position);
+        local.SetPosition(position);
         changed = true;
     }
-    if (_localTransform.GetRotation() != rotation)
+    if (local.GetRotation() != rotation)
     {
-        _localTransform.SetRotation(rotation);
+        local.SetRotation(rotation);
         changed = true;
     }
 
@@ -204,69 +214,33 @@ void Positionable::SetPositionAndRotation(const Math::Vector3 &position, const M
 
 void Positionable::SetLocalTransform(const Transform &transform)
 {
-    if (_localTransform != transform)
+    if (Transform &local = EditLocalTransform(); local != transform)
     {
-        _localTransform = transform;
+        local = transform;
         MarkGlobalTransformDirty();
     }
 }
 
 const Transform &Positionable::GetLocalTransform() const
 {
-    return _localTransform;
+    return _hierarchy->GetLocal(_node);
 }
 
 const Transform &Positionable::GetGlobalTransform() const
 {
-    if (_globalTransformDirty)
-    {
-        UpdateGlobalTransform();
-    }
-    return _cachedGlobalTransform;
+    return _hierarchy->GetWorld(_node);
 }
 
 void Positionable::MarkGlobalTransformDirty() const
 {
-    if (!_globalTransformDirty)
-    {
-        NotifyPhysicsComponents();
-        _globalTransformDirty = true;
-        _hierarchyVersion++;
-        MarkChildrenGlobalTransformDirty();
-    }
-}
-
-void Positionable::MarkChildrenGlobalTransformDirty() const
-{
-    for (const auto &child : _gameObject.GetChildren())
-    {
-        if (auto childPositionable = child->GetPositionable())
-        {
-            childPositionable->MarkGlobalTransformDirty();
-        }
-    }
-}
+    TransformHierarchy &hierarchy = *_hierarchy;
+    hierarchy.MarkDirty(_node);
 
-void Positionable::UpdateGlobalTransform() const
-{
-    _cachedGlobalTransform = CalculateGlobalTransform();
-    _globalTransformDirty = false;
-    _globalTransformValid = true;
-    _cachedHierarchyVersion = _hierarchyVersion;
-}
-
-Transform Positionable::CalculateGlobalTransform() const
-{
-    if (auto parentPositionable = GetParentPositionable())
+    // Bodies follow their transform immediately; resolving the subtree notifies every
+    // bound node in it. Bound descendants of unbound nodes are notified on the next pass.
+    if (hierarchy.IsPhysicsBound(_node))
     {
-        // Combine parent's global transform with our local transform
-        const Transform &parentGlobal = parentPositionable->GetGlobalTransform();
-        return Transform::Combine(parentGlobal, _localTransform);
-    }
-    else
-    {
-        // No parent, so local transform IS the global transform
-        return _localTransform;
+        hierarchy.GetWorld(_node);
     }
 }
 
@@ -284,6 +258,13 @@ Positionable::Matrix4 Positionable::GetLocalToWorldMatrix() const
     return GetGlobalTransform().GetMatrix();
 }
 
+uint32_t Positionable::GetWorldVersion() const
+{
+    TransformHierarchy &hierarchy = *_hierarchy;
+    hierarchy.GetWorld(_node);
+    return hierarchy.GetWorldVersion(_node);
+}
+
 Positionable::Matrix4 Positionable::GetWorldToLocalMatrix() const
 {
     return GetLocalToWorldMatrix().inverse();
@@ -315,12 +296,32 @@ Vector3 Positionable::InverseTransformDirection(const Math::Vector3 &direction)
 
 void Positionable::OnHierarchyChanged() const
 {
+    // A parent in another scene's hierarchy is linked once this object follows it there
+    const Positionable *parent = GetParentPositionable();
+    const bool linked = parent && parent->_hierarchy == _hierarchy;
+    _hierarchy->SetParent(_node, linked ? parent->_node : TransformHierarchy::InvalidNode);
     MarkGlobalTransformDirty();
 }
 
+void Positionable::OnSceneChanged()
+{
+    TransformHierarchy &hierarchy = HierarchyOf(_gameObject);
+    if (&hierarchy == _hierarchy)
+    {
+        return;
+    }
+    hierarchy.Adopt(*_hierarchy, _node);
+    OnHierarchyChanged();
+}
+
+void Positionable::MarkPhysicsBound() const
+{
+    _hierarchy->MarkPhysicsBound(_node);
+}
+
 bool Positionable::IsGlobalTransformDirty() const
 {
-    return _globalTransformDirty;
+    return _hierarchy->IsWorldDirty(_node);
 }
 
 using json = nlohmann::json;
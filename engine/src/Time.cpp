@@ -71,9 +71,14 @@ void Time::Update()
     const double frameTime = std::chrono::duration<double>(currentTime - lastFrameTime).count();
     lastFrameTime = currentTime;
 
-    unscaledDeltaTime = frameTime;
-    scaledDeltaTime = frameTime * timeScale;
+    Advance(frameTime);
+}
+
+void Time::Advance(const double unscaledDelta)
+{
+    unscaledDeltaTime = unscaledDelta;
+    scaledDeltaTime = unscaledDelta * timeScale;
 
-    unscaledTime += frameTime;
+    unscaledTime += unscaledDelta;
     time += scaledDeltaTime;
 }
@@ -0,0 +1,464 @@
+#include <algorithm>
+#include <cassert>
+
+#include "engine/TransformHierarchy.hpp"
+#include "engine/Positionable.hpp"
+#include "engine/scheduling/JobSystem.hpp"
+
+using namespace N2Engine;
+
+namespace
+{
+    // Below this many nodes per piece a pass is cheaper than handing it to another thread
+    constexpr size_t MinNodesPerThread = 4096;
+}
+
+TransformHierarchy &TransformHierarchy::Detached()
+{
+    // Never destroyed: GameObjects held by statics release their nodes during exit
+    static auto *detached = new TransformHierarchy();
+    return *detached;
+}
+
+TransformHierarchy::NodeIndex TransformHierarchy::CreateNode(Positionable *owner)
+{
+    CheckWritable();
+    const auto node = static_cast<NodeIndex>(_owners.size());
+    _locals.push_back(Transform::Identity());
+    _worlds.push_back(Transform::Identity());
+    _parents.push_back(InvalidNode);
+    _subtreeSizes.push_back(1);
+    _dirty.push_back(1);
+    _recomputed.push_back(0);
+    _worldVersions.push_back(0);
+    _resolvedAt.push_back(UINT64_MAX);
+    _physicsBound.push_back(0);
+    _owners.push_back(owner);
+    _hasDirty = true;
+    return node;
+}
+
+void TransformHierarchy::DestroyNode(NodeIndex node)
+{
+    CheckWritable();
+    // Children stay in place as roots; the next reorder drops the dead slot
+    if (!_ordered)
+    {
+        const Positionable *owner = _owners[node];
+        Rebuild();
+        node = owner->_node;
+    }
+
+    const NodeIndex last = node + _subtreeSizes[node];
+    for (NodeIndex child = node + 1; child < last; ++child)
+    {
+        if (_parents[child] == node)
+        {
+            _parents[child] = InvalidNode;
+            MarkDirty(child);
+        }
+    }
+
+    _owners[node] = nullptr;
+    _parents[node] = InvalidNode;
+    _dirty[node] = 0;
+    _physicsBound[node] = 0;
+    ++_deadCount;
+    _slack += _subtreeSizes[node];
+    if (_deadCount + _slack > _owners.size() / 2)
+    {
+        _ordered = false;
+    }
+}
+
+void TransformHierarchy::Adopt(TransformHierarchy &from, const NodeIndex node)
+{
+    Positionable *owner = from._owners[node];
+    const NodeIndex adopted = CreateNode(owner);
+    _locals[adopted] = from._locals[node];
+    _physicsBound[adopted] = from._physicsBound[node];
+    // Recomputing the new node bumps this, so version checks still see a change
+    _worldVersions[adopted] = from._worldVersions[node];
+    from.DestroyNode(node);
+    owner->_node = adopted;
+    owner->_hierarchy = this;
+}
+
+void TransformHierarchy::MoveNodesTo(TransformHierarchy &to)
+{
+    CheckWritable();
+    // In pre-order every parent has moved before its children, which append to its range
+    Rebuild();
+    const auto count = static_cast<NodeIndex>(_owners.size());
+    std::vector<NodeIndex> moved(count);
+    for (NodeIndex node = 0; node < count; ++node)
+    {
+        Positionable *owner = _owners[node];
+        moved[node] = to.CreateNode(owner);
+        to._locals[moved[node]] = _locals[node];
+        to._physicsBound[moved[node]] = _physicsBound[node];
+        to._worldVersions[moved[node]] = _worldVersions[node];
+        if (_parents[node] != InvalidNode)
+        {
+            to.SetParent(moved[node], moved[_parents[node]]);
+        }
+        owner->_node = moved[node];
+        owner->_hierarchy = &to;
+    }
+
+    _locals.clear();
+    _worlds.clear();
+    _parents.clear();
+    _subtreeSizes.clear();
+    _dirty.clear();
+    _recomputed.clear();
+    _worldVersions.clear();
+    _resolvedAt.clear();
+    _physicsBound.clear();
+    _owners.clear();
+    _hasDirty = false;
+}
+
+void TransformHierarchy::SetParent(const NodeIndex node, const NodeIndex parent)
+{
+    CheckWritable();
+    const NodeIndex oldParent = _parents[node];
+    if (oldParent == parent)
+    {
+        return;
+    }
+    MarkDirty(node);
+
+    if (_ordered && parent == InvalidNode)
+    {
+        // Detached in place: the old ancestors' ranges still cover it, which is harmless
+        _slack += _subtreeSizes[node];
+    }
+    else if (_ordered && oldParent == InvalidNode && parent < node && parent + _subtreeSizes[parent] == node)
+    {
+        // The subtree already follows the new parent's range: grow every range ending there
+        const uint32_t size = _subtreeSizes[node];
+        for (NodeIndex ancestor = parent; ancestor != InvalidNode; ancestor = _parents[ancestor])
+        {
+            if (ancestor + _subtreeSizes[ancestor] == node)
+            {
+                _subtreeSizes[ancestor] += size;
+            }
+        }
+    }
+    else
+    {
+        _ordered = false;
+    }
+    _parents[node] = parent;
+}
+
+void TransformHierarchy::MarkDirty(const NodeIndex node)
+{
+    CheckWritable();
+    _dirty[node] = 1;
+    _hasDirty = true;
+    ++_changes;
+}
+
+bool TransformHierarchy::IsWorldDirty(const NodeIndex node) const
+{
+    for (NodeIndex current = node; current != InvalidNode; current = _parents[current])
+    {
+        if (_dirty[current])
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+const Transform &TransformHierarchy::GetWorld(const NodeIndex node)
+{
+    if (_parallelReads)
+    {
+        assert(!IsWorldDirty(node) && "World transform read after a change during a parallel update stage");
+        return _worlds[node];
+    }
+
+    NodeIndex topmostDirty = InvalidNode;
+    for (NodeIndex current = node; current != InvalidNode; current = _parents[current])
+    {
+        if (_dirty[current])
+        {
+            topmostDirty = current;
+        }
+    }
+    if (topmostDirty == InvalidNode)
+    {
+        return _worlds[node];
+    }
+    CheckWritable();
+
+    if (!_ordered)
+    {
+        // Physics bound nodes must leave clean so their owners are notified exactly once
+        if (!_physicsBound[node])
+        {
+            return ResolveChain(node);
+        }
+        const Positionable *owner = _owners[node];
+        Rebuild();
+        return GetWorld(owner->_node);
+    }
+
+    std::vector<Positionable*> notify;
+    RecomputeRange(topmostDirty, topmostDirty + _subtreeSizes[topmostDirty], notify);
+    if (notify.empty())
+    {
+        return _worlds[node];
+    }
+    // Physics callbacks may read other transforms, so look the node up again afterwards
+    const Positionable *owner = _owners[node];
+    Notify(notify);
+    return _worlds[owner->_node];
+}
+
+size_t TransformHierarchy::UpdateWorldTransforms(unsigned threadCount)
+{
+    CheckWritable();
+    if (!_hasDirty)
+    {
+        return 0;
+    }
+    if (!_ordered || _slack > 0)
+    {
+        Rebuild();
+    }
+
+    Scheduling::JobSystem &jobs = Scheduling::JobSystem::Instance();
+    const auto count = static_cast<NodeIndex>(_owners.size());
+    if (threadCount == 0)
+    {
+        threadCount = static_cast<unsigned>(std::clamp<size_t>(count / MinNodesPerThread, 1, jobs.GetThreadCount()));
+    }
+
+    std::vector<std::vector<Positionable*>> notify(threadCount);
+    if (threadCount <= 1)
+    {
+        RecomputeRange(0, count, notify[0]);
+    }
+    else
+    {
+        // Split at top-level subtree boundaries so no thread reads another's output
+        std::vector<NodeIndex> bounds{0};
+        const size_t target = (count + threadCount - 1) / threadCount;
+        for (NodeIndex root = 0; root < count; root += _subtreeSizes[root])
+        {
+            if (root - bounds.back() >= target)
+            {
+                bounds.push_back(root);
+            }
+        }
+        bounds.push_back(count);
+
+        jobs.ParallelFor(bounds.size() - 1, 1, [&](const size_t begin, const size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                RecomputeRange(bounds[i], bounds[i + 1], notify[i]);
+            }
+        });
+    }
+
+    _hasDirty = false;
+    size_t notified = 0;
+    for (const auto &list : notify)
+    {
+        Notify(list);
+        notified += list.size();
+    }
+    return notified;
+}
+
+void TransformHierarchy::BeginParallelReads()
+{
+    UpdateWorldTransforms();
+    _parallelReads = true;
+}
+
+void TransformHierarchy::EndParallelReads()
+{
+    _parallelReads = false;
+}
+
+void TransformHierarchy::RecomputeRange(const NodeIndex first, const NodeIndex last, std::vector<Positionable*> &notify)
+{
+    for (NodeIndex node = first; node < last; ++node)
+    {
+        _recomputed[node] = 0;
+        if (!_owners[node])
+        {
+            continue;
+        }
+
+        // The first node's parent is clean; later ones outside the range may not be
+        const NodeIndex parent = _parents[node];
+        if (parent != InvalidNode && parent < first && node != first)
+        {
+            continue;
+        }
+        if (!_dirty[node] && (parent == InvalidNode || !_recomputed[parent]))
+        {
+            continue;
+        }
+
+        _worlds[node] = parent == InvalidNode ? _locals[node] : Transform::Combine(_worlds[parent], _locals[node]);
+        _worlds[node].BuildMatrix();
+        ++_worldVersions[node];
+        _dirty[node] = 0;
+        _recomputed[node] = 1;
+        if (_physicsBound[node])
+        {
+            notify.push_back(_owners[node]);
+        }
+    }
+}
+
+const Transform &TransformHierarchy::ResolveChain(const NodeIndex node)
+{
+    // Nothing was marked dirty since the last resolve: reading again is not a new version
+    if (_resolvedAt[node] == _changes)
+    {
+        return _worlds[node];
+    }
+
+    // Out of order: combine down the parent chain without clearing any flag
+    _chain.clear();
+    for (NodeIndex current = node; current != InvalidNode; current = _parents[current])
+    {
+        _chain.push_back(current);
+    }
+
+    Transform world = _locals[_chain.back()];
+    for (auto it = _chain.rbegin() + 1; it != _chain.rend(); ++it)
+    {
+        world = Transform::Combine(world, _locals[*it]);
+    }
+    _worlds[node] = world;
+    ++_worldVersions[node];
+    _resolvedAt[node] = _changes;
+    return _worlds[node];
+}
+
+void TransformHierarchy::Rebuild()
+{
+    // Counting sort of live nodes by parent, then an iterative pre-order walk
+    const auto count = static_cast<NodeIndex>(_owners.size());
+    std::vector<uint32_t> childStart(count + 1, 0);
+    std::vector<NodeIndex> roots;
+    for (NodeIndex node = 0; node < count; ++node)
+    {
+        if (!_owners[node])
+        {
+            continue;
+        }
+        if (_parents[node] == InvalidNode)
+        {
+            roots.push_back(node);
+        }
+        else
+        {
+            ++childStart[_parents[node] + 1];
+        }
+    }
+    for (NodeIndex node = 0; node < count; ++node)
+    {
+        childStart[node + 1] += childStart[node];
+    }
+    std::vector<NodeIndex> children(childStart[count]);
+    std::vector<uint32_t> fill(childStart.begin(), childStart.end() - 1);
+    for (NodeIndex node = 0; node < count; ++node)
+    {
+        if (_owners[node] && _parents[node] != InvalidNode)
+        {
+            children[fill[_parents[node]]++] = node;
+        }
+    }
+
+    std::vector<NodeIndex> order;
+    order.reserve(count - _deadCount);
+    std::vector<NodeIndex> stack;
+    for (const NodeIndex root : roots)
+    {
+        stack.push_back(root);
+        while (!stack.empty())
+        {
+            const NodeIndex node = stack.back();
+            stack.pop_back();
+            order.push_back(node);
+            for (uint32_t i = childStart[node + 1]; i-- > childStart[node];)
+            {
+                stack.push_back(children[i]);
+            }
+        }
+    }
+
+    std::vector<NodeIndex> newIndex(count, InvalidNode);
+    for (NodeIndex i = 0; i < order.size(); ++i)
+    {
+        newIndex[order[i]] = i;
+    }
+
+    const auto liveCount = static_cast<NodeIndex>(order.size());
+    std::vector<Transform> locals(liveCount), worlds(liveCount);
+    std::vector<NodeIndex> parents(liveCount);
+    std::vector<uint32_t> subtreeSizes(liveCount, 1);
+    std::vector<uint8_t> dirty(liveCount), physicsBound(liveCount);
+    std::vector<uint32_t> worldVersions(liveCount);
+    std::vector<uint64_t> resolvedAt(liveCount);
+    std::vector<Positionable*> owners(liveCount);
+    for (NodeIndex i = 0; i < liveCount; ++i)
+    {
+        const NodeIndex old = order[i];
+        locals[i] = std::move(_locals[old]);
+        worlds[i] = std::move(_worlds[old]);
+        parents[i] = _parents[old] == InvalidNode ? InvalidNode : newIndex[_parents[old]];
+        dirty[i] = _dirty[old];
+        worldVersions[i] = _worldVersions[old];
+        resolvedAt[i] = _resolvedAt[old];
+        physicsBound[i] = _physicsBound[old];
+        owners[i] = _owners[old];
+        owners[i]->_node = i;
+    }
+    for (NodeIndex i = liveCount; i-- > 0;)
+    {
+        if (parents[i] != InvalidNode)
+        {
+            subtreeSizes[parents[i]] += subtreeSizes[i];
+        }
+    }
+
+    _locals = std::move(locals);
+    _worlds = std::move(worlds);
+    _parents = std::move(parents);
+    _subtreeSizes = std::move(subtreeSizes);
+    _dirty = std::move(dirty);
+    _worldVersions = std::move(worldVersions);
+    _resolvedAt = std::move(resolvedAt);
+    _physicsBound = std::move(physicsBound);
+    _owners = std::move(owners);
+    _recomputed.assign(liveCount, 0);
+    _deadCount = 0;
+    _slack = 0;
+    _ordered = true;
+}
+
+void TransformHierarchy::CheckWritable() const
+{
+    assert(!_parallelReads && "Transforms cannot change during a parallel update stage");
+    assert(!Scheduling::JobSystem::Instance().IsWorkerThread() && "Transforms change only on the thread running the scene");
+}
+
+void TransformHierarchy::Notify(const std::vector<Positionable*> &notify) const
+{
+    for (const Positionable *positionable : notify)
+    {
+        positionable->NotifyPhysicsComponents();
+    }
+}
@@ -7,6 +7,7 @@
 #include "engine/input/InputSystem.hpp"
 #include "engine/input/ActionMap.hpp"
 #include "engine/input/InputBinding.hpp"
+#include "engine/rendering/SharedMeshRegistry.hpp"
 
 using namespace N2Engine;
 
@@ -22,6 +23,21 @@ Window::~Window() = default;
 
 void Window::InitWindow(const Config::ApplicationOptions &options)
 {
+    if (options.simulationOnly)
+    {
+        // Input still exists so components polling it read no input rather than crash
+        windowData.width = static_cast<int>(options.headlessWidth);
+        windowData.height = static_cast<int>(options.headlessHeight);
+        _inputSystem = std::make_unique<Input::InputSystem>(*this);
+        Logger::Log("Simulation only: no window or renderer", Logger::LogLevel::Info);
+        return;
+    }
+    if (options.isHeadless && options.renderBackend == Config::ApplicationOptions::RenderBackend::SOFTWARE)
+    {
+        InitHeadless(options);
+        return;
+    }
+
     if (!glfwInit())
     {
         Logger::Log("Failed to initialize GLFW", Logger::LogLevel::Error);
@@ -81,7 +97,9 @@ void Window::InitWindow(const Config::ApplicationOptions &options)
     }
     else if (options.renderBackend == Config::ApplicationOptions::RenderBackend::SOFTWARE)
     {
-        _renderer = std::make_unique<Renderer::Software::SoftwareRenderer>();
+        auto softwareRenderer = std::make_unique<Renderer::Software::SoftwareRenderer>();
+        softwareRenderer->SetRasterThreadCount(options.softwareRasterThreads);
+        _renderer = std::move(softwareRenderer);
         Logger::Log("Using Software renderer", Logger::LogLevel::Info);
     }
     else
@@ -98,12 +116,55 @@ void Window::InitWindow(const Config::ApplicationOptions &options)
         glfwTerminate();
         return;
     }
+    StartFramePipeline(options);
+
+    _inputSystem = std::make_unique<Input::InputSystem>(*this);
+}
+
+void Window::InitHeadless(const Config::ApplicationOptions &options)
+{
+    // No GLFW at all: the software renderer draws into its CPU framebuffer,
+    // so this runs on machines without a display.
+    windowData.width = static_cast<int>(options.headlessWidth);
+    windowData.height = static_cast<int>(options.headlessHeight);
+
+    auto softwareRenderer = std::make_unique<Renderer::Software::SoftwareRenderer>();
+    softwareRenderer->SetRasterThreadCount(options.softwareRasterThreads);
+    if (!softwareRenderer->Initialize(nullptr, options.headlessWidth, options.headlessHeight))
+    {
+        Logger::Log("Failed to initialize renderer", Logger::LogLevel::Error);
+        return;
+    }
+    _renderer = std::move(softwareRenderer);
+    Logger::Log("Using headless Software renderer", Logger::LogLevel::Info);
+    StartFramePipeline(options);
 
     _inputSystem = std::make_unique<Input::InputSystem>(*this);
 }
 
+void Window::StartFramePipeline(const Config::ApplicationOptions &options)
+{
+    if (options.framePipelineDepth <= 1)
+    {
+        return;
+    }
+    // GL contexts belong to one thread at a time, so the render thread takes this one over.
+    // Vulkan and the headless framebuffer have no context to move.
+    GLFWwindow *contextWindow = options.renderBackend == Config::ApplicationOptions::RenderBackend::VULKAN ? nullptr : _window;
+    auto pipeline = std::make_unique<Rendering::PipelinedRenderer>(
+        std::move(_renderer), contextWindow, options.framePipelineDepth, options.dropLateFrames);
+    _framePipeline = pipeline.get();
+    _renderer = std::move(pipeline);
+    Logger::Log("Rendering on a separate thread, " + std::to_string(_framePipeline->GetDepth()) + " frames in flight",
+                Logger::LogLevel::Info);
+}
+
 Vector2i Window::GetWindowDimensions() const
 {
+    if (!_window)
+    {
+        return {windowData.width, windowData.height};
+    }
     int width, height;
     glfwGetWindowSize(_window, &width, &height);
     return {width, height};
@@ -126,16 +187,25 @@ Input::InputSystem *Window::GetInputSystem() const
 
 void Window::PollEvents()
 {
-    glfwPollEvents();
-    _inputSystem->Update();
+    if (_window)
+    {
+        glfwPollEvents();
+    }
+    if (_inputSystem)
+    {
+        _inputSystem->Update();
+    }
 }
 
 void Window::Shutdown()
 {
     if (_renderer)
     {
+        // Shutdown frees every resource; shared meshes must not outlive it
+        Rendering::SharedMeshRegistry::Instance().Forget(_renderer.get());
         _renderer->Shutdown();
         _renderer.reset();
+        _framePipeline = nullptr;
     }
     if (_window)
     {
@@ -147,9 +217,22 @@ void Window::Shutdown()
 
 bool Window::ShouldClose() const
 {
+    if (!_window)
+    {
+        return _closeRequested;
+    }
     return glfwWindowShouldClose(_window);
 }
 
+void Window::RequestClose()
+{
+    _closeRequested = true;
+    if (_window)
+    {
+        glfwSetWindowShouldClose(_window, GLFW_TRUE);
+    }
+}
+
 void Window::SetTitle(const std::string &title)
 {
     _title = title;
@@ -180,7 +263,7 @@ void Window::OnWindowResize(int width, int height)
 
 void Window::SetWindowMode(WindowMode windowMode)
 {
-    if (_windowMode == windowMode)
+    if (_windowMode == windowMode || !_window)
     {
         return;
     }
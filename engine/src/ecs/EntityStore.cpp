@@ -0,0 +1,390 @@
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+
+#include "engine/ecs/EntityStore.hpp"
+
+#include "engine/GameObject.hpp"
+#include "engine/Positionable.hpp"
+
+using namespace N2Engine::ECS;
+
+namespace
+{
+    struct TypeTable
+    {
+        std::mutex mutex;
+        std::vector<ComponentTypeInfo> types;
+        std::unordered_map<std::type_index, ComponentTypeId> ids;
+    };
+
+    TypeTable &GetTypeTable()
+    {
+        static TypeTable table;
+        return table;
+    }
+
+    uint32_t AlignUp(const uint32_t value, const uint32_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    // Rows a fresh archetype starts its chunks with when it holds no columns at all
+    constexpr uint32_t EmptyChunkCapacity = ChunkBytes / sizeof(Entity);
+}
+
+ComponentTypeId ComponentTypes::Register(const std::type_index type, const uint32_t size, const uint32_t alignment,
+                                         const bool bridged)
+{
+    TypeTable &table = GetTypeTable();
+    std::lock_guard lock(table.mutex);
+    if (const auto it = table.ids.find(type); it != table.ids.end())
+    {
+        return it->second;
+    }
+    if (table.types.size() >= MaxComponentTypes)
+    {
+        throw std::length_error("Too many entity component types registered");
+    }
+
+    const auto id = static_cast<ComponentTypeId>(table.types.size());
+    table.types.push_back({type, size, alignment, bridged});
+    table.ids.emplace(type, id);
+    return id;
+}
+
+ComponentTypeInfo ComponentTypes::Get(const ComponentTypeId id)
+{
+    TypeTable &table = GetTypeTable();
+    std::lock_guard lock(table.mutex);
+    return table.types.at(id);
+}
+
+Archetype::Archetype(const ComponentMask &mask) : _mask(mask)
+{
+    uint32_t rowBytes = 0;
+    uint32_t padding = 0;
+    std::vector<uint32_t> alignments;
+    for (size_t type = 0; type < MaxComponentTypes; ++type)
+    {
+        if (!mask.test(type))
+        {
+            continue;
+        }
+        const ComponentTypeInfo info = ComponentTypes::Get(static_cast<ComponentTypeId>(type));
+        _types.push_back(static_cast<ComponentTypeId>(type));
+        _sizes.push_back(info.size);
+        alignments.push_back(info.alignment);
+        rowBytes += info.size;
+        padding += info.alignment;
+    }
+
+    if (_types.empty())
+    {
+        _chunkCapacity = EmptyChunkCapacity;
+        return;
+    }
+
+    _chunkCapacity = std::max<uint32_t>(1, (static_cast<uint32_t>(ChunkBytes) - std::min<uint32_t>(padding, ChunkBytes)) / rowBytes);
+    uint32_t offset = 0;
+    for (size_t column = 0; column < _types.size(); ++column)
+    {
+        offset = AlignUp(offset, alignments[column]);
+        _offsets.push_back(offset);
+        offset += _sizes[column] * _chunkCapacity;
+    }
+}
+
+size_t Archetype::GetEntityCount() const
+{
+    if (_chunks.empty())
+    {
+        return 0;
+    }
+    return (_chunks.size() - 1) * _chunkCapacity + _chunks.back()->Size();
+}
+
+int Archetype::FindColumn(const ComponentTypeId type) const
+{
+    if (!_mask.test(type))
+    {
+        return -1;
+    }
+    return static_cast<int>(std::ranges::lower_bound(_types, type) - _types.begin());
+}
+
+EntityStore::EntityStore()
+{
+    _emptyArchetype = &GetOrCreateArchetype({});
+}
+
+EntityStore::~EntityStore() = default;
+
+EntityStore::EntityStore(EntityStore &&) noexcept = default;
+EntityStore& EntityStore::operator=(EntityStore &&) noexcept = default;
+
+Entity EntityStore::Create()
+{
+    return CreateIn(*_emptyArchetype);
+}
+
+Entity EntityStore::CreateIn(Archetype &archetype)
+{
+    uint32_t index;
+    if (!_freeRecords.empty())
+    {
+        index = _freeRecords.back();
+        _freeRecords.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(_records.size());
+        _records.emplace_back();
+    }
+
+    const Entity entity{index, _records[index].generation};
+    AppendRow(archetype, entity);
+    ++_entityCount;
+    return entity;
+}
+
+Entity EntityStore::CreateFor(GameObject &gameObject)
+{
+    // Collect every bridged type first so the entity is created in its final archetype
+    std::vector<std::pair<ComponentTypeId, void *>> objects;
+    if (Positionable *positionable = gameObject.GetPositionable())
+    {
+        objects.emplace_back(ComponentTypes::Id<Positionable>(), positionable);
+    }
+    for (const auto &component : gameObject.GetAllComponents())
+    {
+        if (component)
+        {
+            objects.emplace_back(ComponentTypes::BridgedId(typeid(*component)), dynamic_cast<void *>(component.get()));
+        }
+    }
+
+    ComponentMask mask;
+    for (const auto &[type, object] : objects)
+    {
+        mask.set(type);
+    }
+    const Entity entity = CreateIn(GetOrCreateArchetype(mask));
+    for (const auto &[type, object] : objects)
+    {
+        std::memcpy(Locate(entity, type), &object, sizeof(void *));
+    }
+    return entity;
+}
+
+bool EntityStore::Destroy(const Entity entity)
+{
+    if (!Resolve(entity))
+    {
+        return false;
+    }
+
+    EntityRecord &record = _records[entity.index];
+    RemoveRow(*record.archetype, record.chunk, record.row);
+    record.archetype = nullptr;
+    ++record.generation;
+    _freeRecords.push_back(entity.index);
+    --_entityCount;
+    return true;
+}
+
+bool EntityStore::IsAlive(const Entity entity) const
+{
+    return Resolve(entity) != nullptr;
+}
+
+bool EntityStore::Bridge(const Entity entity, Component *component)
+{
+    // The most-derived address, so queries for the dynamic type read a valid pointer
+    return component && BridgeType(entity, ComponentTypes::BridgedId(typeid(*component)), dynamic_cast<void *>(component));
+}
+
+bool EntityStore::Unbridge(const Entity entity, Component *component)
+{
+    return component && RemoveType(entity, ComponentTypes::BridgedId(typeid(*component)));
+}
+
+void EntityStore::Clear()
+{
+    for (const auto &archetype : _archetypes)
+    {
+        archetype->_chunks.clear();
+    }
+    _freeRecords.clear();
+    for (uint32_t index = static_cast<uint32_t>(_records.size()); index-- > 0;)
+    {
+        EntityRecord &record = _records[index];
+        if (record.archetype)
+        {
+            record.archetype = nullptr;
+            ++record.generation;
+        }
+        _freeRecords.push_back(index);
+    }
+    _entityCount = 0;
+}
+
+const EntityStore::EntityRecord* EntityStore::Resolve(const Entity entity) const
+{
+    if (entity.index >= _records.size())
+    {
+        return nullptr;
+    }
+    const EntityRecord &record = _records[entity.index];
+    return record.archetype && record.generation == entity.generation ? &record : nullptr;
+}
+
+Archetype& EntityStore::GetOrCreateArchetype(const ComponentMask &mask)
+{
+    if (const auto it = _archetypesByMask.find(mask); it != _archetypesByMask.end())
+    {
+        return *it->second;
+    }
+
+    Archetype *archetype = _archetypes.emplace_back(std::make_unique<Archetype>(mask)).get();
+    _archetypesByMask.emplace(mask, archetype);
+    return *archetype;
+}
+
+std::byte* EntityStore::AddType(const Entity entity, const ComponentTypeId type)
+{
+    const EntityRecord *record = Resolve(entity);
+    if (!record)
+    {
+        return nullptr;
+    }
+    if (!record->archetype->GetMask().test(type))
+    {
+        ComponentMask mask = record->archetype->GetMask();
+        mask.set(type);
+        MoveEntity(entity, GetOrCreateArchetype(mask));
+    }
+    return Locate(entity, type);
+}
+
+bool EntityStore::BridgeType(const Entity entity, const ComponentTypeId type, void *object)
+{
+    std::byte *slot = AddType(entity, type);
+    if (!slot)
+    {
+        return false;
+    }
+    std::memcpy(slot, &object, sizeof(void *));
+    return true;
+}
+
+bool EntityStore::RemoveType(const Entity entity, const ComponentTypeId type)
+{
+    const EntityRecord *record = Resolve(entity);
+    if (!record || !record->archetype->GetMask().test(type))
+    {
+        return false;
+    }
+
+    ComponentMask mask = record->archetype->GetMask();
+    mask.reset(type);
+    MoveEntity(entity, GetOrCreateArchetype(mask));
+    return true;
+}
+
+std::byte* EntityStore::Locate(const Entity entity, const ComponentTypeId type) const
+{
+    const EntityRecord *record = Resolve(entity);
+    if (!record)
+    {
+        return nullptr;
+    }
+    const Archetype &archetype = *record->archetype;
+    const int column = archetype.FindColumn(type);
+    if (column < 0)
+    {
+        return nullptr;
+    }
+    return archetype.GetColumn(archetype.GetChunk(record->chunk), column) + archetype._sizes[column] * record->row;
+}
+
+void EntityStore::MoveEntity(const Entity entity, Archetype &target)
+{
+    EntityRecord &record = _records[entity.index];
+    Archetype &source = *record.archetype;
+    const uint32_t sourceChunk = record.chunk;
+    const uint32_t sourceRow = record.row;
+
+    AppendRow(target, entity);
+    const Chunk &from = source.GetChunk(sourceChunk);
+    const Chunk &to = target.GetChunk(record.chunk);
+    for (size_t column = 0; column < target._types.size(); ++column)
+    {
+        const uint32_t size = target._sizes[column];
+        std::byte *destination = target.GetColumn(to, column) + size * record.row;
+        const int sourceColumn = source.FindColumn(target._types[column]);
+        if (sourceColumn >= 0)
+        {
+            std::memcpy(destination, source.GetColumn(from, sourceColumn) + size * sourceRow, size);
+        }
+        else
+        {
+            std::memset(destination, 0, size);
+        }
+    }
+
+    RemoveRow(source, sourceChunk, sourceRow);
+}
+
+void EntityStore::AppendRow(Archetype &archetype, const Entity entity)
+{
+    if (archetype._chunks.empty() || archetype._chunks.back()->Size() == archetype._chunkCapacity)
+    {
+        auto chunk = std::make_unique<Chunk>();
+        if (!archetype._types.empty())
+        {
+            const uint32_t lastColumn = static_cast<uint32_t>(archetype._types.size() - 1);
+            const size_t bytes = archetype._offsets[lastColumn] + archetype._sizes[lastColumn] * archetype._chunkCapacity;
+            chunk->data = std::make_unique_for_overwrite<std::max_align_t[]>(
+                (bytes + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t));
+        }
+        chunk->entities.reserve(archetype._chunkCapacity);
+        archetype._chunks.push_back(std::move(chunk));
+    }
+
+    Chunk &chunk = *archetype._chunks.back();
+    EntityRecord &record = _records[entity.index];
+    record.archetype = &archetype;
+    record.chunk = static_cast<uint32_t>(archetype._chunks.size() - 1);
+    record.row = chunk.Size();
+    chunk.entities.push_back(entity);
+}
+
+void EntityStore::RemoveRow(Archetype &archetype, const uint32_t chunk, const uint32_t row)
+{
+    // Swap-remove with the archetype's last row so every chunk but the last stays full
+    Chunk &hole = archetype.GetChunk(chunk);
+    Chunk &last = *archetype._chunks.back();
+    const uint32_t lastRow = last.Size() - 1;
+
+    if (&hole != &last || row != lastRow)
+    {
+        for (size_t column = 0; column < archetype._types.size(); ++column)
+        {
+            const uint32_t size = archetype._sizes[column];
+            std::memcpy(archetype.GetColumn(hole, column) + size * row,
+                        archetype.GetColumn(last, column) + size * lastRow, size);
+        }
+
+        const Entity moved = last.entities[lastRow];
+        hole.entities[row] = moved;
+        _records[moved.index].chunk = chunk;
+        _records[moved.index].row = row;
+    }
+
+    last.entities.pop_back();
+    if (last.entities.empty() && archetype._chunks.size() > 1)
+    {
+        archetype._chunks.pop_back();
+    }
+}
@@ -1,5 +1,6 @@
 #include "engine/Component.hpp"
 #include "engine/GameObject.hpp"
+#include "engine/memory/ObjectPool.hpp"
 // ReSharper disable once CppUnusedIncludeDirective
 #include "engine/serialization/MathSerialization.hpp"
 
@@ -11,6 +12,26 @@ Component::Component(GameObject &gameObject)
 {
 }
 
+void *Component::operator new(const std::size_t size)
+{
+    return Memory::ObjectPools::Instance().AllocateComponent(size);
+}
+
+void *Component::operator new(const std::size_t size, const std::align_val_t alignment)
+{
+    return ::operator new(size, alignment);
+}
+
+void Component::operator delete(void *block, const std::size_t size)
+{
+    Memory::ObjectPools::Instance().DeallocateComponent(block, size);
+}
+
+void Component::operator delete(void *block, const std::size_t size, const std::align_val_t alignment)
+{
+    ::operator delete(block, size, alignment);
+}
+
 GameObject &Component::GetGameObject() const
 {
     return _gameObject;
@@ -6,12 +6,17 @@
 
 #include "engine/GameObject.hpp"
 #include "engine/Component.hpp"
+#include "engine/IRenderable.hpp"
 #include "engine/Positionable.hpp"
+#include "engine/physics/ICollider.hpp"
+#include "engine/rendering/Light.hpp"
+#include "engine/memory/ObjectPool.hpp"
 #include "engine/sceneManagement/Scene.hpp"
 #include "engine/sceneManagement/SceneManager.hpp"
 #include "engine/scheduling/CoroutineScheduler.hpp"
 #include "engine/serialization/ComponentRegistry.hpp"
 #include "engine/serialization/ReferenceResolver.hpp"
+#include "engine/spatial/SpatialIndex.hpp"
 // ReSharper disable once CppUnusedIncludeDirective
 #include "engine/serialization/MathSerialization.hpp"
 
@@ -19,7 +24,7 @@ using namespace N2Engine;
 
 GameObject::Ptr GameObject::Create(const std::string &name)
 {
-    return std::make_shared<GameObject>(name);
+    return std::allocate_shared<GameObject>(Memory::PoolAllocator<GameObject>{}, name);
 }
 
 // GameObject starts active by default
@@ -31,24 +36,62 @@ GameObject::GameObject(std::string name)
     : _name(std::move(name)),
       _positionable{nullptr} {}
 
-void GameObject::Purge()
+GameObject::~GameObject()
 {
-    // Clean up components
-    for (auto &component : _components)
+    if (_indexedIn)
     {
-        if (component)
-        {
-            component->OnDestroy();
-        }
+        _indexedIn->UnregisterGameObject(*this);
     }
-    _components.clear();
-    _componentMap.clear();
+}
 
-    // Remove from parent
-    if (auto parent = _parent.lock())
+void GameObject::SetName(const std::string &name)
+{
+    const std::string oldName = std::exchange(_name, name);
+    if (_indexedIn && oldName != _name)
     {
-        parent->RemoveChild(shared_from_this(), false);
+        _indexedIn->OnGameObjectRenamed(*this, oldName);
     }
+}
+
+void GameObject::SetUUID(const Math::UUID &uuid)
+{
+    Scene *indexedIn = _indexedIn;
+    if (indexedIn)
+    {
+        indexedIn->UnregisterGameObject(*this);
+    }
+    Asset::SetUUID(uuid);
+    if (indexedIn)
+    {
+        indexedIn->RegisterGameObject(*this);
+    }
+}
+
+void GameObject::StoreComponent(std::unique_ptr<Component> component, const ComponentFamilyMask families)
+{
+    component->_families = families;
+    _componentFamilies |= families;
+    _components.push_back(std::move(component));
+}
+
+void GameObject::RefreshComponentFamilies()
+{
+    _componentFamilies = 0;
+    for (const auto &component : _components)
+    {
+        _componentFamilies |= component->_families;
+    }
+}
+
+void GameObject::Purge()
+{
+    // The scene has already called OnDestroy and detached this object from its surviving parent
+    _components.clear();
+    _componentMap.clear();
+    _componentFamilies = 0;
+
+    _parent.reset();
+    _scene = nullptr;
 
     // Clear children (they will handle their own cleanup)
     _children.clear();
@@ -258,6 +301,12 @@ void GameObject::RemoveChild(Ptr child, bool keepWorldPosition)
                 child->GetPositionable()->OnHierarchyChanged();
             }
         }
+
+        if (_scene)
+        {
+            _scene->OnRenderablesRemoved();
+        }
+        child->LeaveSceneIndices();
     }
 }
 
@@ -308,6 +357,8 @@ GameObject::Ptr GameObject::FindChildRecursive(const std::string &name) const
 
 Positionable* GameObject::GetPositionable() const
 {
+    // Parallel stages hold transforms still, so a lookup there only ever reads
+    UpdateRaceDetector::RecordAccess(*this, typeid(Positionable), false);
     return _positionable.get();
 }
 
@@ -316,6 +367,20 @@ void GameObject::CreatePositionable()
     if (!_positionable)
     {
         _positionable = std::make_unique<Positionable>(*this);
+
+        // Children positioned before this object had a transform were hierarchy roots
+        for (const auto &child : _children)
+        {
+            if (child->HasPositionable())
+            {
+                child->GetPositionable()->OnHierarchyChanged();
+            }
+        }
+
+        if (_indexedIn)
+        {
+            _indexedIn->GetSpatialIndex().Insert(*this);
+        }
     }
 }
 
@@ -326,6 +391,7 @@ bool GameObject::HasPositionable() const
 
 Component* GameObject::GetComponent(const std::type_index &type) const
 {
+    UpdateRaceDetector::RecordAccess(*this, type, true);
     if (const auto it = _componentMap.find(type); it != _componentMap.end())
     {
         return it->second;
@@ -340,6 +406,10 @@ bool GameObject::RemoveComponent(const std::type_index &type)
         const auto component = it->second;
         // Notify component
         component->OnDestroy();
+        if (_scene)
+        {
+            _scene->RemoveComponent(*this, component);
+        }
 
         // Remove from map
         _componentMap.erase(it);
@@ -353,6 +423,7 @@ bool GameObject::RemoveComponent(const std::type_index &type)
         {
             _components.erase(vecIt);
         }
+        RefreshComponentFamilies();
 
         return true;
     }
@@ -366,11 +437,16 @@ void GameObject::RemoveAllComponents()
         if (component)
         {
             component->OnDestroy();
+            if (_scene)
+            {
+                _scene->RemoveComponent(*this, component.get());
+            }
         }
     }
 
     _components.clear();
     _componentMap.clear();
+    _componentFamilies = 0;
 }
 
 size_t GameObject::GetComponentCount() const
@@ -380,10 +456,27 @@ size_t GameObject::GetComponentCount() const
 
 void GameObject::SetScene(Scene *scene)
 {
+    if (_indexedIn && _indexedIn != scene)
+    {
+        _indexedIn->UnregisterGameObject(*this);
+    }
+    if (scene && _indexedIn != scene)
+    {
+        scene->RegisterGameObject(*this);
+    }
+
     _scene = scene;
+    if (_positionable)
+    {
+        // Before the children, which link back to this node in the new hierarchy
+        _positionable->OnSceneChanged();
+    }
     for (const auto &component : _components)
     {
-        _scene->AddComponentToAttachQueue(component.get());
+        if (_scene)
+        {
+            _scene->AddComponentToAttachQueue(component.get());
+        }
     }
 
     // Recursively set scene for children
@@ -393,13 +486,28 @@ void GameObject::SetScene(Scene *scene)
     }
 }
 
+void GameObject::LeaveSceneIndices()
+{
+    // A detached subtree keeps its scene pointer but no longer answers scene lookups
+    if (_indexedIn)
+    {
+        _indexedIn->UnregisterGameObject(*this);
+    }
+    for (const auto &child : _children)
+    {
+        child->LeaveSceneIndices();
+    }
+}
+
 void GameObject::Destroy()
 {
-    _isMarkedForDestruction = true;
     if (_scene != nullptr)
     {
+        // The scene marks it, once it is off the worker threads
         _scene->DestroyGameObject(shared_from_this());
+        return;
     }
+    _isMarkedForDestruction = true;
 }
 
 bool GameObject::IsDestroyed() const
@@ -590,7 +698,7 @@ GameObject::Ptr GameObject::Deserialize(const json &j, ReferenceResolver *resolv
 {
     // Create GameObject with UUID
     Math::UUID uuid = j["uuid"].get<Math::UUID>();
-    auto go = std::make_shared<GameObject>(j["name"].get<std::string>());
+    auto go = Create(j["name"].get<std::string>());
     go->_uuid = uuid; // Restore original UUID
 
     // Register this GameObject in the resolver
@@ -636,7 +744,8 @@ GameObject::Ptr GameObject::Deserialize(const json &j, ReferenceResolver *resolv
                 auto *rawPtr = component.get();
                 std::type_index typeIdx(typeid(*rawPtr));
 
-                go->_components.push_back(std::move(component));
+                const ComponentFamilyMask families = ComponentFamilies::MaskOfInstance(*rawPtr);
+                go->StoreComponent(std::move(component), families);
                 go->_componentMap[typeIdx] = rawPtr;
             }
         }
@@ -17,7 +17,10 @@ InputSystem::InputSystem(Window &window)
     : _window{window}
 {
     _mouse = std::make_unique<Mouse>(_window._window);
-    glfwSetWindowUserPointer(_window._window, _mouse.get());
+    if (_window._window)
+    {
+        glfwSetWindowUserPointer(_window._window, _mouse.get());
+    }
 }
 
 InputSystem::~InputSystem() = default;
@@ -101,6 +104,12 @@ std::vector<GamepadInfo> InputSystem::GetConnectedGamepads()
 
 void InputSystem::Update()
 {
+    // Headless: no window to poll, so every action keeps its resting value.
+    if (!_window._window)
+    {
+        return;
+    }
+
     _mouse->Update();
 
     if (const auto it = _actionMaps.find(_curActionMapName); it != _actionMaps.end())
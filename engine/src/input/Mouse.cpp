@@ -11,6 +11,11 @@ namespace N2Engine::Input
     Mouse::Mouse(GLFWwindow *window)
         : _window(window)
     {
+        if (!_window)
+        {
+            return;   // headless
+        }
+
         // Register scroll callback
         glfwSetScrollCallback(_window, ScrollCallback);
 
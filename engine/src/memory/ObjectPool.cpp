@@ -0,0 +1,140 @@
+#include "engine/memory/ObjectPool.hpp"
+
+#include <algorithm>
+#include <format>
+#include <new>
+
+#include "engine/Logger.hpp"
+
+using namespace N2Engine::Memory;
+
+namespace
+{
+    // Slabs of about this many bytes, and never fewer blocks than the minimum
+    constexpr size_t SlabBytes = 16 * 1024;
+    constexpr size_t MinBlocksPerSlab = 8;
+
+    size_t RoundUp(const size_t value, const size_t multiple)
+    {
+        return (value + multiple - 1) / multiple * multiple;
+    }
+}
+
+ObjectPool::ObjectPool(std::string name, const size_t blockSize)
+    : _name{std::move(name)},
+      _blockSize{RoundUp(std::max(blockSize, sizeof(FreeBlock)), Alignment)},
+      _blocksPerSlab{std::max(MinBlocksPerSlab, SlabBytes / _blockSize)} {}
+
+void *ObjectPool::Allocate()
+{
+    std::scoped_lock lock{_mutex};
+    if (_freeList == nullptr)
+    {
+        Grow();
+    }
+
+    FreeBlock *block = _freeList;
+    _freeList = block->next;
+    --_free;
+    _highWater = std::max(_highWater, ++_live);
+    return block;
+}
+
+void ObjectPool::Deallocate(void *block)
+{
+    std::scoped_lock lock{_mutex};
+    _freeList = ::new (block) FreeBlock{_freeList};
+    ++_free;
+    --_live;
+}
+
+PoolStats ObjectPool::GetStats() const
+{
+    std::scoped_lock lock{_mutex};
+    return PoolStats{_name, _blockSize, _live, _free, _highWater, _slabs.size()};
+}
+
+void ObjectPool::Grow()
+{
+    // operator new[] aligns to at least max_align_t, and every block size is a multiple of it
+    auto &slab = _slabs.emplace_back(std::make_unique_for_overwrite<std::byte[]>(_blockSize * _blocksPerSlab));
+
+    // Thread the new blocks in address order so consecutive allocations sit next to each other
+    for (size_t i = _blocksPerSlab; i-- > 0;)
+    {
+        _freeList = ::new (slab.get() + i * _blockSize) FreeBlock{_freeList};
+    }
+    _free += _blocksPerSlab;
+}
+
+ObjectPools &ObjectPools::Instance()
+{
+    // Deliberately leaked: objects released from static destructors still return their blocks
+    static ObjectPools *instance = new ObjectPools();
+    return *instance;
+}
+
+ObjectPool &ObjectPools::Create(std::string name, const size_t blockSize)
+{
+    std::scoped_lock lock{_mutex};
+    return *_pools.emplace_back(std::make_unique<ObjectPool>(std::move(name), blockSize));
+}
+
+void *ObjectPools::AllocateComponent(const size_t size)
+{
+    if (size > MaxPooledSize)
+    {
+        return ::operator new(size);
+    }
+    return ComponentPool(size).Allocate();
+}
+
+void ObjectPools::DeallocateComponent(void *block, const size_t size)
+{
+    if (size > MaxPooledSize)
+    {
+        ::operator delete(block, size);
+        return;
+    }
+    ComponentPool(size).Deallocate(block);
+}
+
+ObjectPool &ObjectPools::ComponentPool(const size_t size)
+{
+    const size_t sizeClass = (std::max<size_t>(size, 1) - 1) / SizeClassGranularity;
+    if (ObjectPool *pool = _componentPools[sizeClass].load(std::memory_order_acquire))
+    {
+        return *pool;
+    }
+
+    std::scoped_lock lock{_mutex};
+    ObjectPool *pool = _componentPools[sizeClass].load(std::memory_order_relaxed);
+    if (pool == nullptr)
+    {
+        const size_t blockSize = (sizeClass + 1) * SizeClassGranularity;
+        pool = _pools.emplace_back(std::make_unique<ObjectPool>("Component " + std::to_string(blockSize) + "B", blockSize)).get();
+        _componentPools[sizeClass].store(pool, std::memory_order_release);
+    }
+    return *pool;
+}
+
+std::vector<PoolStats> ObjectPools::GetStats() const
+{
+    std::scoped_lock lock{_mutex};
+    std::vector<PoolStats> stats;
+    stats.reserve(_pools.size());
+    for (const auto &pool : _pools)
+    {
+        stats.push_back(pool->GetStats());
+    }
+    return stats;
+}
+
+void ObjectPools::LogStats() const
+{
+    for (const PoolStats &pool : GetStats())
+    {
+        Logger::Info(std::format("Pool {}: {} live, {} free, {} high-water, {} slabs of {}B blocks",
+                                 pool.name, pool.live, pool.free, pool.highWater, pool.slabs, pool.blockSize));
+    }
+}
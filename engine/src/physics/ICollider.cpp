@@ -56,6 +56,7 @@ namespace N2Engine::Physics
                 _gameObject.CreatePositionable();
                 positionable = _gameObject.GetPositionable();
             }
+            positionable->MarkPhysicsBound();
 
             _handle = backend->CreateStaticBody(
                 positionable->GetPosition(),
@@ -45,6 +45,7 @@ namespace N2Engine::Physics
             GetGameObject().CreatePositionable();
             positionable = GetGameObject().GetPositionable();
         }
+        positionable->MarkPhysicsBound();
 
         // Create physics body based on type
         if (_bodyType == BodyType::Dynamic || _bodyType == BodyType::Kinematic)
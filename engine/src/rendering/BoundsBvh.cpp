@@ -0,0 +1,64 @@
+#include "engine/rendering/BoundsBvh.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+using namespace N2Engine;
+using namespace N2Engine::Rendering;
+
+void BoundsBvh::Build(const std::vector<BoundingBox> &bounds)
+{
+    Clear();
+    if (bounds.empty())
+    {
+        return;
+    }
+
+    _itemBounds = bounds;
+    _items.resize(bounds.size());
+    std::iota(_items.begin(), _items.end(), 0u);
+    _nodes.reserve(2 * (bounds.size() / LeafSize + 1));
+    BuildNode(bounds, 0, static_cast<uint32_t>(bounds.size()));
+}
+
+void BoundsBvh::Clear()
+{
+    _nodes.clear();
+    _items.clear();
+    _itemBounds.clear();
+}
+
+uint32_t BoundsBvh::BuildNode(const std::vector<BoundingBox> &bounds, const uint32_t first, const uint32_t count)
+{
+    const auto index = static_cast<uint32_t>(_nodes.size());
+    BoundingBox box = bounds[_items[first]];
+    BoundingBox centers{box.GetCenter(), box.GetCenter()};
+    for (uint32_t i = first + 1; i < first + count; ++i)
+    {
+        const BoundingBox &item = bounds[_items[i]];
+        box = box.Merged(item);
+        centers = centers.Merged(BoundingBox{item.GetCenter(), item.GetCenter()});
+    }
+    _nodes.push_back(Node{box, first, count, 0});
+    if (count <= LeafSize)
+    {
+        return index;
+    }
+
+    // Split at the median center along the axis the centers spread furthest
+    const Math::Vector3 spread = centers.GetExtents();
+    const int axis = spread.x >= spread.y && spread.x >= spread.z ? 0 : (spread.y >= spread.z ? 1 : 2);
+    const auto center = [&bounds, axis](const uint32_t item)
+    {
+        const Math::Vector3 c = bounds[item].GetCenter();
+        return axis == 0 ? c.x : (axis == 1 ? c.y : c.z);
+    };
+    const uint32_t half = count / 2;
+    std::nth_element(_items.begin() + first, _items.begin() + first + half, _items.begin() + first + count,
+                     [&center](const uint32_t a, const uint32_t b) { return center(a) < center(b); });
+
+    BuildNode(bounds, first, half);
+    const uint32_t right = BuildNode(bounds, first + half, count - half);
+    _nodes[index].rightChild = right;
+    return index;
+}
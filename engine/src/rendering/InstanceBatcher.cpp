@@ -0,0 +1,68 @@
+#include <functional>
+#include <span>
+
+#include "engine/rendering/InstanceBatcher.hpp"
+
+using namespace N2Engine::Rendering;
+
+static_assert(sizeof(std::array<float, 16>) == sizeof(float[16]),
+              "matrices are handed to the renderer as float[16]");
+
+size_t InstanceBatcher::KeyHash::operator()(const std::pair<const void*, const void*> &key) const noexcept
+{
+    const size_t a = std::hash<const void*>{}(key.first);
+    const size_t b = std::hash<const void*>{}(key.second);
+    return a ^ (b + 0x9e3779b97f4a7c15ull + (a << 6) + (a >> 2));
+}
+
+float* InstanceBatcher::Add(Renderer::Common::IMesh *mesh, Renderer::Common::IMaterial *material)
+{
+    if (_lastBatch >= _batches.size() || _batches[_lastBatch].mesh != mesh || _batches[_lastBatch].material != material)
+    {
+        const auto [it, inserted] = _batchIndex.try_emplace({mesh, material}, _batches.size());
+        if (inserted)
+        {
+            _batches.push_back({mesh, material, {}});
+        }
+        _lastBatch = it->second;
+    }
+
+    return _batches[_lastBatch].matrices.emplace_back().data();
+}
+
+void InstanceBatcher::Flush(Renderer::Common::IRenderer *renderer)
+{
+    bool dropped = false;
+    for (auto &batch : _batches)
+    {
+        if (batch.matrices.empty())
+        {
+            dropped = true;
+            continue;
+        }
+
+        if (renderer)
+        {
+            const std::span<const float[16]> matrices{
+                reinterpret_cast<const float (*)[16]>(batch.matrices.data()), batch.matrices.size()};
+            renderer->DrawMeshInstanced(batch.mesh, batch.material, matrices);
+        }
+    }
+
+    // Meshes and materials that stopped drawing may since have been destroyed
+    if (dropped)
+    {
+        std::erase_if(_batches, [](const Batch &batch) { return batch.matrices.empty(); });
+        _batchIndex.clear();
+        for (size_t i = 0; i < _batches.size(); ++i)
+        {
+            _batchIndex.emplace(std::pair<const void*, const void*>{_batches[i].mesh, _batches[i].material}, i);
+        }
+    }
+
+    for (auto &batch : _batches)
+    {
+        batch.matrices.clear();
+    }
+    _lastBatch = 0;
+}
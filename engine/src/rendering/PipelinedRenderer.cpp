@@ -0,0 +1,534 @@
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <utility>
+
+#include <math/Vector2.hpp>
+#include <math/Vector3.hpp>
+#include <math/Vector4.hpp>
+
+#include "engine/rendering/PipelinedRenderer.hpp"
+#include "engine/Logger.hpp"
+
+using namespace N2Engine::Rendering;
+using namespace Renderer::Common;
+
+namespace
+{
+    double MillisecondsBetween(const RenderSnapshot::Clock::time_point from, const RenderSnapshot::Clock::time_point to)
+    {
+        return std::chrono::duration<double, std::milli>(to - from).count();
+    }
+}
+
+PipelinedMaterial::PipelinedMaterial(IMaterial &backend)
+    : _backend{&backend}, _shader{backend.GetShader()}, _texture{backend.GetTexture()}, _valid{backend.IsValid()}
+{
+    _parameters.Assign(backend.GetParameters().GetParameters());
+}
+
+void PipelinedMaterial::SetInt(const std::string &name, const int value)
+{
+    _parameters.SetInt(ResolveMaterialProperty(name), value);
+}
+
+void PipelinedMaterial::SetFloat(const std::string &name, const float value)
+{
+    _parameters.SetFloat(ResolveMaterialProperty(name), value);
+}
+
+void PipelinedMaterial::SetVec2(const std::string &name, const float x, const float y)
+{
+    _parameters.SetVec2(ResolveMaterialProperty(name), x, y);
+}
+
+void PipelinedMaterial::SetVec2(const std::string &name, Math::Vector2 &value)
+{
+    SetVec2(name, value.x, value.y);
+}
+
+void PipelinedMaterial::SetVec3(const std::string &name, const float x, const float y, const float z)
+{
+    _parameters.SetVec3(ResolveMaterialProperty(name), x, y, z);
+}
+
+void PipelinedMaterial::SetVec3(const std::string &name, Math::Vector3 &value)
+{
+    SetVec3(name, value.x, value.y, value.z);
+}
+
+void PipelinedMaterial::SetVec4(const std::string &name, const float x, const float y, const float z, const float w)
+{
+    _parameters.SetVec4(ResolveMaterialProperty(name), x, y, z, w);
+}
+
+void PipelinedMaterial::SetVec4(const std::string &name, Math::Vector4 &value)
+{
+    SetVec4(name, value.x, value.y, value.z, value.w);
+}
+
+void PipelinedMaterial::SetColor(const std::string &name, const float r, const float g, const float b, const float a)
+{
+    SetVec4(name, r, g, b, a);
+}
+
+PipelinedRenderer::PipelinedRenderer(std::unique_ptr<IRenderer> renderer, GLFWwindow *contextWindow,
+                                     const uint32_t depth, const bool dropLateFrames)
+    : _renderer{std::move(renderer)}, _contextWindow{contextWindow}, _dropLateFrames{dropLateFrames}
+{
+    // Fewer than two would leave nothing to overlap
+    for (uint32_t i = 0; i < std::max(depth, 2u); ++i)
+    {
+        _free.push_back(_snapshots.emplace_back(std::make_unique<RenderSnapshot>()).get());
+    }
+
+    if (_contextWindow)
+    {
+        glfwMakeContextCurrent(nullptr);
+    }
+    _running = true;
+    _thread = std::thread(&PipelinedRenderer::RenderLoop, this);
+}
+
+PipelinedRenderer::~PipelinedRenderer()
+{
+    Stop();
+}
+
+FramePipelineStats PipelinedRenderer::GetStats() const
+{
+    std::scoped_lock lock{_mutex};
+    FramePipelineStats stats = _stats;
+    if (stats.framesPresented > 0)
+    {
+        stats.averageLatencyMs = _totalLatencyMs / static_cast<double>(stats.framesPresented);
+        stats.averageRenderMs = _totalRenderMs / static_cast<double>(stats.framesPresented);
+    }
+    return stats;
+}
+
+void PipelinedRenderer::LogStats() const
+{
+    const FramePipelineStats stats = GetStats();
+    Logger::Info(std::format("Frame pipeline: {} frames presented, {} dropped, {:.2f} ms average latency ({:.2f} max), "
+                             "{:.2f} ms rendering each, {:.1f} ms simulation waited",
+                             stats.framesPresented, stats.framesDropped, stats.averageLatencyMs, stats.maxLatencyMs,
+                             stats.averageRenderMs, stats.simulationWaitMs));
+}
+
+void PipelinedRenderer::Flush()
+{
+    RunOnRenderThread([] {});
+}
+
+bool PipelinedRenderer::Initialize(GLFWwindow *windowHandle, const uint32_t width, const uint32_t height)
+{
+    bool initialized = false;
+    RunOnRenderThread([&] { initialized = _renderer->Initialize(windowHandle, width, height); });
+    return initialized;
+}
+
+void PipelinedRenderer::Shutdown()
+{
+    if (!_thread.joinable())
+    {
+        return;
+    }
+    if (_recording)
+    {
+        // Resources released since the last frame are destroyed before the renderer goes
+        Submit(WorkItem{std::exchange(_recording, nullptr), {}});
+    }
+    RunOnRenderThread([this] { _renderer->Shutdown(); });
+    Stop();
+}
+
+void PipelinedRenderer::Resize(const uint32_t width, const uint32_t height)
+{
+    Submit(WorkItem{nullptr, [this, width, height] { _renderer->Resize(width, height); }});
+}
+
+void PipelinedRenderer::Clear(const float r, const float g, const float b, const float a)
+{
+    Recording().commands.emplace_back(RenderSnapshot::ClearCommand{r, g, b, a});
+}
+
+void PipelinedRenderer::BeginFrame()
+{
+    RenderSnapshot &snapshot = Recording();
+    snapshot.recordedAt = RenderSnapshot::Clock::now();
+    snapshot.commands.emplace_back(RenderSnapshot::BeginFrameCommand{});
+}
+
+void PipelinedRenderer::EndFrame()
+{
+    Recording().commands.emplace_back(RenderSnapshot::EndFrameCommand{});
+}
+
+void PipelinedRenderer::Present()
+{
+    RenderSnapshot &snapshot = Recording();
+    snapshot.presented = true;
+    snapshot.frame = _nextFrame++;
+    Submit(WorkItem{std::exchange(_recording, nullptr), {}});
+}
+
+IShader* PipelinedRenderer::CreateShaderProgram(const char *vertexSource, const char *fragmentSource)
+{
+    IShader *shader = nullptr;
+    RunOnRenderThread([&] { shader = _renderer->CreateShaderProgram(vertexSource, fragmentSource); });
+    return shader;
+}
+
+void PipelinedRenderer::UseShaderProgram(IShader *shader)
+{
+    Recording().commands.emplace_back(RenderSnapshot::ShaderCommand{shader});
+}
+
+bool PipelinedRenderer::DestroyShaderProgram(const ShaderHandle shader)
+{
+    if (!IsValidShader(shader))
+    {
+        return false;
+    }
+    Retire(shader);
+    return true;
+}
+
+bool PipelinedRenderer::IsValidShader(const ShaderHandle shader) const
+{
+    // Destroyed, though the backend keeps it until the frame releasing it is drawn
+    if (_recording && std::ranges::find(_recording->retired, RenderSnapshot::RetiredResource{shader}) !=
+                      _recording->retired.end())
+    {
+        return false;
+    }
+
+    bool valid = false;
+    RunOnRenderThread([&] { valid = _renderer->IsValidShader(shader); });
+    return valid;
+}
+
+IMesh* PipelinedRenderer::CreateMesh(const MeshData &meshData)
+{
+    IMesh *mesh = nullptr;
+    RunOnRenderThread([&] { mesh = _renderer->CreateMesh(meshData); });
+    return mesh;
+}
+
+void PipelinedRenderer::DestroyMesh(const MeshHandle mesh)
+{
+    Retire(mesh);
+}
+
+ITexture* PipelinedRenderer::CreateTexture(const uint8_t *data, const uint32_t width, const uint32_t height,
+                                           const uint32_t channels)
+{
+    ITexture *texture = nullptr;
+    RunOnRenderThread([&] { texture = _renderer->CreateTexture(data, width, height, channels); });
+    return texture;
+}
+
+void PipelinedRenderer::DestroyTexture(const TextureHandle texture)
+{
+    Retire(texture);
+}
+
+IMaterial* PipelinedRenderer::CreateMaterial(IShader *shader)
+{
+    return WrapMaterial([&] { return _renderer->CreateMaterial(shader); });
+}
+
+IMaterial* PipelinedRenderer::CreateMaterial(IShader *shader, ITexture *texture)
+{
+    return WrapMaterial([&] { return _renderer->CreateMaterial(shader, texture); });
+}
+
+void PipelinedRenderer::DestroyMaterial(const MaterialHandle material)
+{
+    const std::unique_ptr<PipelinedMaterial> *wrapper = _materials.Find(material.slot);
+    if (!wrapper)
+    {
+        return;
+    }
+    Retire((*wrapper)->GetBackend()->GetHandle());
+    _materials.Erase(material.slot);
+}
+
+void PipelinedRenderer::SetViewProjection(const float *view, const float *projection)
+{
+    RenderSnapshot &snapshot = Recording();
+    const auto first = static_cast<uint32_t>(snapshot.matrices.size());
+    std::memcpy(snapshot.matrices.emplace_back().data(), view, 16 * sizeof(float));
+    std::memcpy(snapshot.matrices.emplace_back().data(), projection, 16 * sizeof(float));
+    snapshot.commands.emplace_back(RenderSnapshot::ViewProjectionCommand{first});
+}
+
+void PipelinedRenderer::UpdateSceneLighting(const SceneLightingData &lighting, const Math::Vector3 &cameraPosition)
+{
+    RenderSnapshot &snapshot = Recording();
+    snapshot.commands.emplace_back(RenderSnapshot::LightingCommand{static_cast<uint32_t>(snapshot.lighting.size())});
+    snapshot.lighting.push_back(RenderSnapshot::Lighting{lighting, cameraPosition});
+}
+
+void PipelinedRenderer::DrawMesh(IMesh *mesh, const float *modelMatrix, IMaterial *material)
+{
+    RenderSnapshot &snapshot = Recording();
+    const auto first = static_cast<uint32_t>(snapshot.matrices.size());
+    std::memcpy(snapshot.matrices.emplace_back().data(), modelMatrix, 16 * sizeof(float));
+    snapshot.commands.emplace_back(RenderSnapshot::DrawCommand{mesh, RecordMaterial(snapshot, material), first, 1, false});
+}
+
+void PipelinedRenderer::DrawMeshInstanced(IMesh *mesh, IMaterial *material, const std::span<const float[16]> modelMatrices)
+{
+    RenderSnapshot &snapshot = Recording();
+    const auto first = static_cast<uint32_t>(snapshot.matrices.size());
+    snapshot.matrices.resize(first + modelMatrices.size());
+    std::memcpy(snapshot.matrices[first].data(), modelMatrices.data(), modelMatrices.size_bytes());
+    snapshot.commands.emplace_back(RenderSnapshot::DrawCommand{
+        mesh, RecordMaterial(snapshot, material), first, static_cast<uint32_t>(modelMatrices.size()), true});
+}
+
+void PipelinedRenderer::DrawObjects(const std::vector<RenderObject> &objects)
+{
+    RenderSnapshot &snapshot = Recording();
+    const auto first = static_cast<uint32_t>(snapshot.objects.size());
+    const auto firstMaterial = static_cast<uint32_t>(snapshot.materials.size());
+    snapshot.objects.insert(snapshot.objects.end(), objects.begin(), objects.end());
+    const uint64_t call = ++_drawObjectsCalls;
+    for (size_t i = first; i < snapshot.objects.size(); ++i)
+    {
+        IMaterial *&material = snapshot.objects[i].material;
+        PipelinedMaterial *wrapper = FindMaterial(material);
+        if (!wrapper)
+        {
+            material = nullptr;
+            continue;
+        }
+        // One copy per material and call: every object using it draws with the same values
+        PipelinedMaterial &recorded = *wrapper;
+        if (recorded._recordedCall != call)
+        {
+            recorded._recordedCall = call;
+            snapshot.RecordMaterial(recorded, recorded.GetBackend());
+        }
+        material = recorded.GetBackend();
+    }
+    snapshot.commands.emplace_back(RenderSnapshot::DrawObjectsCommand{
+        first, static_cast<uint32_t>(objects.size()), firstMaterial,
+        static_cast<uint32_t>(snapshot.materials.size()) - firstMaterial});
+}
+
+void PipelinedRenderer::OnResize(const int width, const int height)
+{
+    Submit(WorkItem{nullptr, [this, width, height] { _renderer->OnResize(width, height); }});
+}
+
+IShader* PipelinedRenderer::GetStandardUnlitShader() const
+{
+    // Created by Initialize and kept until Shutdown, so reading it races with nothing
+    return _renderer->GetStandardUnlitShader();
+}
+
+IShader* PipelinedRenderer::GetStandardLitShader() const
+{
+    return _renderer->GetStandardLitShader();
+}
+
+void PipelinedRenderer::ReadFramebuffer(std::uint8_t *buffer, const int width, const int height) const
+{
+    // Queued behind every submitted frame, so it reads the last one presented
+    RunOnRenderThread([&] { _renderer->ReadFramebuffer(buffer, width, height); });
+}
+
+void PipelinedRenderer::SetWireframe(const bool enabled)
+{
+    Recording().commands.emplace_back(RenderSnapshot::WireframeCommand{enabled});
+}
+
+const char* PipelinedRenderer::GetRendererName() const
+{
+    return _renderer->GetRendererName();
+}
+
+RenderSnapshot &PipelinedRenderer::Recording()
+{
+    if (!_recording)
+    {
+        // Every snapshot in flight bounds how far simulation may run ahead of the screen
+        const auto start = RenderSnapshot::Clock::now();
+        std::unique_lock lock{_mutex};
+        _workDone.wait(lock, [this] { return !_free.empty(); });
+        _recording = _free.back();
+        _free.pop_back();
+        _stats.simulationWaitMs += MillisecondsBetween(start, RenderSnapshot::Clock::now());
+    }
+    return *_recording;
+}
+
+IMaterial* PipelinedRenderer::WrapMaterial(const std::function<IMaterial*()> &create)
+{
+    std::unique_ptr<PipelinedMaterial> wrapper;
+    RunOnRenderThread([&]
+    {
+        IMaterial *backend = create();
+        if (backend)
+        {
+            wrapper = std::make_unique<PipelinedMaterial>(*backend);
+        }
+    });
+    return wrapper ? _materials.Insert(std::move(wrapper)) : nullptr;
+}
+
+PipelinedMaterial* PipelinedRenderer::FindMaterial(const IMaterial *material) const
+{
+    if (!material)
+    {
+        return nullptr;
+    }
+    // A backend material's handle may name one of ours, so the pointer must match too
+    const std::unique_ptr<PipelinedMaterial> *wrapper = _materials.Find(material->GetHandle().slot);
+    return wrapper && wrapper->get() == material ? wrapper->get() : nullptr;
+}
+
+uint32_t PipelinedRenderer::RecordMaterial(RenderSnapshot &snapshot, IMaterial *material)
+{
+    PipelinedMaterial *wrapper = FindMaterial(material);
+    return wrapper ? snapshot.RecordMaterial(*wrapper, wrapper->GetBackend()) : RenderSnapshot::NoMaterial;
+}
+
+void PipelinedRenderer::Submit(WorkItem item) const
+{
+    {
+        std::scoped_lock lock{_mutex};
+        _work.push_back(std::move(item));
+        ++_submitted;
+    }
+    _workReady.notify_one();
+}
+
+void PipelinedRenderer::RunOnRenderThread(std::function<void()> fn) const
+{
+    if (std::this_thread::get_id() == _thread.get_id())
+    {
+        fn();
+        return;
+    }
+
+    std::unique_lock lock{_mutex};
+    _work.push_back(WorkItem{nullptr, std::move(fn)});
+    const uint64_t ticket = ++_submitted;
+    _workReady.notify_one();
+    _workDone.wait(lock, [this, ticket] { return _completed >= ticket; });
+}
+
+void PipelinedRenderer::Retire(const RenderSnapshot::RetiredResource resource)
+{
+    if (std::visit([](const auto handle) { return handle.IsNull(); }, resource))
+    {
+        return;
+    }
+    Recording().retired.push_back(resource);
+}
+
+void PipelinedRenderer::Stop()
+{
+    if (!_thread.joinable())
+    {
+        return;
+    }
+    if (_recording)
+    {
+        Submit(WorkItem{std::exchange(_recording, nullptr), {}});
+    }
+
+    {
+        std::scoped_lock lock{_mutex};
+        _running = false;
+    }
+    _workReady.notify_one();
+    _thread.join();
+
+    if (_contextWindow)
+    {
+        glfwMakeContextCurrent(_contextWindow);
+    }
+}
+
+void PipelinedRenderer::RenderLoop()
+{
+    if (_contextWindow)
+    {
+        glfwMakeContextCurrent(_contextWindow);
+    }
+
+    while (true)
+    {
+        WorkItem item;
+        bool skip = false;
+        {
+            std::unique_lock lock{_mutex};
+            _workReady.wait(lock, [this] { return !_work.empty() || !_running; });
+            if (_work.empty())
+            {
+                break;
+            }
+            item = std::move(_work.front());
+            _work.pop_front();
+
+            // A newer frame is already waiting: drawing this one would only add latency
+            skip = _dropLateFrames && item.snapshot && item.snapshot->presented &&
+                   std::ranges::any_of(_work, [](const WorkItem &next) { return next.snapshot && next.snapshot->presented; });
+        }
+
+        if (item.snapshot)
+        {
+            RenderSnapshotItem(*item.snapshot, skip);
+            item.snapshot->Clear();
+        }
+        else
+        {
+            item.task();
+        }
+
+        {
+            std::scoped_lock lock{_mutex};
+            ++_completed;
+            if (item.snapshot)
+            {
+                _free.push_back(item.snapshot);
+            }
+        }
+        _workDone.notify_all();
+    }
+
+    if (_contextWindow)
+    {
+        glfwMakeContextCurrent(nullptr);
+    }
+}
+
+void PipelinedRenderer::RenderSnapshotItem(RenderSnapshot &snapshot, const bool skip)
+{
+    const auto start = RenderSnapshot::Clock::now();
+    snapshot.Replay(*_renderer, !skip);
+    // Frames before this one are done, and this one no longer draws: nothing can reach them now
+    snapshot.DestroyRetired(*_renderer);
+    const auto end = RenderSnapshot::Clock::now();
+
+    if (!snapshot.presented)
+    {
+        return;
+    }
+    std::scoped_lock lock{_mutex};
+    if (skip)
+    {
+        ++_stats.framesDropped;
+        return;
+    }
+    const double latencyMs = MillisecondsBetween(snapshot.recordedAt, end);
+    ++_stats.framesPresented;
+    _totalLatencyMs += latencyMs;
+    _totalRenderMs += MillisecondsBetween(start, end);
+    _stats.maxLatencyMs = std::max(_stats.maxLatencyMs, latencyMs);
+}
@@ -0,0 +1,131 @@
+#include <span>
+#include <type_traits>
+
+#include "engine/rendering/RenderSnapshot.hpp"
+
+using namespace N2Engine::Rendering;
+
+void RenderSnapshot::Clear()
+{
+    commands.clear();
+    matrices.clear();
+    objects.clear();
+    materials.clear();
+    parameters.clear();
+    lighting.clear();
+    retired.clear();
+    recordedAt = {};
+    presented = false;
+}
+
+uint32_t RenderSnapshot::RecordMaterial(const Renderer::Common::IMaterial &material, Renderer::Common::IMaterial *backend)
+{
+    const std::span<const Renderer::Common::MaterialParameter> values = material.GetParameters().GetParameters();
+    const auto firstParameter = static_cast<uint32_t>(parameters.size());
+    parameters.insert(parameters.end(), values.begin(), values.end());
+    materials.push_back(MaterialState{backend, material.GetTexture(), firstParameter, static_cast<uint32_t>(values.size())});
+    return static_cast<uint32_t>(materials.size() - 1);
+}
+
+void RenderSnapshot::Replay(Renderer::Common::IRenderer &renderer, const bool drawsToo) const
+{
+    for (const Command &command : commands)
+    {
+        std::visit([&]<typename T>(const T &c)
+        {
+            if constexpr (std::is_same_v<T, ClearCommand>)
+            {
+                renderer.Clear(c.r, c.g, c.b, c.a);
+            }
+            else if constexpr (std::is_same_v<T, ViewProjectionCommand>)
+            {
+                renderer.SetViewProjection(matrices[c.first].data(), matrices[c.first + 1].data());
+            }
+            else if constexpr (std::is_same_v<T, LightingCommand>)
+            {
+                renderer.UpdateSceneLighting(lighting[c.index].data, lighting[c.index].cameraPosition);
+            }
+            else if constexpr (std::is_same_v<T, ShaderCommand>)
+            {
+                renderer.UseShaderProgram(c.shader);
+            }
+            else if constexpr (std::is_same_v<T, WireframeCommand>)
+            {
+                renderer.SetWireframe(c.enabled);
+            }
+            else if (!drawsToo)
+            {
+                // Skipped frames keep the state changes and drop the rest
+            }
+            else if constexpr (std::is_same_v<T, DrawCommand>)
+            {
+                Renderer::Common::IMaterial *material = c.material == NoMaterial ? nullptr : ApplyMaterial(c.material);
+                if (c.instanced)
+                {
+                    renderer.DrawMeshInstanced(c.mesh, material, std::span<const float[16]>{
+                        reinterpret_cast<const float (*)[16]>(matrices[c.first].data()), c.count});
+                }
+                else
+                {
+                    renderer.DrawMesh(c.mesh, matrices[c.first].data(), material);
+                }
+            }
+            else if constexpr (std::is_same_v<T, DrawObjectsCommand>)
+            {
+                for (uint32_t i = c.firstMaterial; i < c.firstMaterial + c.materialCount; ++i)
+                {
+                    ApplyMaterial(i);
+                }
+                renderer.DrawObjects({objects.begin() + c.first, objects.begin() + c.first + c.count});
+            }
+            else if constexpr (std::is_same_v<T, BeginFrameCommand>)
+            {
+                renderer.BeginFrame();
+            }
+            else if constexpr (std::is_same_v<T, EndFrameCommand>)
+            {
+                renderer.EndFrame();
+            }
+        }, command);
+    }
+
+    if (presented && drawsToo)
+    {
+        renderer.Present();
+    }
+}
+
+Renderer::Common::IMaterial* RenderSnapshot::ApplyMaterial(const uint32_t index) const
+{
+    const MaterialState &state = materials[index];
+    state.material->GetParameters().Assign({parameters.begin() + state.firstParameter, state.parameterCount});
+    state.material->SetTexture(state.texture);
+    return state.material;
+}
+
+void RenderSnapshot::DestroyRetired(Renderer::Common::IRenderer &renderer)
+{
+    for (const RetiredResource &resource : retired)
+    {
+        std::visit([&]<typename T>(const T handle)
+        {
+            if constexpr (std::is_same_v<T, Renderer::Common::MeshHandle>)
+            {
+                renderer.DestroyMesh(handle);
+            }
+            else if constexpr (std::is_same_v<T, Renderer::Common::MaterialHandle>)
+            {
+                renderer.DestroyMaterial(handle);
+            }
+            else if constexpr (std::is_same_v<T, Renderer::Common::TextureHandle>)
+            {
+                renderer.DestroyTexture(handle);
+            }
+            else
+            {
+                renderer.DestroyShaderProgram(handle);
+            }
+        }, resource);
+    }
+    retired.clear();
+}
@@ -0,0 +1,128 @@
+#include <bit>
+
+#include "engine/rendering/SharedMeshRegistry.hpp"
+
+using namespace N2Engine::Rendering;
+
+namespace
+{
+    size_t HashCombine(size_t seed, size_t value)
+    {
+        return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+    }
+}
+
+size_t SharedMeshRegistry::KeyHash::operator()(const MeshKey &key) const noexcept
+{
+    return HashCombine(std::hash<const void*>{}(key.renderer), std::hash<std::string>{}(key.key));
+}
+
+size_t SharedMeshRegistry::KeyHash::operator()(const MaterialKey &key) const noexcept
+{
+    size_t seed = HashCombine(std::hash<const void*>{}(key.renderer), std::hash<const void*>{}(key.shader));
+    for (const float channel : key.color)
+    {
+        seed = HashCombine(seed, std::bit_cast<uint32_t>(channel));
+    }
+    return seed;
+}
+
+Renderer::Common::IMesh* SharedMeshRegistry::AcquireMesh(Renderer::Common::IRenderer *renderer, const std::string &key,
+                                                         const MeshFactory &factory)
+{
+    if (!renderer)
+    {
+        return nullptr;
+    }
+
+    MeshKey meshKey{renderer, key};
+    if (const auto it = _meshes.find(meshKey); it != _meshes.end())
+    {
+        ++_meshEntries.at(it->second).references;
+        return it->second;
+    }
+
+    Renderer::Common::IMesh *mesh = renderer->CreateMesh(factory());
+    if (!mesh)
+    {
+        return nullptr;
+    }
+
+    _meshes.emplace(meshKey, mesh);
+    _meshEntries.emplace(mesh, Entry<MeshKey>{std::move(meshKey), 1});
+    return mesh;
+}
+
+void SharedMeshRegistry::ReleaseMesh(Renderer::Common::IRenderer *renderer, Renderer::Common::IMesh *mesh)
+{
+    const auto it = _meshEntries.find(mesh);
+    if (it == _meshEntries.end() || it->second.key.renderer != renderer)
+    {
+        return;
+    }
+
+    if (--it->second.references == 0)
+    {
+        _meshes.erase(it->second.key);
+        _meshEntries.erase(it);
+        renderer->DestroyMesh(mesh->GetHandle());
+    }
+}
+
+Renderer::Common::IMaterial* SharedMeshRegistry::AcquireMaterial(Renderer::Common::IRenderer *renderer,
+                                                                 Renderer::Common::IShader *shader,
+                                                                 const Common::Color &color)
+{
+    if (!renderer)
+    {
+        return nullptr;
+    }
+
+    const MaterialKey materialKey{renderer, shader, {color.r, color.g, color.b, color.a}};
+    if (const auto it = _materials.find(materialKey); it != _materials.end())
+    {
+        ++_materialEntries.at(it->second).references;
+        return it->second;
+    }
+
+    Renderer::Common::IMaterial *material = renderer->CreateMaterial(shader, nullptr);
+    if (!material)
+    {
+        return nullptr;
+    }
+    material->GetParameters().SetVec4(Renderer::Common::MaterialProperty::Albedo, color.r, color.g, color.b, color.a);
+
+    _materials.emplace(materialKey, material);
+    _materialEntries.emplace(material, Entry<MaterialKey>{materialKey, 1});
+    return material;
+}
+
+void SharedMeshRegistry::ReleaseMaterial(Renderer::Common::IRenderer *renderer, Renderer::Common::IMaterial *material)
+{
+    const auto it = _materialEntries.find(material);
+    if (it == _materialEntries.end() || it->second.key.renderer != renderer)
+    {
+        return;
+    }
+
+    if (--it->second.references == 0)
+    {
+        _materials.erase(it->second.key);
+        _materialEntries.erase(it);
+        renderer->DestroyMaterial(material->GetHandle());
+    }
+}
+
+void SharedMeshRegistry::Forget(Renderer::Common::IRenderer *renderer)
+{
+    std::erase_if(_meshes, [renderer](const auto &item) { return item.first.renderer == renderer; });
+    std::erase_if(_meshEntries, [renderer](const auto &item) { return item.second.key.renderer == renderer; });
+    std::erase_if(_materials, [renderer](const auto &item) { return item.first.renderer == renderer; });
+    std::erase_if(_materialEntries, [renderer](const auto &item) { return item.second.key.renderer == renderer; });
+}
+
+size_t SharedMeshRegistry::GetMeshReferences(const Renderer::Common::IMesh *mesh) const
+{
+    const auto it = _meshEntries.find(mesh);
+    return it == _meshEntries.end() ? 0 : it->second.references;
+}
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <cassert>
 #include <memory>
 #include <utility>
 #include <format>
@@ -13,13 +14,59 @@
 #include "engine/rendering/Light.hpp"
 #include "engine/Logger.hpp"
 #include "engine/Positionable.hpp"
+#include "engine/TransformHierarchy.hpp"
+#include "engine/scheduling/JobSystem.hpp"
 
 using namespace N2Engine;
 
+namespace
+{
+    // One traversal stack per nesting level, kept with its capacity for the thread's next walk
+    struct TraversalStackPool
+    {
+        std::vector<std::unique_ptr<std::vector<GameObject*>>> stacks;
+        size_t depth = 0;
+    };
+
+    thread_local TraversalStackPool traversalStacks;
+
+    // Components per piece of a parallel stage: enough to outweigh handing the piece to a worker
+    constexpr size_t ParallelHookGrain = 64;
+
+    // World transforms are frozen during parallel stages, so types moving their GameObject run serially
+    bool RunsInParallel(const ComponentTypeHooks &hooks)
+    {
+        return hooks.parallelism != ComponentParallelism::Serial &&
+               !std::ranges::binary_search(hooks.writes, std::type_index(typeid(Positionable)));
+    }
+}
+
 Scene::Scene(std::string name)
-    : _coroutineScheduler(std::make_unique<Scheduling::CoroutineScheduler>(this)), sceneName(std::move(name)) {}
+    : _commandBuffer(std::make_unique<SceneCommandBuffer>()),
+      _transforms(std::make_unique<TransformHierarchy>()),
+      _coroutineScheduler(std::make_unique<Scheduling::CoroutineScheduler>(this)), sceneName(std::move(name))
+{
+#ifdef N2ENGINE_DEBUG
+    SetRaceDetection(true);
+#endif
+}
 
-Scene::~Scene() = default;
+Scene::~Scene()
+{
+    // GameObjects held elsewhere can outlive the scene and must not report back to it
+    for (const auto &[name, gameObjects] : _gameObjectsByName)
+    {
+        for (GameObject *gameObject : gameObjects)
+        {
+            gameObject->_indexedIn = nullptr;
+        }
+    }
+    // Their transforms too; the rest are destroyed with the roots right after
+    if (_transforms)
+    {
+        _transforms->MoveNodesTo(TransformHierarchy::Detached());
+    }
+}
 
 Scene::Scene(Scene &&) noexcept = default;
 Scene& Scene::operator=(Scene &&) noexcept = default;
@@ -29,37 +76,111 @@ std::unique_ptr<Scene> Scene::Create(const std::string &name)
     return std::unique_ptr<Scene>(new Scene{name});
 }
 
-void Scene::Render(Renderer::Common::IRenderer *renderer)
+void Scene::Render(Renderer::Common::IRenderer *renderer, const Frustum *frustum)
 {
-    // Render all root GameObjects (which will recursively render their children)
-    for (const auto &rootObject : _rootGameObjects)
+    _renderStats = {};
+    if (frustum && _staticRenderablesDirty)
     {
-        if (rootObject->IsActiveInHierarchy())
+        RebuildStaticRenderables();
+    }
+
+    RenderHierarchy(renderer, frustum);
+
+    if (frustum && !_staticRenderables.empty())
+    {
+        size_t visible = 0;
+        _renderStats.boundsTests += _staticBvh.Query(*frustum, [&](const uint32_t index)
         {
-            RenderRecursive(rootObject, renderer);
-        }
+            ++visible;
+            IRenderable *renderable = _staticRenderables[index];
+            if (renderable->IsActive() && renderable->GetGameObject().IsActiveInHierarchy())
+            {
+                DrawRenderable(renderable, renderer);
+            }
+        });
+        _renderStats.staticRenderables = _staticRenderables.size();
+        _renderStats.culled += _staticRenderables.size() - visible;
     }
+
+    // Renderables sharing a mesh and material go out as one instanced draw
+    _instanceBatcher.Flush(renderer);
 }
 
-void Scene::RenderRecursive(std::shared_ptr<GameObject> gameObject, Renderer::Common::IRenderer *renderer)
+void Scene::RenderHierarchy(Renderer::Common::IRenderer *renderer, const Frustum *frustum)
 {
-    if (gameObject == nullptr || !gameObject->IsActiveInHierarchy())
+    Traverse([&](const GameObject &gameObject)
     {
-        return;
+        for (IRenderable *renderable : gameObject.GetComponents<IRenderable>())
+        {
+            if (!renderable->IsActive())
+            {
+                continue;
+            }
+            if (frustum)
+            {
+                // Static renderables in the hierarchy are drawn from its query
+                if (renderable->_staticBuild != 0 && renderable->_staticBuild == _staticBuild)
+                {
+                    continue;
+                }
+                if (BoundingBox bounds; renderable->GetWorldBounds(bounds))
+                {
+                    ++_renderStats.boundsTests;
+                    if (!frustum->IsVisible(bounds))
+                    {
+                        ++_renderStats.culled;
+                        continue;
+                    }
+                }
+            }
+            DrawRenderable(renderable, renderer);
+        }
+    }, true);
+}
+
+void Scene::DrawRenderable(IRenderable *renderable, Renderer::Common::IRenderer *renderer)
+{
+    ++_renderStats.submitted;
+    if (!renderable->CollectInstance(renderer, _instanceBatcher))
+    {
+        renderable->Render(renderer);
     }
+}
 
-    for (const auto renderableComponents = gameObject->GetComponents<IRenderable>(); const auto renderable :
-         renderableComponents)
+void Scene::RebuildStaticRenderables()
+{
+    // Build ids are unique across scenes so a renderable moved between scenes is never mistaken as placed
+    static uint32_t nextBuild = 0;
+    _staticBuild = ++nextBuild;
+    _staticRenderablesDirty = false;
+    _staticRenderables.clear();
+
+    std::vector<BoundingBox> bounds;
+    Traverse([&](const GameObject &gameObject)
     {
-        if (renderable && renderable->IsActive())
+        for (IRenderable *renderable : gameObject.GetComponents<IRenderable>())
         {
-            renderable->Render(renderer);
+            BoundingBox box;
+            if (renderable->IsStatic() && renderable->GetWorldBounds(box))
+            {
+                renderable->_staticBuild = _staticBuild;
+                _staticRenderables.push_back(renderable);
+                bounds.push_back(box);
+            }
         }
-    }
+    });
+    _staticBvh.Build(bounds);
+}
 
-    for (const auto &child : gameObject->GetChildren())
+void Scene::OnRenderablesRemoved()
+{
+    if (!_staticRenderables.empty())
     {
-        RenderRecursive(child, renderer);
+        // Drop them now: the hierarchy must not keep pointers to renderables that left
+        _staticRenderables.clear();
+        _staticBvh.Clear();
+        _staticBuild = 0;
+        _staticRenderablesDirty = true;
     }
 }
 
@@ -70,9 +191,9 @@ void Scene::AddRootGameObject(std::shared_ptr<GameObject> gameObject)
         return;
     }
 
-    auto it = std::ranges::find(_rootGameObjects, gameObject);
-    if (it == _rootGameObjects.end())
+    if (!IsRoot(*gameObject))
     {
+        gameObject->_rootIndex = _rootGameObjects.size();
         _rootGameObjects.push_back(gameObject);
         gameObject->SetScene(this);
     }
@@ -96,13 +217,43 @@ void Scene::AddRootGameObjects(std::initializer_list<std::shared_ptr<GameObject>
 
 bool Scene::RemoveRootGameObject(std::shared_ptr<GameObject> gameObject)
 {
-    if (const auto it = std::ranges::find(_rootGameObjects, gameObject); it != _rootGameObjects.end())
+    if (!gameObject || !IsRoot(*gameObject))
     {
-        (*it)->SetScene(nullptr);
-        _rootGameObjects.erase(it);
-        return true;
+        return false;
+    }
+
+    // Roots keep their order: the slot stays as a hole instead of shifting the tail down
+    const size_t index = gameObject->_rootIndex;
+    gameObject->_rootIndex = SIZE_MAX;
+    gameObject->SetScene(nullptr);
+    _rootGameObjects[index] = nullptr;
+    ++_rootHoles;
+    OnRenderablesRemoved();
+    return true;
+}
+
+bool Scene::IsRoot(const GameObject &gameObject) const
+{
+    return gameObject._rootIndex < _rootGameObjects.size() && _rootGameObjects[gameObject._rootIndex].get() == &gameObject;
+}
+
+void Scene::ReindexRoots(const size_t first) const
+{
+    for (size_t i = first; i < _rootGameObjects.size(); ++i)
+    {
+        _rootGameObjects[i]->_rootIndex = i;
     }
-    return false;
+}
+
+void Scene::CompactRoots() const
+{
+    if (_rootHoles == 0)
+    {
+        return;
+    }
+    std::erase(_rootGameObjects, nullptr);
+    _rootHoles = 0;
+    ReindexRoots(0);
 }
 
 bool Scene::DestroyGameObject(std::shared_ptr<GameObject> gameObject)
@@ -112,73 +263,95 @@ bool Scene::DestroyGameObject(std::shared_ptr<GameObject> gameObject)
         return false;
     }
 
+    if (_runningParallelStage)
+    {
+        // Called from a worker: the queue is only touched once the stage is over
+        _commandBuffer->Destroy(*gameObject);
+        return true;
+    }
+    gameObject->_isMarkedForDestruction = true;
     _markedForDestructionQueue.push(gameObject);
     return true;
 }
 
-void Scene::TraverseAll(std::function<void(std::shared_ptr<GameObject>)> callback) const
+Scene::TraversalStack::TraversalStack()
 {
-    for (const auto &root : _rootGameObjects)
+    if (traversalStacks.depth == traversalStacks.stacks.size())
     {
-        TraverseGameObjectRecursive(root, callback, false);
+        traversalStacks.stacks.push_back(std::make_unique<std::vector<GameObject*>>());
     }
+    _stack = traversalStacks.stacks[traversalStacks.depth++].get();
 }
 
-void Scene::TraverseAllActive(std::function<void(std::shared_ptr<GameObject>)> callback) const
+Scene::TraversalStack::~TraversalStack()
 {
-    for (const auto &root : _rootGameObjects)
-    {
-        if (root->IsActiveInHierarchy())
-        {
-            TraverseGameObjectRecursive(root, callback, true);
-        }
-    }
+    _stack->clear();
+    --traversalStacks.depth;
 }
 
-void Scene::TraverseGameObjectRecursive(std::shared_ptr<GameObject> gameObject,
-                                        std::function<void(std::shared_ptr<GameObject>)> callback,
-                                        const bool onlyActive) const
+std::generator<GameObject&> Scene::GameObjects(const bool onlyActive) const
 {
-    if (!gameObject || (onlyActive && !gameObject->IsActiveInHierarchy()))
+    // Owns its stack: a suspended range must not hold one of the per-thread stacks
+    std::vector<GameObject*> pending;
+    for (auto it = _rootGameObjects.rbegin(); it != _rootGameObjects.rend(); ++it)
     {
-        return;
+        pending.push_back(it->get());
     }
 
-    // Process current object
-    callback(gameObject);
-
-    // Process children
-    for (const auto &child : gameObject->GetChildren())
+    while (!pending.empty())
     {
-        TraverseGameObjectRecursive(child, callback, onlyActive);
+        GameObject *gameObject = pending.back();
+        pending.pop_back();
+        if (!gameObject || (onlyActive && !gameObject->IsActiveInHierarchy()))
+        {
+            continue;
+        }
+
+        co_yield *gameObject;
+
+        const auto &children = gameObject->GetChildren();
+        for (auto it = children.rbegin(); it != children.rend(); ++it)
+        {
+            pending.push_back(it->get());
+        }
     }
 }
 
+void Scene::TraverseAll(std::function<void(std::shared_ptr<GameObject>)> callback) const
+{
+    Traverse([&callback](GameObject &gameObject) { callback(gameObject.shared_from_this()); });
+}
+
+void Scene::TraverseAllActive(std::function<void(std::shared_ptr<GameObject>)> callback) const
+{
+    Traverse([&callback](GameObject &gameObject) { callback(gameObject.shared_from_this()); }, true);
+}
+
 std::shared_ptr<GameObject> Scene::FindGameObject(const std::string &name) const
 {
-    std::shared_ptr<GameObject> result = nullptr;
+    const std::span<GameObject* const> found = FindGameObjectsByName(name);
+    return found.empty() ? nullptr : found.front()->shared_from_this();
+}
 
-    TraverseAll([&](std::shared_ptr<GameObject> gameObject)
+std::span<GameObject* const> Scene::FindGameObjectsByName(const std::string &name) const
+{
+    if (const auto it = _gameObjectsByName.find(name); it != _gameObjectsByName.end())
     {
-        if (!result && gameObject->GetName() == name)
-        {
-            result = gameObject;
-        }
-    });
-
-    return result;
+        return it->second;
+    }
+    return {};
 }
 
 std::vector<std::shared_ptr<GameObject>> Scene::FindGameObjectsByTag(const std::string &tag) const
 {
     std::vector<std::shared_ptr<GameObject>> results;
 
-    TraverseAll([&](std::shared_ptr<GameObject> gameObject)
+    Traverse([&](GameObject &gameObject)
     {
         // Assuming you have a tag system in GameObject
-        // if (gameObject->GetTag() == tag)
+        // if (gameObject.GetTag() == tag)
         // {
-        //     results.push_back(gameObject);
+        //     results.push_back(gameObject.shared_from_this());
         // }
     });
 
@@ -187,26 +360,83 @@ std::vector<std::shared_ptr<GameObject>> Scene::FindGameObjectsByTag(const std::
 
 std::shared_ptr<GameObject> Scene::FindGameObjectByUUID(const Math::UUID uuid)
 {
-    std::shared_ptr<GameObject> result = nullptr;
+    const auto it = _gameObjectsByUuid.find(uuid);
+    return it != _gameObjectsByUuid.end() ? it->second->shared_from_this() : nullptr;
+}
 
-    TraverseAll([&](std::shared_ptr<GameObject> gameObject)
+void Scene::RegisterGameObject(GameObject &gameObject)
+{
+    gameObject._indexedIn = this;
+    _gameObjectsByUuid[gameObject.GetUUID()] = &gameObject;
+    _gameObjectsByName[gameObject.GetName()].push_back(&gameObject);
+    if (gameObject.HasPositionable())
     {
-        if (!result && gameObject->GetUUID() == uuid)
+        _spatialIndex.Insert(gameObject);
+    }
+}
+
+void Scene::UnregisterGameObject(GameObject &gameObject)
+{
+    // A duplicate UUID may have taken the slot over; leave it to that GameObject
+    if (const auto it = _gameObjectsByUuid.find(gameObject.GetUUID());
+        it != _gameObjectsByUuid.end() && it->second == &gameObject)
+    {
+        _gameObjectsByUuid.erase(it);
+    }
+    if (const auto it = _gameObjectsByName.find(gameObject.GetName()); it != _gameObjectsByName.end())
+    {
+        std::erase(it->second, &gameObject);
+        if (it->second.empty())
         {
-            result = gameObject;
+            _gameObjectsByName.erase(it);
         }
-    });
+    }
+    _spatialIndex.Remove(gameObject);
+    gameObject._indexedIn = nullptr;
+}
 
-    return result;
+void Scene::OnGameObjectRenamed(GameObject &gameObject, const std::string &oldName)
+{
+    if (const auto it = _gameObjectsByName.find(oldName); it != _gameObjectsByName.end())
+    {
+        std::erase(it->second, &gameObject);
+        if (it->second.empty())
+        {
+            _gameObjectsByName.erase(it);
+        }
+    }
+    _gameObjectsByName[gameObject.GetName()].push_back(&gameObject);
+}
+
+void Scene::IndexComponent(Component *component)
+{
+    std::vector<Component*> &bucket = _componentsByType[std::type_index(typeid(*component))].components;
+    component->_sceneSlots.byType = static_cast<uint32_t>(bucket.size());
+    bucket.push_back(component);
+}
+
+void Scene::UnindexComponent(Component *component)
+{
+    uint32_t &slot = component->_sceneSlots.byType;
+    if (slot == Component::SceneSlots::None)
+    {
+        return;
+    }
+    // The bucket stays in attach order: the entry becomes a hole until the next sweep
+    ComponentBucket &bucket = _componentsByType.at(std::type_index(typeid(*component)));
+    bucket.components[slot] = nullptr;
+    bucket.hasHoles = true;
+    _componentListsHaveHoles = true;
+    slot = Component::SceneSlots::None;
 }
 
 std::vector<std::shared_ptr<GameObject>> Scene::GetAllGameObjects() const
 {
     std::vector<std::shared_ptr<GameObject>> allObjects;
 
-    TraverseAll([&](std::shared_ptr<GameObject> gameObject)
+    Traverse([&](GameObject &gameObject)
     {
-        allObjects.push_back(gameObject);
+        allObjects.push_back(gameObject.shared_from_this());
     });
 
     return allObjects;
@@ -214,92 +444,262 @@ std::vector<std::shared_ptr<GameObject>> Scene::GetAllGameObjects() const
 
 bool Scene::TraverseUntil(std::function<bool(std::shared_ptr<GameObject>)> callback) const
 {
-    for (const auto &root : _rootGameObjects)
+    return Traverse([&callback](GameObject &gameObject) { return callback(gameObject.shared_from_this()); });
+}
+
+void Scene::RegisterComponentHooks(Component *component)
+{
+    const std::type_index type(typeid(*component));
+    const ComponentTypeHooks &hooks = ComponentHookRegistry::Instance().Get(type);
+
+    for (size_t hook = 0; hook < ComponentHookCount; ++hook)
     {
-        if (TraverseGameObjectUntil(root, callback))
+        const ComponentHookRunner run = hooks.runners[hook];
+        if (!run)
         {
-            return true; // Early exit from entire traversal
+            continue;
         }
+
+        auto &lists = _hookLists[hook];
+        auto it = std::ranges::find(lists, type, &ComponentHookList::type);
+        if (it == lists.end())
+        {
+            it = lists.insert(lists.end(), ComponentHookList{type, run, &hooks, {}});
+            _hookStagesDirty[hook] = true;
+        }
+        component->_sceneSlots.hookLists[hook] = static_cast<uint32_t>(it - lists.begin());
+        component->_sceneSlots.hookPositions[hook] = static_cast<uint32_t>(it->components.size());
+        it->components.push_back(component);
     }
-    return false;
 }
 
-bool Scene::TraverseGameObjectUntil(std::shared_ptr<GameObject> gameObject,
-                                    std::function<bool(std::shared_ptr<GameObject>)> callback) const
+void Scene::RunComponentHook(const ComponentHook hook) const
 {
-    if (callback(gameObject))
+    for (const auto &list : _hookLists[static_cast<size_t>(hook)])
     {
-        return true;
+        list.run(list.components);
+    }
+}
+
+void Scene::RunUpdatePhase(const ComponentHook hook)
+{
+    const auto index = static_cast<size_t>(hook);
+    if (_hookStagesDirty[index])
+    {
+        BuildHookStages(hook);
     }
 
-    for (const auto &child : gameObject->GetChildren())
+    for (const ComponentHookStage &stage : _hookStages[index])
     {
-        if (TraverseGameObjectUntil(child, callback))
+        if (stage.parallel)
         {
-            return true;
+            RunParallelStage(hook, stage);
+            continue;
         }
+        const ComponentHookList &list = _hookLists[index][stage.firstList];
+        list.run(list.components);
     }
+    SweepComponentLists();
+    _commandBuffer->Playback();
+}
 
-    return false;
+void Scene::SweepComponentLists()
+{
+    if (!_componentListsHaveHoles)
+    {
+        return;
+    }
+    // Only lists something left were touched, each compacted once however many left it
+    for (size_t hook = 0; hook < ComponentHookCount; ++hook)
+    {
+        for (auto &list : _hookLists[hook])
+        {
+            if (!list.hasHoles)
+            {
+                continue;
+            }
+            std::erase(list.components, nullptr);
+            for (size_t i = 0; i < list.components.size(); ++i)
+            {
+                list.components[i]->_sceneSlots.hookPositions[hook] = static_cast<uint32_t>(i);
+            }
+            list.hasHoles = false;
+        }
+    }
+    for (auto &[type, bucket] : _componentsByType)
+    {
+        if (!bucket.hasHoles)
+        {
+            continue;
+        }
+        std::erase(bucket.components, nullptr);
+        for (size_t i = 0; i < bucket.components.size(); ++i)
+        {
+            bucket.components[i]->_sceneSlots.byType = static_cast<uint32_t>(i);
+        }
+        bucket.hasHoles = false;
+    }
+    _componentListsHaveHoles = false;
+}
+
+void Scene::BuildHookStages(const ComponentHook hook)
+{
+    // Only neighbours are grouped, so a type still runs after every list before it that it conflicts with
+    const auto index = static_cast<size_t>(hook);
+    const auto &lists = _hookLists[index];
+    auto &stages = _hookStages[index];
+    stages.clear();
+
+    for (size_t i = 0; i < lists.size(); ++i)
+    {
+        const ComponentTypeHooks &hooks = *lists[i].hooks;
+        const bool parallel = RunsInParallel(hooks);
+        if (parallel && hooks.parallelism == ComponentParallelism::Declared && !stages.empty())
+        {
+            ComponentHookStage &last = stages.back();
+            const auto grouped = std::span(lists).subspan(last.firstList, last.listCount);
+            const bool joins = last.parallel && std::ranges::all_of(grouped, [&hooks](const ComponentHookList &list)
+            {
+                return list.hooks->parallelism == ComponentParallelism::Declared && !list.hooks->ConflictsWith(hooks);
+            });
+            if (joins)
+            {
+                ++last.listCount;
+                continue;
+            }
+        }
+        stages.push_back(ComponentHookStage{i, 1, parallel});
+    }
+    _hookStagesDirty[index] = false;
 }
 
-void Scene::OnAllActiveComponents(const std::function<void(Component *)> &callback) const
+void Scene::RunParallelStage(const ComponentHook hook, const ComponentHookStage &stage)
 {
-    for (const auto &c : _components)
+    // The stage's lists laid end to end: _stageOffsets[i] is where list firstList + i starts
+    const auto lists = std::span(_hookLists[static_cast<size_t>(hook)]).subspan(stage.firstList, stage.listCount);
+    _stageOffsets.clear();
+    size_t count = 0;
+    for (const ComponentHookList &list : lists)
+    {
+        _stageOffsets.push_back(count);
+        count += list.components.size();
+    }
+
+    // Components on workers may read world transforms: resolve them all first, then hold them still
+    _transforms->BeginParallelReads();
+
+    UpdateRaceDetector *raceDetector = _raceDetector.get();
+    _runningParallelStage = true;
+    Scheduling::JobSystem::Instance().ParallelFor(count, ParallelHookGrain, [&](const size_t begin, const size_t end)
     {
-        if (c->GetGameObject().IsActiveInHierarchy() && c->IsActive())
+        auto list = std::ranges::upper_bound(_stageOffsets, begin) - 1;
+        for (size_t at = begin; at < end; ++list)
         {
-            callback(c);
+            const ComponentHookList &hookList = lists[list - _stageOffsets.begin()];
+            const size_t listBegin = at - *list;
+            const size_t listEnd = std::min(hookList.components.size(), end - *list);
+            const auto components = std::span<Component *const>(hookList.components).subspan(listBegin, listEnd - listBegin);
+            if (raceDetector)
+            {
+                raceDetector->Run(components, hookList.run, *hookList.hooks);
+            }
+            else
+            {
+                hookList.run(components);
+            }
+            at = *list + listEnd;
         }
+    });
+    _runningParallelStage = false;
+    _transforms->EndParallelReads();
+
+    if (raceDetector)
+    {
+        raceDetector->EndStage(hook);
     }
 }
 
+void Scene::SetRaceDetection(const bool enabled)
+{
+    if (enabled && !_raceDetector)
+    {
+        _raceDetector = std::make_unique<UpdateRaceDetector>();
+    }
+    else if (!enabled)
+    {
+        _raceDetector.reset();
+    }
+}
+
+std::span<const ComponentRace> Scene::GetDetectedRaces() const
+{
+    return _raceDetector ? _raceDetector->GetRaces() : std::span<const ComponentRace>{};
+}
+
 void Scene::AddComponentToAttachQueue(Component *component)
 {
-    _attachQueue.push(component);
+    assert(!_runningParallelStage && "Components updating in parallel add components through SceneCommandBuffer");
+
+    Component::SceneSlots &slots = component->_sceneSlots;
+    if (slots.scene == this)
+    {
+        // Already queued or attached here, e.g. when its GameObject is reparented within the scene
+        return;
+    }
+    slots = {};
+    slots.scene = this;
+    slots.attachQueue = static_cast<uint32_t>(_attachQueue.size());
+    _attachQueue.push_back(component);
 }
 
 void Scene::ProcessAttachQueue()
 {
-    while (!_attachQueue.empty())
+    // Components OnAttach adds join the end and attach in this same call
+    for (size_t i = 0; i < _attachQueue.size(); ++i)
     {
-        Component *c = _attachQueue.front();
-        _attachQueue.pop();
+        Component *c = std::exchange(_attachQueue[i], nullptr);
+        if (!c)
+        {
+            // Removed before it attached
+            continue;
+        }
+        c->_sceneSlots.attachQueue = Component::SceneSlots::None;
         c->OnAttach();
 
-        if (auto *light = dynamic_cast<Rendering::Light*>(c))
+        if (c->GetFamilies() & ComponentFamilies::Bit<Rendering::Light>())
         {
-            _sceneLights.push_back(light);
+            _sceneLights.push_back(static_cast<Rendering::Light*>(c));
         }
         else
         {
+            c->_attachOrder = _nextAttachOrder++;
+            c->_sceneSlots.components = static_cast<uint32_t>(_components.size());
             _components.push_back(c);
+            RegisterComponentHooks(c);
+            IndexComponent(c);
+        }
+
+        if ((c->GetFamilies() & ComponentFamilies::Bit<IRenderable>()) && static_cast<IRenderable*>(c)->IsStatic())
+        {
+            InvalidateStaticRenderables();
         }
     }
+    _attachQueue.clear();
 }
 
-void Scene::Update() const
+void Scene::Update()
 {
-    OnAllActiveComponents([](Component *component)
-    {
-        component->OnUpdate();
-    });
+    RunUpdatePhase(ComponentHook::Update);
 }
 
-void Scene::FixedUpdate() const
+void Scene::FixedUpdate()
 {
-    OnAllActiveComponents([](Component *component)
-    {
-        component->OnFixedUpdate();
-    });
+    RunUpdatePhase(ComponentHook::FixedUpdate);
 }
 
-void Scene::LateUpdate() const
+void Scene::LateUpdate()
 {
-    OnAllActiveComponents([](Component *component)
-    {
-        component->OnLateUpdate();
-    });
+    RunUpdatePhase(ComponentHook::LateUpdate);
 }
 
 void Scene::AdvanceCoroutines() const
@@ -309,10 +709,7 @@ void Scene::AdvanceCoroutines() const
 
 void Scene::OnApplicationQuit() const
 {
-    OnAllActiveComponents([](Component *component)
-    {
-        component->OnApplicationQuit();
-    });
+    RunComponentHook(ComponentHook::ApplicationQuit);
 }
 
 void Scene::Clear()
@@ -320,70 +717,168 @@ void Scene::Clear()
     // Clear all root objects (this will naturally clear their children too)
     for (auto &root : _rootGameObjects)
     {
-        root->SetScene(nullptr);
+        if (root)
+        {
+            root->_rootIndex = SIZE_MAX;
+            root->SetScene(nullptr);
+        }
     }
     _rootGameObjects.clear();
+    _rootHoles = 0;
+
+    for (const auto &[gameObject, entity] : _gameObjectEntities)
+    {
+        _entityStore.Destroy(entity);
+    }
+    _gameObjectEntities.clear();
+    OnRenderablesRemoved();
+}
+
+ECS::Entity Scene::CreateEntity(GameObject &gameObject)
+{
+    // Bridges what the GameObject holds now; components added later need EntityStore::Bridge
+    if (const auto it = _gameObjectEntities.find(&gameObject); it != _gameObjectEntities.end())
+    {
+        return it->second;
+    }
+    const ECS::Entity entity = _entityStore.CreateFor(gameObject);
+    _gameObjectEntities.emplace(&gameObject, entity);
+    return entity;
+}
+
+ECS::Entity Scene::GetEntity(const GameObject &gameObject) const
+{
+    const auto it = _gameObjectEntities.find(&gameObject);
+    return it != _gameObjectEntities.end() ? it->second : ECS::Entity{};
+}
+
+void Scene::RemoveComponent(const GameObject &gameObject, Component *component)
+{
+    assert(!_runningParallelStage && "Components updating in parallel remove components through SceneCommandBuffer");
+
+    // The component is about to be freed: no list may keep pointing at it
+    ReleaseComponentSlots(component);
+    if (component->GetFamilies() & ComponentFamilies::Bit<Rendering::Light>())
+    {
+        std::erase(_sceneLights, static_cast<Rendering::Light*>(component));
+    }
+
+    if (const auto it = _gameObjectEntities.find(&gameObject); it != _gameObjectEntities.end())
+    {
+        _entityStore.Unbridge(it->second, component);
+    }
+    if (component->GetFamilies() & ComponentFamilies::Bit<IRenderable>())
+    {
+        OnRenderablesRemoved();
+    }
+}
+
+void Scene::ReleaseComponentSlots(Component *component)
+{
+    static_assert(std::tuple_size_v<decltype(Component::SceneSlots::hookLists)> == ComponentHookCount);
+    Component::SceneSlots &slots = component->_sceneSlots;
+    if (slots.scene != this)
+    {
+        return;
+    }
+
+    if (slots.attachQueue != Component::SceneSlots::None)
+    {
+        _attachQueue[slots.attachQueue] = nullptr;
+    }
+    if (slots.components != Component::SceneSlots::None)
+    {
+        Component *last = _components.back();
+        _components[slots.components] = last;
+        last->_sceneSlots.components = slots.components;
+        _components.pop_back();
+    }
+    // A walk may be inside these lists, so they keep their order and take a null instead
+    for (size_t hook = 0; hook < ComponentHookCount; ++hook)
+    {
+        if (slots.hookLists[hook] != Component::SceneSlots::None)
+        {
+            ComponentHookList &list = _hookLists[hook][slots.hookLists[hook]];
+            list.components[slots.hookPositions[hook]] = nullptr;
+            list.hasHoles = true;
+            _componentListsHaveHoles = true;
+        }
+    }
+    UnindexComponent(component);
+    slots = {};
 }
 
 void Scene::ProcessDestroyed()
 {
-    std::vector<std::shared_ptr<GameObject>> markedObjects;
+    if (_markedForDestructionQueue.empty())
+    {
+        return;
+    }
 
+    std::vector<std::shared_ptr<GameObject>> doomed;
     while (!_markedForDestructionQueue.empty())
     {
-        auto rootObject = _markedForDestructionQueue.front();
+        auto rootObject = std::move(_markedForDestructionQueue.front());
         _markedForDestructionQueue.pop();
 
-        if (!rootObject || rootObject->_isMarkedForDestruction)
+        // GameObject::Destroy marks before queueing, so only an earlier collection means a duplicate
+        if (rootObject && !rootObject->_isPendingPurge)
         {
-            continue;
+            CollectForPurge(std::move(rootObject), doomed);
         }
-
-        // Mark hierarchy and collect objects in one pass
-        MarkHierarchyForDestruction(rootObject, markedObjects);
     }
 
-    for (auto &obj : markedObjects)
+    for (const auto &gameObject : doomed)
     {
-        CallOnDestroyForGameObject(obj);
+        CallOnDestroyForGameObject(*gameObject);
     }
-    for (auto &obj : markedObjects)
+
+    // Every list is compacted once for the whole batch rather than once per destroyed GameObject
+    DetachDestroyed(doomed);
+    UnregisterDestroyed(doomed);
+    RemoveDestroyedComponents(doomed);
+    OnRenderablesRemoved();
+
+    // Children first, so no purged parent is left pointing at a child still being torn down
+    for (auto it = doomed.rbegin(); it != doomed.rend(); ++it)
     {
-        PurgeMarkedGameObject(obj);
+        (*it)->Purge();
     }
 }
 
-void Scene::MarkHierarchyForDestruction(std::shared_ptr<GameObject> gameObject,
-                                        std::vector<std::shared_ptr<GameObject>> &markedObjects)
+void Scene::CollectForPurge(std::shared_ptr<GameObject> root, std::vector<std::shared_ptr<GameObject>> &doomed)
 {
-    if (!gameObject || gameObject->_isMarkedForDestruction)
-        return;
+    size_t next = doomed.size();
+    root->_isPendingPurge = true;
+    doomed.push_back(std::move(root));
 
-    // Mark this object
-    gameObject->_isMarkedForDestruction = true;
-
-    // Collect it immediately
-    markedObjects.push_back(gameObject);
-
-    // Recursively mark and collect all children
-    auto children = gameObject->GetChildren(); // Copy to avoid iterator issues
-    for (auto &child : children)
+    while (next < doomed.size())
     {
-        MarkHierarchyForDestruction(child, markedObjects);
+        GameObject &gameObject = *doomed[next++];
+        gameObject._isMarkedForDestruction = true;
+        for (const auto &child : gameObject.GetChildren())
+        {
+            if (child && !child->_isPendingPurge)
+            {
+                child->_isPendingPurge = true;
+                doomed.push_back(child);
+            }
+        }
     }
 }
 
-void Scene::CallOnDestroyForGameObject(std::shared_ptr<GameObject> gameObject)
+void Scene::CallOnDestroyForGameObject(GameObject &gameObject)
 {
-    for (auto &component : gameObject->GetAllComponents())
+    for (auto &component : gameObject.GetAllComponents())
     {
         if (component)
         {
             component->OnDestroy();
         }
     }
-    gameObject->StopAllCoroutines();
-    for (auto &component : gameObject->GetAllComponents())
+    // Drops the entry as well: the pooled address may come back as a different GameObject
+    _coroutineScheduler->RemoveGameObject(&gameObject);
+    for (auto &component : gameObject.GetAllComponents())
     {
         if (component)
         {
@@ -392,30 +887,101 @@ void Scene::CallOnDestroyForGameObject(std::shared_ptr<GameObject> gameObject)
     }
 }
 
-void Scene::PurgeMarkedGameObject(std::shared_ptr<GameObject> gameObject)
+void Scene::DetachDestroyed(const std::span<const std::shared_ptr<GameObject>> doomed)
 {
-    // Remove from parent or scene root
-    if (const auto parent = gameObject->GetParent())
+    std::vector<GameObject*> survivingParents;
+    bool removesRoot = false;
+    for (const auto &gameObject : doomed)
     {
-        // Only remove if parent isn't also being destroyed
-        if (!parent->_isMarkedForDestruction)
+        if (const auto parent = gameObject->GetParent(); parent && !parent->_isPendingPurge)
+        {
+            survivingParents.push_back(parent.get());
+        }
+        // A root reparented with AddChild keeps its slot, so both can apply
+        if (IsRoot(*gameObject))
         {
-            parent->RemoveChild(gameObject, false);
+            gameObject->_rootIndex = SIZE_MAX;
+            removesRoot = true;
         }
     }
-    else
+
+    std::ranges::sort(survivingParents);
+    const auto [first, last] = std::ranges::unique(survivingParents);
+    survivingParents.erase(first, last);
+    for (GameObject *parent : survivingParents)
     {
-        RemoveRootGameObject(gameObject);
+        std::erase_if(parent->_children, [](const auto &child) { return child->_isPendingPurge; });
     }
 
-    // Remove from components list
-    std::erase_if(_components,
-                  [&gameObject](const Component *comp)
-                  {
-                      return &comp->GetGameObject() == gameObject.get();
-                  });
+    if (removesRoot)
+    {
+        std::erase_if(_rootGameObjects, [](const auto &root) { return !root || root->_isPendingPurge; });
+        _rootHoles = 0;
+        ReindexRoots(0);
+    }
+}
+
+void Scene::UnregisterDestroyed(const std::span<const std::shared_ptr<GameObject>> doomed)
+{
+    using NameBucket = decltype(_gameObjectsByName)::iterator;
+    std::vector<NameBucket> touchedNames;
+
+    for (const auto &gameObject : doomed)
+    {
+        if (gameObject->_indexedIn == this)
+        {
+            if (const auto it = _gameObjectsByUuid.find(gameObject->GetUUID());
+                it != _gameObjectsByUuid.end() && it->second == gameObject.get())
+            {
+                _gameObjectsByUuid.erase(it);
+            }
+            if (const auto it = _gameObjectsByName.find(gameObject->GetName()); it != _gameObjectsByName.end())
+            {
+                touchedNames.push_back(it);
+            }
+            _spatialIndex.Remove(*gameObject);
+            gameObject->_indexedIn = nullptr;
+        }
 
-    gameObject->Purge();
+        if (const auto it = _gameObjectEntities.find(gameObject.get()); it != _gameObjectEntities.end())
+        {
+            _entityStore.Destroy(it->second);
+            _gameObjectEntities.erase(it);
+        }
+    }
+
+    // Buckets are unique by their key's address; erasing any invalidates only that bucket's iterator
+    const auto bucketAddress = [](const NameBucket &it) { return &*it; };
+    std::ranges::sort(touchedNames, {}, bucketAddress);
+    const auto [first, last] = std::ranges::unique(touchedNames, {}, bucketAddress);
+    touchedNames.erase(first, last);
+    for (const NameBucket &bucket : touchedNames)
+    {
+        std::erase_if(bucket->second, [](const GameObject *gameObject) { return gameObject->_isPendingPurge; });
+        if (bucket->second.empty())
+        {
+            _gameObjectsByName.erase(bucket);
+        }
+    }
+}
+
+void Scene::RemoveDestroyedComponents(const std::span<const std::shared_ptr<GameObject>> doomed)
+{
+    const auto destroyed = [](const Component *component) { return component->_isMarkedForDestruction; };
+
+    // Components added this frame leave the attach queue too: they are freed before they ever attach
+    for (const auto &gameObject : doomed)
+    {
+        for (const auto &component : gameObject->GetAllComponents())
+        {
+            if (component)
+            {
+                ReleaseComponentSlots(component.get());
+            }
+        }
+    }
+    std::erase_if(_sceneLights, destroyed);
+    SweepComponentLists();
 }
 
 using json = nlohmann::json;
@@ -426,7 +992,7 @@ json Scene::Serialize() const
     j["name"] = sceneName;
 
     json roots = json::array();
-    for (const auto &root : _rootGameObjects)
+    for (const auto &root : GetRootGameObjects())
     {
         roots.push_back(root->Serialize());
     }
@@ -452,6 +1018,7 @@ void Scene::Deserialize(const json &j)
         for (const auto &rootJson : j["rootGameObjects"])
         {
             auto root = GameObject::Deserialize(rootJson, &resolver);
+            root->_rootIndex = _rootGameObjects.size();
             _rootGameObjects.push_back(root);
             root->SetScene(this);
         }
@@ -0,0 +1,48 @@
+#include "engine/sceneManagement/SceneCommandBuffer.hpp"
+
+using namespace N2Engine;
+
+void SceneCommandBuffer::Destroy(GameObject &gameObject)
+{
+    Record([target = gameObject.shared_from_this()] { target->Destroy(); });
+}
+
+void SceneCommandBuffer::SetParent(GameObject &child, GameObject *parent, const bool keepWorldPosition)
+{
+    Record([target = child.shared_from_this(), parent = parent ? parent->shared_from_this() : nullptr, keepWorldPosition]
+    {
+        target->SetParent(parent, keepWorldPosition);
+    });
+}
+
+void SceneCommandBuffer::Playback()
+{
+    while (true)
+    {
+        {
+            std::scoped_lock lock{_mutex};
+            if (_commands.empty())
+            {
+                return;
+            }
+            _playing.swap(_commands);
+        }
+        for (auto &command : _playing)
+        {
+            command();
+        }
+        _playing.clear();
+    }
+}
+
+bool SceneCommandBuffer::Empty() const
+{
+    std::scoped_lock lock{_mutex};
+    return _commands.empty();
+}
+
+void SceneCommandBuffer::Record(std::function<void()> command)
+{
+    std::scoped_lock lock{_mutex};
+    _commands.push_back(std::move(command));
+}
@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <format>
+#include <functional>
+
+#include "engine/sceneManagement/UpdateRaceDetector.hpp"
+#include "engine/Component.hpp"
+#include "engine/GameObject.hpp"
+#include "engine/Logger.hpp"
+
+using namespace N2Engine;
+
+namespace
+{
+    // Whether a type's declaration covers an access it made on its own GameObject
+    bool Declares(const ComponentTypeHooks &hooks, const std::type_index &resource, const bool write)
+    {
+        if (hooks.parallelism != ComponentParallelism::Declared)
+        {
+            return true;
+        }
+        return std::ranges::binary_search(hooks.writes, resource) || std::ranges::binary_search(hooks.writesSelf, resource) ||
+               (!write && std::ranges::binary_search(hooks.reads, resource));
+    }
+}
+
+size_t UpdateRaceDetector::RaceHash::operator()(const ComponentRace &race) const
+{
+    size_t seed = std::hash<const GameObject*>{}(race.gameObject);
+    const auto combine = [&seed](const size_t value) { seed ^= value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2); };
+    combine(race.resource.hash_code());
+    combine(race.accessor.hash_code());
+    combine(race.other.hash_code());
+    combine(static_cast<size_t>(race.kind) << 8 | static_cast<size_t>(race.hook) << 1 | race.write);
+    return seed;
+}
+
+void UpdateRaceDetector::Run(const std::span<Component *const> components, const ComponentHookRunner run,
+                             const ComponentTypeHooks &hooks)
+{
+    Recording recording;
+    recording.hooks = &hooks;
+    s_recording = &recording;
+    for (Component *const &component : components)
+    {
+        if (!component)
+        {
+            continue;
+        }
+        recording.component = component;
+        recording.owner = &component->GetGameObject();
+        run(std::span<Component *const>(&component, 1));
+    }
+    s_recording = nullptr;
+
+    if (!recording.accesses.empty())
+    {
+        std::scoped_lock lock{_mutex};
+        _accesses.insert(_accesses.end(), recording.accesses.begin(), recording.accesses.end());
+    }
+}
+
+void UpdateRaceDetector::Add(const GameObject &gameObject, const std::type_index &resource, const bool write)
+{
+    Recording &recording = *s_recording;
+    // Repeated lookups of one resource in a row add nothing new
+    if (!recording.accesses.empty())
+    {
+        const Access &last = recording.accesses.back();
+        if (last.component == recording.component && last.gameObject == &gameObject && last.resource == resource &&
+            last.write == write)
+        {
+            return;
+        }
+    }
+    recording.accesses.push_back(Access{&gameObject, resource, recording.component, recording.owner, recording.hooks, write});
+}
+
+void UpdateRaceDetector::EndStage(const ComponentHook hook)
+{
+    for (const Access &access : _accesses)
+    {
+        const std::type_index accessor(typeid(*access.component));
+        if (access.gameObject != access.owner)
+        {
+            Report(ComponentRace{ComponentRaceKind::OtherGameObject, access.gameObject, access.resource, accessor,
+                                 accessor, access.write, hook}, *access.component, *access.component);
+        }
+        else if (!Declares(*access.hooks, access.resource, access.write))
+        {
+            Report(ComponentRace{ComponentRaceKind::Undeclared, access.gameObject, access.resource, accessor, accessor,
+                                 access.write, hook}, *access.component, *access.component);
+        }
+    }
+
+    const auto key = [](const Access &access) { return std::pair{access.gameObject, access.resource}; };
+    std::ranges::sort(_accesses, {}, key);
+
+    for (auto first = _accesses.begin(); first != _accesses.end();)
+    {
+        const auto last = std::find_if(first, _accesses.end(), [&](const Access &access) { return key(access) != key(*first); });
+        const auto writer = std::find_if(first, last, [](const Access &access) { return access.write; });
+        const auto other = writer == last ? last : std::find_if(first, last, [&](const Access &access)
+        {
+            return access.component != writer->component;
+        });
+
+        if (other != last)
+        {
+            Report(ComponentRace{ComponentRaceKind::Conflict, first->gameObject, first->resource,
+                                 typeid(*writer->component), typeid(*other->component), true, hook},
+                   *writer->component, *other->component);
+        }
+        first = last;
+    }
+    _accesses.clear();
+}
+
+void UpdateRaceDetector::Report(const ComponentRace &race, const Component &accessor, const Component &other)
+{
+    if (_knownRaces.contains(race))
+    {
+        return;
+    }
+    if (_races.size() >= MaxRaces)
+    {
+        if (_droppedRaces++ == 0)
+        {
+            Logger::Warn(std::format("Update race detector holds {} races; further ones are counted, not kept", MaxRaces));
+        }
+        return;
+    }
+    _knownRaces.insert(race);
+    _races.push_back(race);
+
+    const std::string &name = race.gameObject->GetName();
+    switch (race.kind)
+    {
+    case ComponentRaceKind::Conflict:
+        Logger::Warn(std::format("Update race on '{}': {} writes {} while {} touches it in parallel", name,
+                                 accessor.GetTypeName(), race.resource.name(), other.GetTypeName()));
+        break;
+    case ComponentRaceKind::Undeclared:
+        Logger::Warn(std::format("Update race on '{}': {} {} {} without declaring it", name, accessor.GetTypeName(),
+                                 race.write ? "writes" : "reads", race.resource.name()));
+        break;
+    case ComponentRaceKind::OtherGameObject:
+        Logger::Warn(std::format("Update race on '{}': {} {} its {} from another GameObject in parallel", name,
+                                 accessor.GetTypeName(), race.write ? "writes" : "reads", race.resource.name()));
+        break;
+    }
+}
@@ -15,20 +15,22 @@ bool Coroutine::MoveNext()
         return false;
     }
 
-    if (_currentYield.has_value())
+    _currentYield.reset();
+    if (_it.has_value())
     {
-        if (_currentYield->Wait())
-            return true;
-        _currentYield.reset();
+        ++*_it;
+    }
+    else
+    {
+        _it.emplace(_gen.begin());
     }
 
-    auto it = _gen.begin();
-    if (it == _gen.end())
+    if (*_it == _gen.end())
     {
         _isComplete = true;
         return false;
     }
 
-    _currentYield = *it;
-    return !_currentYield->Wait();
+    _currentYield.emplace(std::move(**_it));
+    return true;
 }
\ No newline at end of file
@@ -4,31 +4,58 @@
 #include "engine/scheduling/CoroutineScheduler.hpp"
 
 #include "engine/Application.hpp"
+#include "engine/Time.hpp"
 #include "engine/scheduling/Coroutine.hpp"
 #include "engine/GameObjectScene.hpp"
 
 using namespace N2Engine::Scheduling;
 
+namespace
+{
+    // Heap entries for stopped coroutines tolerated before the heaps are swept
+    constexpr size_t StaleWakeupSlack = 1024;
+
+    template <typename Wakeup>
+    bool DueLater(const Wakeup &a, const Wakeup &b)
+    {
+        return a.due > b.due || (a.due == b.due && a.sequence > b.sequence);
+    }
+}
+
 CoroutineScheduler::CoroutineScheduler(Scene *scene)
     : _scene(scene) {}
 
 
 void CoroutineScheduler::Update()
 {
-    std::vector<std::pair<GameObject*, Coroutine*>> coroutinesToRemove;
-    CleanupInvalid();
+    Update(Time::GetDeltaTime());
+}
+
+void CoroutineScheduler::Update(const double deltaSeconds)
+{
+    ++_frame;
+    _time += deltaSeconds;
+
+    WakeDue(_frameWakeups, static_cast<double>(_frame));
+    WakeDue(_timeWakeups, _time);
+    PollWaits();
 
-    for (auto &[gameObject, coroutineList] : _coroutines)
+    // Whatever the resumed coroutines start or yield for the next frame lands in _ready for the next Update
+    _resuming.swap(_ready);
+    for (const Ticket &ticket : _resuming)
     {
-        for (auto &coroutine : coroutineList)
+        Resume(ticket);
+    }
+    _resuming.clear();
+
+    if (_frameWakeups.size() + _timeWakeups.size() > 2 * _liveCount + StaleWakeupSlack)
+    {
+        for (std::vector<Wakeup> *wakeups : {&_frameWakeups, &_timeWakeups})
         {
-            if (AdvanceCoroutine(coroutine.get()))
-            {
-                coroutinesToRemove.emplace_back(gameObject, coroutine.get());
-            }
+            std::erase_if(*wakeups, [this](const Wakeup &wakeup) { return !IsLive(wakeup.ticket); });
+            std::ranges::make_heap(*wakeups, DueLater<Wakeup>);
         }
     }
-    CleanupCompleted(coroutinesToRemove);
 }
 
 Coroutine* CoroutineScheduler::StartCoroutine(GameObject *gameObject, std::generator<ICoroutineWait> &&generator)
@@ -37,10 +64,35 @@ Coroutine* CoroutineScheduler::StartCoroutine(GameObject *gameObject, std::gener
     {
         return nullptr;
     }
-    auto routine = std::make_unique<Coroutine>(std::move(generator));
 
-    _coroutines[gameObject].push_back(std::move(routine));
-    return _coroutines[gameObject].back().get();
+    uint32_t index;
+    if (!_freeSlots.empty())
+    {
+        index = _freeSlots.back();
+        _freeSlots.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(_slots.size());
+        _slots.emplace_back();
+    }
+
+    Slot &slot = _slots[index];
+    slot.coroutine.emplace(std::move(generator));
+    slot.gameObject = gameObject;
+    slot.prevOwned = NoSlot;
+    slot.nextOwned = NoSlot;
+    if (const auto [it, inserted] = _firstOwned.try_emplace(gameObject, index); !inserted)
+    {
+        slot.nextOwned = it->second;
+        _slots[it->second].prevOwned = index;
+        it->second = index;
+    }
+    ++_liveCount;
+
+    // First runs to its first yield on the next Update
+    _ready.push_back(Ticket{index, slot.generation});
+    return &*slot.coroutine;
 }
 
 bool CoroutineScheduler::StopCoroutine(GameObject *gameObject, Coroutine *coroutine)
@@ -49,18 +101,24 @@ bool CoroutineScheduler::StopCoroutine(GameObject *gameObject, Coroutine *corout
     {
         return false;
     }
-    if (const auto it = _coroutines.find(gameObject); it != _coroutines.end())
+    const auto it = _firstOwned.find(gameObject);
+    if (it == _firstOwned.end())
     {
-        auto &coroutineList = it->second;
-        const auto coroutineIt = std::ranges::find_if(coroutineList,
-                                                      [coroutine](const std::unique_ptr<Coroutine> &ptr)
-                                                      {
-                                                          return ptr.get() == coroutine;
-                                                      });
+        return false;
+    }
 
-        if (coroutineIt != coroutineList.end())
+    for (uint32_t index = it->second; index != NoSlot; index = _slots[index].nextOwned)
+    {
+        if (&*_slots[index].coroutine == coroutine)
         {
-            coroutineList.erase(coroutineIt);
+            if (index == _runningSlot)
+            {
+                _runningStopped = true;
+            }
+            else
+            {
+                Release(index);
+            }
             return true;
         }
     }
@@ -69,9 +127,24 @@ bool CoroutineScheduler::StopCoroutine(GameObject *gameObject, Coroutine *corout
 
 void CoroutineScheduler::StopAllCoroutines(GameObject *gameObject)
 {
-    if (const auto it = _coroutines.find(gameObject); it != _coroutines.end())
+    const auto it = _firstOwned.find(gameObject);
+    if (it == _firstOwned.end())
     {
-        it->second.clear();
+        return;
+    }
+
+    for (uint32_t index = it->second; index != NoSlot;)
+    {
+        const uint32_t next = _slots[index].nextOwned;
+        if (index == _runningSlot)
+        {
+            _runningStopped = true;
+        }
+        else
+        {
+            Release(index);
+        }
+        index = next;
     }
 }
 
@@ -94,56 +167,142 @@ void CoroutineScheduler::StopAllCoroutines(const Scene *curScene, GameObject *ga
 
 bool CoroutineScheduler::RemoveGameObject(GameObject *gameObject)
 {
-    return _coroutines.erase(gameObject) > 0;
+    if (!_firstOwned.contains(gameObject))
+    {
+        return false;
+    }
+    StopAllCoroutines(gameObject);
+    return true;
 }
 
-bool CoroutineScheduler::AdvanceCoroutine(Coroutine *coroutine)
+bool CoroutineScheduler::IsLive(const Ticket &ticket) const
 {
-    return !coroutine->MoveNext(); // Returns true when coroutine is complete
+    return _slots[ticket.slot].generation == ticket.generation;
 }
 
-void CoroutineScheduler::CleanupCompleted(const std::vector<std::pair<GameObject*, Coroutine*>> &coroutinesToRemove)
+void CoroutineScheduler::Resume(const Ticket &ticket)
 {
-    for (const auto &[gameObject, coroutine] : coroutinesToRemove)
+    if (!IsLive(ticket))
     {
-        if (auto it = _coroutines.find(gameObject); it != _coroutines.end())
-        {
-            auto &coroutineList = it->second;
-            auto coroutineIt = std::ranges::find_if(coroutineList,
-                                                    [coroutine](const std::unique_ptr<Coroutine> &ptr)
-                                                    {
-                                                        return ptr.get() == coroutine;
-                                                    });
-
-            if (coroutineIt != coroutineList.end())
-            {
-                coroutineList.erase(coroutineIt);
+        return;
+    }
+    // Coroutines of inactive or destroyed GameObjects are dropped when they next come due
+    if (!_slots[ticket.slot].gameObject->IsActiveInHierarchy())
+    {
+        Release(ticket.slot);
+        return;
+    }
 
-                // Remove GameObject if it has no more coroutines
-                if (coroutineList.empty())
-                {
-                    _coroutines.erase(it);
-                }
-            }
+    _runningSlot = ticket.slot;
+    _runningStopped = false;
+    const bool running = _slots[ticket.slot].coroutine->MoveNext();
+    _runningSlot = NoSlot;
+
+    if (running && !_runningStopped)
+    {
+        Park(ticket.slot);
+    }
+    else
+    {
+        Release(ticket.slot);
+    }
+}
+
+void CoroutineScheduler::Park(const uint32_t slot)
+{
+    const Ticket ticket{slot, _slots[slot].generation};
+    const CoroutineWaitSchedule schedule = _slots[slot].coroutine->_currentYield->Schedule();
+    switch (schedule.kind)
+    {
+    case CoroutineWaitKind::NextFrame:
+        _ready.push_back(ticket);
+        break;
+    case CoroutineWaitKind::Frames:
+        if (schedule.amount <= 1.0)
+        {
+            _ready.push_back(ticket);
+            break;
         }
+        _frameWakeups.push_back(Wakeup{static_cast<double>(_frame) + schedule.amount, _sequence++, ticket});
+        std::ranges::push_heap(_frameWakeups, DueLater<Wakeup>);
+        break;
+    case CoroutineWaitKind::Seconds:
+        if (schedule.amount <= 0.0)
+        {
+            _ready.push_back(ticket);
+            break;
+        }
+        _timeWakeups.push_back(Wakeup{_time + schedule.amount, _sequence++, ticket});
+        std::ranges::push_heap(_timeWakeups, DueLater<Wakeup>);
+        break;
+    case CoroutineWaitKind::Forever:
+        // Only StopCoroutine ends it
+        break;
+    case CoroutineWaitKind::Poll:
+        _polling.push_back(ticket);
+        break;
     }
 }
 
-void CoroutineScheduler::CleanupInvalid()
+void CoroutineScheduler::WakeDue(std::vector<Wakeup> &wakeups, const double now)
 {
-    for (auto it = _coroutines.begin(); it != _coroutines.end();)
+    while (!wakeups.empty() && wakeups.front().due <= now)
     {
-        const GameObject *curGameObject = it->first;
-        const bool curGameObjectIsInvalid = curGameObject == nullptr || curGameObject->IsActiveInHierarchy() ||
-            curGameObject->IsDestroyed();
+        std::ranges::pop_heap(wakeups, DueLater<Wakeup>);
+        if (IsLive(wakeups.back().ticket))
+        {
+            _ready.push_back(wakeups.back().ticket);
+        }
+        wakeups.pop_back();
+    }
+}
 
-        if (curGameObjectIsInvalid || it->second.empty())
+void CoroutineScheduler::PollWaits()
+{
+    size_t kept = 0;
+    for (const Ticket &ticket : _polling)
+    {
+        if (!IsLive(ticket))
         {
-            it = _coroutines.erase(it);
+            continue;
+        }
+        if (_slots[ticket.slot].coroutine->_currentYield->Wait())
+        {
+            _polling[kept++] = ticket;
         }
         else
         {
-            ++it;
+            _ready.push_back(ticket);
         }
     }
+    _polling.resize(kept);
+}
+
+void CoroutineScheduler::Release(const uint32_t slot)
+{
+    Slot &released = _slots[slot];
+    if (released.prevOwned != NoSlot)
+    {
+        _slots[released.prevOwned].nextOwned = released.nextOwned;
+    }
+    else if (released.nextOwned != NoSlot)
+    {
+        _firstOwned[released.gameObject] = released.nextOwned;
+    }
+    else
+    {
+        _firstOwned.erase(released.gameObject);
+    }
+    if (released.nextOwned != NoSlot)
+    {
+        _slots[released.nextOwned].prevOwned = released.prevOwned;
+    }
+
+    released.coroutine.reset();
+    released.gameObject = nullptr;
+    released.prevOwned = NoSlot;
+    released.nextOwned = NoSlot;
+    ++released.generation;
+    _freeSlots.push_back(slot);
+    --_liveCount;
 }
@@ -8,19 +8,49 @@ bool WaitForNextFrame::Wait()
     return false;
 }
 
+CoroutineWaitSchedule WaitForNextFrame::Schedule() const
+{
+    return {CoroutineWaitKind::NextFrame};
+}
+
 bool WaitForFrames::Wait()
 {
     _elapsedFrames++;
     return _elapsedFrames < _waitFrames;
 }
 
+CoroutineWaitSchedule WaitForFrames::Schedule() const
+{
+    return {CoroutineWaitKind::Frames, static_cast<double>(_waitFrames)};
+}
+
 bool WaitForSeconds::Wait()
 {
     _elapsedSeconds += Time::GetDeltaTime();
     return _elapsedSeconds < _waitSeconds;
 }
 
+CoroutineWaitSchedule WaitForSeconds::Schedule() const
+{
+    return {CoroutineWaitKind::Seconds, static_cast<double>(_waitSeconds)};
+}
+
 bool WaitForever::Wait()
 {
     return true;
+}
+
+CoroutineWaitSchedule WaitForever::Schedule() const
+{
+    return {CoroutineWaitKind::Forever};
+}
+
+bool WaitUntil::Wait()
+{
+    return !_predicate();
+}
+
+bool WaitWhile::Wait()
+{
+    return _predicate();
 }
\ No newline at end of file
@@ -0,0 +1,233 @@
+#include "engine/scheduling/JobSystem.hpp"
+
+#include <format>
+#include <optional>
+
+#include "engine/Logger.hpp"
+
+using namespace N2Engine::Scheduling;
+
+namespace
+{
+    // Queue owned by the current thread in the pool it belongs to
+    thread_local const JobSystem *currentSystem = nullptr;
+    thread_local size_t currentQueue = 0;
+}
+
+JobCounter::~JobCounter()
+{
+    // The last finisher may still hold the lock after the count reached zero
+    std::scoped_lock lock{_mutex};
+}
+
+JobSystem &JobSystem::Instance()
+{
+    // Never destroyed: workers may still be parked when static destructors run
+    static auto *instance = new JobSystem();
+    return *instance;
+}
+
+JobSystem::JobSystem()
+{
+    _queues.push_back(std::make_unique<WorkerQueue>());
+}
+
+void JobSystem::Initialize(unsigned threadCount)
+{
+    Shutdown();
+
+    if (threadCount == 0)
+    {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    currentSystem = this;
+    currentQueue = 0;
+    _running = true;
+    for (unsigned i = 1; i < threadCount; ++i)
+    {
+        _queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (size_t i = 1; i < _queues.size(); ++i)
+    {
+        _workers.emplace_back([this, i] { WorkerLoop(i); });
+    }
+    Logger::Info(std::format("Job system running on {} threads", GetThreadCount()));
+}
+
+void JobSystem::Shutdown()
+{
+    while (_queued.load() > 0)
+    {
+        RunOne(0);
+    }
+
+    {
+        std::scoped_lock lock{_sleepMutex};
+        _running = false;
+    }
+    _wake.notify_all();
+    for (std::thread &worker : _workers)
+    {
+        worker.join();
+    }
+    _workers.clear();
+    _queues.resize(1);
+}
+
+JobSystemStats JobSystem::GetStats() const
+{
+    return JobSystemStats{GetThreadCount(), _executed.load(std::memory_order_relaxed), _stolen.load(std::memory_order_relaxed)};
+}
+
+void JobSystem::Submit(Job job, JobCounter *counter)
+{
+    if (counter)
+    {
+        counter->_pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    Enqueue(QueuedJob{std::move(job), counter});
+}
+
+void JobSystem::SubmitAfter(JobCounter &after, Job job, JobCounter *counter)
+{
+    if (counter)
+    {
+        counter->_pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    {
+        std::scoped_lock lock{after._mutex};
+        if (after._pending.load(std::memory_order_acquire) > 0)
+        {
+            after._continuations.emplace_back(std::move(job), counter);
+            return;
+        }
+    }
+    Enqueue(QueuedJob{std::move(job), counter});
+}
+
+void JobSystem::Wait(JobCounter &counter)
+{
+    const size_t home = CurrentQueue();
+    while (!counter.IsDone())
+    {
+        if (!RunOne(home))
+        {
+            std::this_thread::yield();
+        }
+    }
+    // Returning lets the caller destroy the counter: wait for the last finisher to let go of it
+    std::scoped_lock lock{counter._mutex};
+}
+
+void JobSystem::Enqueue(QueuedJob job)
+{
+    // Counted before it is visible, so a thief never takes the count below zero.
+    // Pairs with a sleeper raising _sleeping before it rechecks _queued.
+    _queued.fetch_add(1);
+    WorkerQueue &queue = *_queues[CurrentQueue()];
+    {
+        std::scoped_lock lock{queue.mutex};
+        queue.jobs.push_back(std::move(job));
+    }
+
+    if (_sleeping.load() > 0)
+    {
+        {
+            std::scoped_lock lock{_sleepMutex};
+        }
+        _wake.notify_one();
+    }
+}
+
+bool JobSystem::RunOne(const size_t home)
+{
+    std::optional<QueuedJob> job;
+    {
+        // Newest first from our own queue: its data is most likely still in cache
+        WorkerQueue &queue = *_queues[home];
+        std::scoped_lock lock{queue.mutex};
+        if (!queue.jobs.empty())
+        {
+            job.emplace(std::move(queue.jobs.back()));
+            queue.jobs.pop_back();
+        }
+    }
+    for (size_t offset = 1; !job && offset < _queues.size(); ++offset)
+    {
+        // Oldest first from a victim: the largest remaining work, furthest from what it runs next
+        WorkerQueue &victim = *_queues[(home + offset) % _queues.size()];
+        std::scoped_lock lock{victim.mutex};
+        if (!victim.jobs.empty())
+        {
+            job.emplace(std::move(victim.jobs.front()));
+            victim.jobs.pop_front();
+            _stolen.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    if (!job)
+    {
+        return false;
+    }
+
+    _queued.fetch_sub(1);
+    job->work();
+    _executed.fetch_add(1, std::memory_order_relaxed);
+    Finish(job->counter);
+    return true;
+}
+
+void JobSystem::Finish(JobCounter *counter)
+{
+    if (!counter)
+    {
+        return;
+    }
+
+    std::vector<std::pair<Job, JobCounter*>> ready;
+    {
+        std::scoped_lock lock{counter->_mutex};
+        if (counter->_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            ready.swap(counter->_continuations);
+        }
+    }
+    for (auto &[job, continuationCounter] : ready)
+    {
+        Enqueue(QueuedJob{std::move(job), continuationCounter});
+    }
+}
+
+void JobSystem::WorkerLoop(const size_t queue)
+{
+    currentSystem = this;
+    currentQueue = queue;
+
+    while (true)
+    {
+        if (RunOne(queue))
+        {
+            continue;
+        }
+
+        std::unique_lock lock{_sleepMutex};
+        _sleeping.fetch_add(1);
+        _wake.wait(lock, [this] { return _queued.load() > 0 || !_running; });
+        _sleeping.fetch_sub(1);
+        if (!_running)
+        {
+            return;
+        }
+    }
+}
+
+bool JobSystem::IsWorkerThread() const
+{
+    return CurrentQueue() != 0;
+}
+
+size_t JobSystem::CurrentQueue() const
+{
+    // Threads outside the pool share the initializing thread's queue
+    return currentSystem == this ? currentQueue : 0;
+}
@@ -29,14 +29,16 @@ namespace N2Engine::Scripting::Bindings
             
             "GetCenter", &BoundingBox::GetCenter,
             "GetExtents", &BoundingBox::GetExtents,
-            "GetCorner", &BoundingBox::GetCorner
+            "GetCorner", &BoundingBox::GetCorner,
+            "Merged", &BoundingBox::Merged
         );
         
         // ===== Frustum =====
         lua.new_usertype<Frustum>("Frustum",
             sol::no_constructor,
             
-            "IsVisible", &Frustum::IsVisible
+            "IsVisible", &Frustum::IsVisible,
+            "Contains", &Frustum::Contains
         );
         
         // ===== Camera =====
@@ -6,6 +6,20 @@
 
 namespace N2Engine::Scripting::Bindings
 {
+    namespace
+    {
+        std::vector<std::shared_ptr<GameObject>> ToShared(const std::vector<GameObject*> &gameObjects)
+        {
+            std::vector<std::shared_ptr<GameObject>> result;
+            result.reserve(gameObjects.size());
+            for (GameObject *gameObject : gameObjects)
+            {
+                result.push_back(gameObject->shared_from_this());
+            }
+            return result;
+        }
+    }
+
     void BindCore(LuaRuntime &runtime)
     {
         auto &lua = runtime.GetState();
@@ -72,7 +86,41 @@ namespace N2Engine::Scripting::Bindings
             "GetRootGameObjects", &Scene::GetRootGameObjects,
             "AddRootGameObject", &Scene::AddRootGameObject,
             "RemoveRootGameObject", &Scene::RemoveRootGameObject,
-            "DestroyGameObject", &Scene::DestroyGameObject
+            "DestroyGameObject", &Scene::DestroyGameObject,
+
+            "QueryBox", [](const Scene &scene, const BoundingBox &box)
+            {
+                std::vector<GameObject*> found;
+                scene.GetSpatialIndex().QueryBox(box, found);
+                return ToShared(found);
+            },
+            "QuerySphere", [](const Scene &scene, const Math::Vector3 &center, float radius)
+            {
+                std::vector<GameObject*> found;
+                scene.GetSpatialIndex().QuerySphere(center, radius, found);
+                return ToShared(found);
+            },
+            // Returns the hit objects and their distances, nearest first
+            "QueryRay", [](const Scene &scene, const Math::Vector3 &origin, const Math::Vector3 &direction,
+                           float maxDistance)
+            {
+                std::vector<Spatial::SpatialIndex::RayHit> hits;
+                scene.GetSpatialIndex().QueryRay(origin, direction, maxDistance, hits);
+                std::vector<std::shared_ptr<GameObject>> gameObjects;
+                std::vector<float> distances;
+                for (const auto &hit : hits)
+                {
+                    gameObjects.push_back(hit.gameObject->shared_from_this());
+                    distances.push_back(hit.distance);
+                }
+                return std::make_tuple(gameObjects, distances);
+            },
+            "QueryNearest", [](const Scene &scene, const Math::Vector3 &point, size_t count)
+            {
+                std::vector<GameObject*> found;
+                scene.GetSpatialIndex().QueryNearest(point, count, found);
+                return ToShared(found);
+            }
         );
 
         // ===== SceneManager (global) =====
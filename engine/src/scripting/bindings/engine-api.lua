@@ -796,6 +796,31 @@ function Scene:RemoveRootGameObject(gameObject) end
 ---@return boolean
 function Scene:DestroyGameObject(gameObject) end
 
+---Find positioned GameObjects whose bounds overlap a box
+---@param box BoundingBox
+---@return GameObject[]
+function Scene:QueryBox(box) end
+
+---Find positioned GameObjects whose bounds come within radius of a point
+---@param center Vector3
+---@param radius number
+---@return GameObject[]
+function Scene:QuerySphere(center, radius) end
+
+---Find positioned GameObjects whose bounds a ray passes through, nearest first
+---@param origin Vector3
+---@param direction Vector3
+---@param maxDistance number
+---@return GameObject[] gameObjects
+---@return number[] distances Distance along the ray to each hit
+function Scene:QueryRay(origin, direction, maxDistance) end
+
+---Find the count positioned GameObjects nearest to a point, nearest first
+---@param point Vector3
+---@param count integer
+---@return GameObject[]
+function Scene:QueryNearest(point, count) end
+
 ---@class SceneManager
 SceneManager = {}
 
@@ -1387,6 +1412,11 @@ function BoundingBox:GetExtents() end
 ---@return Vector3
 function BoundingBox:GetCorner(index) end
 
+---Get the smallest bounding box holding both boxes
+---@param other BoundingBox
+---@return BoundingBox
+function BoundingBox:Merged(other) end
+
 ---@class Frustum
 Frustum = {}
 
@@ -1395,6 +1425,11 @@ Frustum = {}
 ---@return boolean
 function Frustum:IsVisible(bbox) end
 
+---Check if a bounding box lies entirely inside the frustum
+---@param bbox BoundingBox
+---@return boolean
+function Frustum:Contains(bbox) end
+
 ---@class Camera
 Camera = {}
 
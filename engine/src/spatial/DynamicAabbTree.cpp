@@ -0,0 +1,300 @@
+#include "engine/spatial/DynamicAabbTree.hpp"
+
+#include <cassert>
+
+using namespace N2Engine;
+using namespace N2Engine::Spatial;
+
+namespace
+{
+    BoundingBox Union(const BoundingBox &a, const BoundingBox &b)
+    {
+        return BoundingBox{
+            Math::Vector3{std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z)},
+            Math::Vector3{std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z)}
+        };
+    }
+
+    // Half the surface area: the insertion cost only compares areas
+    float Area(const BoundingBox &box)
+    {
+        const float x = box.max.x - box.min.x;
+        const float y = box.max.y - box.min.y;
+        const float z = box.max.z - box.min.z;
+        return x * y + y * z + z * x;
+    }
+
+    bool Holds(const BoundingBox &outer, const BoundingBox &inner)
+    {
+        return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+            inner.max.x <= outer.max.x && inner.max.y <= outer.max.y && inner.max.z <= outer.max.z;
+    }
+}
+
+DynamicAabbTree::DynamicAabbTree(const float margin)
+    : _margin{margin} {}
+
+float DynamicAabbTree::DistanceSquared(const BoundingBox &box, const Math::Vector3 &point)
+{
+    const float dx = std::max({box.min.x - point.x, 0.f, point.x - box.max.x});
+    const float dy = std::max({box.min.y - point.y, 0.f, point.y - box.max.y});
+    const float dz = std::max({box.min.z - point.z, 0.f, point.z - box.max.z});
+    return dx * dx + dy * dy + dz * dz;
+}
+
+int32_t DynamicAabbTree::CreateProxy(const BoundingBox &box, const uint32_t userData)
+{
+    const int32_t proxy = AllocateNode();
+    _nodes[proxy].box = Fatten(box, Math::Vector3{0.f, 0.f, 0.f});
+    _nodes[proxy].userData = userData;
+    _nodes[proxy].height = 0;
+    InsertLeaf(proxy);
+    ++_proxyCount;
+    return proxy;
+}
+
+void DynamicAabbTree::DestroyProxy(const int32_t proxy)
+{
+    assert(_nodes[proxy].IsLeaf());
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+    --_proxyCount;
+}
+
+bool DynamicAabbTree::MoveProxy(const int32_t proxy, const BoundingBox &box, const Math::Vector3 &displacement)
+{
+    const BoundingBox fat = Fatten(box, displacement);
+    const BoundingBox &current = _nodes[proxy].box;
+    if (Holds(current, box))
+    {
+        // Keep the leaf unless its fat box has grown far beyond what is needed now,
+        // as it does after a fast move followed by a slow one
+        const Math::Vector3 slack{4.f * _margin, 4.f * _margin, 4.f * _margin};
+        if (Holds(BoundingBox{fat.min - slack, fat.max + slack}, current))
+        {
+            return false;
+        }
+    }
+
+    RemoveLeaf(proxy);
+    _nodes[proxy].box = fat;
+    InsertLeaf(proxy);
+    return true;
+}
+
+void DynamicAabbTree::Clear()
+{
+    _nodes.clear();
+    _root = NullNode;
+    _freeList = NullNode;
+    _proxyCount = 0;
+}
+
+BoundingBox DynamicAabbTree::Fatten(const BoundingBox &box, const Math::Vector3 &displacement) const
+{
+    // Extend towards where the box is heading so steady motion rarely leaves it
+    BoundingBox fat{
+        Math::Vector3{box.min.x - _margin, box.min.y - _margin, box.min.z - _margin},
+        Math::Vector3{box.max.x + _margin, box.max.y + _margin, box.max.z + _margin}
+    };
+    const Math::Vector3 ahead{4.f * displacement.x, 4.f * displacement.y, 4.f * displacement.z};
+    (ahead.x < 0.f ? fat.min.x : fat.max.x) += ahead.x;
+    (ahead.y < 0.f ? fat.min.y : fat.max.y) += ahead.y;
+    (ahead.z < 0.f ? fat.min.z : fat.max.z) += ahead.z;
+    return fat;
+}
+
+int32_t DynamicAabbTree::AllocateNode()
+{
+    if (_freeList == NullNode)
+    {
+        _nodes.emplace_back();
+        return static_cast<int32_t>(_nodes.size() - 1);
+    }
+    const int32_t node = _freeList;
+    _freeList = _nodes[node].parent;
+    _nodes[node] = Node{};
+    return node;
+}
+
+void DynamicAabbTree::FreeNode(const int32_t node)
+{
+    _nodes[node].parent = _freeList;
+    _nodes[node].height = -1;
+    _freeList = node;
+}
+
+void DynamicAabbTree::InsertLeaf(const int32_t leaf)
+{
+    if (_root == NullNode)
+    {
+        _root = leaf;
+        _nodes[leaf].parent = NullNode;
+        return;
+    }
+
+    // Descend towards the sibling that grows the tree's total area the least
+    const BoundingBox leafBox = _nodes[leaf].box;
+    int32_t index = _root;
+    while (!_nodes[index].IsLeaf())
+    {
+        const Node &node = _nodes[index];
+        const float area = Area(node.box);
+        const float combinedArea = Area(Union(node.box, leafBox));
+
+        // Pairing with this node creates a parent of the combined area, and every
+        // ancestor further down grows by the same amount as this one
+        const float cost = 2.f * combinedArea;
+        const float inheritanceCost = 2.f * (combinedArea - area);
+
+        const auto descendCost = [&](const int32_t child)
+        {
+            const BoundingBox box = Union(leafBox, _nodes[child].box);
+            if (_nodes[child].IsLeaf())
+            {
+                return Area(box) + inheritanceCost;
+            }
+            return Area(box) - Area(_nodes[child].box) + inheritanceCost;
+        };
+        const float cost1 = descendCost(node.child1);
+        const float cost2 = descendCost(node.child2);
+
+        if (cost < cost1 && cost < cost2)
+        {
+            break;
+        }
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    const int32_t sibling = index;
+    const int32_t oldParent = _nodes[sibling].parent;
+    const int32_t newParent = AllocateNode();
+    _nodes[newParent].parent = oldParent;
+    _nodes[newParent].box = Union(leafBox, _nodes[sibling].box);
+    _nodes[newParent].height = _nodes[sibling].height + 1;
+    _nodes[newParent].child1 = sibling;
+    _nodes[newParent].child2 = leaf;
+    _nodes[sibling].parent = newParent;
+    _nodes[leaf].parent = newParent;
+
+    if (oldParent == NullNode)
+    {
+        _root = newParent;
+    }
+    else if (_nodes[oldParent].child1 == sibling)
+    {
+        _nodes[oldParent].child1 = newParent;
+    }
+    else
+    {
+        _nodes[oldParent].child2 = newParent;
+    }
+
+    RefitAncestors(newParent);
+}
+
+void DynamicAabbTree::RemoveLeaf(const int32_t leaf)
+{
+    if (leaf == _root)
+    {
+        _root = NullNode;
+        return;
+    }
+
+    // The leaf's parent goes away and its sibling takes the parent's place
+    const int32_t parent = _nodes[leaf].parent;
+    const int32_t grandParent = _nodes[parent].parent;
+    const int32_t sibling = _nodes[parent].child1 == leaf ? _nodes[parent].child2 : _nodes[parent].child1;
+
+    _nodes[sibling].parent = grandParent;
+    FreeNode(parent);
+    if (grandParent == NullNode)
+    {
+        _root = sibling;
+        return;
+    }
+
+    if (_nodes[grandParent].child1 == parent)
+    {
+        _nodes[grandParent].child1 = sibling;
+    }
+    else
+    {
+        _nodes[grandParent].child2 = sibling;
+    }
+    RefitAncestors(grandParent);
+}
+
+void DynamicAabbTree::RefitAncestors(int32_t node)
+{
+    while (node != NullNode)
+    {
+        node = Balance(node);
+        Node &current = _nodes[node];
+        current.height = 1 + std::max(_nodes[current.child1].height, _nodes[current.child2].height);
+        current.box = Union(_nodes[current.child1].box, _nodes[current.child2].box);
+        node = current.parent;
+    }
+}
+
+int32_t DynamicAabbTree::Balance(const int32_t a)
+{
+    // Rotates the taller grandchild up when A's children differ in height by more than one
+    Node &nodeA = _nodes[a];
+    if (nodeA.IsLeaf() || nodeA.height < 2)
+    {
+        return a;
+    }
+
+    const int32_t b = nodeA.child1;
+    const int32_t c = nodeA.child2;
+    const int32_t balance = _nodes[c].height - _nodes[b].height;
+    if (balance >= -1 && balance <= 1)
+    {
+        return a;
+    }
+
+    // The taller child rises to A's place; A keeps the shorter child and one of its grandchildren
+    const int32_t up = balance > 1 ? c : b;
+    const int32_t kept = balance > 1 ? b : c;
+    Node &nodeUp = _nodes[up];
+    const int32_t f = nodeUp.child1;
+    const int32_t g = nodeUp.child2;
+
+    nodeUp.child1 = a;
+    nodeUp.parent = nodeA.parent;
+    nodeA.parent = up;
+    if (nodeUp.parent == NullNode)
+    {
+        _root = up;
+    }
+    else if (_nodes[nodeUp.parent].child1 == a)
+    {
+        _nodes[nodeUp.parent].child1 = up;
+    }
+    else
+    {
+        _nodes[nodeUp.parent].child2 = up;
+    }
+
+    // The taller grandchild stays under the risen node, the shorter one moves under A
+    const bool fTaller = _nodes[f].height > _nodes[g].height;
+    const int32_t stays = fTaller ? f : g;
+    const int32_t moves = fTaller ? g : f;
+    nodeUp.child2 = stays;
+    if (balance > 1)
+    {
+        nodeA.child2 = moves;
+    }
+    else
+    {
+        nodeA.child1 = moves;
+    }
+    _nodes[moves].parent = a;
+
+    nodeA.box = Union(_nodes[kept].box, _nodes[moves].box);
+    nodeA.height = 1 + std::max(_nodes[kept].height, _nodes[moves].height);
+    nodeUp.box = Union(nodeA.box, _nodes[stays].box);
+    nodeUp.height = 1 + std::max(nodeA.height, _nodes[stays].height);
+    return up;
+}
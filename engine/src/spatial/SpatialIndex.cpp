@@ -0,0 +1,263 @@
+#include "engine/spatial/SpatialIndex.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "engine/GameObjectScene.hpp"
+#include "engine/IRenderable.hpp"
+#include "engine/Positionable.hpp"
+
+using namespace N2Engine;
+using namespace N2Engine::Spatial;
+
+namespace
+{
+    bool Overlaps(const BoundingBox &a, const BoundingBox &b)
+    {
+        return a.min.x <= b.max.x && b.min.x <= a.max.x && a.min.y <= b.max.y && b.min.y <= a.max.y &&
+            a.min.z <= b.max.z && b.min.z <= a.max.z;
+    }
+
+    // Slab test: distance along the ray where it enters the box, or a negative value on a miss
+    float RayEntry(const BoundingBox &box, const float origin[3], const float inverse[3], const float maxDistance)
+    {
+        const float mins[3] = {box.min.x, box.min.y, box.min.z};
+        const float maxs[3] = {box.max.x, box.max.y, box.max.z};
+        float enter = 0.f;
+        float leave = maxDistance;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            float t0 = (mins[axis] - origin[axis]) * inverse[axis];
+            float t1 = (maxs[axis] - origin[axis]) * inverse[axis];
+            if (t0 > t1)
+            {
+                std::swap(t0, t1);
+            }
+            // NaN from 0 * inf means the ray runs inside this slab's plane: no constraint
+            enter = t0 > enter ? t0 : enter;
+            leave = t1 < leave ? t1 : leave;
+            if (enter > leave)
+            {
+                return -1.f;
+            }
+        }
+        return enter;
+    }
+}
+
+SpatialIndex::~SpatialIndex()
+{
+    ReleaseAll();
+}
+
+SpatialIndex::SpatialIndex(SpatialIndex &&other) noexcept
+    : _tree{std::move(other._tree)},
+      _entries{std::move(other._entries)}
+{
+    for (const Entry &entry : _entries)
+    {
+        entry.gameObject->_spatialIndex = this;
+    }
+    other._tree.Clear();
+    other._entries.clear();
+}
+
+SpatialIndex& SpatialIndex::operator=(SpatialIndex &&other) noexcept
+{
+    if (this != &other)
+    {
+        ReleaseAll();
+        _tree = std::move(other._tree);
+        _entries = std::move(other._entries);
+        for (const Entry &entry : _entries)
+        {
+            entry.gameObject->_spatialIndex = this;
+        }
+        other._tree.Clear();
+        other._entries.clear();
+    }
+    return *this;
+}
+
+void SpatialIndex::Insert(GameObject &gameObject)
+{
+    if (gameObject._spatialIndex == this || !gameObject.HasPositionable())
+    {
+        return;
+    }
+    if (gameObject._spatialIndex)
+    {
+        gameObject._spatialIndex->Remove(gameObject);
+    }
+
+    const auto index = static_cast<uint32_t>(_entries.size());
+    const BoundingBox bounds = ComputeBounds(gameObject);
+    _entries.push_back(Entry{&gameObject, _tree.CreateProxy(bounds, index),
+                             gameObject.GetPositionable()->GetWorldVersion(), bounds});
+    gameObject._spatialIndex = this;
+    gameObject._spatialEntry = index;
+}
+
+void SpatialIndex::Remove(GameObject &gameObject)
+{
+    if (gameObject._spatialIndex != this)
+    {
+        return;
+    }
+
+    // Swap the last entry into the hole so entries stay dense
+    const uint32_t index = gameObject._spatialEntry;
+    _tree.DestroyProxy(_entries[index].proxy);
+    if (index + 1 != _entries.size())
+    {
+        _entries[index] = _entries.back();
+        _entries[index].gameObject->_spatialEntry = index;
+        _tree.SetUserData(_entries[index].proxy, index);
+    }
+    _entries.pop_back();
+    gameObject._spatialIndex = nullptr;
+}
+
+void SpatialIndex::Clear()
+{
+    ReleaseAll();
+    _tree.Clear();
+    _entries.clear();
+}
+
+void SpatialIndex::ReleaseAll()
+{
+    // GameObjects can outlive the index; they must not point back into it
+    for (const Entry &entry : _entries)
+    {
+        entry.gameObject->_spatialIndex = nullptr;
+    }
+}
+
+BoundingBox SpatialIndex::ComputeBounds(GameObject &gameObject)
+{
+    for (IRenderable *renderable : gameObject.GetComponents<IRenderable>())
+    {
+        if (BoundingBox bounds; renderable->GetWorldBounds(bounds))
+        {
+            return bounds;
+        }
+    }
+    const Math::Vector3 position = gameObject.GetPositionable()->GetPosition();
+    return BoundingBox{position, position};
+}
+
+size_t SpatialIndex::Refit()
+{
+    size_t reinserted = 0;
+    for (Entry &entry : _entries)
+    {
+        const uint32_t version = entry.gameObject->GetPositionable()->GetWorldVersion();
+        if (version == entry.worldVersion)
+        {
+            continue;
+        }
+
+        const BoundingBox bounds = ComputeBounds(*entry.gameObject);
+        const Math::Vector3 displacement = bounds.GetCenter() - entry.bounds.GetCenter();
+        entry.worldVersion = version;
+        entry.bounds = bounds;
+        if (_tree.MoveProxy(entry.proxy, bounds, displacement))
+        {
+            ++reinserted;
+        }
+    }
+    return reinserted;
+}
+
+void SpatialIndex::QueryBox(const BoundingBox &box, std::vector<GameObject*> &out) const
+{
+    _tree.Query([&box](const BoundingBox &node) { return Overlaps(node, box); }, [&](const int32_t proxy)
+    {
+        const Entry &entry = _entries[_tree.GetUserData(proxy)];
+        if (Overlaps(entry.bounds, box))
+        {
+            out.push_back(entry.gameObject);
+        }
+        return true;
+    });
+}
+
+void SpatialIndex::QuerySphere(const Math::Vector3 &center, const float radius, std::vector<GameObject*> &out) const
+{
+    const float radiusSquared = radius * radius;
+    _tree.Query([&](const BoundingBox &node)
+    {
+        return DynamicAabbTree::DistanceSquared(node, center) <= radiusSquared;
+    }, [&](const int32_t proxy)
+    {
+        const Entry &entry = _entries[_tree.GetUserData(proxy)];
+        if (DynamicAabbTree::DistanceSquared(entry.bounds, center) <= radiusSquared)
+        {
+            out.push_back(entry.gameObject);
+        }
+        return true;
+    });
+}
+
+void SpatialIndex::QueryRay(const Math::Vector3 &origin, const Math::Vector3 &direction, const float maxDistance,
+                            std::vector<RayHit> &out) const
+{
+    const float length = std::sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
+    if (length <= 0.f)
+    {
+        return;
+    }
+
+    const float start[3] = {origin.x, origin.y, origin.z};
+    const float inverse[3] = {length / direction.x, length / direction.y, length / direction.z};
+    const size_t first = out.size();
+    _tree.Query([&](const BoundingBox &node) { return RayEntry(node, start, inverse, maxDistance) >= 0.f; },
+                [&](const int32_t proxy)
+                {
+                    const Entry &entry = _entries[_tree.GetUserData(proxy)];
+                    if (const float distance = RayEntry(entry.bounds, start, inverse, maxDistance); distance >= 0.f)
+                    {
+                        out.push_back(RayHit{entry.gameObject, distance});
+                    }
+                    return true;
+                });
+    std::sort(out.begin() + static_cast<std::ptrdiff_t>(first), out.end(),
+              [](const RayHit &a, const RayHit &b) { return a.distance < b.distance; });
+}
+
+void SpatialIndex::QueryNearest(const Math::Vector3 &point, const size_t k, std::vector<GameObject*> &out) const
+{
+    if (k == 0)
+    {
+        return;
+    }
+
+    // Max-heap of the k best so far; its top is the distance a candidate has to beat
+    std::vector<std::pair<float, GameObject*>> best;
+    best.reserve(k + 1);
+    _tree.QueryNearest(point, [&](const int32_t proxy)
+    {
+        const Entry &entry = _entries[_tree.GetUserData(proxy)];
+        const float distance = DynamicAabbTree::DistanceSquared(entry.bounds, point);
+        if (best.size() < k || distance < best.front().first)
+        {
+            best.emplace_back(distance, entry.gameObject);
+            std::push_heap(best.begin(), best.end());
+            if (best.size() > k)
+            {
+                std::pop_heap(best.begin(), best.end());
+                best.pop_back();
+            }
+        }
+        return best.size() < k ? std::numeric_limits<float>::max() : best.front().first;
+    });
+
+    std::sort_heap(best.begin(), best.end());
+    for (const auto &[distance, gameObject] : best)
+    {
+        out.push_back(gameObject);
+    }
+}
@@ -2,6 +2,9 @@
 
 #include <string>
 
+#include "renderer/common/MaterialParameters.hpp"
+#include "renderer/common/SlotMap.hpp"
+
 
 namespace N2Engine::Math
 {
@@ -15,11 +18,16 @@ namespace Renderer::Common
     class ITexture;
     class IShader;
 
-    class IMaterial
+    class IMaterial;
+    using MaterialHandle = ResourceHandle<IMaterial>;
+
+    class IMaterial : public SlotResident<IMaterial>
     {
     public:
         virtual ~IMaterial() = default;
 
+        // Name-based setters resolve the name on every call; hot paths should
+        // write GetParameters() with ids from MaterialProperty / ResolveMaterialProperty.
         virtual void SetInt(const std::string &name, int value) = 0;
         virtual void SetFloat(const std::string &name, float value) = 0;
         virtual void SetVec2(const std::string &name, float x, float y) = 0;
@@ -31,6 +39,9 @@ namespace Renderer::Common
         virtual void SetColor(const std::string &name, float r, float g, float b, float a) = 0;
         virtual void SetTexture(ITexture *texture) = 0;
 
+        [[nodiscard]] virtual MaterialParameterBlock& GetParameters() = 0;
+        [[nodiscard]] virtual const MaterialParameterBlock& GetParameters() const = 0;
+
         [[nodiscard]] virtual IShader* GetShader() const = 0;
         [[nodiscard]] virtual ITexture* GetTexture() const = 0;
         [[nodiscard]] virtual bool IsValid() const = 0;
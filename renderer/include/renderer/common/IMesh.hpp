@@ -2,9 +2,14 @@
 
 #include <cstdint>
 
+#include "renderer/common/SlotMap.hpp"
+
 namespace Renderer::Common
 {
-    class IMesh
+    class IMesh;
+    using MeshHandle = ResourceHandle<IMesh>;
+
+    class IMesh : public SlotResident<IMesh>
     {
     public:
         virtual ~IMesh() = default;
@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <string>
 
+#include "renderer/common/SlotMap.hpp"
+
 namespace N2Engine::Math
 {
     struct Vector2;
@@ -16,7 +18,10 @@ namespace Renderer::Common
 {
     class IMaterial;
 
-    class IShader
+    class IShader;
+    using ShaderHandle = ResourceHandle<IShader>;
+
+    class IShader : public SlotResident<IShader>
     {
     public:
         virtual ~IShader() = default;
@@ -2,9 +2,14 @@
 
 #include <cstdint>
 
+#include "renderer/common/SlotMap.hpp"
+
 namespace Renderer::Common
 {
-    class ITexture
+    class ITexture;
+    using TextureHandle = ResourceHandle<ITexture>;
+
+    class ITexture : public SlotResident<ITexture>
     {
     public:
         virtual ~ITexture() = default;
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Renderer::Common
+{
+    // Process-wide integer id of a material property name.
+    using MaterialPropertyId = uint32_t;
+
+    // Properties the standard shaders use have fixed ids, so hot paths never
+    // resolve a name.
+    namespace MaterialProperty
+    {
+        inline constexpr MaterialPropertyId Albedo = 0;       // "uAlbedo"
+        inline constexpr MaterialPropertyId Smoothness = 1;   // "uSmoothness"
+        inline constexpr MaterialPropertyId Metallic = 2;     // "uMetallic"
+        inline constexpr MaterialPropertyId HasTexture = 3;   // "uHasTexture"
+        inline constexpr MaterialPropertyId BuiltinCount = 4;
+    }
+
+    // Interns `name` on first use; the same name always yields the same id.
+    MaterialPropertyId ResolveMaterialProperty(std::string_view name);
+    const std::string& GetMaterialPropertyName(MaterialPropertyId id);
+
+    enum class MaterialParameterType : uint8_t
+    {
+        None,
+        Int,
+        Float,
+        Vec2,
+        Vec3,
+        Vec4
+    };
+
+    struct MaterialParameter
+    {
+        MaterialParameterType type = MaterialParameterType::None;
+        int intValue = 0;
+        float value[4] = {};
+    };
+
+    // Material values stored by property id in one flat array of PODs; backends
+    // walk it directly instead of hashing names per draw.
+    class MaterialParameterBlock
+    {
+    public:
+        MaterialParameterBlock() : m_parameters(MaterialProperty::BuiltinCount) {}
+
+        void SetInt(MaterialPropertyId id, int value)
+        {
+            MaterialParameter &p = At(id);
+            p.type = MaterialParameterType::Int;
+            p.intValue = value;
+        }
+
+        void SetFloat(MaterialPropertyId id, float value) { Store(id, MaterialParameterType::Float, value, 0, 0, 0); }
+        void SetVec2(MaterialPropertyId id, float x, float y) { Store(id, MaterialParameterType::Vec2, x, y, 0, 0); }
+        void SetVec3(MaterialPropertyId id, float x, float y, float z) { Store(id, MaterialParameterType::Vec3, x, y, z, 0); }
+        void SetVec4(MaterialPropertyId id, float x, float y, float z, float w) { Store(id, MaterialParameterType::Vec4, x, y, z, w); }
+
+        // nullptr when the property was never set on this material.
+        [[nodiscard]] const MaterialParameter* Find(MaterialPropertyId id) const
+        {
+            if (id >= m_parameters.size() || m_parameters[id].type == MaterialParameterType::None)
+            {
+                return nullptr;
+            }
+            return &m_parameters[id];
+        }
+
+        [[nodiscard]] int GetInt(MaterialPropertyId id, int def = 0) const
+        {
+            const MaterialParameter *p = Find(id);
+            return p ? p->intValue : def;
+        }
+
+        [[nodiscard]] float GetFloat(MaterialPropertyId id, float def = 0.f) const
+        {
+            const MaterialParameter *p = Find(id);
+            return p ? p->value[0] : def;
+        }
+
+        [[nodiscard]] std::array<float, 4> GetVec4(MaterialPropertyId id, std::array<float, 4> def = {1, 1, 1, 1}) const
+        {
+            const MaterialParameter *p = Find(id);
+            return p ? std::array<float, 4>{p->value[0], p->value[1], p->value[2], p->value[3]} : def;
+        }
+
+        // Indexed by property id; unset entries have type None.
+        [[nodiscard]] std::span<const MaterialParameter> GetParameters() const { return m_parameters; }
+
+        // Replaces every value with parameters, as read from another block's GetParameters().
+        void Assign(std::span<const MaterialParameter> parameters)
+        {
+            m_parameters.assign(parameters.begin(), parameters.end());
+        }
+
+    private:
+        MaterialParameter& At(MaterialPropertyId id)
+        {
+            if (id >= m_parameters.size())
+            {
+                m_parameters.resize(id + 1);
+            }
+            return m_parameters[id];
+        }
+
+        void Store(MaterialPropertyId id, MaterialParameterType type, float x, float y, float z, float w)
+        {
+            MaterialParameter &p = At(id);
+            p.type = type;
+            p.value[0] = x;
+            p.value[1] = y;
+            p.value[2] = z;
+            p.value[3] = w;
+        }
+
+        std::vector<MaterialParameter> m_parameters;
+    };
+}
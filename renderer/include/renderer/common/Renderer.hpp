@@ -1,5 +1,6 @@
 #pragma once
 
+#include <span>
 #include <vector>
 
 #include <glad/glad.h>
@@ -11,6 +12,7 @@
 #include "renderer/common/IMaterial.hpp"
 #include "renderer/common/IShader.hpp"
 #include "renderer/common/IMesh.hpp"
+#include "renderer/common/ITexture.hpp"
 
 #include "renderer/common/SceneLighting.hpp"
 
@@ -42,17 +44,18 @@ namespace Renderer::Common
         // Shader management
         virtual IShader* CreateShaderProgram(const char *vertexSource, const char *fragmentSource) = 0;
         virtual void UseShaderProgram(IShader *shader) = 0;
-        virtual bool DestroyShaderProgram(IShader *shader) = 0;
-        virtual bool IsValidShader(IShader *shader) const = 0;
+        virtual bool DestroyShaderProgram(ShaderHandle shader) = 0;
+        virtual bool IsValidShader(ShaderHandle shader) const = 0;
 
-        // Resource management
+        // Resource management. Resources are destroyed through their GetHandle(), so
+        // destroying one twice, or after its slot was reused, does nothing.
         virtual IMesh* CreateMesh(const MeshData &meshData) = 0;
-        virtual void DestroyMesh(IMesh *mesh) = 0;
+        virtual void DestroyMesh(MeshHandle mesh) = 0;
         virtual ITexture* CreateTexture(const uint8_t *data, uint32_t width, uint32_t height, uint32_t channels) = 0;
-        virtual void DestroyTexture(ITexture *texture) = 0;
+        virtual void DestroyTexture(TextureHandle texture) = 0;
         virtual IMaterial* CreateMaterial(IShader *shader) = 0;
         virtual IMaterial* CreateMaterial(IShader *shader, ITexture *texture) = 0;
-        virtual void DestroyMaterial(IMaterial *material) = 0;
+        virtual void DestroyMaterial(MaterialHandle material) = 0;
 
         // Rendering
         virtual void SetViewProjection(const float *view, const float *projection) = 0;
@@ -60,6 +63,10 @@ namespace Renderer::Common
                                          const N2Engine::Math::Vector3 &cameraPosition) = 0;
 
         virtual void DrawMesh(IMesh *mesh, const float *modelMatrix, IMaterial *material) = 0;
+        // Draws the mesh once per row-major model matrix, with the per-draw
+        // setup (casts, material, view/projection) done once for the batch.
+        virtual void DrawMeshInstanced(IMesh *mesh, IMaterial *material,
+                                       std::span<const float[16]> modelMatrices) = 0;
         virtual void DrawObjects(const std::vector<RenderObject> &objects) = 0;
         virtual void OnResize(int width, int height) = 0;
 
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace Renderer::Common
+{
+    // Index into a SlotMap plus the generation of the slot when the handle was
+    // issued. Erasing bumps the slot's generation, so stale handles never
+    // resolve to whatever reuses the slot later.
+    struct SlotHandle
+    {
+        uint32_t index = std::numeric_limits<uint32_t>::max();
+        uint32_t generation = 0;
+
+        [[nodiscard]] bool IsNull() const { return index == std::numeric_limits<uint32_t>::max(); }
+        bool operator==(const SlotHandle &) const = default;
+    };
+
+    // A SlotHandle typed by the resource it names, so a mesh handle can't be
+    // handed to DestroyTexture. Renderers destroy and validate resources by
+    // handle, never by pointer: a pointer can be reused by the next resource
+    // allocated, a handle's generation can't.
+    template <typename Resource>
+    struct ResourceHandle
+    {
+        SlotHandle slot;
+
+        [[nodiscard]] bool IsNull() const { return slot.IsNull(); }
+        bool operator==(const ResourceHandle &) const = default;
+    };
+
+    template <typename T, typename Owner>
+    class SlotMap;
+
+    // Base of every renderer resource: remembers the handle its backend stored
+    // it under.
+    template <typename Resource>
+    class SlotResident
+    {
+    public:
+        [[nodiscard]] ResourceHandle<Resource> GetHandle() const { return {m_slotHandle}; }
+
+    private:
+        template <typename, typename>
+        friend class SlotMap;
+
+        SlotHandle m_slotHandle;
+    };
+
+    // Owning slot map with generational handles; freed slots are reused LIFO.
+    // Every lookup indexes the slot and compares generations, so stale handles
+    // fail even once their slot, or their resource's address, is reused.
+    template <typename T, typename Owner = std::unique_ptr<T>>
+    class SlotMap
+    {
+    public:
+        T* Insert(Owner value)
+        {
+            uint32_t index;
+            if (!m_free.empty())
+            {
+                index = m_free.back();
+                m_free.pop_back();
+            }
+            else
+            {
+                index = static_cast<uint32_t>(m_slots.size());
+                m_slots.emplace_back();
+            }
+
+            Slot &slot = m_slots[index];
+            slot.value = std::move(value);
+            slot.value->m_slotHandle = {index, slot.generation};
+            ++m_size;
+            return slot.value.get();
+        }
+
+        [[nodiscard]] T* Get(SlotHandle handle) const
+        {
+            const Slot *slot = Resolve(handle);
+            return slot ? slot->value.get() : nullptr;
+        }
+
+        // The owning pointer stored under handle, or nullptr for null, stale or
+        // other-map handles.
+        [[nodiscard]] const Owner* Find(SlotHandle handle) const
+        {
+            const Slot *slot = Resolve(handle);
+            return slot ? &slot->value : nullptr;
+        }
+
+        [[nodiscard]] bool Contains(SlotHandle handle) const { return Resolve(handle) != nullptr; }
+
+        bool Erase(SlotHandle handle)
+        {
+            if (!Resolve(handle))
+            {
+                return false;
+            }
+            Slot &slot = m_slots[handle.index];
+            slot.value.reset();
+            ++slot.generation;
+            m_free.push_back(handle.index);
+            --m_size;
+            return true;
+        }
+
+        void Clear()
+        {
+            m_free.clear();
+            for (uint32_t index = static_cast<uint32_t>(m_slots.size()); index-- > 0;)
+            {
+                Slot &slot = m_slots[index];
+                if (slot.value)
+                {
+                    slot.value.reset();
+                    ++slot.generation;
+                }
+                m_free.push_back(index);
+            }
+            m_size = 0;
+        }
+
+        [[nodiscard]] size_t Size() const { return m_size; }
+
+    private:
+        struct Slot
+        {
+            Owner value;
+            uint32_t generation = 0;
+        };
+
+        const Slot* Resolve(SlotHandle handle) const
+        {
+            if (handle.index >= m_slots.size())
+            {
+                return nullptr;
+            }
+            const Slot &slot = m_slots[handle.index];
+            return slot.value && slot.generation == handle.generation ? &slot : nullptr;
+        }
+
+        std::vector<Slot> m_slots;
+        std::vector<uint32_t> m_free;
+        size_t m_size = 0;
+    };
+}
@@ -2,8 +2,6 @@
 #pragma once
 
 #include <memory>
-#include <unordered_map>
-#include <array>
 #include <string>
 
 #include "renderer/common/IMaterial.hpp"
@@ -32,6 +30,9 @@ namespace Renderer::OpenGL
 
         bool IsValid() const override { return _shader && _shader->IsValid(); }
 
+        Common::MaterialParameterBlock &GetParameters() override { return _parameters; }
+        const Common::MaterialParameterBlock &GetParameters() const override { return _parameters; }
+
         // Internal use by renderer
         void Apply(); // Binds shader and applies all properties
         OpenGLShader *GetShader() const { return _shader.get(); }
@@ -42,11 +43,6 @@ namespace Renderer::OpenGL
         std::shared_ptr<OpenGLShader> _shader;
         OpenGLTexture *_texture;
 
-        // Property storage
-        std::unordered_map<std::string, float> _floats;
-        std::unordered_map<std::string, int> _ints;
-        std::unordered_map<std::string, std::array<float, 2>> _vec2s;
-        std::unordered_map<std::string, std::array<float, 3>> _vec3s;
-        std::unordered_map<std::string, std::array<float, 4>> _vec4s;
+        Common::MaterialParameterBlock _parameters;
     };
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "renderer/common/Renderer.hpp"
+#include "renderer/common/SlotMap.hpp"
 #include "renderer/opengl/OpenGLShader.hpp"
 #include "renderer/opengl/OpenGLMaterial.hpp"
 #include "renderer/opengl/OpenGLMesh.hpp"
@@ -46,8 +47,8 @@ namespace Renderer::OpenGL
         // Shader management
         Common::IShader* CreateShaderProgram(const char* vertexSource, const char* fragmentSource) override;
         void UseShaderProgram(Common::IShader* shader) override;
-        bool DestroyShaderProgram(Common::IShader* shader) override;
-        bool IsValidShader(Common::IShader* shader) const override;
+        bool DestroyShaderProgram(Common::ShaderHandle shader) override;
+        bool IsValidShader(Common::ShaderHandle shader) const override;
 
         // Frame management
         void BeginFrame() override;
@@ -56,21 +57,23 @@ namespace Renderer::OpenGL
 
         // Resource management
         Common::IMesh* CreateMesh(const Common::MeshData& meshData) override;
-        void DestroyMesh(Common::IMesh* mesh) override;
+        void DestroyMesh(Common::MeshHandle mesh) override;
         Common::ITexture*
         CreateTexture(const uint8_t* data, uint32_t width, uint32_t height, uint32_t channels) override;
-        void DestroyTexture(Common::ITexture* texture) override;
+        void DestroyTexture(Common::TextureHandle texture) override;
 
         // Updated material management
         Common::IMaterial* CreateMaterial(Common::IShader* shader) override;
         Common::IMaterial* CreateMaterial(Common::IShader* shader, Common::ITexture* texture) override;
-        void DestroyMaterial(Common::IMaterial* material) override;
+        void DestroyMaterial(Common::MaterialHandle material) override;
 
         // Rendering - updated signature
         void SetViewProjection(const float* view, const float* projection) override;
         void UpdateSceneLighting(const Common::SceneLightingData& lighting,
                                  const N2Engine::Math::Vector3& cameraPosition) override;
         void DrawMesh(Common::IMesh* mesh, const float* modelMatrix, Common::IMaterial* material) override;
+        void DrawMeshInstanced(Common::IMesh* mesh, Common::IMaterial* material,
+                               std::span<const float[16]> modelMatrices) override;
         void DrawObjects(const std::vector<Common::RenderObject>& objects) override;
         void OnResize(int width, int height) override;
 
@@ -97,13 +100,17 @@ namespace Renderer::OpenGL
 
         Common::SceneLightingData m_currentLighting;
 
+        // Per-instance model matrices, streamed by DrawMeshInstanced (attributes 4-7)
+        GLuint m_instanceVBO = 0;
+        size_t m_instanceCapacity = 0;   // in matrices
+
         uint32_t m_currentShader;
 
-        // resource containers
-        std::unordered_map<Common::IShader*, std::shared_ptr<OpenGLShader>> m_shaderPrograms;
-        std::unordered_map<Common::IMesh*, std::unique_ptr<OpenGLMesh>> m_meshes;
-        std::unordered_map<Common::ITexture*, std::unique_ptr<OpenGLTexture>> m_textures;
-        std::unordered_map<Common::IMaterial*, std::unique_ptr<OpenGLMaterial>> m_materials;
+        // resource containers (shaders are shared with the materials using them)
+        Common::SlotMap<OpenGLShader, std::shared_ptr<OpenGLShader>> m_shaderPrograms;
+        Common::SlotMap<OpenGLMesh> m_meshes;
+        Common::SlotMap<OpenGLTexture> m_textures;
+        Common::SlotMap<OpenGLMaterial> m_materials;
 
         // State
         bool m_wireframeEnabled;
@@ -114,6 +121,8 @@ namespace Renderer::OpenGL
         GLuint LinkProgram(GLuint vertexShader, GLuint fragmentShader);
         bool CheckCompileErrors(GLuint shader, const std::string& type);
         static void SetMatrix4fv(GLint location, const float* matrix);
+        // Binds material, texture and view/projection; returns the shader, or null if unusable.
+        const OpenGLShader* ApplyDrawState(OpenGLMaterial* material) const;
         static GLenum GetOpenGLFormat(uint32_t channels);
         static GLenum GetOpenGLInternalFormat(uint32_t channels);
 
@@ -4,8 +4,10 @@
 #include <glad/glad.h>
 
 #include <unordered_map>
+#include <vector>
 
 #include "renderer/common/IShader.hpp"
+#include "renderer/common/MaterialParameters.hpp"
 
 namespace Renderer::OpenGL
 {
@@ -16,6 +18,7 @@ namespace Renderer::OpenGL
         GLint projectionLoc = -1;
         GLint textureLoc = -1;
         GLint colorLoc = -1;
+        GLint instancedLoc = -1;   // -1: the shader has no per-instance model matrix
     };
 
     class OpenGLShader : public Common::IShader
@@ -47,9 +50,13 @@ namespace Renderer::OpenGL
         GLuint GetId() const;
         inline const ShaderUniforms &GetCommonUniforms() const { return _commonUniforms; }
 
+        // Uniform location of a material property, looked up by name once per shader.
+        GLint GetPropertyLocation(Common::MaterialPropertyId id) const;
+
     private:
         GLuint _programId;
         mutable std::unordered_map<std::string, int> _uniformLocationCache;
+        mutable std::vector<GLint> _propertyLocations;   // by property id; -2 = not looked up yet
         ShaderUniforms _commonUniforms;
 
         // Helper methods
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+
+namespace Renderer::Software
+{
+    // Fixed set of raster workers. The thread that calls ParallelFor always takes
+    // part, so a pool with N workers runs jobs on N + 1 threads.
+    class RasterWorkerPool
+    {
+    public:
+        ~RasterWorkerPool() { Stop(); }
+
+        void Start(uint32_t workerCount)
+        {
+            Stop();
+            m_running = true;
+            m_workers.reserve(workerCount);
+            for (uint32_t i = 0; i < workerCount; ++i)
+                m_workers.emplace_back(&RasterWorkerPool::WorkerFunc, this);
+        }
+
+        void Stop()
+        {
+            {
+                std::lock_guard lock(m_mutex);
+                m_running = false;
+            }
+            m_wake.notify_all();
+            for (auto& worker : m_workers)
+                if (worker.joinable()) worker.join();
+            m_workers.clear();
+        }
+
+        [[nodiscard]] uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_workers.size()) + 1; }
+
+        // Runs job(i) for every i in [0, count) and returns once all of them finished.
+        // Indices are handed out dynamically, so uneven jobs balance themselves.
+        void ParallelFor(uint32_t count, const std::function<void(uint32_t)>& job)
+        {
+            if (count == 0) return;
+            if (m_workers.empty() || count == 1)
+            {
+                for (uint32_t i = 0; i < count; ++i) job(i);
+                return;
+            }
+
+            {
+                std::lock_guard lock(m_mutex);
+                m_job = &job;
+                m_count = count;
+                m_next = 0;
+                ++m_generation;
+            }
+            m_wake.notify_all();
+
+            Drain(job, count);
+
+            // Every index has been claimed; wait for workers still finishing theirs.
+            std::unique_lock lock(m_mutex);
+            m_idle.wait(lock, [this]{ return m_active == 0; });
+            m_job = nullptr;
+        }
+
+    private:
+        void Drain(const std::function<void(uint32_t)>& job, uint32_t count)
+        {
+            for (uint32_t i = m_next.fetch_add(1, std::memory_order_relaxed); i < count;
+                 i = m_next.fetch_add(1, std::memory_order_relaxed))
+            {
+                job(i);
+            }
+        }
+
+        void WorkerFunc()
+        {
+            uint64_t seen = 0;
+            while (true)
+            {
+                const std::function<void(uint32_t)>* job;
+                uint32_t count;
+                {
+                    std::unique_lock lock(m_mutex);
+                    m_wake.wait(lock, [&]{ return !m_running || m_generation != seen; });
+                    if (!m_running) break;
+                    seen = m_generation;
+                    // Woke up after the caller already wrapped this job up.
+                    if (!m_job) continue;
+                    job = m_job;
+                    count = m_count;
+                    ++m_active;
+                }
+
+                Drain(*job, count);
+
+                {
+                    std::lock_guard lock(m_mutex);
+                    --m_active;
+                }
+                m_idle.notify_one();
+            }
+        }
+
+        std::vector<std::thread> m_workers;
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_idle;
+        const std::function<void(uint32_t)>* m_job = nullptr;
+        uint32_t m_count = 0;
+        std::atomic<uint32_t> m_next{0};
+        uint32_t m_active = 0;
+        uint64_t m_generation = 0;
+        bool m_running = false;
+    };
+}
@@ -26,6 +26,8 @@ public:
         if (m_thread.joinable()) m_thread.join();
     }
 
+    bool IsRunning() const { return m_running; }
+
     // Called from main thread — queues a frame's worth of work
     void SubmitFrame(std::vector<std::function<void()>> commands)
     {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+
 #include "renderer/common/IMesh.hpp"
 #include "renderer/common/RenderTypes.hpp"
 
@@ -11,6 +13,24 @@ namespace Renderer::Software
         std::vector<Common::Vertex> vertices;
         std::vector<uint32_t> indices;
 
+        // Object-space AABB of the vertices; the renderer culls whole draws with it.
+        float boundsMin[3] = {};
+        float boundsMax[3] = {};
+
+        void ComputeBounds()
+        {
+            if (vertices.empty()) return;
+            for (int i = 0; i < 3; ++i) boundsMin[i] = boundsMax[i] = vertices[0].position[i];
+            for (const auto& v : vertices)
+            {
+                for (int i = 0; i < 3; ++i)
+                {
+                    boundsMin[i] = std::min(boundsMin[i], v.position[i]);
+                    boundsMax[i] = std::max(boundsMax[i], v.position[i]);
+                }
+            }
+        }
+
         [[nodiscard]] bool IsValid() const override { return !vertices.empty() && !indices.empty(); }
         [[nodiscard]] uint32_t GetIndexCount() const override { return static_cast<uint32_t>(indices.size()); }
         [[nodiscard]] uint32_t GetVertexCount() const override { return static_cast<uint32_t>(vertices.size()); }
@@ -1,37 +1,151 @@
 #pragma once
 
+#include <algorithm>
+#include <bit>
 #include <cmath>
+#include <cstdint>
 #include <vector>
 
 #include "renderer/common/ITexture.hpp"
 
 namespace Renderer::Software
 {
+    enum class SWTextureFilter
+    {
+        Nearest,    // base level only, no mips
+        Bilinear,   // bilinear within the nearest mip level
+        Trilinear   // bilinear in the two nearest mip levels, blended by the fractional LOD
+    };
+
+    enum class SWTextureLayout
+    {
+        Linear,     // row-major
+        Tiled       // 4x4 texel blocks, one 64-byte cache line each, blocks row-major
+    };
+
     class SWTexture : public Common::ITexture
     {
     public:
-        std::vector<uint8_t> data;
+        struct MipLevel
+        {
+            uint32_t width, height;
+            uint32_t blocksPerRow;   // width in tiles, rounded up
+            size_t offset;           // into texels
+        };
+
         uint32_t width = 0, height = 0, channels = 0;
+        SWTextureLayout layout = SWTextureLayout::Linear;
+        std::vector<uint32_t> texels;    // every mip level, packed RGBA8, level 0 first
+        std::vector<MipLevel> levels;
+
+        // Converts the source to RGBA8 once, builds the full mip chain (2x2 box
+        // filter) and stores every level in the given layout.
+        void Build(const uint8_t *data, uint32_t w, uint32_t h, uint32_t ch,
+                   SWTextureLayout memoryLayout = SWTextureLayout::Linear);
 
-        [[nodiscard]] bool IsValid() const override { return !data.empty(); }
+        // Address of texel (x, y) in a level. A tile shift of 0 is plain
+        // row-major, so both layouts share one branch-free formula.
+        [[nodiscard]] size_t TexelIndex(const MipLevel &level, uint32_t x, uint32_t y) const
+        {
+            const uint32_t mask = (1u << m_tileShift) - 1;
+            const size_t block = (size_t)(y >> m_tileShift) * level.blocksPerRow + (x >> m_tileShift);
+            return level.offset + (block << (2 * m_tileShift)) + (((y & mask) << m_tileShift) | (x & mask));
+        }
+
+        [[nodiscard]] bool IsValid() const override { return !texels.empty(); }
         [[nodiscard]] uint32_t GetWidth() const override { return width; }
         [[nodiscard]] uint32_t GetHeight() const override { return height; }
         [[nodiscard]] uint32_t GetChannels() const override { return channels; }
 
-        // Sample at normalized UV (nearest)
+        // Sample at normalized UV (nearest, base level)
         [[nodiscard]] uint32_t Sample(float u, float v) const
         {
-            if (data.empty()) return 0xFFFFFFFF;
+            if (texels.empty()) return 0xFFFFFFFF;
             u = u - std::floor(u); // wrap
             v = v - std::floor(v);
-            int x = (int)(u * (float)(width - 1));
-            int y = (int)(v * (float)(height - 1));
-            const uint8_t *p = data.data() + (y * width + x) * channels;
-            uint8_t r = channels > 0 ? p[0] : 255;
-            uint8_t g = channels > 1 ? p[1] : 255;
-            uint8_t b = channels > 2 ? p[2] : 255;
-            uint8_t a = channels > 3 ? p[3] : 255;
-            return ((uint32_t)a << 24) | ((uint32_t)b << 16) | ((uint32_t)g << 8) | r;
+            const uint32_t x = (uint32_t)(u * (float)(width - 1));
+            const uint32_t y = (uint32_t)(v * (float)(height - 1));
+            return texels[TexelIndex(levels[0], x, y)];
+        }
+
+        // Level of detail from the UV derivatives along screen x and y:
+        // log2 of the larger texel-space footprint. <= 0 means magnified.
+        [[nodiscard]] float ComputeLod(float dudx, float dvdx, float dudy, float dvdy) const
+        {
+            const float fw = (float)width, fh = (float)height;
+            const float x2 = dudx * dudx * fw * fw + dvdx * dvdx * fh * fh;
+            const float y2 = dudy * dudy * fw * fw + dvdy * dvdy * fh * fh;
+            return 0.5f * FastLog2(std::max(x2, y2));
+        }
+
+        [[nodiscard]] uint32_t SampleFiltered(float u, float v, float lod, SWTextureFilter filter) const
+        {
+            if (texels.empty()) return 0xFFFFFFFF;
+            u = u - std::floor(u); // wrap
+            v = v - std::floor(v);
+
+            const float maxLevel = (float)(levels.size() - 1);
+            if (filter == SWTextureFilter::Nearest) return Sample(u, v);
+            if (filter == SWTextureFilter::Bilinear || lod <= 0.f || lod >= maxLevel)
+            {
+                const float level = std::clamp(std::floor(lod + 0.5f), 0.f, maxLevel);
+                return Bilinear(levels[(size_t)level], u, v);
+            }
+
+            const float level = std::floor(lod);
+            const uint32_t t = (uint32_t)((lod - level) * 256.f);
+            const uint32_t a = Bilinear(levels[(size_t)level], u, v);
+            const uint32_t b = Bilinear(levels[(size_t)level + 1], u, v);
+            return Lerp(a, b, t);
+        }
+
+    private:
+        uint32_t m_tileShift = 0;   // log2 of the tile edge: 0 for Linear, 2 for Tiled
+
+        // Re-lays the linear mip chain out in 4x4 tiles.
+        void Swizzle();
+
+        // Per-channel a + (b - a) * t / 256 on packed RGBA8, two channels per multiply.
+        static uint32_t Lerp(uint32_t a, uint32_t b, uint32_t t)
+        {
+            const uint32_t rbA = a & 0x00FF00FF, agA = (a >> 8) & 0x00FF00FF;
+            const uint32_t rbB = b & 0x00FF00FF, agB = (b >> 8) & 0x00FF00FF;
+            const uint32_t rb = ((rbA * (256 - t) + rbB * t) >> 8) & 0x00FF00FF;
+            const uint32_t ag = ((agA * (256 - t) + agB * t) >> 8) & 0x00FF00FF;
+            return rb | (ag << 8);
+        }
+
+        // u, v already wrapped to [0, 1).
+        uint32_t Bilinear(const MipLevel &level, float u, float v) const
+        {
+            const float fx = u * (float)level.width - 0.5f;
+            const float fy = v * (float)level.height - 0.5f;
+            const float x0f = std::floor(fx), y0f = std::floor(fy);
+            const uint32_t tx = (uint32_t)((fx - x0f) * 256.f);
+            const uint32_t ty = (uint32_t)((fy - y0f) * 256.f);
+
+            // fx is in [-0.5, width - 0.5), so only one step of wrapping is ever needed.
+            uint32_t x0 = (uint32_t)(int)x0f, y0 = (uint32_t)(int)y0f;
+            uint32_t x1 = x0 + 1, y1 = y0 + 1;
+            if (x0f < 0.f) x0 = level.width - 1;
+            if (y0f < 0.f) y0 = level.height - 1;
+            if (x1 >= level.width) x1 = 0;
+            if (y1 >= level.height) y1 = 0;
+
+            const uint32_t *t = texels.data();
+            return Lerp(Lerp(t[TexelIndex(level, x0, y0)], t[TexelIndex(level, x1, y0)], tx),
+                        Lerp(t[TexelIndex(level, x0, y1)], t[TexelIndex(level, x1, y1)], tx), ty);
+        }
+
+        // log2 from the float's exponent plus a quadratic fit of the mantissa
+        // (error < 0.01) - plenty for picking and blending mip levels.
+        static float FastLog2(float x)
+        {
+            if (!(x > 0.f)) return -128.f;
+            const uint32_t bits = std::bit_cast<uint32_t>(x);
+            const float e = (float)((int)(bits >> 23) - 127);
+            const float m = std::bit_cast<float>((bits & 0x007FFFFF) | 0x3F800000) - 1.f;   // [0, 1)
+            return e + m * (1.3465552f - 0.3465552f * m);
         }
     };
 }
@@ -2,9 +2,12 @@
 
 #include <vector>
 #include <memory>
+#include <span>
 
 #include "renderer/common/Renderer.hpp"
+#include "renderer/common/SlotMap.hpp"
 #include "renderer/software/RenderThread.hpp"
+#include "renderer/software/RasterWorkerPool.hpp"
 #include "renderer/software/SWMesh.hpp"
 #include "renderer/software/SWTexture.hpp"
 #include "renderer/software/SWShader.hpp"
@@ -12,10 +15,26 @@
 
 namespace Renderer::Software
 {
+    // Width of the rasterizer's inner loop. Every path produces the same image.
+    enum class SWRasterPath { Scalar, SSE41, AVX2 };
+
+    // Culling counters for one frame.
+    struct SWFrameStats
+    {
+        uint32_t drawsSubmitted = 0;
+        uint32_t drawsOutsideFrustum = 0;   // bounds entirely off screen
+        uint32_t drawsOccluded = 0;         // bounds behind the depth pyramid
+        uint32_t trianglesSubmitted = 0;    // every triangle of every submitted draw
+        uint32_t trianglesOccluded = 0;     // set up, then rejected by the depth pyramid
+        uint32_t trianglesRasterized = 0;
+    };
+
     class SoftwareRenderer : public Common::IRenderer
     {
     public:
         // Lifecycle
+        // A null windowHandle runs headless: frames render into the CPU framebuffer
+        // only, no GL context is touched and Present() just waits for the frame.
         bool Initialize(GLFWwindow *windowHandle, uint32_t width, uint32_t height) override;
         void Shutdown() override;
         void Resize(uint32_t width, uint32_t height) override;
@@ -29,34 +48,74 @@ namespace Renderer::Software
         // Shaders
         Common::IShader* CreateShaderProgram(const char *vs, const char *fs) override;
         void UseShaderProgram(Common::IShader *shader) override;
-        bool DestroyShaderProgram(Common::IShader *shader) override;
-        bool IsValidShader(Common::IShader *shader) const override;
+        bool DestroyShaderProgram(Common::ShaderHandle shader) override;
+        bool IsValidShader(Common::ShaderHandle shader) const override;
 
         // Resources
         Common::IMesh* CreateMesh(const Common::MeshData &meshData) override;
-        void DestroyMesh(Common::IMesh *mesh) override;
+        void DestroyMesh(Common::MeshHandle mesh) override;
         Common::ITexture* CreateTexture(const uint8_t *data, uint32_t w, uint32_t h, uint32_t ch) override;
-        void DestroyTexture(Common::ITexture *texture) override;
+        void DestroyTexture(Common::TextureHandle texture) override;
         Common::IMaterial* CreateMaterial(Common::IShader *shader) override;
         Common::IMaterial* CreateMaterial(Common::IShader *shader, Common::ITexture *texture) override;
-        void DestroyMaterial(Common::IMaterial *material) override;
+        void DestroyMaterial(Common::MaterialHandle material) override;
 
         // Rendering
         void SetViewProjection(const float *view, const float *projection) override;
         void UpdateSceneLighting(const Common::SceneLightingData &lighting,
                                  const N2Engine::Math::Vector3 &cameraPosition) override;
         void DrawMesh(Common::IMesh *mesh, const float *modelMatrix, Common::IMaterial *material) override;
+        void DrawMeshInstanced(Common::IMesh *mesh, Common::IMaterial *material,
+                               std::span<const float[16]> modelMatrices) override;
         void DrawObjects(const std::vector<Common::RenderObject> &objects) override;
         void OnResize(int width, int height) override;
 
-        Common::IShader* GetStandardUnlitShader() const override { return m_unlitShader.get(); }
-        Common::IShader* GetStandardLitShader() const override { return m_litShader.get(); }
+        Common::IShader* GetStandardUnlitShader() const override { return m_unlitShader; }
+        Common::IShader* GetStandardLitShader() const override { return m_litShader; }
 
         void ReadFramebuffer(uint8_t *buffer, int width, int height) const override;
 
         void SetWireframe(bool enabled) override;
         const char* GetRendererName() const override { return "Software Rasterizer"; }
 
+        // Number of threads rasterizing a frame (the render thread included).
+        // 0 picks std::thread::hardware_concurrency(); 1 disables tile binning.
+        // Every thread count produces the same image.
+        void SetRasterThreadCount(uint32_t threadCount);
+        uint32_t GetRasterThreadCount() const { return m_rasterPool.GetThreadCount(); }
+
+        // Defaults to the widest path CPUInfo::DetectCPUFeatures reports.
+        // Returns false (and keeps the current path) if the CPU can't run it.
+        bool SetRasterPath(SWRasterPath path);
+        SWRasterPath GetRasterPath() const { return m_rasterPath; }
+        static bool IsRasterPathSupported(SWRasterPath path);
+        static SWRasterPath DetectRasterPath();
+
+        // Hierarchical-Z rejection of occluded draws and triangles (on by
+        // default). Only skips work that couldn't pass the depth test, so the
+        // image is the same either way.
+        void SetOcclusionCulling(bool enabled);
+        bool IsOcclusionCullingEnabled() const { return m_occlusionCulling; }
+
+        // How textured draws sample: mipmapped bilinear by default.
+        void SetTextureFilter(SWTextureFilter filter);
+        SWTextureFilter GetTextureFilter() const { return m_textureFilter; }
+
+        // Memory layout for textures created from now on; existing textures keep theirs.
+        void SetTextureLayout(SWTextureLayout layout) { m_textureLayout = layout; }
+        SWTextureLayout GetTextureLayout() const { return m_textureLayout; }
+
+        // Counters of the most recently completed frame; valid after Present().
+        SWFrameStats GetFrameStats() const { return m_frameStats; }
+
+        bool IsHeadless() const { return m_window == nullptr; }
+
+        // The CPU framebuffer itself, not a copy: packed RGBA8, GetWidth() * GetHeight()
+        // pixels, bottom row first. Valid after Present() until the next EndFrame() or Resize().
+        std::span<const uint32_t> GetColorBuffer() const { return m_colorBuffer; }
+        uint32_t GetWidth() const { return m_width; }
+        uint32_t GetHeight() const { return m_height; }
+
     private:
         struct DrawCommand {
             SWMesh* mesh;
@@ -64,8 +123,18 @@ namespace Renderer::Software
             SWMaterial* material;
         };
 
+        struct FrameContext;
+
         std::vector<DrawCommand> m_drawQueue;
         RenderThread m_renderThread;
+        RasterWorkerPool m_rasterPool;
+        uint32_t m_rasterThreadCount = 0;
+        SWRasterPath m_rasterPath = DetectRasterPath();
+        bool m_occlusionCulling = true;
+        SWTextureFilter m_textureFilter = SWTextureFilter::Bilinear;
+        SWTextureLayout m_textureLayout = SWTextureLayout::Tiled;
+        SWFrameStats m_frameStats;
+        uint32_t ResolveRasterThreadCount() const;
 
         // Framebuffer
         uint32_t m_width = 0, m_height = 0;
@@ -73,7 +142,7 @@ namespace Renderer::Software
         std::vector<float> m_depthBuffer;
         float m_clearR = 0, m_clearG = 0, m_clearB = 0, m_clearA = 1;
 
-        // GL blit
+        // GL blit (unused when headless)
         GLFWwindow *m_window = nullptr;
         unsigned int m_blitTex = 0, m_blitVAO = 0, m_blitVBO = 0, m_blitProg = 0;
         bool SetupBlitResources();
@@ -85,15 +154,15 @@ namespace Renderer::Software
         Common::SceneLightingData m_lighting;
         N2Engine::Math::Vector3 m_cameraPos{};
 
-        // Built-in shaders
-        std::unique_ptr<SWShader> m_unlitShader;
-        std::unique_ptr<SWShader> m_litShader;
+        // Built-in shaders, stored in m_shaders like any other
+        SWShader *m_unlitShader = nullptr;
+        SWShader *m_litShader = nullptr;
 
-        // Owned resource sets (for lifetime tracking)
-        std::vector<std::unique_ptr<SWMesh>> m_meshes;
-        std::vector<std::unique_ptr<SWTexture>> m_textures;
-        std::vector<std::unique_ptr<SWMaterial>> m_materials;
-        std::vector<std::unique_ptr<SWShader>> m_shaders;
+        // Owned resources; Destroy* resolves a handle to its slot, so stale handles are safe
+        Common::SlotMap<SWMesh> m_meshes;
+        Common::SlotMap<SWTexture> m_textures;
+        Common::SlotMap<SWMaterial> m_materials;
+        Common::SlotMap<SWShader> m_shaders;
 
         bool m_wireframe = false;
 
@@ -112,7 +181,7 @@ namespace Renderer::Software
 
         void RasterizeTriangle(const SWFragment &f0, const SWFragment &f1, const SWFragment &f2, const SWMaterial *mat,
                                const float *modelMatrix);
-        void RasterizeMesh(SWMesh* mesh, const float* modelMatrix, SWMaterial* material);
+        void RasterizeMesh(SWMesh* mesh, const float* modelMatrix, SWMaterial* material, FrameContext& ctx);
 
         uint32_t ShadeLit(const SWFragment &frag, const SWMaterial *mat, const float *modelMatrix) const;
         uint32_t ShadeUnlit(const SWFragment &frag, const SWMaterial *mat) const;
@@ -91,26 +91,28 @@ namespace Renderer
 
             // Resource management - updated to use interface pointers
             Common::IMesh* CreateMesh(const Common::MeshData& meshData) override;
-            void DestroyMesh(Common::IMesh* mesh) override;
+            void DestroyMesh(Common::MeshHandle mesh) override;
 
             Common::ITexture*
             CreateTexture(const uint8_t* data, uint32_t width, uint32_t height, uint32_t channels) override;
-            void DestroyTexture(Common::ITexture* texture) override;
+            void DestroyTexture(Common::TextureHandle texture) override;
 
             Common::IMaterial* CreateMaterial(Common::IShader* shader) override;
             Common::IMaterial* CreateMaterial(Common::IShader* shader, Common::ITexture* texture) override;
-            void DestroyMaterial(Common::IMaterial* material) override;
+            void DestroyMaterial(Common::MaterialHandle material) override;
 
             Common::IShader* CreateShaderProgram(const char* vertexSource, const char* fragmentSource) override;
             void UseShaderProgram(Common::IShader* shader) override;
-            bool DestroyShaderProgram(Common::IShader* shader) override;
-            bool IsValidShader(Common::IShader* shader) const override;
+            bool DestroyShaderProgram(Common::ShaderHandle shader) override;
+            bool IsValidShader(Common::ShaderHandle shader) const override;
 
             void SetViewProjection(const float* view, const float* projection) override;
             void UpdateSceneLighting(const Common::SceneLightingData& lighting,
                                      const N2Engine::Math::Vector3& cameraPosition) override;
 
             void DrawMesh(Common::IMesh* mesh, const float* modelMatrix, Common::IMaterial* material) override;
+            void DrawMeshInstanced(Common::IMesh* mesh, Common::IMaterial* material,
+                                   std::span<const float[16]> modelMatrices) override;
             void DrawObjects(const std::vector<Common::RenderObject>& objects) override;
             void OnResize(int width, int height) override;
 
@@ -0,0 +1,57 @@
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+#include "renderer/common/MaterialParameters.hpp"
+
+using namespace Renderer::Common;
+
+namespace
+{
+    struct PropertyTable
+    {
+        std::mutex mutex;
+        std::unordered_map<std::string, MaterialPropertyId> ids;
+        std::deque<std::string> names;   // deque: references stay valid as it grows
+
+        PropertyTable()
+        {
+            for (const char *name : {"uAlbedo", "uSmoothness", "uMetallic", "uHasTexture"})
+            {
+                ids.emplace(name, static_cast<MaterialPropertyId>(names.size()));
+                names.emplace_back(name);
+            }
+        }
+    };
+
+    PropertyTable& Table()
+    {
+        static PropertyTable table;
+        return table;
+    }
+}
+
+MaterialPropertyId Renderer::Common::ResolveMaterialProperty(std::string_view name)
+{
+    PropertyTable &table = Table();
+    std::lock_guard lock(table.mutex);
+
+    std::string key(name);
+    if (const auto it = table.ids.find(key); it != table.ids.end())
+    {
+        return it->second;
+    }
+
+    const auto id = static_cast<MaterialPropertyId>(table.names.size());
+    table.names.push_back(key);
+    table.ids.emplace(std::move(key), id);
+    return id;
+}
+
+const std::string& Renderer::Common::GetMaterialPropertyName(MaterialPropertyId id)
+{
+    static const std::string unknown;
+    PropertyTable &table = Table();
+    std::lock_guard lock(table.mutex);
+    return id < table.names.size() ? table.names[id] : unknown;
+}
@@ -9,47 +9,47 @@ using namespace Renderer::OpenGL;
 OpenGLMaterial::OpenGLMaterial(std::shared_ptr<OpenGLShader> shader, Common::ITexture *texture)
     : _shader(shader), _texture(texture ? static_cast<OpenGLTexture *>(texture) : nullptr)
 {
-    SetColor("uAlbedo", 1, 1, 1, 1);
+    _parameters.SetVec4(Common::MaterialProperty::Albedo, 1, 1, 1, 1);
 }
 
 void OpenGLMaterial::SetFloat(const std::string &name, float value)
 {
-    _floats[name] = value;
+    _parameters.SetFloat(Common::ResolveMaterialProperty(name), value);
 }
 
 void OpenGLMaterial::SetInt(const std::string &name, int value)
 {
-    _ints[name] = value;
+    _parameters.SetInt(Common::ResolveMaterialProperty(name), value);
 }
 
 void OpenGLMaterial::SetVec2(const std::string &name, float x, float y)
 {
-    _vec2s[name] = {x, y};
+    _parameters.SetVec2(Common::ResolveMaterialProperty(name), x, y);
 }
 
 void OpenGLMaterial::SetVec2(const std::string &name, N2Engine::Math::Vector2 &value)
 {
-    _vec2s[name] = {value.x, value.y};
+    SetVec2(name, value.x, value.y);
 }
 
 void OpenGLMaterial::SetVec3(const std::string &name, float x, float y, float z)
 {
-    _vec3s[name] = {x, y, z};
+    _parameters.SetVec3(Common::ResolveMaterialProperty(name), x, y, z);
 }
 
 void OpenGLMaterial::SetVec3(const std::string &name, N2Engine::Math::Vector3 &value)
 {
-    _vec3s[name] = {value.x, value.y, value.z};
+    SetVec3(name, value.x, value.y, value.z);
 }
 
 void OpenGLMaterial::SetVec4(const std::string &name, float x, float y, float z, float w)
 {
-    _vec4s[name] = {x, y, z, w};
+    _parameters.SetVec4(Common::ResolveMaterialProperty(name), x, y, z, w);
 }
 
 void OpenGLMaterial::SetVec4(const std::string &name, N2Engine::Math::Vector4 &value)
 {
-    _vec4s[name] = {value.x, value.y, value.z, value.w};
+    SetVec4(name, value.x, value.y, value.z, value.w);
 }
 
 void Renderer::OpenGL::OpenGLMaterial::SetColor(const std::string &name, float r, float g, float b, float a)
@@ -69,29 +69,38 @@ void OpenGLMaterial::Apply()
     // Bind the shader first
     _shader->Bind();
 
-    // Apply all stored properties to the shader
-    for (const auto &[name, value] : _floats)
+    // Upload every set property straight from the parameter block; the shader
+    // caches each property's uniform location, so no names are touched here.
+    const auto parameters = _parameters.GetParameters();
+    for (Common::MaterialPropertyId id = 0; id < parameters.size(); ++id)
     {
-        _shader->SetFloat(name, value);
-    }
-
-    for (const auto &[name, value] : _ints)
-    {
-        _shader->SetInt(name, value);
-    }
-
-    for (const auto &[name, value] : _vec2s)
-    {
-        _shader->SetVec2(name, value[0], value[1]);
-    }
-
-    for (const auto &[name, value] : _vec3s)
-    {
-        _shader->SetVec3(name, value[0], value[1], value[2]);
-    }
-
-    for (const auto &[name, value] : _vec4s)
-    {
-        _shader->SetVec4(name, value[0], value[1], value[2], value[3]);
+        const Common::MaterialParameter &p = parameters[id];
+        if (p.type == Common::MaterialParameterType::None)
+            continue;
+
+        const GLint location = _shader->GetPropertyLocation(id);
+        if (location < 0)
+            continue;
+
+        switch (p.type)
+        {
+            case Common::MaterialParameterType::Int:
+                glUniform1i(location, p.intValue);
+                break;
+            case Common::MaterialParameterType::Float:
+                glUniform1f(location, p.value[0]);
+                break;
+            case Common::MaterialParameterType::Vec2:
+                glUniform2fv(location, 1, p.value);
+                break;
+            case Common::MaterialParameterType::Vec3:
+                glUniform3fv(location, 1, p.value);
+                break;
+            case Common::MaterialParameterType::Vec4:
+                glUniform4fv(location, 1, p.value);
+                break;
+            case Common::MaterialParameterType::None:
+                break;
+        }
     }
 }
\ No newline at end of file
@@ -75,10 +75,17 @@ bool OpenGLRenderer::Initialize(GLFWwindow *windowHandle, const uint32_t width,
 
 void OpenGLRenderer::Shutdown()
 {
-    m_materials.clear(); // Destroy materials first
-    m_meshes.clear(); // Then meshes
-    m_textures.clear();
-    m_shaderPrograms.clear();
+    m_materials.Clear(); // Destroy materials first
+    m_meshes.Clear(); // Then meshes
+    m_textures.Clear();
+    m_shaderPrograms.Clear();
+
+    if (m_instanceVBO != 0)
+    {
+        glDeleteBuffers(1, &m_instanceVBO);
+        m_instanceVBO = 0;
+        m_instanceCapacity = 0;
+    }
 }
 
 void OpenGLRenderer::Resize(const uint32_t width, const uint32_t height)
@@ -98,9 +105,7 @@ Renderer::Common::IShader* OpenGLRenderer::CreateShaderProgram(const char *verte
         return nullptr;
     }
 
-    Common::IShader *ptr = shader.get();
-    m_shaderPrograms[ptr] = shader;
-    return ptr;
+    return m_shaderPrograms.Insert(std::move(shader));
 }
 
 void OpenGLRenderer::UseShaderProgram(Common::IShader *shader)
@@ -125,34 +130,23 @@ void OpenGLRenderer::UseShaderProgram(Common::IShader *shader)
     }
 }
 
-bool OpenGLRenderer::DestroyShaderProgram(Common::IShader *shader)
+bool OpenGLRenderer::DestroyShaderProgram(const Common::ShaderHandle shader)
 {
-    if (!shader)
-    {
-        return false;
-    }
-
-    if (auto it = m_shaderPrograms.find(shader); it != m_shaderPrograms.end())
+    if (const auto *owned = m_shaderPrograms.Find(shader.slot))
     {
-        if (it->second->GetId() == m_currentShader)
+        if ((*owned)->GetId() == m_currentShader)
         {
             m_currentShader = 0;
         }
-        m_shaderPrograms.erase(it);
-        return true;
+        return m_shaderPrograms.Erase(shader.slot);
     }
     return false;
 }
 
-bool OpenGLRenderer::IsValidShader(Common::IShader *shader) const
+bool OpenGLRenderer::IsValidShader(const Common::ShaderHandle shader) const
 {
-    if (!shader)
-    {
-        return false;
-    }
-
-    auto it = m_shaderPrograms.find(shader);
-    return it != m_shaderPrograms.end() && it->second->IsValid();
+    const auto *owned = m_shaderPrograms.Find(shader.slot);
+    return owned && (*owned)->IsValid();
 }
 
 void OpenGLRenderer::BeginFrame()
@@ -199,16 +193,12 @@ Renderer::Common::IMesh* OpenGLRenderer::CreateMesh(const Common::MeshData &mesh
         return nullptr;
     }
 
-    auto [iter, inserted] = m_meshes.try_emplace(mesh.get(), std::move(mesh));
-    return iter->first;
+    return m_meshes.Insert(std::move(mesh));
 }
 
-void OpenGLRenderer::DestroyMesh(Common::IMesh *mesh)
+void OpenGLRenderer::DestroyMesh(const Common::MeshHandle mesh)
 {
-    if (!mesh)
-        return;
-
-    m_meshes.erase(mesh);
+    m_meshes.Erase(mesh.slot);
 }
 
 Renderer::Common::ITexture* OpenGLRenderer::CreateTexture(const uint8_t *data, const uint32_t width,
@@ -223,17 +213,12 @@ Renderer::Common::ITexture* OpenGLRenderer::CreateTexture(const uint8_t *data, c
         return nullptr;
     }
 
-    auto [iter, inserted] = m_textures.try_emplace(texture.get(), std::move(texture));
-    return iter->first;
+    return m_textures.Insert(std::move(texture));
 }
 
-void OpenGLRenderer::DestroyTexture(Common::ITexture *texture)
+void OpenGLRenderer::DestroyTexture(const Common::TextureHandle texture)
 {
-    if (!texture)
-    {
-        return;
-    }
-    m_textures.erase(texture);
+    m_textures.Erase(texture.slot);
 }
 
 Renderer::Common::IMaterial* OpenGLRenderer::CreateMaterial(Common::IShader* shader)
@@ -256,40 +241,34 @@ Renderer::Common::IMaterial* OpenGLRenderer::CreateMaterial(Common::IShader *sha
     }
 
     // Ensure shader is managed by this renderer
-    const auto shaderIt = m_shaderPrograms.find(shader);
-    if (shaderIt == m_shaderPrograms.end())
+    const auto *ownedShader = m_shaderPrograms.Find(shader->GetHandle().slot);
+    if (!ownedShader || ownedShader->get() != shader)
     {
         std::cerr << "Shader not managed by this renderer." << std::endl;
         return nullptr;
     }
 
-    auto material = std::make_unique<OpenGLMaterial>(shaderIt->second, texture);
+    auto material = std::make_unique<OpenGLMaterial>(*ownedShader, texture);
 
     if (shader == m_standardLitShader)
     {
         // lit shader defaults
-        material->SetFloat("uMetallic", 0.0f);
-        material->SetFloat("uSmoothness", 0.5f);
-        material->SetInt("uHasTexture", texture != nullptr ? 1 : 0);
+        material->GetParameters().SetFloat(Common::MaterialProperty::Metallic, 0.0f);
+        material->GetParameters().SetFloat(Common::MaterialProperty::Smoothness, 0.5f);
+        material->GetParameters().SetInt(Common::MaterialProperty::HasTexture, texture != nullptr ? 1 : 0);
     }
     else if (shader == m_standardUnlitShader)
     {
-        material->SetInt("uHasTexture", texture != nullptr ? 1 : 0);
+        material->GetParameters().SetInt(Common::MaterialProperty::HasTexture, texture != nullptr ? 1 : 0);
     }
     // ⭐ END ADD ⭐
 
-    auto [iter, inserted] = m_materials.try_emplace(material.get(), std::move(material));
-    return iter->first;
+    return m_materials.Insert(std::move(material));
 }
 
-void OpenGLRenderer::DestroyMaterial(Common::IMaterial *material)
+void OpenGLRenderer::DestroyMaterial(const Common::MaterialHandle material)
 {
-    if (!material)
-    {
-        return;
-    }
-
-    m_materials.erase(material);
+    m_materials.Erase(material.slot);
 }
 
 void OpenGLRenderer::SetViewProjection(const float *view, const float *projection)
@@ -314,11 +293,11 @@ void OpenGLRenderer::UpdateSceneLighting(
     if (!m_standardLitShader)
         return;
 
-    auto shaderIt = m_shaderPrograms.find(m_standardLitShader);
-    if (shaderIt == m_shaderPrograms.end())
+    const auto *ownedShader = m_shaderPrograms.Find(m_standardLitShader->GetHandle().slot);
+    if (!ownedShader)
         return;
 
-    auto *shader = static_cast<OpenGLShader*>(shaderIt->second.get());
+    auto *shader = ownedShader->get();
     shader->Bind();
 
     // Set ambient
@@ -393,17 +372,8 @@ void OpenGLRenderer::UpdateSceneLighting(
 }
 
 
-void OpenGLRenderer::DrawMesh(Common::IMesh *mesh, const float *modelMatrix, Common::IMaterial *material)
+const OpenGLShader* OpenGLRenderer::ApplyDrawState(OpenGLMaterial *glMaterial) const
 {
-    if (!mesh || !mesh->IsValid() || !material)
-    {
-        return;
-    }
-
-    // implicitly safe cast to OpenGL-specific types created
-    const auto *glMesh = dynamic_cast<OpenGLMesh*>(mesh);
-    auto *glMaterial = dynamic_cast<OpenGLMaterial*>(material);
-
     // Apply material (binds shader and sets material properties)
     glMaterial->Apply();
 
@@ -411,17 +381,11 @@ void OpenGLRenderer::DrawMesh(Common::IMesh *mesh, const float *modelMatrix, Com
     const OpenGLShader *shader = glMaterial->GetShader();
     if (!shader)
     {
-        return;
+        return nullptr;
     }
 
     const ShaderUniforms &uniforms = shader->GetCommonUniforms();
 
-    // Set transform uniforms
-    if (uniforms.modelLoc != -1)
-    {
-        glUniformMatrix4fv(uniforms.modelLoc, 1, GL_TRUE, modelMatrix);
-    }
-
     if (uniforms.viewLoc != -1)
     {
         glUniformMatrix4fv(uniforms.viewLoc, 1, GL_TRUE, m_viewMatrix);
@@ -444,12 +408,118 @@ void OpenGLRenderer::DrawMesh(Common::IMesh *mesh, const float *modelMatrix, Com
         }
     }
 
+    return shader;
+}
+
+void OpenGLRenderer::DrawMesh(Common::IMesh *mesh, const float *modelMatrix, Common::IMaterial *material)
+{
+    if (!mesh || !mesh->IsValid() || !material)
+    {
+        return;
+    }
+
+    // implicitly safe cast to OpenGL-specific types created
+    const auto *glMesh = dynamic_cast<OpenGLMesh*>(mesh);
+    auto *glMaterial = dynamic_cast<OpenGLMaterial*>(material);
+
+    const OpenGLShader *shader = ApplyDrawState(glMaterial);
+    if (!shader)
+    {
+        return;
+    }
+
+    const ShaderUniforms &uniforms = shader->GetCommonUniforms();
+
+    // Set transform uniforms
+    if (uniforms.modelLoc != -1)
+    {
+        glUniformMatrix4fv(uniforms.modelLoc, 1, GL_TRUE, modelMatrix);
+    }
+
+    if (uniforms.instancedLoc != -1)
+    {
+        glUniform1i(uniforms.instancedLoc, GL_FALSE);
+    }
+
     // Draw mesh
     glBindVertexArray(glMesh->GetVAO());
     glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(glMesh->GetIndexCount()), GL_UNSIGNED_INT, nullptr);
     glBindVertexArray(0);
 }
 
+void OpenGLRenderer::DrawMeshInstanced(Common::IMesh *mesh, Common::IMaterial *material,
+                                       std::span<const float[16]> modelMatrices)
+{
+    if (!mesh || !mesh->IsValid() || !material || modelMatrices.empty())
+    {
+        return;
+    }
+
+    const auto *glMesh = dynamic_cast<OpenGLMesh*>(mesh);
+    auto *glMaterial = dynamic_cast<OpenGLMaterial*>(material);
+
+    const OpenGLShader *shader = ApplyDrawState(glMaterial);
+    if (!shader)
+    {
+        return;
+    }
+
+    const ShaderUniforms &uniforms = shader->GetCommonUniforms();
+    const auto indexCount = static_cast<GLsizei>(glMesh->GetIndexCount());
+
+    // Custom shaders without the instance attribute: one model uniform per instance
+    if (uniforms.instancedLoc == -1)
+    {
+        glBindVertexArray(glMesh->GetVAO());
+        for (const float (&modelMatrix)[16] : modelMatrices)
+        {
+            if (uniforms.modelLoc != -1)
+            {
+                glUniformMatrix4fv(uniforms.modelLoc, 1, GL_TRUE, modelMatrix);
+            }
+            glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr);
+        }
+        glBindVertexArray(0);
+        return;
+    }
+
+    // Stream the matrices; orphaning the old storage avoids stalling on draws still using it
+    if (m_instanceVBO == 0)
+    {
+        glGenBuffers(1, &m_instanceVBO);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+    m_instanceCapacity = std::max(m_instanceCapacity, modelMatrices.size());
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_instanceCapacity * sizeof(float[16])), nullptr,
+                 GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(modelMatrices.size_bytes()), modelMatrices.data());
+
+    glUniform1i(uniforms.instancedLoc, GL_TRUE);
+
+    // mat4 attribute = 4 vec4 slots. The matrices are row-major, so each slot
+    // receives a row; the shader transposes.
+    glBindVertexArray(glMesh->GetVAO());
+    for (GLuint i = 0; i < 4; ++i)
+    {
+        const GLuint location = 4 + i;
+        glEnableVertexAttribArray(location);
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(float[16]),
+                              reinterpret_cast<void*>(i * 4 * sizeof(float)));
+        glVertexAttribDivisor(location, 1);
+    }
+
+    glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr,
+                            static_cast<GLsizei>(modelMatrices.size()));
+
+    // Leave the mesh's VAO as CreateMesh made it, for the non-instanced path
+    for (GLuint i = 0; i < 4; ++i)
+    {
+        glDisableVertexAttribArray(4 + i);
+    }
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
 void OpenGLRenderer::DrawObjects(const std::vector<Common::RenderObject> &objects)
 {
     for (const auto &obj : objects)
@@ -593,15 +663,18 @@ void OpenGLRenderer::CreateStandardShaders()
         layout (location = 1) in vec3 aNormal;
         layout (location = 2) in vec2 aTexCoord;
         layout (location = 3) in vec4 aColor;
+        layout (location = 4) in mat4 aInstanceModel;   // row-major, from DrawMeshInstanced
 
         uniform mat4 uModel;
         uniform mat4 uView;
         uniform mat4 uProjection;
+        uniform bool uInstanced;
 
         out vec2 fragTexCoord;
 
         void main() {
-            gl_Position = uProjection * uView * uModel * vec4(aPos, 1.0);
+            mat4 model = uInstanced ? transpose(aInstanceModel) : uModel;
+            gl_Position = uProjection * uView * model * vec4(aPos, 1.0);
             fragTexCoord = aTexCoord;
         }
     )";
@@ -634,21 +707,24 @@ void OpenGLRenderer::CreateStandardShaders()
         layout (location = 1) in vec3 aNormal;
         layout (location = 2) in vec2 aTexCoord;
         layout (location = 3) in vec4 aColor;
+        layout (location = 4) in mat4 aInstanceModel;   // row-major, from DrawMeshInstanced
 
         uniform mat4 uModel;
         uniform mat4 uView;
         uniform mat4 uProjection;
+        uniform bool uInstanced;
 
         out vec3 fragNormal;
         out vec3 fragWorldPos;
         out vec2 fragTexCoord;
 
         void main() {
-            vec4 worldPos = uModel * vec4(aPos, 1.0);
+            mat4 model = uInstanced ? transpose(aInstanceModel) : uModel;
+            vec4 worldPos = model * vec4(aPos, 1.0);
             fragWorldPos = worldPos.xyz;
 
             // Transform normal to world space (proper method)
-            mat3 normalMatrix = transpose(inverse(mat3(uModel)));
+            mat3 normalMatrix = transpose(inverse(mat3(model)));
             fragNormal = normalize(normalMatrix * aNormal);
 
             fragTexCoord = aTexCoord;
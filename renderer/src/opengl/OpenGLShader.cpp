@@ -35,6 +35,7 @@ bool OpenGLShader::LoadFromStrings(const std::string &vertexSource, const std::s
         glDeleteProgram(_programId);
         _programId = 0;
         _uniformLocationCache.clear();
+        _propertyLocations.clear();
     }
 
     unsigned int vertexShader = CompileShader(vertexSource, GL_VERTEX_SHADER);
@@ -196,6 +197,21 @@ GLint OpenGLShader::GetUniformLocation(const std::string &name) const
     return location;
 }
 
+GLint OpenGLShader::GetPropertyLocation(Common::MaterialPropertyId id) const
+{
+    if (id >= _propertyLocations.size())
+    {
+        _propertyLocations.resize(id + 1, -2);
+    }
+
+    GLint &location = _propertyLocations[id];
+    if (location == -2)
+    {
+        location = GetUniformLocation(Common::GetMaterialPropertyName(id));
+    }
+    return location;
+}
+
 void OpenGLShader::CheckCompileErrors(unsigned int shader, const std::string &type)
 {
     int infoLogLength;
@@ -235,6 +251,7 @@ void OpenGLShader::CacheCommonUniforms()
     _commonUniforms.projectionLoc = glGetUniformLocation(_programId, "uProjection");
     _commonUniforms.textureLoc = glGetUniformLocation(_programId, "uTexture");
     _commonUniforms.colorLoc = glGetUniformLocation(_programId, "uColor");
+    _commonUniforms.instancedLoc = glGetUniformLocation(_programId, "uInstanced");
 
     // Add to cache to avoid duplicate lookups
     if (_commonUniforms.modelLoc != -1)
@@ -247,4 +264,6 @@ void OpenGLShader::CacheCommonUniforms()
         _uniformLocationCache["uTexture"] = _commonUniforms.textureLoc;
     if (_commonUniforms.colorLoc != -1)
         _uniformLocationCache["uColor"] = _commonUniforms.colorLoc;
+    if (_commonUniforms.instancedLoc != -1)
+        _uniformLocationCache["uInstanced"] = _commonUniforms.instancedLoc;
 }
\ No newline at end of file
@@ -0,0 +1,95 @@
+#include "renderer/software/SWTexture.hpp"
+
+using namespace Renderer::Software;
+
+void SWTexture::Build(const uint8_t *data, uint32_t w, uint32_t h, uint32_t ch, SWTextureLayout memoryLayout)
+{
+    width = w;
+    height = h;
+    channels = ch;
+    layout = memoryLayout;
+    m_tileShift = 0;
+    texels.clear();
+    levels.clear();
+    if (!data || w == 0 || h == 0 || ch == 0) return;
+
+    // Level sizes first, so the chain is allocated once.
+    size_t total = 0;
+    for (uint32_t lw = w, lh = h;; lw = std::max(lw >> 1, 1u), lh = std::max(lh >> 1, 1u))
+    {
+        levels.push_back({lw, lh, lw, total});
+        total += (size_t)lw * lh;
+        if (lw == 1 && lh == 1) break;
+    }
+    texels.resize(total);
+
+    // Level 0: expand to RGBA8 once, instead of branching on channels per lookup.
+    for (size_t i = 0; i < (size_t)w * h; ++i)
+    {
+        const uint8_t *p = data + i * ch;
+        const uint32_t r = p[0];
+        const uint32_t g = ch > 1 ? p[1] : 255;
+        const uint32_t b = ch > 2 ? p[2] : 255;
+        const uint32_t a = ch > 3 ? p[3] : 255;
+        texels[i] = (a << 24) | (b << 16) | (g << 8) | r;
+    }
+
+    // Each level averages 2x2 texels of the previous one. Odd sizes repeat
+    // the last row/column rather than reading past it.
+    for (size_t l = 1; l < levels.size(); ++l)
+    {
+        const MipLevel &src = levels[l - 1];
+        const MipLevel &dst = levels[l];
+        const uint32_t *s = texels.data() + src.offset;
+        uint32_t *d = texels.data() + dst.offset;
+        for (uint32_t y = 0; y < dst.height; ++y)
+        {
+            const uint32_t *row0 = s + (size_t)std::min(2 * y, src.height - 1) * src.width;
+            const uint32_t *row1 = s + (size_t)std::min(2 * y + 1, src.height - 1) * src.width;
+            for (uint32_t x = 0; x < dst.width; ++x)
+            {
+                const uint32_t x0 = std::min(2 * x, src.width - 1);
+                const uint32_t x1 = std::min(2 * x + 1, src.width - 1);
+                const uint32_t quad[4] = {row0[x0], row0[x1], row1[x0], row1[x1]};
+                uint32_t out = 0;
+                for (int c = 0; c < 32; c += 8)
+                {
+                    uint32_t sum = 2;   // round to nearest
+                    for (const uint32_t t : quad) sum += (t >> c) & 0xFF;
+                    out |= (sum >> 2) << c;
+                }
+                d[(size_t)y * dst.width + x] = out;
+            }
+        }
+    }
+
+    if (memoryLayout == SWTextureLayout::Tiled) Swizzle();
+}
+
+void SWTexture::Swizzle()
+{
+    // Every level is padded up to whole 4x4 tiles; padding is never sampled.
+    constexpr uint32_t shift = 2, edge = 1u << shift;
+    std::vector<MipLevel> tiled;
+    size_t total = 0;
+    for (const MipLevel &level : levels)
+    {
+        const uint32_t bw = (level.width + edge - 1) >> shift;
+        const uint32_t bh = (level.height + edge - 1) >> shift;
+        tiled.push_back({level.width, level.height, bw, total});
+        total += (size_t)bw * bh << (2 * shift);
+    }
+
+    std::vector<uint32_t> linear = std::move(texels);
+    texels.assign(total, 0);
+    m_tileShift = shift;
+    for (size_t l = 0; l < levels.size(); ++l)
+    {
+        const MipLevel &src = levels[l];
+        const uint32_t *s = linear.data() + src.offset;
+        for (uint32_t y = 0; y < src.height; ++y)
+            for (uint32_t x = 0; x < src.width; ++x)
+                texels[TexelIndex(tiled[l], x, y)] = s[(size_t)y * src.width + x];
+    }
+    levels = std::move(tiled);
+}
@@ -5,6 +5,11 @@
 #include <array>
 #include <cassert>
 #include <vector>
+#include <thread>
+#include <bit>
+#include <immintrin.h>
+
+#include <math/CpuInfo.hpp>
 
 #include "renderer/software/SWMaterial.hpp"
 #include "renderer/software/SWMesh.hpp"
@@ -72,6 +77,7 @@ namespace
         float aR = 1.f, aG = 1.f, aB = 1.f, aA = 1.f;
         float shininess = 130.f;
         const SWTexture* tex = nullptr;   // null if absent or invalid
+        SWTextureFilter filter = SWTextureFilter::Bilinear;
         bool lit = false;
         uint32_t flatColor = 0xFFFFFFFF;  // unlit + untextured: constant per draw
     };
@@ -82,9 +88,10 @@ namespace
         float smooth = 0.5f;
         if (mat)
         {
-            auto alb = mat->GetVec4("uAlbedo", {1, 1, 1, 1});
+            const auto& params = mat->GetParameters();
+            auto alb = params.GetVec4(MaterialProperty::Albedo, {1, 1, 1, 1});
             r.aR = alb[0]; r.aG = alb[1]; r.aB = alb[2]; r.aA = alb[3];
-            smooth = mat->GetFloat("uSmoothness", 0.5f);
+            smooth = params.GetFloat(MaterialProperty::Smoothness, 0.5f);
 
             if (auto* t = dynamic_cast<const SWTexture*>(mat->GetTexture()); t && t->IsValid())
                 r.tex = t;
@@ -142,10 +149,9 @@ namespace
     // Per-pixel shading. Same math as before, but everything variable was
     // hoisted into ResolvedMat / LitState, and pow() only runs when N·H > 0.
     // ------------------------------------------------------------------
-    inline uint32_t ShadeUnlitPx(float u, float v, const ResolvedMat& m)
+    // s is the filtered texel; the flat case never reaches here.
+    inline uint32_t ShadeUnlitPx(uint32_t s, const ResolvedMat& m)
     {
-        // Caller guarantees m.tex != nullptr (the flat case never reaches here).
-        const uint32_t s = m.tex->Sample(u, v);
         constexpr float k = 1.f / 255.f;
         const float r = m.aR * (float)((s >>  0) & 0xFF) * k;
         const float g = m.aG * (float)((s >>  8) & 0xFF) * k;
@@ -156,7 +162,7 @@ namespace
 
     inline uint32_t ShadeLitPx(float wx, float wy, float wz,
                                float nx, float ny, float nz,
-                               float u, float v,
+                               uint32_t s,   // filtered texel; ignored without a texture
                                const ResolvedMat& m, const LitState& L)
     {
         const float nlen = std::sqrt(nx*nx + ny*ny + nz*nz);
@@ -165,7 +171,6 @@ namespace
         float r = m.aR, g = m.aG, b = m.aB, a = m.aA;
         if (m.tex)
         {
-            const uint32_t s = m.tex->Sample(u, v);
             constexpr float k = 1.f / 255.f;
             r *= (float)((s >>  0) & 0xFF) * k;
             g *= (float)((s >>  8) & 0xFF) * k;
@@ -361,22 +366,56 @@ namespace
              - (int64_t)(b.fy - a.fy) * (c.fx - a.fx);
     }
 
-    template <bool LIT>
-    void RasterTri(const ScreenVert& sv0, const ScreenVert& sv1, const ScreenVert& sv2,
-                   const RasterTarget& t, const ResolvedMat& mat,
-                   [[maybe_unused]] const LitState& lit)
+    // Edge setup. The fill-rule bias makes a shared edge belong to exactly
+    // one of its two triangles, so adjacent triangles neither double-shade
+    // nor leave cracks along shared edges.
+    inline void EdgeSetup(const ScreenVert& a, const ScreenVert& b,
+                          int64_t& stepX, int64_t& stepY, int64_t& bias)
+    {
+        const int32_t dx = b.fx - a.fx;
+        const int32_t dy = b.fy - a.fy;
+        stepX = -(int64_t)dy * kSubStep;   // per +1 pixel in x
+        stepY =  (int64_t)dx * kSubStep;   // per +1 pixel in y
+        const bool acceptsEq = (dy < 0) || (dy == 0 && dx > 0);
+        bias = acceptsEq ? 0 : 1;
+    }
+
+    inline int64_t EdgeAt(const ScreenVert& a, const ScreenVert& b, int64_t cx, int64_t cy)
+    {
+        return (int64_t)(b.fx - a.fx) * (cy - a.fy)
+             - (int64_t)(b.fy - a.fy) * (cx - a.fx);
+    }
+
+    // Everything about a triangle that doesn't depend on which pixels are
+    // walked. Edge values are exact integers, so walking any sub-rectangle of
+    // the bounding box (a tile) touches exactly the pixels — with exactly the
+    // barycentrics — that a walk over the whole box would.
+    struct TriSetup
+    {
+        ScreenVert A, B, C;            // canonicalized to CCW
+        int px0, py0, px1, py1;        // covered pixel centers, clamped to the target
+        int64_t s0x, s0y, b0;          // weight of A
+        int64_t s1x, s1y, b1;          // weight of B
+        int64_t s2x, s2y, b2;          // weight of C
+        float invArea;
+        float duwdx, duwdy, dvwdx, dvwdy, diwdx, diwdy;   // per-pixel steps of u/w, v/w, 1/w (texture LOD)
+    };
+
+    // Returns false if the triangle is culled or covers no pixel center.
+    bool SetupTri(const ScreenVert& sv0, const ScreenVert& sv1, const ScreenVert& sv2,
+                  int width, int height, TriSetup& s)
     {
         const ScreenVert* A = &sv0;
         const ScreenVert* B = &sv1;
         const ScreenVert* C = &sv2;
 
         int64_t area2 = Orient(*A, *B, *C);   // 2x signed area; sign = winding
-        if (area2 == 0) return;
+        if (area2 == 0) return false;
 
         if constexpr (kCullBackfaces)
         {
             const bool front = kFrontFaceCCW ? (area2 > 0) : (area2 < 0);
-            if (!front) return;
+            if (!front) return false;
         }
         if (area2 < 0) { std::swap(B, C); area2 = -area2; }   // canonicalize to CCW
 
@@ -386,51 +425,125 @@ namespace
         const int32_t minFy = std::min({A->fy, B->fy, C->fy});
         const int32_t maxFy = std::max({A->fy, B->fy, C->fy});
 
-        int px0 = (minFx - kSubHalf + kSubStep - 1) >> kSubBits;   // ceil
-        int px1 = (maxFx - kSubHalf) >> kSubBits;                  // floor
-        int py0 = (minFy - kSubHalf + kSubStep - 1) >> kSubBits;
-        int py1 = (maxFy - kSubHalf) >> kSubBits;
-
-        px0 = std::max(px0, 0);
-        py0 = std::max(py0, 0);
-        px1 = std::min(px1, t.width  - 1);
-        py1 = std::min(py1, t.height - 1);
-        if (px0 > px1 || py0 > py1) return;
-
-        // Edge setup. The fill-rule bias makes a shared edge belong to exactly
-        // one of its two triangles, so adjacent triangles neither double-shade
-        // nor leave cracks along shared edges.
-        auto edgeSetup = [](const ScreenVert& a, const ScreenVert& b,
-                            int64_t& stepX, int64_t& stepY, int64_t& bias)
-        {
-            const int32_t dx = b.fx - a.fx;
-            const int32_t dy = b.fy - a.fy;
-            stepX = -(int64_t)dy * kSubStep;   // per +1 pixel in x
-            stepY =  (int64_t)dx * kSubStep;   // per +1 pixel in y
-            const bool acceptsEq = (dy < 0) || (dy == 0 && dx > 0);
-            bias = acceptsEq ? 0 : 1;
-        };
-        auto edgeAt = [](const ScreenVert& a, const ScreenVert& b, int64_t cx, int64_t cy)
+        s.px0 = std::max((minFx - kSubHalf + kSubStep - 1) >> kSubBits, 0);        // ceil
+        s.py0 = std::max((minFy - kSubHalf + kSubStep - 1) >> kSubBits, 0);
+        s.px1 = std::min((maxFx - kSubHalf) >> kSubBits, width  - 1);              // floor
+        s.py1 = std::min((maxFy - kSubHalf) >> kSubBits, height - 1);
+        if (s.px0 > s.px1 || s.py0 > s.py1) return false;
+
+        s.A = *A; s.B = *B; s.C = *C;
+        EdgeSetup(*B, *C, s.s0x, s.s0y, s.b0);
+        EdgeSetup(*C, *A, s.s1x, s.s1y, s.b1);
+        EdgeSetup(*A, *B, s.s2x, s.s2y, s.b2);
+        s.invArea = 1.f / (float)area2;
+
+        const float l0x = (float)s.s0x * s.invArea, l0y = (float)s.s0y * s.invArea;
+        const float l1x = (float)s.s1x * s.invArea, l1y = (float)s.s1y * s.invArea;
+        const float l2x = (float)s.s2x * s.invArea, l2y = (float)s.s2y * s.invArea;
+        s.duwdx = l0x*A->uw   + l1x*B->uw   + l2x*C->uw;    s.duwdy = l0y*A->uw   + l1y*B->uw   + l2y*C->uw;
+        s.dvwdx = l0x*A->vw   + l1x*B->vw   + l2x*C->vw;    s.dvwdy = l0y*A->vw   + l1y*B->vw   + l2y*C->vw;
+        s.diwdx = l0x*A->invW + l1x*B->invW + l2x*C->invW;  s.diwdy = l0y*A->invW + l1y*B->invW + l2y*C->invW;
+        return true;
+    }
+
+    // Filtered texel for a pixel with perspective-correct (u, v). Like a GPU,
+    // the LOD comes from derivatives of the 2x2 quad holding the pixel, so all
+    // four pixels of a quad pick the same mip. uw, vw, iw are u/w, v/w and 1/w
+    // at the pixel; the derivatives are exact ones at the quad's first pixel.
+    inline uint32_t SampleTexPx(const TriSetup& s, float uw, float vw, float iw, float u, float v,
+                                int px, int py, const ResolvedMat& mat)
+    {
+        if (mat.filter == SWTextureFilter::Nearest) return mat.tex->Sample(u, v);
+
+        const float qx = (float)(px & 1), qy = (float)(py & 1);
+        float qiw = iw - qx * s.diwdx - qy * s.diwdy;
+        float qu = u, qv = v, rq = 1.f / iw;
+        if (qiw > 0.f)   // extrapolating 1/w past the triangle can cross the horizon; keep the pixel's own
         {
-            return (int64_t)(b.fx - a.fx) * (cy - a.fy)
-                 - (int64_t)(b.fy - a.fy) * (cx - a.fx);
-        };
+            rq = 1.f / qiw;
+            qu = (uw - qx * s.duwdx - qy * s.duwdy) * rq;
+            qv = (vw - qx * s.dvwdx - qy * s.dvwdy) * rq;
+        }
+        const float dudx = (s.duwdx - qu * s.diwdx) * rq, dvdx = (s.dvwdx - qv * s.diwdx) * rq;
+        const float dudy = (s.duwdy - qu * s.diwdy) * rq, dvdy = (s.dvwdy - qv * s.diwdy) * rq;
+        return mat.tex->SampleFiltered(u, v, mat.tex->ComputeLod(dudx, dvdx, dudy, dvdy), mat.filter);
+    }
+
+    // Shades one covered pixel from its screen-space barycentrics.
+    template <bool LIT>
+    inline uint32_t ShadePx(const TriSetup& s, float l0, float l1, float l2, int px, int py,
+                            const ResolvedMat& mat, [[maybe_unused]] const LitState& lit)
+    {
+        const ScreenVert* A = &s.A;
+        const ScreenVert* B = &s.B;
+        const ScreenVert* C = &s.C;
+
+        if constexpr (LIT)
+        {
+            const float iw = l0*A->invW + l1*B->invW + l2*C->invW;
+            const float rw = 1.f / iw;
+            const float uw = l0*A->uw  + l1*B->uw  + l2*C->uw;
+            const float vw = l0*A->vw  + l1*B->vw  + l2*C->vw;
+            const float u  = uw * rw;
+            const float v  = vw * rw;
+            const float nx = (l0*A->nxw + l1*B->nxw + l2*C->nxw) * rw;
+            const float ny = (l0*A->nyw + l1*B->nyw + l2*C->nyw) * rw;
+            const float nz = (l0*A->nzw + l1*B->nzw + l2*C->nzw) * rw;
+            const float wx = (l0*A->wxw + l1*B->wxw + l2*C->wxw) * rw;
+            const float wy = (l0*A->wyw + l1*B->wyw + l2*C->wyw) * rw;
+            const float wz = (l0*A->wzw + l1*B->wzw + l2*C->wzw) * rw;
+            const uint32_t texel = mat.tex ? SampleTexPx(s, uw, vw, iw, u, v, px, py, mat) : 0xFFFFFFFF;
+            return ShadeLitPx(wx, wy, wz, nx, ny, nz, texel, mat, lit);
+        }
+        else if (mat.tex)
+        {
+            const float iw = l0*A->invW + l1*B->invW + l2*C->invW;
+            const float rw = 1.f / iw;
+            const float uw = l0*A->uw + l1*B->uw + l2*C->uw;
+            const float vw = l0*A->vw + l1*B->vw + l2*C->vw;
+            return ShadeUnlitPx(SampleTexPx(s, uw, vw, iw, uw * rw, vw * rw, px, py, mat), mat);
+        }
+        else
+        {
+            return mat.flatColor;   // constant per draw — no interpolation at all
+        }
+    }
 
-        int64_t s0x, s0y, b0, s1x, s1y, b1, s2x, s2y, b2;
-        edgeSetup(*B, *C, s0x, s0y, b0);   // weight of A
-        edgeSetup(*C, *A, s1x, s1y, b1);   // weight of B
-        edgeSetup(*A, *B, s2x, s2y, b2);   // weight of C
+    // One pixel of the scalar loop; e0..e2 are the biased edge values at it.
+    template <bool LIT>
+    inline void RasterPx(const TriSetup& s, int64_t e0, int64_t e1, int64_t e2,
+                         float* drow, uint32_t* crow, int px, int py,
+                         const ResolvedMat& mat, const LitState& lit)
+    {
+        if ((e0 | e1 | e2) >= 0)   // sign-bit trick: inside iff none negative
+        {
+            const float l0 = (float)(e0 + s.b0) * s.invArea;
+            const float l1 = (float)(e1 + s.b1) * s.invArea;
+            const float l2 = (float)(e2 + s.b2) * s.invArea;
 
+            // Early-Z: interpolate depth only; shade only survivors.
+            const float z = l0 * s.A.z + l1 * s.B.z + l2 * s.C.z;
+            if (z < drow[px])
+            {
+                drow[px] = z;
+                crow[px] = ShadePx<LIT>(s, l0, l1, l2, px, py, mat, lit);
+            }
+        }
+    }
+
+    // Walks the pixel rectangle [px0, px1] x [py0, py1], which must lie inside
+    // the triangle's bounding box.
+    template <bool LIT>
+    void RasterTriRect(const TriSetup& s, int px0, int py0, int px1, int py1,
+                       const RasterTarget& t, const ResolvedMat& mat, const LitState& lit)
+    {
         const int64_t cx0 = (int64_t)px0 * kSubStep + kSubHalf;
         const int64_t cy0 = (int64_t)py0 * kSubStep + kSubHalf;
 
         // Bias folded in: the inside test collapses to (e0|e1|e2) >= 0.
-        int64_t r0 = edgeAt(*B, *C, cx0, cy0) - b0;
-        int64_t r1 = edgeAt(*C, *A, cx0, cy0) - b1;
-        int64_t r2 = edgeAt(*A, *B, cx0, cy0) - b2;
-
-        const float invArea = 1.f / (float)area2;
-        const float zA = A->z, zB = B->z, zC = C->z;
+        int64_t r0 = EdgeAt(s.B, s.C, cx0, cy0) - s.b0;
+        int64_t r1 = EdgeAt(s.C, s.A, cx0, cy0) - s.b1;
+        int64_t r2 = EdgeAt(s.A, s.B, cx0, cy0) - s.b2;
 
         for (int py = py0; py <= py1; ++py)
         {
@@ -440,57 +553,588 @@ namespace
             float*    drow = t.depth + row;
 
             int64_t e0 = r0, e1 = r1, e2 = r2;
-
             for (int px = px0; px <= px1; ++px)
             {
-                if ((e0 | e1 | e2) >= 0)   // sign-bit trick: inside iff none negative
+                RasterPx<LIT>(s, e0, e1, e2, drow, crow, px, py, mat, lit);
+                e0 += s.s0x; e1 += s.s1x; e2 += s.s2x;
+            }
+            r0 += s.s0y; r1 += s.s1y; r2 += s.s2y;
+        }
+    }
+}
+
+// ============================================================================
+// SIMD inner loops. Pixels are processed in groups of 4 (SSE4.1) or 8 (AVX2)
+// aligned to multiples of the group width: edge masks, depth interpolation
+// and the depth test run on the whole group, depth (and flat color) is
+// written with a blend, and only the surviving lanes are shaded — one at a
+// time, through the same ShadePx as the scalar loop.
+//
+// Images match the scalar loop exactly: the edge functions stay exact 64-bit
+// integers, their int64 -> float conversion is exact-then-rounded once like
+// the scalar cvtsi2ss, and depth is evaluated in the same operation order.
+//
+// Groups start at an aligned x, so a group never straddles two 64-pixel
+// tiles; lanes outside the rect are rewritten with their own values by the
+// thread that owns the tile. A group that would run past the right edge of
+// the target falls back to the scalar pixel.
+// ============================================================================
+namespace
+{
+    // Exact for |v| < 2^51, which fixed-point edge values always are.
+    inline __m128 I64x4ToF32(__m128i lo, __m128i hi)
+    {
+        const __m128i magicI = _mm_set1_epi64x(0x4338000000000000LL);
+        const __m128d magicD = _mm_set1_pd(6755399441055744.0);   // 1.5 * 2^52
+        const __m128d dlo = _mm_sub_pd(_mm_castsi128_pd(_mm_add_epi64(lo, magicI)), magicD);
+        const __m128d dhi = _mm_sub_pd(_mm_castsi128_pd(_mm_add_epi64(hi, magicI)), magicD);
+        return _mm_movelh_ps(_mm_cvtpd_ps(dlo), _mm_cvtpd_ps(dhi));
+    }
+
+    // Bit k set if lane gx + k lies inside [px0, px1].
+    template <int W>
+    inline unsigned LaneRange(int gx, int px0, int px1)
+    {
+        unsigned range = (1u << W) - 1u;
+        if (gx < px0)         range &= range << (px0 - gx);
+        if (gx + W - 1 > px1) range &= range >> (gx + W - 1 - px1);
+        return range;
+    }
+
+    template <bool LIT>
+    TARGET_SSE4_1 void RasterTriRectSSE41(const TriSetup& s, int px0, int py0, int px1, int py1,
+                                          const RasterTarget& t, const ResolvedMat& mat, const LitState& lit)
+    {
+        constexpr int W = 4;
+        const int gx0 = px0 & ~(W - 1);
+        const int lastGroupX = t.width - W;
+
+        const int64_t cx0 = (int64_t)gx0 * kSubStep + kSubHalf;
+        const int64_t cy0 = (int64_t)py0 * kSubStep + kSubHalf;
+        int64_t r0 = EdgeAt(s.B, s.C, cx0, cy0) - s.b0;
+        int64_t r1 = EdgeAt(s.C, s.A, cx0, cy0) - s.b1;
+        int64_t r2 = EdgeAt(s.A, s.B, cx0, cy0) - s.b2;
+
+        const __m128i off0lo = _mm_set_epi64x(s.s0x, 0), off0hi = _mm_set_epi64x(3 * s.s0x, 2 * s.s0x);
+        const __m128i off1lo = _mm_set_epi64x(s.s1x, 0), off1hi = _mm_set_epi64x(3 * s.s1x, 2 * s.s1x);
+        const __m128i off2lo = _mm_set_epi64x(s.s2x, 0), off2hi = _mm_set_epi64x(3 * s.s2x, 2 * s.s2x);
+        const __m128i step0 = _mm_set1_epi64x(W * s.s0x);
+        const __m128i step1 = _mm_set1_epi64x(W * s.s1x);
+        const __m128i step2 = _mm_set1_epi64x(W * s.s2x);
+        const __m128i bias0 = _mm_set1_epi64x(s.b0);
+        const __m128i bias1 = _mm_set1_epi64x(s.b1);
+        const __m128i bias2 = _mm_set1_epi64x(s.b2);
+
+        const __m128 invArea = _mm_set1_ps(s.invArea);
+        const __m128 zA = _mm_set1_ps(s.A.z), zB = _mm_set1_ps(s.B.z), zC = _mm_set1_ps(s.C.z);
+        const __m128i laneBits = _mm_setr_epi32(1, 2, 4, 8);
+        const __m128i flat = _mm_set1_epi32((int)mat.flatColor);
+        const bool flatOnly = !LIT && !mat.tex;
+
+        alignas(16) float L0[W], L1[W], L2[W];
+
+        for (int py = py0; py <= py1; ++py)
+        {
+            const size_t row = (size_t)(t.height - 1 - py) * (size_t)t.width;
+            uint32_t* crow = t.color + row;
+            float*    drow = t.depth + row;
+
+            __m128i e0lo = _mm_add_epi64(_mm_set1_epi64x(r0), off0lo), e0hi = _mm_add_epi64(_mm_set1_epi64x(r0), off0hi);
+            __m128i e1lo = _mm_add_epi64(_mm_set1_epi64x(r1), off1lo), e1hi = _mm_add_epi64(_mm_set1_epi64x(r1), off1hi);
+            __m128i e2lo = _mm_add_epi64(_mm_set1_epi64x(r2), off2lo), e2hi = _mm_add_epi64(_mm_set1_epi64x(r2), off2hi);
+
+            for (int gx = gx0; gx <= px1; gx += W)
+            {
+                if (gx > lastGroupX)
                 {
-                    const float l0 = (float)(e0 + b0) * invArea;
-                    const float l1 = (float)(e1 + b1) * invArea;
-                    const float l2 = (float)(e2 + b2) * invArea;
+                    for (int px = std::max(gx, px0); px <= px1; ++px)
+                    {
+                        const int64_t dx = px - gx0;
+                        RasterPx<LIT>(s, r0 + dx * s.s0x, r1 + dx * s.s1x, r2 + dx * s.s2x,
+                                      drow, crow, px, py, mat, lit);
+                    }
+                    break;
+                }
+
+                const __m128i orLo = _mm_or_si128(_mm_or_si128(e0lo, e1lo), e2lo);
+                const __m128i orHi = _mm_or_si128(_mm_or_si128(e0hi, e1hi), e2hi);
+                const unsigned outside = (unsigned)_mm_movemask_pd(_mm_castsi128_pd(orLo))
+                                       | ((unsigned)_mm_movemask_pd(_mm_castsi128_pd(orHi)) << 2);
+                const unsigned cover = ~outside & LaneRange<W>(gx, px0, px1);
 
-                    // Early-Z: interpolate depth only; shade only survivors.
-                    const float z = l0 * zA + l1 * zB + l2 * zC;
-                    if (z < drow[px])
+                if (cover)
+                {
+                    const __m128 l0 = _mm_mul_ps(I64x4ToF32(_mm_add_epi64(e0lo, bias0), _mm_add_epi64(e0hi, bias0)), invArea);
+                    const __m128 l1 = _mm_mul_ps(I64x4ToF32(_mm_add_epi64(e1lo, bias1), _mm_add_epi64(e1hi, bias1)), invArea);
+                    const __m128 l2 = _mm_mul_ps(I64x4ToF32(_mm_add_epi64(e2lo, bias2), _mm_add_epi64(e2hi, bias2)), invArea);
+                    const __m128 z = _mm_add_ps(_mm_add_ps(_mm_mul_ps(l0, zA), _mm_mul_ps(l1, zB)), _mm_mul_ps(l2, zC));
+
+                    float* dp = drow + gx;
+                    const __m128 d = _mm_loadu_ps(dp);
+                    const unsigned pass = (unsigned)_mm_movemask_ps(_mm_cmplt_ps(z, d)) & cover;
+                    if (pass)
                     {
-                        uint32_t colOut;
-                        if constexpr (LIT)
+                        const __m128 m = _mm_castsi128_ps(_mm_cmpeq_epi32(
+                            _mm_and_si128(_mm_set1_epi32((int)pass), laneBits), laneBits));
+                        _mm_storeu_ps(dp, _mm_blendv_ps(d, z, m));
+
+                        if (flatOnly)
                         {
-                            const float iw = l0*A->invW + l1*B->invW + l2*C->invW;
-                            const float rw = 1.f / iw;
-                            const float u  = (l0*A->uw  + l1*B->uw  + l2*C->uw ) * rw;
-                            const float v  = (l0*A->vw  + l1*B->vw  + l2*C->vw ) * rw;
-                            const float nx = (l0*A->nxw + l1*B->nxw + l2*C->nxw) * rw;
-                            const float ny = (l0*A->nyw + l1*B->nyw + l2*C->nyw) * rw;
-                            const float nz = (l0*A->nzw + l1*B->nzw + l2*C->nzw) * rw;
-                            const float wx = (l0*A->wxw + l1*B->wxw + l2*C->wxw) * rw;
-                            const float wy = (l0*A->wyw + l1*B->wyw + l2*C->wyw) * rw;
-                            const float wz = (l0*A->wzw + l1*B->wzw + l2*C->wzw) * rw;
-                            colOut = ShadeLitPx(wx, wy, wz, nx, ny, nz, u, v, mat, lit);
+                            auto* cp = reinterpret_cast<__m128i*>(crow + gx);
+                            const __m128 c = _mm_castsi128_ps(_mm_loadu_si128(cp));
+                            _mm_storeu_si128(cp, _mm_castps_si128(_mm_blendv_ps(c, _mm_castsi128_ps(flat), m)));
                         }
-                        else if (mat.tex)
+                        else
+                        {
+                            _mm_store_ps(L0, l0); _mm_store_ps(L1, l1); _mm_store_ps(L2, l2);
+                            for (unsigned bits = pass; bits; bits &= bits - 1)
+                            {
+                                const int k = std::countr_zero(bits);
+                                crow[gx + k] = ShadePx<LIT>(s, L0[k], L1[k], L2[k], gx + k, py, mat, lit);
+                            }
+                        }
+                    }
+                }
+
+                e0lo = _mm_add_epi64(e0lo, step0); e0hi = _mm_add_epi64(e0hi, step0);
+                e1lo = _mm_add_epi64(e1lo, step1); e1hi = _mm_add_epi64(e1hi, step1);
+                e2lo = _mm_add_epi64(e2lo, step2); e2hi = _mm_add_epi64(e2hi, step2);
+            }
+            r0 += s.s0y; r1 += s.s1y; r2 += s.s2y;
+        }
+    }
+
+    TARGET_AVX2 inline __m256 I64x8ToF32(__m256i lo, __m256i hi)
+    {
+        const __m256i magicI = _mm256_set1_epi64x(0x4338000000000000LL);
+        const __m256d magicD = _mm256_set1_pd(6755399441055744.0);   // 1.5 * 2^52
+        const __m256d dlo = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(lo, magicI)), magicD);
+        const __m256d dhi = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(hi, magicI)), magicD);
+        return _mm256_set_m128(_mm256_cvtpd_ps(dhi), _mm256_cvtpd_ps(dlo));
+    }
+
+    // Edge offsets of four consecutive lanes from lane `first`. Not a lambda: those
+    // don't inherit TARGET_AVX2 and fail to inline the intrinsic without -mavx2.
+    TARGET_AVX2 inline __m256i LaneOffsets(int64_t step, int first)
+    {
+        return _mm256_setr_epi64x(first * step, (first + 1) * step, (first + 2) * step, (first + 3) * step);
+    }
+
+    template <bool LIT>
+    TARGET_AVX2 void RasterTriRectAVX2(const TriSetup& s, int px0, int py0, int px1, int py1,
+                                       const RasterTarget& t, const ResolvedMat& mat, const LitState& lit)
+    {
+        constexpr int W = 8;
+        const int gx0 = px0 & ~(W - 1);
+        const int lastGroupX = t.width - W;
+
+        const int64_t cx0 = (int64_t)gx0 * kSubStep + kSubHalf;
+        const int64_t cy0 = (int64_t)py0 * kSubStep + kSubHalf;
+        int64_t r0 = EdgeAt(s.B, s.C, cx0, cy0) - s.b0;
+        int64_t r1 = EdgeAt(s.C, s.A, cx0, cy0) - s.b1;
+        int64_t r2 = EdgeAt(s.A, s.B, cx0, cy0) - s.b2;
+
+        const __m256i off0lo = LaneOffsets(s.s0x, 0), off0hi = LaneOffsets(s.s0x, 4);
+        const __m256i off1lo = LaneOffsets(s.s1x, 0), off1hi = LaneOffsets(s.s1x, 4);
+        const __m256i off2lo = LaneOffsets(s.s2x, 0), off2hi = LaneOffsets(s.s2x, 4);
+        const __m256i step0 = _mm256_set1_epi64x(W * s.s0x);
+        const __m256i step1 = _mm256_set1_epi64x(W * s.s1x);
+        const __m256i step2 = _mm256_set1_epi64x(W * s.s2x);
+        const __m256i bias0 = _mm256_set1_epi64x(s.b0);
+        const __m256i bias1 = _mm256_set1_epi64x(s.b1);
+        const __m256i bias2 = _mm256_set1_epi64x(s.b2);
+
+        const __m256 invArea = _mm256_set1_ps(s.invArea);
+        const __m256 zA = _mm256_set1_ps(s.A.z), zB = _mm256_set1_ps(s.B.z), zC = _mm256_set1_ps(s.C.z);
+        const __m256i laneBits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+        const __m256i flat = _mm256_set1_epi32((int)mat.flatColor);
+        const bool flatOnly = !LIT && !mat.tex;
+
+        alignas(32) float L0[W], L1[W], L2[W];
+
+        for (int py = py0; py <= py1; ++py)
+        {
+            const size_t row = (size_t)(t.height - 1 - py) * (size_t)t.width;
+            uint32_t* crow = t.color + row;
+            float*    drow = t.depth + row;
+
+            const __m256i row0 = _mm256_set1_epi64x(r0), row1 = _mm256_set1_epi64x(r1), row2 = _mm256_set1_epi64x(r2);
+            __m256i e0lo = _mm256_add_epi64(row0, off0lo), e0hi = _mm256_add_epi64(row0, off0hi);
+            __m256i e1lo = _mm256_add_epi64(row1, off1lo), e1hi = _mm256_add_epi64(row1, off1hi);
+            __m256i e2lo = _mm256_add_epi64(row2, off2lo), e2hi = _mm256_add_epi64(row2, off2hi);
+
+            for (int gx = gx0; gx <= px1; gx += W)
+            {
+                if (gx > lastGroupX)
+                {
+                    for (int px = std::max(gx, px0); px <= px1; ++px)
+                    {
+                        const int64_t dx = px - gx0;
+                        RasterPx<LIT>(s, r0 + dx * s.s0x, r1 + dx * s.s1x, r2 + dx * s.s2x,
+                                      drow, crow, px, py, mat, lit);
+                    }
+                    break;
+                }
+
+                const __m256i orLo = _mm256_or_si256(_mm256_or_si256(e0lo, e1lo), e2lo);
+                const __m256i orHi = _mm256_or_si256(_mm256_or_si256(e0hi, e1hi), e2hi);
+                const unsigned outside = (unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(orLo))
+                                       | ((unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(orHi)) << 4);
+                const unsigned cover = ~outside & LaneRange<W>(gx, px0, px1);
+
+                if (cover)
+                {
+                    const __m256 l0 = _mm256_mul_ps(I64x8ToF32(_mm256_add_epi64(e0lo, bias0), _mm256_add_epi64(e0hi, bias0)), invArea);
+                    const __m256 l1 = _mm256_mul_ps(I64x8ToF32(_mm256_add_epi64(e1lo, bias1), _mm256_add_epi64(e1hi, bias1)), invArea);
+                    const __m256 l2 = _mm256_mul_ps(I64x8ToF32(_mm256_add_epi64(e2lo, bias2), _mm256_add_epi64(e2hi, bias2)), invArea);
+                    const __m256 z = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(l0, zA), _mm256_mul_ps(l1, zB)),
+                                                   _mm256_mul_ps(l2, zC));
+
+                    float* dp = drow + gx;
+                    const __m256 d = _mm256_loadu_ps(dp);
+                    const unsigned pass = (unsigned)_mm256_movemask_ps(_mm256_cmp_ps(z, d, _CMP_LT_OQ)) & cover;
+                    if (pass)
+                    {
+                        const __m256 m = _mm256_castsi256_ps(_mm256_cmpeq_epi32(
+                            _mm256_and_si256(_mm256_set1_epi32((int)pass), laneBits), laneBits));
+                        _mm256_storeu_ps(dp, _mm256_blendv_ps(d, z, m));
+
+                        if (flatOnly)
                         {
-                            const float iw = l0*A->invW + l1*B->invW + l2*C->invW;
-                            const float rw = 1.f / iw;
-                            const float u  = (l0*A->uw + l1*B->uw + l2*C->uw) * rw;
-                            const float v  = (l0*A->vw + l1*B->vw + l2*C->vw) * rw;
-                            colOut = ShadeUnlitPx(u, v, mat);
+                            auto* cp = reinterpret_cast<__m256i*>(crow + gx);
+                            const __m256 c = _mm256_castsi256_ps(_mm256_loadu_si256(cp));
+                            _mm256_storeu_si256(cp, _mm256_castps_si256(_mm256_blendv_ps(c, _mm256_castsi256_ps(flat), m)));
                         }
                         else
                         {
-                            colOut = mat.flatColor;   // constant per draw — no interpolation at all
+                            _mm256_store_ps(L0, l0); _mm256_store_ps(L1, l1); _mm256_store_ps(L2, l2);
+                            for (unsigned bits = pass; bits; bits &= bits - 1)
+                            {
+                                const int k = std::countr_zero(bits);
+                                crow[gx + k] = ShadePx<LIT>(s, L0[k], L1[k], L2[k], gx + k, py, mat, lit);
+                            }
                         }
-                        drow[px] = z;
-                        crow[px] = colOut;
                     }
                 }
-                e0 += s0x; e1 += s1x; e2 += s2x;
+
+                e0lo = _mm256_add_epi64(e0lo, step0); e0hi = _mm256_add_epi64(e0hi, step0);
+                e1lo = _mm256_add_epi64(e1lo, step1); e1hi = _mm256_add_epi64(e1hi, step1);
+                e2lo = _mm256_add_epi64(e2lo, step2); e2hi = _mm256_add_epi64(e2hi, step2);
             }
-            r0 += s0y; r1 += s1y; r2 += s2y;
+            r0 += s.s0y; r1 += s.s1y; r2 += s.s2y;
+        }
+    }
+
+    using RasterRectFn = void (*)(const TriSetup&, int, int, int, int,
+                                  const RasterTarget&, const ResolvedMat&, const LitState&);
+
+    struct RasterKernels
+    {
+        RasterRectFn unlit;
+        RasterRectFn lit;
+
+        void Raster(const TriSetup& s, int px0, int py0, int px1, int py1,
+                    const RasterTarget& t, const ResolvedMat& mat, const LitState& lit) const
+        {
+            (mat.lit ? this->lit : unlit)(s, px0, py0, px1, py1, t, mat, lit);
+        }
+    };
+
+    RasterKernels KernelsFor(SWRasterPath path)
+    {
+        switch (path)
+        {
+        case SWRasterPath::AVX2:  return { &RasterTriRectAVX2<false>,  &RasterTriRectAVX2<true>  };
+        case SWRasterPath::SSE41: return { &RasterTriRectSSE41<false>, &RasterTriRectSSE41<true> };
+        case SWRasterPath::Scalar:
+        default:                  return { &RasterTriRect<false>,      &RasterTriRect<true>      };
         }
     }
 }
 
+// ============================================================================
+// Hierarchical Z.
+// A two-level pyramid holding the farthest depth of every 8x8 and every
+// 64x64 block of the depth buffer. The depth test is LESS, so anything whose
+// nearest depth is no nearer than the farthest depth of every block it
+// overlaps can't write a single pixel: such triangles — and whole draws, by
+// their projected bounds — are rejected before setup, shading, or (for
+// draws) vertex transform. Rejection is conservative and never changes the
+// image.
+// Levels are refreshed lazily: raster marks the blocks it touched dirty and
+// a query recomputes only the dirty blocks it actually reads. Coarse blocks
+// coincide with the 64x64 raster tiles, so a worker only dirties blocks of
+// the tile it owns.
+// ============================================================================
+namespace
+{
+    constexpr int kHiZFineShift   = 3;   // 8x8
+    constexpr int kHiZCoarseShift = 6;   // 64x64
+    constexpr int kHiZFanout      = kHiZCoarseShift - kHiZFineShift;
+
+    // A dirty coarse block is only rebuilt when a query overlaps at least
+    // this many of its fine blocks; small triangles read the fine level.
+    constexpr int kHiZCoarseRebuildMin = 16;
+
+    // Interpolated depth can undershoot the smallest vertex depth by a few
+    // ulps (the barycentrics are rounded), so occlusion tests pull the
+    // nearest depth in by this fraction of the depths' magnitude.
+    constexpr float kHiZTriSlack  = 1e-6f;
+    constexpr float kHiZDrawSlack = 1e-5f;   // bounds are transformed separately from the vertices
+
+    class HiZBuffer
+    {
+    public:
+        void Reset(const float* depth, int width, int height)
+        {
+            m_depth  = depth;
+            m_width  = width;
+            m_height = height;
+            m_fineX   = (width  + (1 << kHiZFineShift) - 1) >> kHiZFineShift;
+            m_fineY   = (height + (1 << kHiZFineShift) - 1) >> kHiZFineShift;
+            m_coarseX = (width  + (1 << kHiZCoarseShift) - 1) >> kHiZCoarseShift;
+            m_coarseY = (height + (1 << kHiZCoarseShift) - 1) >> kHiZCoarseShift;
+
+            // Matches the cleared depth buffer.
+            m_fine.assign((size_t)m_fineX * m_fineY, 1.f);
+            m_fineDirty.assign(m_fine.size(), 0);
+            m_coarse.assign((size_t)m_coarseX * m_coarseY, 1.f);
+            m_coarseDirty.assign(m_coarse.size(), 0);
+        }
+
+        // Pixels in [px0, px1] x [py0, py1] may have been written.
+        void MarkWritten(int px0, int py0, int px1, int py1)
+        {
+            for (int fy = py0 >> kHiZFineShift; fy <= (py1 >> kHiZFineShift); ++fy)
+                for (int fx = px0 >> kHiZFineShift; fx <= (px1 >> kHiZFineShift); ++fx)
+                    m_fineDirty[(size_t)fy * m_fineX + fx] = 1;
+            for (int cy = py0 >> kHiZCoarseShift; cy <= (py1 >> kHiZCoarseShift); ++cy)
+                for (int cx = px0 >> kHiZCoarseShift; cx <= (px1 >> kHiZCoarseShift); ++cx)
+                    m_coarseDirty[(size_t)cy * m_coarseX + cx] = 1;
+        }
+
+        // True if nothing at depth >= zNear can pass the depth test anywhere
+        // in [px0, px1] x [py0, py1] (clamped to the target).
+        bool Occluded(int px0, int py0, int px1, int py1, float zNear)
+        {
+            for (int cy = py0 >> kHiZCoarseShift; cy <= (py1 >> kHiZCoarseShift); ++cy)
+            {
+                const int fy0 = std::max(py0 >> kHiZFineShift, cy << kHiZFanout);
+                const int fy1 = std::min(py1 >> kHiZFineShift, ((cy + 1) << kHiZFanout) - 1);
+                for (int cx = px0 >> kHiZCoarseShift; cx <= (px1 >> kHiZCoarseShift); ++cx)
+                {
+                    const int fx0 = std::max(px0 >> kHiZFineShift, cx << kHiZFanout);
+                    const int fx1 = std::min(px1 >> kHiZFineShift, ((cx + 1) << kHiZFanout) - 1);
+
+                    const size_t c = (size_t)cy * m_coarseX + cx;
+                    const bool useCoarse = !m_coarseDirty[c] ||
+                                           (fx1 - fx0 + 1) * (fy1 - fy0 + 1) >= kHiZCoarseRebuildMin;
+                    if (useCoarse && zNear >= CoarseMax(cx, cy)) continue;
+
+                    for (int fy = fy0; fy <= fy1; ++fy)
+                        for (int fx = fx0; fx <= fx1; ++fx)
+                            if (zNear < FineMax(fx, fy)) return false;
+                }
+            }
+            return true;
+        }
+
+    private:
+        float FineMax(int fx, int fy)
+        {
+            const size_t f = (size_t)fy * m_fineX + fx;
+            if (m_fineDirty[f])
+            {
+                const int x0 = fx << kHiZFineShift, x1 = std::min(x0 + (1 << kHiZFineShift), m_width);
+                const int y0 = fy << kHiZFineShift, y1 = std::min(y0 + (1 << kHiZFineShift), m_height);
+                float m = -INFINITY;   // NDC depth goes below 0: a 0 floor would overstate the tile's far depth
+                for (int y = y0; y < y1; ++y)
+                {
+                    const float* row = m_depth + (size_t)(m_height - 1 - y) * m_width;   // Y-flipped like raster
+                    for (int x = x0; x < x1; ++x) m = std::max(m, row[x]);
+                }
+                m_fine[f] = m;
+                m_fineDirty[f] = 0;
+            }
+            return m_fine[f];
+        }
+
+        float CoarseMax(int cx, int cy)
+        {
+            const size_t c = (size_t)cy * m_coarseX + cx;
+            if (m_coarseDirty[c])
+            {
+                const int fx0 = cx << kHiZFanout, fx1 = std::min(fx0 + (1 << kHiZFanout), m_fineX);
+                const int fy0 = cy << kHiZFanout, fy1 = std::min(fy0 + (1 << kHiZFanout), m_fineY);
+                float m = -INFINITY;
+                for (int fy = fy0; fy < fy1; ++fy)
+                    for (int fx = fx0; fx < fx1; ++fx)
+                        m = std::max(m, FineMax(fx, fy));
+                m_coarse[c] = m;
+                m_coarseDirty[c] = 0;
+            }
+            return m_coarse[c];
+        }
+
+        const float* m_depth = nullptr;
+        int m_width = 0, m_height = 0;
+        int m_fineX = 0, m_fineY = 0, m_coarseX = 0, m_coarseY = 0;
+        std::vector<float> m_fine, m_coarse;
+        std::vector<uint8_t> m_fineDirty, m_coarseDirty;   // bytes, not bits: workers write them concurrently
+    };
+
+    enum class BoundsResult { Visible, OutsideFrustum, Occluded };
+
+    // Tests a draw's object-space bounds before any of its vertices are
+    // transformed. Off-screen draws are rejected by the clip-space planes
+    // (valid for any w); the depth pyramid is only consulted when the whole
+    // box lies in front of the camera, so its projection is a proper rect.
+    BoundsResult TestBounds(const float* mvp, const float* bmin, const float* bmax,
+                            int width, int height, HiZBuffer* hiz)
+    {
+        float c[8][4];
+        for (int i = 0; i < 8; ++i)
+        {
+            const float p[3] = { (i & 1) ? bmax[0] : bmin[0],
+                                 (i & 2) ? bmax[1] : bmin[1],
+                                 (i & 4) ? bmax[2] : bmin[2] };
+            for (int r = 0; r < 4; ++r)
+                c[i][r] = mvp[r * 4 + 0] * p[0] + mvp[r * 4 + 1] * p[1] + mvp[r * 4 + 2] * p[2] + mvp[r * 4 + 3];
+        }
+
+        // All corners strictly outside one plane (left, right, bottom, top,
+        // near, far). The slack absorbs rounding against the real vertices.
+        auto outside = [&](int axis, float sign)
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                const float d = c[i][3] + sign * c[i][axis];
+                if (d >= -kHiZDrawSlack * (std::fabs(c[i][3]) + std::fabs(c[i][axis]))) return false;
+            }
+            return true;
+        };
+        for (int axis = 0; axis < 3; ++axis)
+            if (outside(axis, 1.f) || outside(axis, -1.f)) return BoundsResult::OutsideFrustum;
+
+        if (!hiz) return BoundsResult::Visible;
+
+        float x0 = INFINITY, y0 = INFINITY, x1 = -INFINITY, y1 = -INFINITY, zNear = INFINITY;
+        for (const auto& v : c)
+        {
+            if (v[3] < kMinW) return BoundsResult::Visible;   // straddles the camera plane
+            const float invW = 1.f / v[3];
+            x0 = std::min(x0, v[0] * invW); x1 = std::max(x1, v[0] * invW);
+            y0 = std::min(y0, v[1] * invW); y1 = std::max(y1, v[1] * invW);
+            zNear = std::min(zNear, v[2] * invW);
+        }
+
+        // Pixel centers the projected box can cover, padded by a pixel for
+        // the fixed-point snap.
+        const float halfW = 0.5f * (float)width, halfH = 0.5f * (float)height;
+        const int px0 = std::max((int)std::floor((x0 + 1.f) * halfW - 0.5f) - 1, 0);
+        const int py0 = std::max((int)std::floor((y0 + 1.f) * halfH - 0.5f) - 1, 0);
+        const int px1 = std::min((int)std::ceil ((x1 + 1.f) * halfW - 0.5f) + 1, width  - 1);
+        const int py1 = std::min((int)std::ceil ((y1 + 1.f) * halfH - 0.5f) + 1, height - 1);
+        if (px0 > px1 || py0 > py1) return BoundsResult::OutsideFrustum;
+
+        const float slack = kHiZDrawSlack * (1.f + std::fabs(zNear));
+        return hiz->Occluded(px0, py0, px1, py1, zNear - slack) ? BoundsResult::Occluded : BoundsResult::Visible;
+    }
+}
+
+// ============================================================================
+// Tile binning (multi-threaded path).
+// Geometry for the whole frame is transformed, clipped and set up first; each
+// surviving triangle is appended to the bin of every 64x64 tile its bounding
+// box touches. Tiles are then rasterized independently by the worker pool —
+// a tile owns its pixels exclusively, so no locks are needed. Bins are filled
+// in submission order, so every pixel sees the same triangles in the same
+// order as the single-threaded path and the output is bit-identical.
+// ============================================================================
+namespace
+{
+    constexpr int kTileShift = 6;
+    constexpr int kTileSize  = 1 << kTileShift;   // 64
+    static_assert(kTileShift == kHiZCoarseShift, "a worker must own every depth pyramid block it dirties");
+
+    // Binned geometry is flushed to the workers once this many triangles are
+    // queued, so later draws are tested against an up-to-date depth pyramid.
+    constexpr size_t kBinFlushTriangles = 1u << 12;
+
+    struct BinnedTri
+    {
+        TriSetup setup;
+        uint32_t draw;   // index into TileBins::draws
+    };
+
+    struct TileBins
+    {
+        int tilesX = 0, tilesY = 0;
+        std::vector<ResolvedMat> draws;
+        std::vector<BinnedTri> tris;
+        std::vector<std::vector<uint32_t>> bins;   // triangle indices per tile
+
+        void Reset(int width, int height)
+        {
+            tilesX = (width  + kTileSize - 1) >> kTileShift;
+            tilesY = (height + kTileSize - 1) >> kTileShift;
+            bins.resize((size_t)tilesX * (size_t)tilesY);
+            Clear();
+        }
+
+        void Clear()
+        {
+            for (auto& bin : bins) bin.clear();   // keeps capacity across frames
+            draws.clear();
+            tris.clear();
+        }
+
+        void Add(const TriSetup& s, uint32_t draw)
+        {
+            const auto index = (uint32_t)tris.size();
+            tris.push_back({s, draw});
+            for (int ty = s.py0 >> kTileShift; ty <= (s.py1 >> kTileShift); ++ty)
+                for (int tx = s.px0 >> kTileShift; tx <= (s.px1 >> kTileShift); ++tx)
+                    bins[(size_t)ty * tilesX + tx].push_back(index);
+        }
+
+        void RasterTile(uint32_t tile, const RasterTarget& t, const RasterKernels& kernels, const LitState& lit,
+                        HiZBuffer* hiz) const
+        {
+            if (bins[tile].empty()) return;
+
+            const int tx0 = (int)(tile % (uint32_t)tilesX) << kTileShift;
+            const int ty0 = (int)(tile / (uint32_t)tilesX) << kTileShift;
+            const int tx1 = std::min(tx0 + kTileSize, t.width)  - 1;
+            const int ty1 = std::min(ty0 + kTileSize, t.height) - 1;
+
+            for (const uint32_t index : bins[tile])
+            {
+                const BinnedTri& bt = tris[index];
+                const TriSetup& s = bt.setup;
+                const int px0 = std::max(s.px0, tx0), px1 = std::min(s.px1, tx1);
+                const int py0 = std::max(s.py0, ty0), py1 = std::min(s.py1, ty1);
+                kernels.Raster(s, px0, py0, px1, py1, t, draws[bt.draw], lit);
+            }
+            if (hiz) hiz->MarkWritten(tx0, ty0, tx1, ty1);
+        }
+    };
+}
+
+// Per-frame state shared by every draw of a frame on the render thread.
+struct SoftwareRenderer::FrameContext
+{
+    RasterKernels kernels;
+    LitState lit;
+    TileBins* bins = nullptr;   // null: rasterize immediately, single-threaded
+    HiZBuffer* hiz = nullptr;   // null: occlusion culling disabled
+    SWTextureFilter filter = SWTextureFilter::Bilinear;
+    SWFrameStats stats;
+    float viewProj[16];                   // proj * view, once per frame
+    const SWMaterial* resolvedFor = nullptr;
+    ResolvedMat resolved;                 // last material resolved; instances share it
+};
+
 // ============================================================================
 // Renderer
 // ============================================================================
@@ -498,15 +1142,19 @@ namespace
 bool SoftwareRenderer::Initialize(GLFWwindow *windowHandle, uint32_t width, uint32_t height)
 {
     m_window = windowHandle;
-    glfwMakeContextCurrent(windowHandle);
-    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) return false;
+    if (m_window)
+    {
+        glfwMakeContextCurrent(windowHandle);
+        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) return false;
+    }
 
-    m_unlitShader = std::make_unique<SWShader>(SWShaderType::Unlit);
-    m_litShader = std::make_unique<SWShader>(SWShaderType::Lit);
+    m_unlitShader = m_shaders.Insert(std::make_unique<SWShader>(SWShaderType::Unlit));
+    m_litShader = m_shaders.Insert(std::make_unique<SWShader>(SWShaderType::Lit));
 
     Resize(width, height);
-    if (!SetupBlitResources()) return false;
+    if (m_window && !SetupBlitResources()) return false;
 
+    m_rasterPool.Start(ResolveRasterThreadCount() - 1);
     m_renderThread.Start();
     return true;
 }
@@ -515,12 +1163,15 @@ void SoftwareRenderer::Shutdown()
 {
     // Stop thread BEFORE tearing down GL/resources it might reference.
     m_renderThread.Stop();
+    m_rasterPool.Stop();
 
-    m_meshes.clear();
-    m_textures.clear();
-    m_materials.clear();
-    m_shaders.clear();
+    m_meshes.Clear();
+    m_textures.Clear();
+    m_materials.Clear();
+    m_shaders.Clear();
+    m_unlitShader = m_litShader = nullptr;
 
+    if (!m_window) return;   // headless: GL was never loaded
     glDeleteTextures(1, &m_blitTex);
     glDeleteVertexArrays(1, &m_blitVAO);
     glDeleteBuffers(1, &m_blitVBO);
@@ -546,6 +1197,58 @@ void SoftwareRenderer::Resize(uint32_t w, uint32_t h)
 
 void SoftwareRenderer::OnResize(int w, int h) { Resize((uint32_t)w, (uint32_t)h); }
 
+void SoftwareRenderer::SetRasterThreadCount(uint32_t threadCount)
+{
+    m_rasterThreadCount = threadCount;
+    if (!m_renderThread.IsRunning()) return;
+
+    // The pool is only touched from inside a frame; wait for the current one.
+    m_renderThread.WaitForFrame();
+    m_rasterPool.Start(ResolveRasterThreadCount() - 1);
+}
+
+bool SoftwareRenderer::SetRasterPath(SWRasterPath path)
+{
+    if (!IsRasterPathSupported(path)) return false;
+    m_rasterPath = path;   // read when a frame is submitted, not while one runs
+    return true;
+}
+
+void SoftwareRenderer::SetTextureFilter(SWTextureFilter filter)
+{
+    m_textureFilter = filter;   // read when a frame is submitted, not while one runs
+}
+
+void SoftwareRenderer::SetOcclusionCulling(bool enabled)
+{
+    m_occlusionCulling = enabled;   // read when a frame is submitted, not while one runs
+}
+
+bool SoftwareRenderer::IsRasterPathSupported(SWRasterPath path)
+{
+    static const CPUInfo::CPUFeatures features = CPUInfo::DetectCPUFeatures();
+    switch (path)
+    {
+    case SWRasterPath::AVX2:  return features.avx2;
+    case SWRasterPath::SSE41: return features.sse41;
+    case SWRasterPath::Scalar:
+    default:                  return true;
+    }
+}
+
+SWRasterPath SoftwareRenderer::DetectRasterPath()
+{
+    if (IsRasterPathSupported(SWRasterPath::AVX2))  return SWRasterPath::AVX2;
+    if (IsRasterPathSupported(SWRasterPath::SSE41)) return SWRasterPath::SSE41;
+    return SWRasterPath::Scalar;
+}
+
+uint32_t SoftwareRenderer::ResolveRasterThreadCount() const
+{
+    if (m_rasterThreadCount != 0) return m_rasterThreadCount;
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
 void SoftwareRenderer::Clear(float r, float g, float b, float a)
 {
     m_clearR = r;
@@ -577,7 +1280,8 @@ void SoftwareRenderer::EndFrame()
 
     m_renderThread.SubmitFrame({
         [this, queue = std::move(queue), view, proj,
-         lighting = std::move(lighting), camPos, cr, cg, cb, ca]() mutable
+         lighting = std::move(lighting), camPos, cr, cg, cb, ca, path = m_rasterPath,
+         occlusion = m_occlusionCulling, filter = m_textureFilter]() mutable
         {
             m_clearR = cr; m_clearG = cg; m_clearB = cb; m_clearA = ca;
             ClearBuffers();
@@ -604,8 +1308,56 @@ void SoftwareRenderer::EndFrame()
                           return dist2(a) < dist2(b);
                       });
 
-            for (auto& cmd : queue)
-                RasterizeMesh(cmd.mesh, cmd.modelMatrix, cmd.material);
+            FrameContext ctx;
+            ctx.kernels = KernelsFor(path);
+            ctx.filter = filter;
+            Mul4x4(m_proj, m_view, ctx.viewProj);
+            PrepareLighting(m_lighting, m_cameraPos, ctx.lit);   // normalize lights once, not per pixel
+            ctx.stats.drawsSubmitted = (uint32_t)queue.size();
+
+            // Scratch reused across frames (render thread only).
+            static thread_local HiZBuffer s_hiz;
+            if (occlusion)
+            {
+                s_hiz.Reset(m_depthBuffer.data(), (int)m_width, (int)m_height);
+                ctx.hiz = &s_hiz;
+            }
+
+            if (m_rasterPool.GetThreadCount() <= 1)
+            {
+                for (auto& cmd : queue)
+                    RasterizeMesh(cmd.mesh, cmd.modelMatrix, cmd.material, ctx);
+            }
+            else
+            {
+                // Scratch reused across frames (render thread only).
+                static thread_local TileBins s_bins;
+                TileBins& bins = s_bins;   // workers must see the render thread's instance
+                bins.Reset((int)m_width, (int)m_height);
+                ctx.bins = &bins;
+
+                const RasterTarget target{ m_colorBuffer.data(), m_depthBuffer.data(),
+                                           (int)m_width, (int)m_height };
+                const LitState& lit = ctx.lit;
+                HiZBuffer* hiz = ctx.hiz;
+                auto flush = [&]
+                {
+                    m_rasterPool.ParallelFor((uint32_t)bins.bins.size(), [&](uint32_t tile)
+                    {
+                        bins.RasterTile(tile, target, ctx.kernels, lit, hiz);
+                    });
+                    bins.Clear();
+                };
+
+                for (auto& cmd : queue)
+                {
+                    RasterizeMesh(cmd.mesh, cmd.modelMatrix, cmd.material, ctx);
+                    if (hiz && bins.tris.size() >= kBinFlushTriangles) flush();
+                }
+                flush();
+            }
+
+            m_frameStats = ctx.stats;
 
             // NOTE: GL upload stays in Present() — GL context lives on the main thread.
         }
@@ -616,6 +1368,7 @@ void SoftwareRenderer::Present()
 {
     // Wait for the render thread to finish rasterizing into m_colorBuffer
     m_renderThread.WaitForFrame();
+    if (!m_window) return;   // headless: the CPU framebuffer is the output
 
     // Upload CPU framebuffer to GL texture (main thread — context is current here)
     glBindTexture(GL_TEXTURE_2D, m_blitTex);
@@ -641,32 +1394,26 @@ void SoftwareRenderer::Present()
 IShader* SoftwareRenderer::CreateShaderProgram(const char *, const char *)
 {
     auto shader = std::make_unique<SWShader>(SWShaderType::Unlit);
-    IShader *raw = shader.get();
-    m_shaders.push_back(std::move(shader));
-    return raw;
+    return m_shaders.Insert(std::move(shader));
 }
 
 void SoftwareRenderer::UseShaderProgram(IShader *) {} // no-op; shader chosen per-draw via material
 
-bool SoftwareRenderer::DestroyShaderProgram(IShader *shader)
+bool SoftwareRenderer::DestroyShaderProgram(ShaderHandle shader)
 {
-    if (shader == m_unlitShader.get() || shader == m_litShader.get())
+    // The built-ins live until Shutdown
+    if (m_unlitShader && (shader == m_unlitShader->GetHandle() || shader == m_litShader->GetHandle()))
     {
         return true;
     }
 
-    const auto it = std::ranges::find_if(m_shaders, [shader](const auto &p) { return p.get() == shader; });
-    if (it == m_shaders.end())
-    {
-        return false;
-    }
-    m_shaders.erase(it);
-    return true;
+    return m_shaders.Erase(shader.slot);
 }
 
-bool SoftwareRenderer::IsValidShader(IShader *shader) const
+bool SoftwareRenderer::IsValidShader(ShaderHandle shader) const
 {
-    return shader && shader->IsValid();
+    const SWShader *owned = m_shaders.Get(shader.slot);
+    return owned && owned->IsValid();
 }
 
 IMesh* SoftwareRenderer::CreateMesh(const MeshData &d)
@@ -674,64 +1421,40 @@ IMesh* SoftwareRenderer::CreateMesh(const MeshData &d)
     auto mesh = std::make_unique<SWMesh>();
     mesh->vertices = d.vertices;
     mesh->indices = d.indices;
-    IMesh *raw = mesh.get();
-    m_meshes.push_back(std::move(mesh));
-    return raw;
+    mesh->ComputeBounds();
+    return m_meshes.Insert(std::move(mesh));
 }
 
-void SoftwareRenderer::DestroyMesh(IMesh *mesh)
+void SoftwareRenderer::DestroyMesh(MeshHandle mesh)
 {
-    if (const auto it = std::ranges::find_if(m_meshes, [mesh](const auto &p) { return p.get() == mesh; });
-        it != m_meshes.end())
-    {
-        m_meshes.erase(it);
-    }
+    m_meshes.Erase(mesh.slot);
 }
 
 ITexture* SoftwareRenderer::CreateTexture(const uint8_t *data, uint32_t w, uint32_t h, uint32_t ch)
 {
     auto tex = std::make_unique<SWTexture>();
-    tex->width = w;
-    tex->height = h;
-    tex->channels = ch;
-    tex->data.assign(data, data + w * h * ch);
-    ITexture *raw = tex.get();
-    m_textures.push_back(std::move(tex));
-    return raw;
+    tex->Build(data, w, h, ch, m_textureLayout);   // RGBA8 + mip chain + swizzle, once
+    return m_textures.Insert(std::move(tex));
 }
 
-void SoftwareRenderer::DestroyTexture(ITexture *texture)
+void SoftwareRenderer::DestroyTexture(TextureHandle texture)
 {
-    if (const auto it = std::ranges::find_if(m_textures, [texture](const auto &p) { return p.get() == texture; });
-        it != m_textures.end())
-    {
-        m_textures.erase(it);
-    }
+    m_textures.Erase(texture.slot);
 }
 
 IMaterial* SoftwareRenderer::CreateMaterial(IShader *shader)
 {
-    auto mat = std::make_unique<SWMaterial>(shader);
-    IMaterial *raw = mat.get();
-    m_materials.push_back(std::move(mat));
-    return raw;
+    return m_materials.Insert(std::make_unique<SWMaterial>(shader));
 }
 
 IMaterial* SoftwareRenderer::CreateMaterial(IShader *shader, ITexture *texture)
 {
-    auto mat = std::make_unique<SWMaterial>(shader, texture);
-    IMaterial *raw = mat.get();
-    m_materials.push_back(std::move(mat));
-    return raw;
+    return m_materials.Insert(std::make_unique<SWMaterial>(shader, texture));
 }
 
-void SoftwareRenderer::DestroyMaterial(IMaterial *material)
+void SoftwareRenderer::DestroyMaterial(MaterialHandle material)
 {
-    if (const auto it = std::ranges::find_if(m_materials, [material](const auto &p) { return p.get() == material; });
-        it != m_materials.end())
-    {
-        m_materials.erase(it);
-    }
+    m_materials.Erase(material.slot);
 }
 
 void SoftwareRenderer::SetViewProjection(const float *view, const float *proj)
@@ -760,6 +1483,25 @@ void SoftwareRenderer::DrawMesh(IMesh* mesh, const float* modelMatrix, IMaterial
     m_drawQueue.push_back(cmd);
 }
 
+void SoftwareRenderer::DrawMeshInstanced(IMesh* mesh, IMaterial* material, std::span<const float[16]> modelMatrices)
+{
+    // Casts once per batch. Instances stay separate commands so the
+    // front-to-back sort and occlusion culling still see each one.
+    auto* swMesh = dynamic_cast<SWMesh*>(mesh);
+    auto* swMat  = dynamic_cast<SWMaterial*>(material);
+    if (!swMesh || !swMat) return;
+
+    const size_t first = m_drawQueue.size();
+    m_drawQueue.resize(first + modelMatrices.size());
+    for (size_t i = 0; i < modelMatrices.size(); ++i)
+    {
+        DrawCommand& cmd = m_drawQueue[first + i];
+        cmd.mesh = swMesh;
+        cmd.material = swMat;
+        memcpy(cmd.modelMatrix, modelMatrices[i], 64);
+    }
+}
+
 void SoftwareRenderer::DrawObjects(const std::vector<RenderObject> &objects)
 {
     for (const auto &obj : objects)
@@ -768,17 +1510,19 @@ void SoftwareRenderer::DrawObjects(const std::vector<RenderObject> &objects)
 
 void SoftwareRenderer::ReadFramebuffer(uint8_t *buffer, int width, int height) const
 {
-    // nearest-neighbour downsample/copy into the caller's buffer (RGBA8)
+    // nearest-neighbour downsample/copy into the caller's buffer (RGBA8).
+    // Integer mapping: float division rounded some indices down by one, so a
+    // same-size read wasn't an exact copy.
     for (int y = 0; y < height; ++y)
     {
-        int sy = (int)((float)y / (float)height * (float)m_height);
+        int sy = (int)((int64_t)y * m_height / height);
         sy = std::clamp(sy, 0, (int)m_height - 1);
         const uint32_t* srcRow = m_colorBuffer.data() + (size_t)(m_height - 1 - sy) * m_width; // flip Y
         uint8_t* dstRow = buffer + (size_t)y * width * 4;
 
         for (int x = 0; x < width; ++x)
         {
-            int sx = (int)((float)x / (float)width * (float)m_width);
+            int sx = (int)((int64_t)x * m_width / width);
             sx = std::clamp(sx, 0, (int)m_width - 1);
 
             const uint32_t packed = srcRow[sx];
@@ -816,22 +1560,34 @@ void SoftwareRenderer::SetPixel(int x, int y, float depth, uint32_t color)
     }
 }
 
-void SoftwareRenderer::RasterizeMesh(SWMesh* mesh, const float* modelMatrix, SWMaterial* material)
+void SoftwareRenderer::RasterizeMesh(SWMesh* mesh, const float* modelMatrix, SWMaterial* material, FrameContext& ctx)
 {
     if (!mesh || !mesh->IsValid()) return;
     if (m_width == 0 || m_height == 0) return;
 
-    float mv[16], mvp[16];
-    Mul4x4(m_view, modelMatrix, mv);
-    Mul4x4(m_proj, mv, mvp);
+    float mvp[16];
+    Mul4x4(ctx.viewProj, modelMatrix, mvp);
 
-    // Everything the pixel loop needs, resolved ONCE per draw. The old path
-    // paid string-keyed uniform lookups and dynamic_casts per pixel.
-    const ResolvedMat rm = ResolveMaterial(material);
+    SWFrameStats& stats = ctx.stats;
+    stats.trianglesSubmitted += (uint32_t)(mesh->indices.size() / 3);
+    switch (TestBounds(mvp, mesh->boundsMin, mesh->boundsMax, (int)m_width, (int)m_height, ctx.hiz))
+    {
+    case BoundsResult::OutsideFrustum: ++stats.drawsOutsideFrustum; return;
+    case BoundsResult::Occluded:       ++stats.drawsOccluded;       return;
+    case BoundsResult::Visible:        break;
+    }
 
-    LitState lit;
-    if (rm.lit)
-        PrepareLighting(m_lighting, m_cameraPos, lit);   // normalize lights once, not per pixel
+    // Everything the pixel loop needs, resolved ONCE per draw - or once per
+    // run of draws sharing a material, as instances do. The old path paid
+    // string-keyed uniform lookups and dynamic_casts per pixel.
+    if (material != ctx.resolvedFor)
+    {
+        ctx.resolved = ResolveMaterial(material);
+        ctx.resolved.filter = ctx.filter;
+        ctx.resolvedFor = material;
+    }
+    const ResolvedMat& rm = ctx.resolved;
+    const LitState& lit = ctx.lit;
 
     const RasterTarget target{ m_colorBuffer.data(), m_depthBuffer.data(),
                                (int)m_width, (int)m_height };
@@ -869,10 +1625,37 @@ void SoftwareRenderer::RasterizeMesh(SWMesh* mesh, const float* modelMatrix, SWM
             x.sv = Project(x.cv, halfW, halfH);   // project once; reused by every triangle sharing it
     }
 
+    TileBins* bins = ctx.bins;
+    uint32_t drawIndex = 0;
+    if (bins)
+    {
+        drawIndex = (uint32_t)bins->draws.size();
+        bins->draws.push_back(rm);
+    }
+
+    HiZBuffer* hiz = ctx.hiz;
     auto raster = [&](const ScreenVert& a, const ScreenVert& b, const ScreenVert& c)
     {
-        if (rm.lit) RasterTri<true >(a, b, c, target, rm, lit);
-        else        RasterTri<false>(a, b, c, target, rm, lit);
+        TriSetup setup;
+        if (!SetupTri(a, b, c, target.width, target.height, setup)) return;
+        if (hiz)
+        {
+            const float zNear = std::min({setup.A.z, setup.B.z, setup.C.z});
+            const float slack = kHiZTriSlack * (std::fabs(setup.A.z) + std::fabs(setup.B.z) + std::fabs(setup.C.z));
+            if (hiz->Occluded(setup.px0, setup.py0, setup.px1, setup.py1, zNear - slack))
+            {
+                ++stats.trianglesOccluded;
+                return;
+            }
+        }
+        ++stats.trianglesRasterized;
+
+        if (bins) bins->Add(setup, drawIndex);
+        else
+        {
+            ctx.kernels.Raster(setup, setup.px0, setup.py0, setup.px1, setup.py1, target, rm, lit);
+            if (hiz) hiz->MarkWritten(setup.px0, setup.py0, setup.px1, setup.py1);
+        }
     };
 
     for (size_t i = 0; i + 2 < indices.size(); i += 3)
@@ -51,7 +51,7 @@ Renderer::Common::IMesh* Renderer::Vulkan::VulkanRenderer::CreateMesh(const Rend
     return nullptr;
 }
 
-void Renderer::Vulkan::VulkanRenderer::DestroyMesh(Renderer::Common::IMesh* mesh)
+void Renderer::Vulkan::VulkanRenderer::DestroyMesh(Renderer::Common::MeshHandle mesh)
 {
 }
 
@@ -61,7 +61,7 @@ Renderer::Common::ITexture* Renderer::Vulkan::VulkanRenderer::CreateTexture(
     return nullptr;
 }
 
-void Renderer::Vulkan::VulkanRenderer::DestroyTexture(Renderer::Common::ITexture* texture)
+void Renderer::Vulkan::VulkanRenderer::DestroyTexture(Renderer::Common::TextureHandle texture)
 {
 }
 
@@ -76,7 +76,7 @@ Renderer::Common::IMaterial* VulkanRenderer::CreateMaterial(
     return nullptr;
 }
 
-void Renderer::Vulkan::VulkanRenderer::DestroyMaterial(Renderer::Common::IMaterial* material)
+void Renderer::Vulkan::VulkanRenderer::DestroyMaterial(Renderer::Common::MaterialHandle material)
 {
 }
 
@@ -95,6 +95,17 @@ void Renderer::Vulkan::VulkanRenderer::DrawMesh(Renderer::Common::IMesh* mesh, c
 {
 }
 
+void Renderer::Vulkan::VulkanRenderer::DrawMeshInstanced(Renderer::Common::IMesh* mesh,
+                                                         Renderer::Common::IMaterial* material,
+                                                         std::span<const float[16]> modelMatrices)
+{
+    // No instance buffer yet: one draw per instance.
+    for (const float (&modelMatrix)[16] : modelMatrices)
+    {
+        DrawMesh(mesh, modelMatrix, material);
+    }
+}
+
 void Renderer::Vulkan::VulkanRenderer::DrawObjects(const std::vector<Renderer::Common::RenderObject>& objects)
 {
 }
@@ -796,13 +807,13 @@ void VulkanRenderer::UseShaderProgram(Renderer::Common::IShader* shaderId)
     std::cerr << "VulkanRenderer::UseShaderProgram not implemented yet" << std::endl;
 }
 
-bool VulkanRenderer::DestroyShaderProgram(Renderer::Common::IShader* shader)
+bool VulkanRenderer::DestroyShaderProgram(Renderer::Common::ShaderHandle shader)
 {
     std::cerr << "VulkanRenderer::DestroyShaderProgram not implemented yet" << std::endl;
     return false;
 }
 
-bool VulkanRenderer::IsValidShader(Renderer::Common::IShader* shader) const
+bool VulkanRenderer::IsValidShader(Renderer::Common::ShaderHandle shader) const
 {
     return false; // No shaders are valid in stub implementation
 }
@@ -205,7 +205,7 @@ void TestRenderer()
     if (shaderProgram == nullptr)
     {
         std::cerr << "Failed to create shader program" << std::endl;
-        renderer->DestroyMesh(triangleMesh);
+        renderer->DestroyMesh(triangleMesh->GetHandle());
         renderer->Shutdown();
         glfwDestroyWindow(window);
         glfwTerminate();
@@ -217,8 +217,8 @@ void TestRenderer()
     if (material == nullptr)
     {
         std::cerr << "Failed to create material" << std::endl;
-        renderer->DestroyShaderProgram(shaderProgram);
-        renderer->DestroyMesh(triangleMesh);
+        renderer->DestroyShaderProgram(shaderProgram->GetHandle());
+        renderer->DestroyMesh(triangleMesh->GetHandle());
         renderer->Shutdown();
         glfwDestroyWindow(window);
         glfwTerminate();
@@ -280,9 +280,9 @@ void TestRenderer()
 
     // Cleanup
     std::cout << "Cleaning up..." << std::endl;
-    renderer->DestroyMaterial(material);
-    renderer->DestroyShaderProgram(shaderProgram);
-    renderer->DestroyMesh(triangleMesh);
+    renderer->DestroyMaterial(material->GetHandle());
+    renderer->DestroyShaderProgram(shaderProgram->GetHandle());
+    renderer->DestroyMesh(triangleMesh->GetHandle());
     renderer->Shutdown();
 
     glfwDestroyWindow(window);
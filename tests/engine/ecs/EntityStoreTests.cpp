@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+#include "engine/GameObjectScene.hpp"
+#include "engine/Positionable.hpp"
+
+using namespace N2Engine;
+
+namespace
+{
+    struct Velocity
+    {
+        float x = 0.f, y = 0.f, z = 0.f;
+    };
+
+    struct Health
+    {
+        int value = 0;
+    };
+
+    class Tag final : public Component
+    {
+    public:
+        explicit Tag(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "Tag"; }
+
+        int hits = 0;
+    };
+}
+
+TEST(EntityStoreTest, AddRemoveMovesBetweenArchetypesKeepingData)
+{
+    ECS::EntityStore store;
+    const ECS::Entity a = store.Create(Velocity{1.f, 2.f, 3.f});
+    const ECS::Entity b = store.Create(Velocity{4.f, 5.f, 6.f}, Health{7});
+
+    ASSERT_TRUE(store.Has<Velocity>(a));
+    EXPECT_FALSE(store.Has<Health>(a));
+    EXPECT_EQ(store.Get<Health>(b)->value, 7);
+
+    store.Add(a, Health{9});
+    EXPECT_EQ(store.Get<Velocity>(a)->y, 2.f);
+    EXPECT_EQ(store.Get<Health>(a)->value, 9);
+
+    EXPECT_TRUE(store.Remove<Velocity>(b));
+    EXPECT_EQ(store.Get<Velocity>(b), nullptr);
+    EXPECT_EQ(store.Get<Health>(b)->value, 7);
+    EXPECT_EQ((store.Query<Velocity, Health>().Count()), 1u);
+
+    EXPECT_TRUE(store.Destroy(a));
+    EXPECT_FALSE(store.IsAlive(a));
+    EXPECT_EQ(store.Get<Health>(a), nullptr);
+
+    // The record is reused under a new generation
+    const ECS::Entity c = store.Create();
+    EXPECT_EQ(c.index, a.index);
+    EXPECT_NE(c, a);
+    EXPECT_EQ(store.GetEntityCount(), 2u);
+}
+
+TEST(EntityStoreTest, QueriesVisitEveryMatchingRowAcrossChunks)
+{
+    ECS::EntityStore store;
+    constexpr int count = 5000;
+    std::vector<ECS::Entity> entities;
+    for (int i = 0; i < count; ++i)
+    {
+        entities.push_back(i % 2 ? store.Create(Velocity{1.f, 0.f, 0.f}, Health{i})
+                                 : store.Create(Velocity{1.f, 0.f, 0.f}));
+    }
+    // Swap-removes keep the chunks dense
+    for (int i = 0; i < count; i += 5)
+    {
+        store.Destroy(entities[i]);
+    }
+
+    auto moving = store.Query<Velocity>();
+    EXPECT_EQ(moving.Count(), 4000u);
+    moving.ForEach([](Velocity &velocity) { velocity.x *= 2.f; });
+
+    float total = 0.f;
+    store.Query<const Velocity>().ForEach([&](const Velocity &velocity) { total += velocity.x; });
+    EXPECT_EQ(total, 8000.f);
+
+    std::atomic<int> healthy{0};
+    store.Query<Velocity, Health>().ParallelForEach([&](ECS::Entity entity, Velocity &, Health &health)
+    {
+        EXPECT_EQ(health.value % 2, 1);
+        EXPECT_TRUE(entity.index % 5 != 0);
+        healthy.fetch_add(1, std::memory_order_relaxed);
+    }, 4);
+    EXPECT_EQ(healthy.load(), 2000);
+}
+
+TEST(EntityStoreTest, SceneBridgesGameObjectsIntoQueries)
+{
+    auto scene = Scene::Create("Entities");
+    auto gameObject = GameObject::Create("Mover");
+    gameObject->CreatePositionable();
+    Tag *tag = gameObject->AddComponent<Tag>();
+    scene->AddRootGameObject(gameObject);
+
+    const ECS::Entity entity = scene->CreateEntity(*gameObject);
+    EXPECT_EQ(scene->CreateEntity(*gameObject), entity);
+    EXPECT_EQ(scene->GetEntity(*gameObject), entity);
+    scene->GetEntityStore().Add(entity, Velocity{0.f, 1.f, 0.f});
+
+    int visited = 0;
+    scene->Query<Positionable, Velocity>().ForEach([&](Positionable &positionable, const Velocity &velocity)
+    {
+        EXPECT_EQ(&positionable, gameObject->GetPositionable());
+        EXPECT_EQ(velocity.y, 1.f);
+        ++visited;
+    });
+    EXPECT_EQ(visited, 1);
+
+    scene->Query<Tag>().ForEach([](Tag &t) { ++t.hits; });
+    EXPECT_EQ(tag->hits, 1);
+
+    // Removing the component drops it from the entity instead of leaving a dangling pointer
+    gameObject->RemoveComponent<Tag>();
+    EXPECT_EQ(scene->Query<Tag>().Count(), 0u);
+
+    // Detached GameObjects take their entities with them
+    scene->Clear();
+    EXPECT_FALSE(scene->GetEntityStore().IsAlive(entity));
+    EXPECT_TRUE(scene->GetEntity(*gameObject).IsNull());
+}
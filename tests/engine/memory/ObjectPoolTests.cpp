@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "engine/GameObjectScene.hpp"
+#include "engine/memory/ObjectPool.hpp"
+
+using namespace N2Engine;
+using namespace N2Engine::Memory;
+
+namespace
+{
+    class Projectile final : public Component
+    {
+    public:
+        explicit Projectile(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "Projectile"; }
+
+        float payload[40]{};
+    };
+
+    PoolStats StatsOf(const std::string &name)
+    {
+        const std::vector<PoolStats> stats = ObjectPools::Instance().GetStats();
+        const auto it = std::ranges::find(stats, name, &PoolStats::name);
+        return it != stats.end() ? *it : PoolStats{};
+    }
+
+    std::string ComponentPoolName(const size_t size)
+    {
+        const size_t granularity = ObjectPools::SizeClassGranularity;
+        return "Component " + std::to_string((size + granularity - 1) / granularity * granularity) + "B";
+    }
+}
+
+TEST(ObjectPoolTest, RecyclesFreedBlocksBeforeGrowing)
+{
+    ObjectPool pool{"Test", 24};
+    void *first = pool.Allocate();
+    void *second = pool.Allocate();
+    EXPECT_NE(first, second);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(first) % ObjectPool::Alignment, 0u);
+
+    pool.Deallocate(first);
+    EXPECT_EQ(pool.Allocate(), first);
+
+    const PoolStats stats = pool.GetStats();
+    EXPECT_EQ(stats.live, 2u);
+    EXPECT_EQ(stats.highWater, 2u);
+    EXPECT_EQ(stats.slabs, 1u);
+    EXPECT_EQ(stats.live + stats.free, stats.slabs * (16 * 1024 / stats.blockSize));
+    pool.Deallocate(first);
+    pool.Deallocate(second);
+    EXPECT_EQ(pool.GetStats().live, 0u);
+    EXPECT_EQ(pool.GetStats().highWater, 2u);
+}
+
+TEST(ObjectPoolTest, GameObjectsAndComponentsComeFromPools)
+{
+    const std::string componentPool = ComponentPoolName(sizeof(Projectile));
+    const size_t gameObjectsBefore = StatsOf(GameObject::PoolName).live;
+    const size_t componentsBefore = StatsOf(componentPool).live;
+
+    std::vector<GameObject::Ptr> spawned;
+    for (int i = 0; i < 100; ++i)
+    {
+        spawned.push_back(GameObject::Create("Projectile"));
+        spawned.back()->AddComponent<Projectile>();
+    }
+    EXPECT_EQ(StatsOf(GameObject::PoolName).live, gameObjectsBefore + 100);
+    EXPECT_EQ(StatsOf(componentPool).live, componentsBefore + 100);
+
+    // A despawned wave leaves its blocks to the next one instead of growing the pools
+    spawned.clear();
+    const PoolStats afterDespawn = StatsOf(componentPool);
+    EXPECT_EQ(afterDespawn.live, componentsBefore);
+    for (int i = 0; i < 100; ++i)
+    {
+        spawned.push_back(GameObject::Create("Projectile"));
+        spawned.back()->AddComponent<Projectile>();
+    }
+    EXPECT_EQ(StatsOf(componentPool).slabs, afterDespawn.slabs);
+    EXPECT_EQ(StatsOf(GameObject::PoolName).live, gameObjectsBefore + 100);
+}
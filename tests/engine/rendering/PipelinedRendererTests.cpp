@@ -0,0 +1,292 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <renderer/software/SWMaterial.hpp>
+#include <renderer/software/SWShader.hpp>
+
+#include "engine/rendering/PipelinedRenderer.hpp"
+
+using namespace N2Engine::Rendering;
+using namespace Renderer::Common;
+using Renderer::Software::SWMaterial;
+using Renderer::Software::SWShader;
+
+namespace
+{
+    class FakeMesh final : public IMesh
+    {
+    public:
+        bool IsValid() const override { return true; }
+        uint32_t GetIndexCount() const override { return 0; }
+        uint32_t GetVertexCount() const override { return 0; }
+    };
+
+    // Logs every call with the thread it arrived on; DrawMesh logs the model matrix translation,
+    // then the material's albedo red when it has one
+    class RecordingRenderer final : public IRenderer
+    {
+    public:
+        explicit RecordingRenderer(std::chrono::milliseconds presentDelay = {}) : _presentDelay{presentDelay} {}
+
+        bool Initialize(GLFWwindow *, uint32_t, uint32_t) override { Log("Initialize"); return true; }
+        void Shutdown() override { Log("Shutdown"); }
+        void Resize(uint32_t, uint32_t) override { Log("Resize"); }
+        void Clear(float, float, float, float) override { Log("Clear"); }
+        void BeginFrame() override { Log("BeginFrame"); }
+        void EndFrame() override { Log("EndFrame"); }
+        void Present() override
+        {
+            std::this_thread::sleep_for(_presentDelay);
+            Log("Present");
+        }
+
+        IShader* CreateShaderProgram(const char *, const char *) override
+        {
+            return _shaders.Insert(std::make_unique<SWShader>());
+        }
+        void UseShaderProgram(IShader *) override {}
+        bool DestroyShaderProgram(const ShaderHandle shader) override { return _shaders.Erase(shader.slot); }
+        bool IsValidShader(const ShaderHandle shader) const override { return _shaders.Contains(shader.slot); }
+
+        IMesh* CreateMesh(const MeshData &) override
+        {
+            Log("CreateMesh");
+            return _meshes.Insert(std::make_unique<FakeMesh>());
+        }
+        void DestroyMesh(const MeshHandle mesh) override
+        {
+            Log("DestroyMesh");
+            _meshes.Erase(mesh.slot);
+        }
+        ITexture* CreateTexture(const uint8_t *, uint32_t, uint32_t, uint32_t) override { return nullptr; }
+        void DestroyTexture(TextureHandle) override {}
+        IMaterial* CreateMaterial(IShader *shader) override
+        {
+            return _materials.Insert(std::make_unique<SWMaterial>(shader));
+        }
+        IMaterial* CreateMaterial(IShader *shader, ITexture *) override { return CreateMaterial(shader); }
+        void DestroyMaterial(const MaterialHandle material) override
+        {
+            Log("DestroyMaterial");
+            _materials.Erase(material.slot);
+        }
+
+        void SetViewProjection(const float *, const float *) override {}
+        void UpdateSceneLighting(const SceneLightingData &, const N2Engine::Math::Vector3 &) override {}
+        void DrawMesh(IMesh *, const float *modelMatrix, IMaterial *material) override
+        {
+            std::string call = "DrawMesh " + std::to_string(static_cast<int>(modelMatrix[12]));
+            if (material)
+            {
+                call += " " + std::to_string(static_cast<int>(material->GetParameters().GetVec4(MaterialProperty::Albedo)[0]));
+            }
+            Log(std::move(call));
+        }
+        void DrawMeshInstanced(IMesh *, IMaterial *, std::span<const float[16]> modelMatrices) override
+        {
+            Log("DrawMeshInstanced " + std::to_string(modelMatrices.size()));
+        }
+        void DrawObjects(const std::vector<RenderObject> &) override {}
+        void OnResize(int, int) override {}
+
+        IShader* GetStandardUnlitShader() const override { return nullptr; }
+        IShader* GetStandardLitShader() const override { return nullptr; }
+        void ReadFramebuffer(std::uint8_t *, int, int) const override {}
+        void SetWireframe(bool) override {}
+        const char* GetRendererName() const override { return "Recording"; }
+
+        std::vector<std::string> Calls() const
+        {
+            std::scoped_lock lock{_mutex};
+            return _calls;
+        }
+
+        bool AllOnThread(const std::thread::id id) const
+        {
+            std::scoped_lock lock{_mutex};
+            return std::ranges::all_of(_threads, [id](const std::thread::id t) { return t == id; });
+        }
+
+    private:
+        void Log(std::string call)
+        {
+            std::scoped_lock lock{_mutex};
+            _calls.push_back(std::move(call));
+            _threads.push_back(std::this_thread::get_id());
+        }
+
+        std::chrono::milliseconds _presentDelay;
+        SlotMap<FakeMesh> _meshes;
+        SlotMap<SWShader> _shaders;
+        SlotMap<SWMaterial> _materials;
+        mutable std::mutex _mutex;
+        std::vector<std::string> _calls;
+        std::vector<std::thread::id> _threads;
+    };
+
+    void DrawFrame(IRenderer &renderer, IMesh *mesh, const float x)
+    {
+        float model[16]{};
+        model[12] = x;
+        renderer.BeginFrame();
+        renderer.Clear(0.f, 0.f, 0.f, 1.f);
+        renderer.DrawMesh(mesh, model, nullptr);
+        // The snapshot holds its own copy
+        model[12] = -1.f;
+        renderer.EndFrame();
+        renderer.Present();
+    }
+}
+
+TEST(PipelinedRendererTest, ReplaysFramesInOrderOnTheRenderThread)
+{
+    auto recording = std::make_unique<RecordingRenderer>();
+    RecordingRenderer *backend = recording.get();
+    PipelinedRenderer pipeline{std::move(recording), nullptr, 3, false};
+    EXPECT_EQ(pipeline.GetDepth(), 3u);
+
+    IMesh *mesh = pipeline.CreateMesh(MeshData{});
+    ASSERT_NE(mesh, nullptr);
+    for (int frame = 0; frame < 5; ++frame)
+    {
+        DrawFrame(pipeline, mesh, static_cast<float>(frame));
+    }
+    pipeline.Flush();
+
+    std::vector<std::string> expected{"CreateMesh"};
+    for (int frame = 0; frame < 5; ++frame)
+    {
+        expected.insert(expected.end(), {"BeginFrame", "Clear", "DrawMesh " + std::to_string(frame), "EndFrame", "Present"});
+    }
+    EXPECT_EQ(backend->Calls(), expected);
+    EXPECT_FALSE(backend->AllOnThread(std::this_thread::get_id()));
+
+    const FramePipelineStats stats = pipeline.GetStats();
+    EXPECT_EQ(stats.framesPresented, 5u);
+    EXPECT_EQ(stats.framesDropped, 0u);
+}
+
+TEST(PipelinedRendererTest, DestroysResourcesOnlyAfterTheFrameReleasingThemIsDrawn)
+{
+    auto recording = std::make_unique<RecordingRenderer>(std::chrono::milliseconds{5});
+    RecordingRenderer *backend = recording.get();
+    PipelinedRenderer pipeline{std::move(recording), nullptr, 2, false};
+
+    IMesh *mesh = pipeline.CreateMesh(MeshData{});
+    DrawFrame(pipeline, mesh, 1.f);
+    pipeline.DestroyMesh(mesh->GetHandle());
+    DrawFrame(pipeline, mesh, 2.f);
+    pipeline.Flush();
+
+    const std::vector<std::string> calls = backend->Calls();
+    const auto destroyed = std::ranges::find(calls, "DestroyMesh");
+    ASSERT_NE(destroyed, calls.end());
+    EXPECT_EQ(std::ranges::count(calls, "DestroyMesh"), 1);
+    // Released while the second frame was recorded, so destroyed once it has been presented
+    EXPECT_EQ(*(destroyed - 1), "Present");
+    EXPECT_EQ(std::ranges::find(calls, "DrawMesh 2") < destroyed, true);
+}
+
+TEST(PipelinedRendererTest, DropsFramesTheRenderThreadFellBehindOn)
+{
+    auto recording = std::make_unique<RecordingRenderer>(std::chrono::milliseconds{10});
+    RecordingRenderer *backend = recording.get();
+    PipelinedRenderer pipeline{std::move(recording), nullptr, 3, true};
+
+    IMesh *mesh = pipeline.CreateMesh(MeshData{});
+    constexpr int Frames = 12;
+    for (int frame = 0; frame < Frames; ++frame)
+    {
+        DrawFrame(pipeline, mesh, static_cast<float>(frame));
+    }
+    pipeline.Flush();
+
+    const FramePipelineStats stats = pipeline.GetStats();
+    EXPECT_EQ(stats.framesPresented + stats.framesDropped, static_cast<uint64_t>(Frames));
+    EXPECT_GT(stats.framesDropped, 0u);
+    // The newest frame always reaches the screen
+    const std::vector<std::string> calls = backend->Calls();
+    EXPECT_EQ(std::ranges::count(calls, "Present"), static_cast<long>(stats.framesPresented));
+    EXPECT_EQ(*(std::ranges::find(calls, "DrawMesh " + std::to_string(Frames - 1)) + 2), "Present");
+}
+
+TEST(PipelinedRendererTest, DrawsWithTheMaterialValuesOfTheDrawCall)
+{
+    auto recording = std::make_unique<RecordingRenderer>(std::chrono::milliseconds{5});
+    RecordingRenderer *backend = recording.get();
+    PipelinedRenderer pipeline{std::move(recording), nullptr, 3, false};
+
+    IMesh *mesh = pipeline.CreateMesh(MeshData{});
+    IMaterial *material = pipeline.CreateMaterial(pipeline.CreateShaderProgram("", ""));
+    ASSERT_NE(material, nullptr);
+    const float model[16]{};
+    for (int frame = 1; frame <= 3; ++frame)
+    {
+        pipeline.BeginFrame();
+        material->GetParameters().SetVec4(MaterialProperty::Albedo, static_cast<float>(frame), 0.f, 0.f, 1.f);
+        pipeline.DrawMesh(mesh, model, material);
+        // Recorded already, so only the next draw sees it
+        material->SetColor("uAlbedo", 9.f, 0.f, 0.f, 1.f);
+        pipeline.DrawMesh(mesh, model, material);
+        pipeline.EndFrame();
+        pipeline.Present();
+    }
+    pipeline.Flush();
+
+    std::vector<std::string> expected{"CreateMesh"};
+    for (int frame = 1; frame <= 3; ++frame)
+    {
+        expected.insert(expected.end(), {"BeginFrame", "DrawMesh 0 " + std::to_string(frame), "DrawMesh 0 9", "EndFrame", "Present"});
+    }
+    EXPECT_EQ(backend->Calls(), expected);
+}
+
+TEST(PipelinedRendererTest, DestroyedShadersAreInvalidAtOnce)
+{
+    PipelinedRenderer pipeline{std::make_unique<RecordingRenderer>(), nullptr, 2, false};
+
+    IShader *shader = pipeline.CreateShaderProgram("", "");
+    const ShaderHandle handle = shader->GetHandle();
+    ASSERT_TRUE(pipeline.IsValidShader(handle));
+    EXPECT_TRUE(pipeline.DestroyShaderProgram(handle));
+    // The backend keeps it until the frame releasing it is drawn
+    EXPECT_FALSE(pipeline.IsValidShader(handle));
+    EXPECT_FALSE(pipeline.DestroyShaderProgram(handle));
+    EXPECT_FALSE(pipeline.DestroyShaderProgram(ShaderHandle{}));
+
+    pipeline.Present();
+    pipeline.Flush();
+    EXPECT_FALSE(pipeline.IsValidShader(handle));
+}
+
+TEST(PipelinedRendererTest, StaleMaterialHandlesDoNotDestroyTheMaterialReusingTheirSlot)
+{
+    auto recording = std::make_unique<RecordingRenderer>();
+    RecordingRenderer *backend = recording.get();
+    PipelinedRenderer pipeline{std::move(recording), nullptr, 2, false};
+
+    IShader *shader = pipeline.CreateShaderProgram("", "");
+    const MaterialHandle stale = pipeline.CreateMaterial(shader)->GetHandle();
+    pipeline.DestroyMaterial(stale);
+    IMaterial *material = pipeline.CreateMaterial(shader);
+    ASSERT_EQ(material->GetHandle().slot.index, stale.slot.index);
+
+    pipeline.DestroyMaterial(stale);
+    material->GetParameters().SetVec4(MaterialProperty::Albedo, 7.f, 0.f, 0.f, 1.f);
+    IMesh *mesh = pipeline.CreateMesh(MeshData{});
+    const float model[16]{};
+    pipeline.DrawMesh(mesh, model, material);
+    pipeline.Present();
+    pipeline.Flush();
+
+    const std::vector<std::string> calls = backend->Calls();
+    EXPECT_EQ(std::ranges::count(calls, "DestroyMaterial"), 1);
+    EXPECT_NE(std::ranges::find(calls, "DrawMesh 0 7"), calls.end());
+}
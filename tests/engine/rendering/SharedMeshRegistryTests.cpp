@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <array>
+
+#include <engine/rendering/SharedMeshRegistry.hpp>
+#include <renderer/software/SoftwareRenderer.hpp>
+
+using namespace Renderer::Common;
+using namespace Renderer::Software;
+using N2Engine::Rendering::SharedMeshRegistry;
+using N2Engine::Common::Color;
+
+namespace
+{
+    MeshData MakeTriangle()
+    {
+        MeshData data;
+        data.vertices.resize(3);
+        data.vertices[1].position[0] = 1.f;
+        data.vertices[2].position[1] = 1.f;
+        data.indices = {0, 1, 2};
+        return data;
+    }
+}
+
+class SharedMeshRegistryTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(renderer.Initialize(nullptr, 64, 64));
+    }
+
+    void TearDown() override
+    {
+        registry.Forget(&renderer);
+        renderer.Shutdown();
+    }
+
+    SoftwareRenderer renderer;
+    SharedMeshRegistry &registry = SharedMeshRegistry::Instance();
+};
+
+TEST_F(SharedMeshRegistryTest, SameKeySharesOneMeshBuiltOnce)
+{
+    int builds = 0;
+    auto factory = [&] { ++builds; return MakeTriangle(); };
+
+    IMesh *a = registry.AcquireMesh(&renderer, "Triangle", factory);
+    IMesh *b = registry.AcquireMesh(&renderer, "Triangle", factory);
+    IMesh *other = registry.AcquireMesh(&renderer, "Triangle 2", factory);
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, other);
+    EXPECT_EQ(builds, 2);
+    EXPECT_EQ(registry.GetMeshReferences(a), 2u);
+
+    registry.ReleaseMesh(&renderer, a);
+    EXPECT_EQ(registry.GetMeshReferences(a), 1u);
+    registry.ReleaseMesh(&renderer, b);
+    EXPECT_EQ(registry.GetMeshReferences(a), 0u);
+    registry.ReleaseMesh(&renderer, other);
+    EXPECT_EQ(registry.GetMeshCount(), 0u);
+
+    // Released for good: the next acquire builds again.
+    IMesh *rebuilt = registry.AcquireMesh(&renderer, "Triangle", factory);
+    EXPECT_EQ(builds, 3);
+    registry.ReleaseMesh(&renderer, rebuilt);
+}
+
+TEST_F(SharedMeshRegistryTest, MaterialsAreSharedByShaderAndColor)
+{
+    IShader *shader = renderer.GetStandardUnlitShader();
+    const Color red(1.f, 0.f, 0.f, 1.f), blue(0.f, 0.f, 1.f, 1.f);
+
+    IMaterial *a = registry.AcquireMaterial(&renderer, shader, red);
+    IMaterial *b = registry.AcquireMaterial(&renderer, shader, red);
+    IMaterial *c = registry.AcquireMaterial(&renderer, shader, blue);
+    IMaterial *lit = registry.AcquireMaterial(&renderer, renderer.GetStandardLitShader(), red);
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, c);
+    EXPECT_NE(a, lit);
+    EXPECT_EQ(registry.GetMaterialCount(), 3u);
+
+    const auto albedo = dynamic_cast<SWMaterial *>(c)->GetVec4("uAlbedo", {});
+    EXPECT_EQ(albedo, (std::array<float, 4>{0.f, 0.f, 1.f, 1.f}));
+
+    for (IMaterial *material : {a, b, c, lit})
+        registry.ReleaseMaterial(&renderer, material);
+    EXPECT_EQ(registry.GetMaterialCount(), 0u);
+}
+
+TEST_F(SharedMeshRegistryTest, ForgetDropsEntriesOfOneRenderer)
+{
+    SoftwareRenderer second;
+    ASSERT_TRUE(second.Initialize(nullptr, 16, 16));
+
+    IMesh *mine = registry.AcquireMesh(&renderer, "Triangle", MakeTriangle);
+    IMesh *theirs = registry.AcquireMesh(&second, "Triangle", MakeTriangle);
+    EXPECT_NE(mine, theirs);
+
+    registry.Forget(&second);
+    second.Shutdown();
+    EXPECT_EQ(registry.GetMeshCount(), 1u);
+    EXPECT_EQ(registry.GetMeshReferences(mine), 1u);
+
+    registry.ReleaseMesh(&renderer, mine);
+    EXPECT_EQ(registry.GetMeshCount(), 0u);
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include "engine/GameObjectScene.hpp"
+#include "engine/IRenderable.hpp"
+
+using namespace N2Engine;
+
+namespace
+{
+    class Quad : public IRenderable
+    {
+    public:
+        explicit Quad(GameObject &gameObject) : IRenderable(gameObject) {}
+        std::string GetTypeName() const override { return "Quad"; }
+
+        void Render(Renderer::Common::IRenderer *) override {}
+        void InitializeRenderResources(Renderer::Common::IRenderer *) override {}
+        void CleanupRenderResources(Renderer::Common::IRenderer *) override {}
+    };
+
+    class Sprite final : public Quad
+    {
+    public:
+        explicit Sprite(GameObject &gameObject) : Quad(gameObject) {}
+        std::string GetTypeName() const override { return "Sprite"; }
+    };
+
+    class Tag final : public Component
+    {
+    public:
+        explicit Tag(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "Tag"; }
+    };
+
+    template <typename T>
+    std::vector<T*> Collect(const GameObject &gameObject)
+    {
+        std::vector<T*> found;
+        for (T *component : gameObject.GetComponents<T>())
+        {
+            found.push_back(component);
+        }
+        return found;
+    }
+}
+
+static_assert(ComponentFamilies::MaskOf<Sprite>() == ComponentFamilies::Bit<IRenderable>());
+static_assert(ComponentFamilies::MaskOf<Tag>() == 0);
+
+TEST(ComponentFamilyTest, GetComponentsMatchesByFamilyTypeAndCast)
+{
+    auto gameObject = GameObject::Create("Holder");
+    EXPECT_TRUE(gameObject->GetComponents<IRenderable>().empty());
+
+    Quad *quad = gameObject->AddComponent<Quad>();
+    Tag *tag = gameObject->AddComponent<Tag>();
+    Sprite *sprite = gameObject->AddComponent<Sprite>();
+    EXPECT_EQ(quad->GetFamilies(), ComponentFamilies::Bit<IRenderable>());
+    EXPECT_EQ(tag->GetFamilies(), 0u);
+
+    EXPECT_EQ(Collect<IRenderable>(*gameObject), (std::vector<IRenderable*>{quad, sprite}));
+    EXPECT_EQ(Collect<Quad>(*gameObject), (std::vector<Quad*>{quad, sprite}));
+    EXPECT_EQ(Collect<Sprite>(*gameObject), std::vector<Sprite*>{sprite});
+    EXPECT_EQ(Collect<Component>(*gameObject).size(), 3u);
+
+    gameObject->RemoveComponent<Quad>();
+    gameObject->RemoveComponent<Sprite>();
+    EXPECT_TRUE(gameObject->GetComponents<IRenderable>().empty());
+    EXPECT_EQ(Collect<Tag>(*gameObject), std::vector<Tag*>{tag});
+}
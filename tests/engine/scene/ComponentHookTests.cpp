@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include "engine/GameObjectScene.hpp"
+
+using namespace N2Engine;
+
+namespace
+{
+    class Counter : public Component
+    {
+    public:
+        explicit Counter(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "Counter"; }
+        void OnUpdate() override { ++updates; }
+        void OnLateUpdate() override { ++lateUpdates; }
+
+        int updates = 0;
+        int lateUpdates = 0;
+    };
+
+    // Inherits Counter's hooks without redeclaring them
+    class DerivedCounter final : public Counter
+    {
+    public:
+        explicit DerivedCounter(GameObject &gameObject) : Counter(gameObject) {}
+        std::string GetTypeName() const override { return "DerivedCounter"; }
+    };
+
+    class Inert final : public Component
+    {
+    public:
+        explicit Inert(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "Inert"; }
+    };
+
+    int selfRemoverUpdates = 0;
+
+    class SelfRemover final : public Component
+    {
+    public:
+        explicit SelfRemover(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "SelfRemover"; }
+        void OnUpdate() override
+        {
+            ++selfRemoverUpdates;
+            if (leave)
+            {
+                GetGameObject().RemoveComponent<SelfRemover>();
+            }
+        }
+
+        bool leave = false;
+    };
+}
+
+TEST(ComponentHookTest, DetectsOverriddenHooksPerType)
+{
+    const ComponentTypeHooks counter = MakeComponentTypeHooks<Counter>();
+    EXPECT_NE(counter.Get(ComponentHook::Update), nullptr);
+    EXPECT_NE(counter.Get(ComponentHook::LateUpdate), nullptr);
+    EXPECT_EQ(counter.Get(ComponentHook::FixedUpdate), nullptr);
+    EXPECT_EQ(counter.Get(ComponentHook::ApplicationQuit), nullptr);
+
+    EXPECT_NE(MakeComponentTypeHooks<DerivedCounter>().Get(ComponentHook::Update), nullptr);
+
+    const ComponentTypeHooks inert = MakeComponentTypeHooks<Inert>();
+    for (size_t hook = 0; hook < ComponentHookCount; ++hook)
+    {
+        EXPECT_EQ(inert.runners[hook], nullptr);
+    }
+}
+
+TEST(ComponentHookTest, SceneUpdatesOnlyActiveComponents)
+{
+    auto scene = Scene::Create("Hooks");
+    auto active = GameObject::Create("Active");
+    auto inactive = GameObject::Create("Inactive");
+    Counter *a = active->AddComponent<Counter>();
+    DerivedCounter *b = active->AddComponent<DerivedCounter>();
+    active->AddComponent<Inert>();
+    Counter *c = inactive->AddComponent<Counter>();
+    scene->AddRootGameObjects({active, inactive});
+    scene->ProcessAttachQueue();
+    inactive->SetActive(false);
+
+    scene->Update();
+    scene->Update();
+    scene->LateUpdate();
+    scene->FixedUpdate();
+
+    EXPECT_EQ(a->updates, 2);
+    EXPECT_EQ(a->lateUpdates, 1);
+    EXPECT_EQ(b->updates, 2);
+    EXPECT_EQ(c->updates, 0);
+}
+
+TEST(ComponentHookTest, ComponentsRemovingThemselvesDoNotDisturbTheWalk)
+{
+    selfRemoverUpdates = 0;
+    auto scene = Scene::Create("Hooks");
+    std::vector<GameObject::Ptr> gameObjects;
+    for (int i = 0; i < 6; ++i)
+    {
+        auto gameObject = GameObject::Create("Remover");
+        gameObject->AddComponent<SelfRemover>()->leave = i % 2 == 0;
+        gameObjects.push_back(gameObject);
+    }
+    scene->AddRootGameObjects(gameObjects);
+    scene->ProcessAttachQueue();
+
+    // Every component runs once, the ones after each removal included
+    scene->Update();
+    EXPECT_EQ(selfRemoverUpdates, 6);
+    EXPECT_EQ(scene->FindObjectsByType<SelfRemover>().size(), 3u);
+
+    scene->Update();
+    EXPECT_EQ(selfRemoverUpdates, 9);
+}
+
+TEST(ComponentHookTest, ComponentsRemovedBeforeAttachingNeverAttach)
+{
+    auto scene = Scene::Create("Hooks");
+    auto gameObject = GameObject::Create("Pending");
+    gameObject->AddComponent<Counter>();
+    Inert *kept = gameObject->AddComponent<Inert>();
+    scene->AddRootGameObject(gameObject);
+
+    EXPECT_TRUE(gameObject->RemoveComponent<Counter>());
+    scene->ProcessAttachQueue();
+    scene->Update();
+    EXPECT_EQ(scene->FindObjectByType<Counter>(), nullptr);
+    EXPECT_EQ(scene->FindObjectByType<Inert>(), kept);
+}
+
+TEST(ComponentHookTest, RemovedComponentsLeaveTheRestInAttachOrder)
+{
+    auto scene = Scene::Create("Hooks");
+    std::vector<GameObject::Ptr> gameObjects;
+    std::vector<Counter*> counters;
+    for (int i = 0; i < 8; ++i)
+    {
+        auto gameObject = GameObject::Create("Counted");
+        counters.push_back(i % 3 == 0 ? gameObject->AddComponent<DerivedCounter>() : gameObject->AddComponent<Counter>());
+        gameObjects.push_back(gameObject);
+    }
+    scene->AddRootGameObjects(gameObjects);
+    scene->ProcessAttachQueue();
+
+    // Removed between phases, so lookups read the lists while they still hold the holes
+    EXPECT_TRUE(gameObjects[0]->RemoveComponent<DerivedCounter>());
+    EXPECT_TRUE(gameObjects[1]->RemoveComponent<Counter>());
+    EXPECT_TRUE(gameObjects[4]->RemoveComponent<Counter>());
+    EXPECT_TRUE(gameObjects[6]->RemoveComponent<DerivedCounter>());
+    std::vector<Counter*> expected{counters[2], counters[3], counters[5], counters[7]};
+    EXPECT_EQ(scene->FindObjectsByType<Counter>(), expected);
+    EXPECT_EQ(scene->FindObjectByType<DerivedCounter>(), counters[3]);
+
+    scene->Update();
+    for (const Counter *counter : expected)
+    {
+        EXPECT_EQ(counter->updates, 1);
+    }
+
+    // A component attached after the sweep goes last, and a later removal leaves the rest in order
+    auto late = GameObject::Create("Late");
+    Counter *added = late->AddComponent<Counter>();
+    scene->AddRootGameObject(late);
+    scene->ProcessAttachQueue();
+    EXPECT_TRUE(gameObjects[3]->RemoveComponent<DerivedCounter>());
+    expected = {counters[2], counters[5], counters[7], added};
+    EXPECT_EQ(scene->FindObjectsByType<Counter>(), expected);
+    scene->LateUpdate();
+    EXPECT_EQ(added->lateUpdates, 1);
+    EXPECT_EQ(counters[7]->lateUpdates, 1);
+    EXPECT_EQ(scene->FindObjectsByType<Counter>(), expected);
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include "engine/Application.hpp"
+#include "engine/FrameLoop.hpp"
+#include "engine/GameObjectScene.hpp"
+#include "engine/Time.hpp"
+#include "engine/scheduling/JobSystem.hpp"
+
+using namespace N2Engine;
+
+namespace
+{
+    class TickCounter final : public Component
+    {
+    public:
+        explicit TickCounter(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "TickCounter"; }
+        void OnFixedUpdate() override { ++fixedUpdates; }
+        void OnUpdate() override { ++updates; }
+
+        int fixedUpdates = 0;
+        int updates = 0;
+    };
+
+    // Quits on its quitOn-th update; parallel, so the call can come from a job worker
+    class Quitter final : public Component
+    {
+    public:
+        static constexpr bool ParallelSafe = true;
+
+        explicit Quitter(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "Quitter"; }
+        void OnUpdate() override
+        {
+            if (++updates == quitOn)
+            {
+                Application::Quit();
+            }
+        }
+
+        int quitOn = 0;
+        int updates = 0;
+    };
+}
+
+TEST(FrameLoopTest, SimulateRunsExactlyOneFixedStepPerTick)
+{
+    auto scene = Scene::Create("Simulated");
+    auto gameObject = GameObject::Create("Counter");
+    const TickCounter *counter = gameObject->AddComponent<TickCounter>();
+    scene->AddRootGameObject(gameObject);
+
+    FrameLoop loop;
+    const float startTime = Time::GetUnscaledTime();
+    const SimulationStats stats = loop.Simulate(250, [&scene] { return scene.get(); });
+
+    EXPECT_EQ(stats.ticks, 250u);
+    EXPECT_EQ(counter->fixedUpdates, 250);
+    EXPECT_EQ(counter->updates, 250);
+    // The getter rounds the double step to float
+    const double step = Time::GetFixedUnscaledDeltaTime();
+    EXPECT_NEAR(stats.simulatedSeconds, 250 * step, 1e-5);
+    EXPECT_NEAR(Time::GetUnscaledTime() - startTime, 250 * step, 1e-3);
+    EXPECT_FLOAT_EQ(Time::GetUnscaledDeltaTime(), Time::GetFixedUnscaledDeltaTime());
+}
+
+TEST(FrameLoopTest, QuitStopsTheSimulationAfterTheCurrentTick)
+{
+    auto scene = Scene::Create("Quitting");
+    auto gameObject = GameObject::Create("Quitter");
+    const TickCounter *counter = gameObject->AddComponent<TickCounter>();
+    gameObject->AddComponent<Quitter>()->quitOn = 7;
+    scene->AddRootGameObject(gameObject);
+
+    FrameLoop loop;
+    const SimulationStats stats = loop.Simulate(100, [&scene] { return scene.get(); });
+    EXPECT_EQ(stats.ticks, 7u);
+    EXPECT_EQ(counter->updates, 7);
+
+    // The stop belonged to that tick only: stepping again carries on
+    EXPECT_TRUE(loop.Step(scene.get()));
+    EXPECT_EQ(counter->updates, 8);
+    EXPECT_FALSE(FrameLoop::StopStepping());
+}
+
+TEST(FrameLoopTest, QuitFromAParallelStageStopsTheSimulation)
+{
+    Scheduling::JobSystem::Instance().Initialize(4);
+    auto scene = Scene::Create("Workers");
+    std::vector<GameObject::Ptr> gameObjects;
+    for (int i = 0; i < 512; ++i)
+    {
+        auto gameObject = GameObject::Create("Quitter");
+        gameObject->AddComponent<Quitter>()->quitOn = i == 300 ? 3 : 0;
+        gameObjects.push_back(gameObject);
+    }
+    scene->AddRootGameObjects(gameObjects);
+
+    FrameLoop loop;
+    const SimulationStats stats = loop.Simulate(10, [&scene] { return scene.get(); });
+    EXPECT_EQ(stats.ticks, 3u);
+    EXPECT_EQ(gameObjects.front()->GetComponent<Quitter>()->updates, 3);
+}
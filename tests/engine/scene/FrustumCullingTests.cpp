@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include "engine/Camera.hpp"
+#include "engine/GameObjectScene.hpp"
+#include "engine/IRenderable.hpp"
+#include "engine/Positionable.hpp"
+
+using namespace N2Engine;
+using Math::Vector3;
+
+namespace
+{
+    class Box final : public IRenderable
+    {
+    public:
+        explicit Box(GameObject &gameObject) : IRenderable(gameObject) { gameObject.CreatePositionable(); }
+        std::string GetTypeName() const override { return "Box"; }
+
+        void Render(Renderer::Common::IRenderer *) override { ++renders; }
+        void InitializeRenderResources(Renderer::Common::IRenderer *) override {}
+        void CleanupRenderResources(Renderer::Common::IRenderer *) override {}
+
+        bool GetLocalBounds(BoundingBox &bounds) const override
+        {
+            bounds = BoundingBox{Vector3{-0.5f, -0.5f, -0.5f}, Vector3{0.5f, 0.5f, 0.5f}};
+            return true;
+        }
+
+        int renders = 0;
+    };
+
+    Box* AddBox(GameObject &parent, const Vector3 &position)
+    {
+        auto gameObject = GameObject::Create("Box");
+        Box *box = gameObject->AddComponent<Box>();
+        gameObject->GetPositionable()->SetLocalPosition(position);
+        parent.AddChild(gameObject, false);
+        return box;
+    }
+}
+
+class FrustumCullingTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Positionable::Matrix4::InitializeSIMD();
+        camera.SetPerspective(60.f, 1.f, 0.1f, 100.f);
+        camera.SetPosition(Vector3{0.f, 0.f, 10.f});
+        frustum = camera.GetViewFrustum();
+    }
+
+    Camera camera;
+    Frustum frustum;
+};
+
+TEST_F(FrustumCullingTest, SkipsRenderablesOutsideTheViewAndFollowsMoves)
+{
+    auto scene = Scene::Create("Culling");
+    auto root = GameObject::Create("Root");
+    root->CreatePositionable();
+    Box *visible = AddBox(*root, {0.f, 0.f, 0.f});
+    Box *aside = AddBox(*root, {1000.f, 0.f, 0.f});
+    Box *behind = AddBox(*root, {0.f, 0.f, 50.f});
+    scene->AddRootGameObject(root);
+    scene->ProcessAttachQueue();
+
+    scene->Render(nullptr, &frustum);
+    EXPECT_EQ(visible->renders, 1);
+    EXPECT_EQ(aside->renders, 0);
+    EXPECT_EQ(behind->renders, 0);
+    EXPECT_EQ(scene->GetRenderStats().submitted, 1u);
+    EXPECT_EQ(scene->GetRenderStats().culled, 2u);
+
+    // Cached bounds are refreshed when the transform changes
+    aside->GetGameObject().GetPositionable()->SetLocalPosition({1.f, 0.f, 0.f});
+    scene->Render(nullptr, &frustum);
+    EXPECT_EQ(aside->renders, 1);
+    EXPECT_EQ(scene->GetRenderStats().culled, 1u);
+
+    // Moving the parent moves the child's bounds with it
+    root->GetPositionable()->SetLocalPosition({0.f, 500.f, 0.f});
+    scene->Render(nullptr, &frustum);
+    EXPECT_EQ(scene->GetRenderStats().submitted, 0u);
+
+    // Without a frustum nothing is culled
+    scene->Render(nullptr);
+    EXPECT_EQ(scene->GetRenderStats().submitted, 3u);
+    EXPECT_EQ(behind->renders, 1);
+}
+
+TEST_F(FrustumCullingTest, StaticRenderablesMatchPerRenderableTests)
+{
+    auto scene = Scene::Create("Static");
+    auto root = GameObject::Create("Root");
+    std::vector<Box*> boxes;
+    for (int x = -20; x < 20; ++x)
+    {
+        for (int y = -20; y < 20; ++y)
+        {
+            boxes.push_back(AddBox(*root, {x * 3.f, y * 3.f, -20.f}));
+        }
+    }
+    scene->AddRootGameObject(root);
+    scene->ProcessAttachQueue();
+    for (Box *box : boxes)
+    {
+        box->SetStatic(true);
+    }
+
+    scene->Render(nullptr, &frustum);
+    const Scene::RenderStats &stats = scene->GetRenderStats();
+    EXPECT_EQ(stats.staticRenderables, boxes.size());
+    EXPECT_EQ(stats.submitted + stats.culled, boxes.size());
+    // The hierarchy tests far fewer bounds than there are renderables
+    EXPECT_LT(stats.boundsTests, boxes.size() / 4);
+
+    std::set<Box*> expected;
+    for (Box *box : boxes)
+    {
+        BoundingBox bounds;
+        ASSERT_TRUE(box->GetWorldBounds(bounds));
+        if (frustum.IsVisible(bounds))
+        {
+            expected.insert(box);
+        }
+        EXPECT_EQ(box->renders, frustum.IsVisible(bounds) ? 1 : 0);
+    }
+    EXPECT_EQ(stats.submitted, expected.size());
+    EXPECT_GT(expected.size(), 0u);
+
+    // Detached renderables leave the hierarchy instead of dangling in it
+    Box *first = *expected.begin();
+    const GameObject::Ptr detached = first->GetGameObject().shared_from_this();
+    root->RemoveChild(detached, false);
+    scene->Render(nullptr, &frustum);
+    EXPECT_EQ(first->renders, 1);
+    EXPECT_EQ(scene->GetRenderStats().staticRenderables, boxes.size() - 1);
+    EXPECT_EQ(scene->GetRenderStats().submitted, expected.size() - 1);
+}
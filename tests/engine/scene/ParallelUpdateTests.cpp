@@ -0,0 +1,363 @@
+#include <gtest/gtest.h>
+
+#include <typeindex>
+
+#include "engine/GameObjectScene.hpp"
+#include "engine/Positionable.hpp"
+#include "engine/TransformHierarchy.hpp"
+#include "engine/scheduling/JobSystem.hpp"
+
+using namespace N2Engine;
+
+namespace
+{
+    // Plain data the updating components below share through their GameObject
+    class Counter final : public Component
+    {
+    public:
+        explicit Counter(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "Counter"; }
+
+        int value = 0;
+    };
+
+    class Incrementer final : public Component
+    {
+    public:
+        using WriteSet = ComponentAccessSet<Counter>;
+
+        explicit Incrementer(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "Incrementer"; }
+        void OnUpdate() override { ++GetGameObject().GetComponent<Counter>()->value; }
+    };
+
+    class Observer final : public Component
+    {
+    public:
+        using ReadSet = ComponentAccessSet<Counter>;
+
+        explicit Observer(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "Observer"; }
+        void OnUpdate() override { seen = GetGameObject().GetComponent<const Counter>()->value; }
+
+        int seen = -1;
+    };
+
+    // Claims to only read the Counter it increments
+    class SneakyIncrementer final : public Component
+    {
+    public:
+        using ReadSet = ComponentAccessSet<Counter>;
+
+        explicit SneakyIncrementer(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "SneakyIncrementer"; }
+        void OnUpdate() override { ++GetGameObject().GetComponent<Counter>()->value; }
+    };
+
+    // Parallel safe, yet reads a Counter on another GameObject
+    class Peeker final : public Component
+    {
+    public:
+        static constexpr bool ParallelSafe = true;
+
+        explicit Peeker(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "Peeker"; }
+        void OnUpdate() override { seen = target->GetComponent<const Counter>()->value; }
+
+        GameObject *target = nullptr;
+        int seen = -1;
+    };
+
+    class Ticker final : public Component
+    {
+    public:
+        static constexpr bool ParallelSafe = true;
+
+        explicit Ticker(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "Ticker"; }
+        void OnUpdate() override { ++ticks; }
+        void OnLateUpdate() override { ++lateTicks; }
+
+        int ticks = 0;
+        int lateTicks = 0;
+    };
+
+    class Follower final : public Component
+    {
+    public:
+        using ReadSet = ComponentAccessSet<Positionable>;
+
+        explicit Follower(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "Follower"; }
+        void OnUpdate() override { seenX = GetGameObject().GetPositionable()->GetPosition().x; }
+
+        float seenX = 0.f;
+    };
+
+    class Mover final : public Component
+    {
+    public:
+        using WriteSet = ComponentAccessSet<Positionable>;
+
+        explicit Mover(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "Mover"; }
+        void OnUpdate() override
+        {
+            Positionable *positionable = GetGameObject().GetPositionable();
+            positionable->SetLocalPosition(positionable->GetLocalPosition() + Math::Vector3{1.f, 0.f, 0.f});
+        }
+    };
+
+    class Spawner final : public Component
+    {
+    public:
+        static constexpr bool ParallelSafe = true;
+
+        explicit Spawner(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "Spawner"; }
+        void OnUpdate() override
+        {
+            SceneCommandBuffer &commands = GetGameObject().GetScene()->GetCommandBuffer();
+            commands.AddComponent<Counter>(GetGameObject(), [](Counter &counter) { counter.value = 7; });
+            commands.SetParent(GetGameObject(), parent);
+            commands.RemoveComponent<Spawner>(GetGameObject());
+            if (doomed)
+            {
+                commands.Destroy(GetGameObject());
+            }
+        }
+
+        GameObject *parent = nullptr;
+        bool doomed = false;
+    };
+
+    // Destroys its GameObject directly rather than through the command buffer
+    class SelfDestructor final : public Component
+    {
+    public:
+        static constexpr bool ParallelSafe = true;
+
+        explicit SelfDestructor(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "SelfDestructor"; }
+        void OnUpdate() override
+        {
+            if (doomed)
+            {
+                GetGameObject().Destroy();
+            }
+        }
+
+        bool doomed = false;
+    };
+}
+
+TEST(ParallelUpdateTest, DeclaresParallelismPerType)
+{
+    EXPECT_EQ(MakeComponentTypeHooks<Counter>().parallelism, ComponentParallelism::Serial);
+    EXPECT_EQ(MakeComponentTypeHooks<Ticker>().parallelism, ComponentParallelism::Parallel);
+
+    const ComponentTypeHooks incrementer = MakeComponentTypeHooks<Incrementer>();
+    const ComponentTypeHooks observer = MakeComponentTypeHooks<Observer>();
+    EXPECT_EQ(incrementer.parallelism, ComponentParallelism::Declared);
+    EXPECT_EQ(incrementer.writes, std::vector<std::type_index>{typeid(Counter)});
+    EXPECT_EQ(observer.reads, std::vector<std::type_index>{typeid(Counter)});
+    EXPECT_TRUE(incrementer.ConflictsWith(observer));
+    EXPECT_TRUE(observer.ConflictsWith(incrementer));
+    EXPECT_FALSE(observer.ConflictsWith(MakeComponentTypeHooks<Counter>()));
+}
+
+TEST(ParallelUpdateTest, ConflictingTypesRunInOrderAcrossWorkers)
+{
+    Scheduling::JobSystem::Instance().Initialize(4);
+    auto scene = Scene::Create("Parallel");
+    scene->SetRaceDetection(true);
+    std::vector<GameObject::Ptr> gameObjects;
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto gameObject = GameObject::Create("Unit");
+        gameObject->AddComponent<Counter>();
+        gameObject->AddComponent<Incrementer>();
+        gameObject->AddComponent<Observer>();
+        gameObject->AddComponent<Ticker>();
+        gameObjects.push_back(gameObject);
+    }
+    scene->AddRootGameObjects(gameObjects);
+    scene->ProcessAttachQueue();
+
+    scene->Update();
+    scene->Update();
+    scene->LateUpdate();
+
+    for (const auto &gameObject : gameObjects)
+    {
+        EXPECT_EQ(gameObject->GetComponent<Counter>()->value, 2);
+        // Observer reads what Incrementer wrote: it runs in the stage after
+        EXPECT_EQ(gameObject->GetComponent<Observer>()->seen, 2);
+        EXPECT_EQ(gameObject->GetComponent<Ticker>()->ticks, 2);
+        EXPECT_EQ(gameObject->GetComponent<Ticker>()->lateTicks, 1);
+    }
+    EXPECT_TRUE(scene->GetDetectedRaces().empty());
+}
+
+TEST(ParallelUpdateTest, StructuralChangesWaitForTheSyncPoint)
+{
+    Scheduling::JobSystem::Instance().Initialize(4);
+    auto scene = Scene::Create("Commands");
+    auto pool = GameObject::Create("Pool");
+    auto parent = GameObject::Create("Parent");
+    std::vector<GameObject::Ptr> spawners;
+    for (int i = 0; i < 200; ++i)
+    {
+        auto gameObject = GameObject::Create("Spawner");
+        Spawner *spawner = gameObject->AddComponent<Spawner>();
+        spawner->parent = parent.get();
+        spawner->doomed = i % 2 == 0;
+        pool->AddChild(gameObject, false);
+        spawners.push_back(gameObject);
+    }
+    scene->AddRootGameObjects({pool, parent});
+    scene->ProcessAttachQueue();
+
+    scene->Update();
+    EXPECT_TRUE(scene->GetCommandBuffer().Empty());
+    EXPECT_EQ(parent->GetChildCount(), spawners.size());
+    EXPECT_EQ(pool->GetChildCount(), 0u);
+    for (const auto &gameObject : spawners)
+    {
+        ASSERT_NE(gameObject->GetComponent<Counter>(), nullptr);
+        EXPECT_EQ(gameObject->GetComponent<Counter>()->value, 7);
+        EXPECT_EQ(gameObject->GetComponent<Spawner>(), nullptr);
+    }
+
+    scene->ProcessDestroyed();
+    EXPECT_EQ(parent->GetChildCount(), spawners.size() / 2);
+}
+
+TEST(ParallelUpdateTest, DestroyingFromAParallelStageWaitsForTheSyncPoint)
+{
+    Scheduling::JobSystem::Instance().Initialize(4);
+    auto scene = Scene::Create("Destroyers");
+    std::vector<GameObject::Ptr> gameObjects;
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto gameObject = GameObject::Create("Destroyer");
+        gameObject->AddComponent<SelfDestructor>()->doomed = i % 2 == 0;
+        gameObjects.push_back(gameObject);
+    }
+    scene->AddRootGameObjects(gameObjects);
+    scene->ProcessAttachQueue();
+
+    scene->Update();
+    EXPECT_TRUE(scene->GetCommandBuffer().Empty());
+    for (size_t i = 0; i < gameObjects.size(); ++i)
+    {
+        EXPECT_EQ(gameObjects[i]->IsDestroyed(), i % 2 == 0);
+    }
+
+    scene->ProcessDestroyed();
+    EXPECT_EQ(scene->GetRootGameObjectCount(), gameObjects.size() / 2);
+}
+
+TEST(ParallelUpdateTest, DetectsWritesRacingOnOneGameObject)
+{
+    auto scene = Scene::Create("Races");
+    scene->SetRaceDetection(true);
+    auto gameObject = GameObject::Create("Shared");
+    gameObject->AddComponent<Counter>();
+    // Two writers of the same Counter update at the same time
+    gameObject->AddComponent<Incrementer>();
+    gameObject->AddComponent<Incrementer>();
+    scene->AddRootGameObject(gameObject);
+    scene->ProcessAttachQueue();
+
+    scene->Update();
+    scene->Update();
+    ASSERT_EQ(scene->GetDetectedRaces().size(), 1u);
+    const ComponentRace &race = scene->GetDetectedRaces().front();
+    EXPECT_EQ(race.gameObject, gameObject.get());
+    EXPECT_EQ(race.resource, std::type_index(typeid(Counter)));
+    EXPECT_EQ(race.kind, ComponentRaceKind::Conflict);
+    EXPECT_EQ(race.accessor, std::type_index(typeid(Incrementer)));
+    EXPECT_EQ(race.hook, ComponentHook::Update);
+
+    scene->SetRaceDetection(false);
+    EXPECT_TRUE(scene->GetDetectedRaces().empty());
+}
+
+TEST(ParallelUpdateTest, DetectsWritesToADeclaredReadSet)
+{
+    auto scene = Scene::Create("Undeclared");
+    scene->SetRaceDetection(true);
+    auto gameObject = GameObject::Create("Sneaky");
+    gameObject->AddComponent<Counter>();
+    gameObject->AddComponent<SneakyIncrementer>();
+    scene->AddRootGameObject(gameObject);
+    scene->ProcessAttachQueue();
+
+    scene->Update();
+    scene->Update();
+    EXPECT_EQ(gameObject->GetComponent<Counter>()->value, 2);
+    ASSERT_EQ(scene->GetDetectedRaces().size(), 1u);
+    const ComponentRace &race = scene->GetDetectedRaces().front();
+    EXPECT_EQ(race.kind, ComponentRaceKind::Undeclared);
+    EXPECT_EQ(race.gameObject, gameObject.get());
+    EXPECT_EQ(race.resource, std::type_index(typeid(Counter)));
+    EXPECT_EQ(race.accessor, std::type_index(typeid(SneakyIncrementer)));
+    EXPECT_TRUE(race.write);
+}
+
+TEST(ParallelUpdateTest, DetectsParallelSafeTypesReachingIntoOtherGameObjects)
+{
+    auto scene = Scene::Create("Foreign");
+    scene->SetRaceDetection(true);
+    auto target = GameObject::Create("Target");
+    target->AddComponent<Counter>()->value = 5;
+    auto peeker = GameObject::Create("Peeker");
+    peeker->AddComponent<Peeker>()->target = target.get();
+    scene->AddRootGameObjects({target, peeker});
+    scene->ProcessAttachQueue();
+
+    scene->Update();
+    EXPECT_EQ(peeker->GetComponent<Peeker>()->seen, 5);
+    ASSERT_EQ(scene->GetDetectedRaces().size(), 1u);
+    const ComponentRace &race = scene->GetDetectedRaces().front();
+    EXPECT_EQ(race.kind, ComponentRaceKind::OtherGameObject);
+    EXPECT_EQ(race.gameObject, target.get());
+    EXPECT_EQ(race.resource, std::type_index(typeid(Counter)));
+    EXPECT_EQ(race.accessor, std::type_index(typeid(Peeker)));
+    EXPECT_FALSE(race.write);
+}
+
+TEST(ParallelUpdateTest, ParallelStagesReadResolvedWorldTransforms)
+{
+    Scheduling::JobSystem::Instance().Initialize(4);
+    auto scene = Scene::Create("Transforms");
+    auto root = GameObject::Create("Root");
+    root->CreatePositionable();
+    std::vector<GameObject::Ptr> units;
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto gameObject = GameObject::Create("Unit");
+        gameObject->CreatePositionable();
+        gameObject->GetPositionable()->SetLocalPosition(Math::Vector3{static_cast<float>(i), 0.f, 0.f});
+        gameObject->AddComponent<Mover>();
+        gameObject->AddComponent<Follower>();
+        root->AddChild(gameObject, false);
+        units.push_back(gameObject);
+    }
+    scene->AddRootGameObject(root);
+    scene->ProcessAttachQueue();
+    scene->GetTransformHierarchy().UpdateWorldTransforms();
+
+    // A dirty parent: every worker would otherwise resolve the same subtree on read
+    root->GetPositionable()->SetPosition(Math::Vector3{10.f, 0.f, 0.f});
+    scene->Update();
+    scene->Update();
+
+    EXPECT_FALSE(scene->GetTransformHierarchy().IsInParallelReads());
+    for (size_t i = 0; i < units.size(); ++i)
+    {
+        // Mover runs serially before the Follower stage, which sees both of its moves
+        EXPECT_EQ(units[i]->GetComponent<Follower>()->seenX, 10.f + static_cast<float>(i) + 2.f);
+    }
+}
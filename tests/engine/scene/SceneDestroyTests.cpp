@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include "engine/GameObjectScene.hpp"
+
+using namespace N2Engine;
+
+namespace
+{
+    int destroyCalls = 0;
+
+    class Health final : public Component
+    {
+    public:
+        explicit Health(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "Health"; }
+        void OnUpdate() override { ++updates; }
+        void OnDestroy() override { ++destroyCalls; }
+
+        int updates = 0;
+    };
+
+    GameObject::Ptr Spawn(const std::string &name)
+    {
+        auto gameObject = GameObject::Create(name);
+        gameObject->AddComponent<Health>();
+        return gameObject;
+    }
+}
+
+TEST(SceneDestroyTest, DestroyedHierarchiesLeaveEveryList)
+{
+    destroyCalls = 0;
+    auto scene = Scene::Create("Destroy");
+    auto first = Spawn("First");
+    auto doomed = Spawn("Doomed");
+    auto last = Spawn("Last");
+    auto child = Spawn("Child");
+    auto grandchild = Spawn("Grandchild");
+    auto keptChild = Spawn("Kept");
+    auto lostChild = Spawn("Lost");
+    doomed->AddChild(child, false);
+    child->AddChild(grandchild, false);
+    last->AddChild(keptChild, false);
+    last->AddChild(lostChild, false);
+    scene->AddRootGameObjects({first, doomed, last});
+    scene->ProcessAttachQueue();
+    EXPECT_EQ(scene->FindObjectsByType<Health>().size(), 7u);
+
+    const Math::UUID grandchildUuid = grandchild->GetUUID();
+    doomed->Destroy();
+    lostChild->Destroy();
+    // Queued again, and already covered by its root: still torn down once
+    scene->DestroyGameObject(child);
+    scene->ProcessDestroyed();
+
+    EXPECT_EQ(destroyCalls, 4);
+    EXPECT_EQ(scene->GetRootGameObjects(), (std::vector<GameObject::Ptr>{first, last}));
+    EXPECT_EQ(last->GetChildren(), std::vector<GameObject::Ptr>{keptChild});
+    EXPECT_EQ(scene->FindGameObject("Doomed"), nullptr);
+    EXPECT_EQ(scene->FindGameObject("Lost"), nullptr);
+    EXPECT_EQ(scene->FindGameObjectByUUID(grandchildUuid), nullptr);
+    EXPECT_EQ(scene->FindObjectsByType<Health>().size(), 3u);
+    EXPECT_EQ(grandchild->GetComponentCount(), 0u);
+
+    scene->Update();
+    EXPECT_EQ(keptChild->GetComponent<Health>()->updates, 1);
+    EXPECT_EQ(first->GetComponent<Health>()->updates, 1);
+
+    // Nothing queued is a no-op, and roots can still be removed one at a time in order
+    scene->ProcessDestroyed();
+    EXPECT_EQ(destroyCalls, 4);
+    auto third = Spawn("Third");
+    scene->AddRootGameObject(third);
+    EXPECT_TRUE(scene->RemoveRootGameObject(first));
+    EXPECT_FALSE(scene->RemoveRootGameObject(first));
+    EXPECT_EQ(scene->GetRootGameObjects(), (std::vector<GameObject::Ptr>{last, third}));
+    third->Destroy();
+    scene->ProcessDestroyed();
+    EXPECT_EQ(scene->GetRootGameObjects(), std::vector<GameObject::Ptr>{last});
+}
+
+TEST(SceneDestroyTest, ComponentsAddedThisFrameDoNotAttachAfterDestroy)
+{
+    auto scene = Scene::Create("Destroy");
+    auto root = Spawn("Root");
+    scene->AddRootGameObject(root);
+    root->Destroy();
+    scene->ProcessDestroyed();
+
+    // The queued Health was freed with its GameObject; attaching must not reach it
+    scene->ProcessAttachQueue();
+    EXPECT_TRUE(scene->FindObjectsByType<Health>().empty());
+    EXPECT_EQ(scene->GetRootGameObjectCount(), 0u);
+}
+
+TEST(SceneDestroyTest, RemovedRootsLeaveTheRestInOrder)
+{
+    auto scene = Scene::Create("Roots");
+    std::vector<GameObject::Ptr> roots;
+    for (int i = 0; i < 8; ++i)
+    {
+        roots.push_back(Spawn("Root"));
+    }
+    scene->AddRootGameObjects(roots);
+
+    for (int i = 0; i < 8; i += 2)
+    {
+        EXPECT_TRUE(scene->RemoveRootGameObject(roots[i]));
+    }
+    EXPECT_EQ(scene->GetRootGameObjectCount(), 4u);
+    EXPECT_FALSE(scene->RemoveRootGameObject(roots[2]));
+
+    // Traversal skips the holes before anything reads the roots back
+    std::vector<GameObject*> visited;
+    scene->Traverse([&](GameObject &gameObject) { visited.push_back(&gameObject); });
+    EXPECT_EQ(visited, (std::vector<GameObject*>{roots[1].get(), roots[3].get(), roots[5].get(), roots[7].get()}));
+
+    // A root added back goes after the ones that stayed, and can be removed again
+    scene->AddRootGameObject(roots[0]);
+    EXPECT_TRUE(scene->RemoveRootGameObject(roots[3]));
+    EXPECT_EQ(scene->GetRootGameObjects(), (std::vector<GameObject::Ptr>{roots[1], roots[5], roots[7], roots[0]}));
+    EXPECT_TRUE(scene->RemoveRootGameObject(roots[0]));
+    EXPECT_EQ(scene->GetRootGameObjects(), (std::vector<GameObject::Ptr>{roots[1], roots[5], roots[7]}));
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include "engine/GameObjectScene.hpp"
+
+using namespace N2Engine;
+
+namespace
+{
+    class Marker : public Component
+    {
+    public:
+        explicit Marker(GameObject &gameObject) : Component(gameObject) {}
+        std::string GetTypeName() const override { return "Marker"; }
+    };
+
+    class SpecialMarker final : public Marker
+    {
+    public:
+        explicit SpecialMarker(GameObject &gameObject) : Marker(gameObject) {}
+        std::string GetTypeName() const override { return "SpecialMarker"; }
+    };
+
+    class OtherMarker final : public Marker
+    {
+    public:
+        explicit OtherMarker(GameObject &gameObject) : Marker(gameObject) {}
+        std::string GetTypeName() const override { return "OtherMarker"; }
+    };
+}
+
+TEST(SceneLookupTest, NameAndUuidIndicesFollowTheHierarchy)
+{
+    auto scene = Scene::Create("Lookup");
+    auto root = GameObject::Create("Root");
+    auto enemy = GameObject::Create("Enemy");
+    auto otherEnemy = GameObject::Create("Enemy");
+    root->AddChild(enemy, false);
+    root->AddChild(otherEnemy, false);
+    scene->AddRootGameObject(root);
+
+    EXPECT_EQ(scene->FindGameObject("Root"), root);
+    EXPECT_EQ(scene->FindGameObjectsByName("Enemy").size(), 2u);
+    EXPECT_EQ(scene->FindGameObjectByUUID(otherEnemy->GetUUID()), otherEnemy);
+
+    // Renames and new UUIDs move the entries
+    otherEnemy->SetName("Boss");
+    EXPECT_EQ(scene->FindGameObjectsByName("Enemy").size(), 1u);
+    EXPECT_EQ(scene->FindGameObject("Boss"), otherEnemy);
+    const Math::UUID oldUuid = enemy->GetUUID();
+    enemy->SetUUID(Math::UUID::Random());
+    EXPECT_EQ(scene->FindGameObjectByUUID(oldUuid), nullptr);
+    EXPECT_EQ(scene->FindGameObjectByUUID(enemy->GetUUID()), enemy);
+
+    // Children added later join; detached and released ones leave
+    auto late = GameObject::Create("Late");
+    otherEnemy->AddChild(late, false);
+    EXPECT_EQ(scene->FindGameObject("Late"), late);
+    root->RemoveChild(otherEnemy, false);
+    EXPECT_EQ(scene->FindGameObject("Boss"), nullptr);
+    EXPECT_EQ(scene->FindGameObject("Late"), nullptr);
+    root->AddChild(otherEnemy, false);
+    EXPECT_EQ(scene->FindGameObject("Late"), late);
+    {
+        auto temporary = GameObject::Create("Temporary");
+        root->AddChild(temporary, false);
+        root->RemoveChild(temporary, false);
+        otherEnemy->RemoveChild(late, false);
+    }
+    late.reset();
+    EXPECT_TRUE(scene->FindGameObjectsByName("Temporary").empty());
+
+    // The scene going away first leaves nothing to report back to
+    scene.reset();
+    root->SetName("Renamed");
+}
+
+TEST(SceneLookupTest, TypeIndexTracksAttachedComponents)
+{
+    auto scene = Scene::Create("Types");
+    auto root = GameObject::Create("Root");
+    auto first = GameObject::Create("First");
+    auto second = GameObject::Create("Second");
+    root->AddChild(first, false);
+    root->AddChild(second, false);
+    Marker *marker = first->AddComponent<Marker>();
+    SpecialMarker *special = second->AddComponent<SpecialMarker>();
+    scene->AddRootGameObject(root);
+
+    // Not attached yet
+    EXPECT_TRUE(scene->FindObjectsByType<Marker>().empty());
+    scene->ProcessAttachQueue();
+
+    EXPECT_EQ(scene->FindObjectsByType<Marker>().size(), 2u);
+    EXPECT_EQ(scene->FindObjectsByType<SpecialMarker>(), std::vector<SpecialMarker*>{special});
+    EXPECT_EQ(scene->FindObjectByType<SpecialMarker>(), special);
+
+    second->SetActive(false);
+    EXPECT_EQ(scene->FindObjectsByType<Marker>(false), std::vector<Marker*>{marker});
+
+    // Removed components leave every scene list before they are freed
+    second->RemoveComponent<SpecialMarker>();
+    EXPECT_EQ(scene->FindObjectByType<SpecialMarker>(), nullptr);
+    EXPECT_EQ(scene->FindObjectsByType<Marker>().size(), 1u);
+    scene->Update();
+}
+
+TEST(SceneLookupTest, BaseTypeLookupsFollowAttachOrder)
+{
+    auto scene = Scene::Create("Order");
+    std::vector<Marker*> attached;
+    for (int i = 0; i < 6; ++i)
+    {
+        auto gameObject = GameObject::Create("Marked");
+        // Interleaved so every derived type's bucket holds later components than some other bucket
+        if (i % 3 == 0)
+        {
+            attached.push_back(gameObject->AddComponent<OtherMarker>());
+        }
+        else if (i % 3 == 1)
+        {
+            attached.push_back(gameObject->AddComponent<SpecialMarker>());
+        }
+        else
+        {
+            attached.push_back(gameObject->AddComponent<Marker>());
+        }
+        scene->AddRootGameObject(gameObject);
+        scene->ProcessAttachQueue();
+    }
+
+    EXPECT_EQ(scene->FindObjectByType<Marker>(), attached.front());
+    EXPECT_EQ(scene->FindObjectsByType<Marker>(), attached);
+
+    attached.front()->GetGameObject().SetActive(false);
+    EXPECT_EQ(scene->FindObjectByType<Marker>(false), attached[1]);
+}
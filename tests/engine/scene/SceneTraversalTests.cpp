@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "engine/GameObjectScene.hpp"
+
+using namespace N2Engine;
+
+namespace
+{
+    void CollectRecursive(GameObject &gameObject, std::vector<GameObject*> &order, const bool onlyActive)
+    {
+        if (onlyActive && !gameObject.IsActiveInHierarchy())
+        {
+            return;
+        }
+        order.push_back(&gameObject);
+        for (const auto &child : gameObject.GetChildren())
+        {
+            CollectRecursive(*child, order, onlyActive);
+        }
+    }
+}
+
+class SceneTraversalTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        scene = Scene::Create("Traversal");
+        std::mt19937 rng{3};
+        for (int r = 0; r < 3; ++r)
+        {
+            auto root = GameObject::Create("Root");
+            std::vector<GameObject::Ptr> nodes{root};
+            for (int i = 0; i < 200; ++i)
+            {
+                auto child = GameObject::Create("Node" + std::to_string(i));
+                nodes[rng() % nodes.size()]->AddChild(child, false);
+                child->SetActive(rng() % 7 != 0);
+                nodes.push_back(child);
+            }
+            scene->AddRootGameObject(root);
+        }
+    }
+
+    std::vector<GameObject*> Recursive(const bool onlyActive) const
+    {
+        std::vector<GameObject*> order;
+        for (const auto &root : scene->GetRootGameObjects())
+        {
+            CollectRecursive(*root, order, onlyActive);
+        }
+        return order;
+    }
+
+    std::unique_ptr<Scene> scene;
+};
+
+TEST_F(SceneTraversalTest, VisitsInDepthFirstOrder)
+{
+    for (const bool onlyActive : {false, true})
+    {
+        std::vector<GameObject*> visited;
+        EXPECT_FALSE(scene->Traverse([&](GameObject &gameObject) { visited.push_back(&gameObject); }, onlyActive));
+        EXPECT_EQ(visited, Recursive(onlyActive));
+
+        std::vector<GameObject*> generated;
+        for (GameObject &gameObject : scene->GameObjects(onlyActive))
+        {
+            generated.push_back(&gameObject);
+        }
+        EXPECT_EQ(generated, visited);
+    }
+    EXPECT_LT(Recursive(true).size(), Recursive(false).size());
+    EXPECT_EQ(scene->GetAllGameObjects().size(), Recursive(false).size());
+}
+
+TEST_F(SceneTraversalTest, StopsEarlyAndNests)
+{
+    const std::vector<GameObject*> all = Recursive(false);
+    size_t visits = 0;
+    EXPECT_TRUE(scene->Traverse([&](const GameObject &gameObject)
+    {
+        ++visits;
+        return &gameObject == all[100];
+    }));
+    EXPECT_EQ(visits, 101u);
+    EXPECT_EQ(scene->FindGameObject("Node150").get(), all[0]->FindChildRecursive("Node150").get());
+
+    // A traversal inside a visitor gets its own stack
+    size_t outer = 0;
+    size_t inner = 0;
+    scene->Traverse([&](const GameObject &)
+    {
+        if (++outer % 100 == 0)
+        {
+            scene->Traverse([&](const GameObject &) { ++inner; });
+        }
+    });
+    EXPECT_EQ(outer, all.size());
+    EXPECT_EQ(inner, (all.size() / 100) * all.size());
+}
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include "engine/GameObjectScene.hpp"
+#include "engine/Positionable.hpp"
+#include "engine/spatial/SpatialIndex.hpp"
+
+using namespace N2Engine;
+using Math::Vector3;
+
+class SpatialIndexTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Positionable::Matrix4::InitializeSIMD();
+    }
+
+    static GameObject::Ptr AddPoint(GameObject &parent, const Vector3 &position)
+    {
+        auto gameObject = GameObject::Create("Point");
+        gameObject->CreatePositionable();
+        gameObject->GetPositionable()->SetLocalPosition(position);
+        parent.AddChild(gameObject, false);
+        return gameObject;
+    }
+
+    static std::vector<GameObject*> Sorted(std::vector<GameObject*> gameObjects)
+    {
+        std::ranges::sort(gameObjects);
+        return gameObjects;
+    }
+};
+
+TEST_F(SpatialIndexTest, QueriesMatchBruteForceAsObjectsMove)
+{
+    auto scene = Scene::Create("Spatial");
+    auto root = GameObject::Create("Root");
+    root->CreatePositionable();
+    std::vector<GameObject::Ptr> points;
+    std::mt19937 rng{7};
+    std::uniform_real_distribution<float> coordinate{-50.f, 50.f};
+    for (int i = 0; i < 500; ++i)
+    {
+        points.push_back(AddPoint(*root, {coordinate(rng), coordinate(rng), coordinate(rng)}));
+    }
+    scene->AddRootGameObject(root);
+
+    Spatial::SpatialIndex &index = scene->GetSpatialIndex();
+    EXPECT_EQ(index.GetCount(), points.size() + 1);
+
+    std::uniform_real_distribution<float> step{-3.f, 3.f};
+    for (int frame = 0; frame < 10; ++frame)
+    {
+        for (size_t i = frame % 2; i < points.size(); i += 2)
+        {
+            Positionable *positionable = points[i]->GetPositionable();
+            positionable->SetLocalPosition(positionable->GetLocalPosition() + Vector3{step(rng), step(rng), step(rng)});
+        }
+        index.Refit();
+
+        const Vector3 center{coordinate(rng), coordinate(rng), coordinate(rng)};
+        const BoundingBox box{center - Vector3{10.f, 10.f, 10.f}, center + Vector3{10.f, 10.f, 10.f}};
+        std::vector<GameObject*> expectedBox;
+        std::vector<GameObject*> expectedSphere;
+        std::vector<std::pair<float, GameObject*>> byDistance;
+        for (const auto &point : points)
+        {
+            const Vector3 p = point->GetPositionable()->GetPosition();
+            if (p.x >= box.min.x && p.x <= box.max.x && p.y >= box.min.y && p.y <= box.max.y &&
+                p.z >= box.min.z && p.z <= box.max.z)
+            {
+                expectedBox.push_back(point.get());
+            }
+            if ((p - center).LengthSquared() <= 15.f * 15.f)
+            {
+                expectedSphere.push_back(point.get());
+            }
+            byDistance.emplace_back((p - center).LengthSquared(), point.get());
+        }
+        // The root sits at the origin
+        if (Spatial::DynamicAabbTree::DistanceSquared(box, Vector3{0.f, 0.f, 0.f}) == 0.f)
+        {
+            expectedBox.push_back(root.get());
+        }
+        if (center.LengthSquared() <= 15.f * 15.f)
+        {
+            expectedSphere.push_back(root.get());
+        }
+        byDistance.emplace_back(center.LengthSquared(), root.get());
+
+        std::vector<GameObject*> found;
+        index.QueryBox(box, found);
+        EXPECT_EQ(Sorted(found), Sorted(expectedBox));
+
+        found.clear();
+        index.QuerySphere(center, 15.f, found);
+        EXPECT_EQ(Sorted(found), Sorted(expectedSphere));
+
+        found.clear();
+        index.QueryNearest(center, 5, found);
+        std::ranges::sort(byDistance);
+        ASSERT_EQ(found.size(), 5u);
+        for (size_t i = 0; i < found.size(); ++i)
+        {
+            EXPECT_EQ(found[i], byDistance[i].second);
+        }
+    }
+}
+
+TEST_F(SpatialIndexTest, RayHitsAreSortedAndBounded)
+{
+    auto scene = Scene::Create("Ray");
+    auto root = GameObject::Create("Root");
+    std::vector<GameObject::Ptr> line;
+    for (int i = 1; i <= 5; ++i)
+    {
+        line.push_back(AddPoint(*root, {static_cast<float>(i) * 10.f, 0.f, 0.f}));
+    }
+    AddPoint(*root, {20.f, 5.f, 0.f});
+    scene->AddRootGameObject(root);
+
+    std::vector<Spatial::SpatialIndex::RayHit> hits;
+    scene->GetSpatialIndex().QueryRay({0.f, 0.f, 0.f}, {2.f, 0.f, 0.f}, 35.f, hits);
+    ASSERT_EQ(hits.size(), 3u);
+    for (size_t i = 0; i < hits.size(); ++i)
+    {
+        EXPECT_EQ(hits[i].gameObject, line[i].get());
+        EXPECT_FLOAT_EQ(hits[i].distance, static_cast<float>(i + 1) * 10.f);
+    }
+}
+
+TEST_F(SpatialIndexTest, MembershipFollowsTheScene)
+{
+    auto scene = Scene::Create("Membership");
+    auto root = GameObject::Create("Root");
+    const GameObject::Ptr near = AddPoint(*root, {1.f, 0.f, 0.f});
+    const GameObject::Ptr far = AddPoint(*root, {100.f, 0.f, 0.f});
+    const GameObject::Ptr grandChild = AddPoint(*far, {1.f, 0.f, 0.f});
+    scene->AddRootGameObject(root);
+    Spatial::SpatialIndex &index = scene->GetSpatialIndex();
+    EXPECT_EQ(index.GetCount(), 3u);
+
+    // Gaining a Positionable inside the scene joins the index
+    root->CreatePositionable();
+    EXPECT_EQ(index.GetCount(), 4u);
+
+    // A detached subtree leaves, and joins again when reattached
+    root->RemoveChild(far, false);
+    EXPECT_EQ(index.GetCount(), 2u);
+    std::vector<GameObject*> found;
+    index.QuerySphere({100.f, 0.f, 0.f}, 5.f, found);
+    EXPECT_TRUE(found.empty());
+    root->AddChild(far, false);
+    index.QuerySphere({100.f, 0.f, 0.f}, 5.f, found);
+    EXPECT_EQ(Sorted(found), Sorted({far.get(), grandChild.get()}));
+
+    // Small moves stay inside the fattened leaf
+    near->GetPositionable()->SetLocalPosition({1.01f, 0.f, 0.f});
+    EXPECT_EQ(index.Refit(), 0u);
+    near->GetPositionable()->SetLocalPosition({30.f, 0.f, 0.f});
+    EXPECT_EQ(index.Refit(), 1u);
+
+    // Released objects and the scene itself unregister without dangling
+    {
+        const GameObject::Ptr temporary = AddPoint(*root, {0.f, 0.f, 0.f});
+        EXPECT_EQ(index.GetCount(), 5u);
+        root->RemoveChild(temporary, false);
+    }
+    EXPECT_EQ(index.GetCount(), 4u);
+    scene->RemoveRootGameObject(root);
+    EXPECT_EQ(index.GetCount(), 0u);
+
+    scene->AddRootGameObject(root);
+    EXPECT_EQ(index.GetCount(), 4u);
+    scene.reset();
+    root->GetPositionable()->SetLocalPosition({1.f, 1.f, 1.f});
+}
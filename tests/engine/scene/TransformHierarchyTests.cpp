@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "engine/GameObjectScene.hpp"
+#include "engine/Positionable.hpp"
+#include "engine/TransformHierarchy.hpp"
+
+using namespace N2Engine;
+using Math::Quaternion;
+using Math::Vector3;
+
+namespace
+{
+    GameObject::Ptr MakePositioned(const std::string &name, const Vector3 &localPosition)
+    {
+        auto gameObject = GameObject::Create(name);
+        gameObject->CreatePositionable();
+        gameObject->GetPositionable()->SetLocalPosition(localPosition);
+        return gameObject;
+    }
+
+    // What the recursive implementation computed: the parent's world combined with the local
+    Transform ReferenceWorld(const GameObject &gameObject)
+    {
+        const Transform &local = gameObject.GetPositionable()->GetLocalTransform();
+        const auto parent = gameObject.GetParent();
+        if (parent && parent->HasPositionable())
+        {
+            return Transform::Combine(ReferenceWorld(*parent), local);
+        }
+        return local;
+    }
+
+    void ExpectNear(const Vector3 &actual, const Vector3 &expected)
+    {
+        EXPECT_NEAR(actual.x, expected.x, 1e-3f);
+        EXPECT_NEAR(actual.y, expected.y, 1e-3f);
+        EXPECT_NEAR(actual.z, expected.z, 1e-3f);
+    }
+}
+
+class TransformHierarchyTest : public ::testing::Test
+{
+protected:
+    // Matrix inversion (keepWorldPosition reparenting) dispatches through the SIMD tables
+    void SetUp() override { Positionable::Matrix4::InitializeSIMD(); }
+};
+
+TEST_F(TransformHierarchyTest, ChildrenFollowTheirParentLazilyAndInThePass)
+{
+    auto root = MakePositioned("Root", {1.f, 0.f, 0.f});
+    auto child = MakePositioned("Child", {0.f, 2.f, 0.f});
+    auto grandchild = MakePositioned("Grandchild", {0.f, 0.f, 3.f});
+    root->AddChild(child, false);
+    child->AddChild(grandchild, false);
+
+    ExpectNear(grandchild->GetPositionable()->GetPosition(), {1.f, 2.f, 3.f});
+
+    root->GetPositionable()->SetLocalPosition({5.f, 0.f, 0.f});
+    EXPECT_TRUE(grandchild->GetPositionable()->IsGlobalTransformDirty());
+    ExpectNear(grandchild->GetPositionable()->GetPosition(), {5.f, 2.f, 3.f});
+
+    root->GetPositionable()->SetLocalScale({2.f, 2.f, 2.f});
+    TransformHierarchy::Detached().UpdateWorldTransforms();
+    EXPECT_FALSE(grandchild->GetPositionable()->IsGlobalTransformDirty());
+    ExpectNear(grandchild->GetPositionable()->GetPosition(), {5.f, 4.f, 6.f});
+
+    // Detached children keep their local transform as their world transform
+    child->RemoveChild(grandchild, false);
+    ExpectNear(grandchild->GetPositionable()->GetPosition(), {0.f, 0.f, 3.f});
+}
+
+TEST_F(TransformHierarchyTest, LinksChildrenWhenTheParentGainsAPositionable)
+{
+    auto parent = GameObject::Create("Parent");
+    auto child = MakePositioned("Child", {0.f, 1.f, 0.f});
+    parent->AddChild(child, false);
+    ExpectNear(child->GetPositionable()->GetPosition(), {0.f, 1.f, 0.f});
+
+    parent->CreatePositionable();
+    parent->GetPositionable()->SetLocalPosition({0.f, 0.f, 4.f});
+    ExpectNear(child->GetPositionable()->GetPosition(), {0.f, 1.f, 4.f});
+}
+
+TEST_F(TransformHierarchyTest, RereadingAnOutOfOrderNodeKeepsItsVersion)
+{
+    // The child is older than its parent, so linking them leaves the hierarchy out of order
+    auto child = MakePositioned("Child", {0.f, 1.f, 0.f});
+    auto parent = MakePositioned("Parent", {2.f, 0.f, 0.f});
+    parent->AddChild(child, false);
+    ASSERT_FALSE(TransformHierarchy::Detached().IsOrdered());
+
+    const Positionable *positionable = child->GetPositionable();
+    ExpectNear(positionable->GetPosition(), {2.f, 1.f, 0.f});
+    const uint32_t version = positionable->GetWorldVersion();
+    ExpectNear(positionable->GetPosition(), {2.f, 1.f, 0.f});
+    EXPECT_EQ(positionable->GetWorldVersion(), version);
+
+    parent->GetPositionable()->SetLocalPosition({3.f, 0.f, 0.f});
+    ExpectNear(positionable->GetPosition(), {3.f, 1.f, 0.f});
+    EXPECT_NE(positionable->GetWorldVersion(), version);
+}
+
+TEST_F(TransformHierarchyTest, MatchesRecursiveCompositionUnderRandomEdits)
+{
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> unit(-1.f, 1.f);
+    std::vector<GameObject::Ptr> objects;
+    for (int i = 0; i < 300; ++i)
+    {
+        objects.push_back(MakePositioned("Node", {unit(rng), unit(rng), unit(rng)}));
+    }
+
+    auto index = [&] { return std::uniform_int_distribution<size_t>(0, objects.size() - 1)(rng); };
+    auto pick = [&] { return objects[index()]; };
+    for (int round = 0; round < 6; ++round)
+    {
+        for (int edit = 0; edit < 200; ++edit)
+        {
+            const auto a = pick();
+            const auto b = pick();
+            switch (edit % 5)
+            {
+            case 0:
+                if (a != b && !a->IsChildOf(b) && !b->IsChildOf(a))
+                    a->AddChild(b, edit % 8 == 0);
+                break;
+            case 1:
+                if (const auto parent = a->GetParent())
+                    parent->RemoveChild(a, false);
+                break;
+            case 2:
+            {
+                // Destroying a node orphans its children in place
+                const size_t slot = index();
+                if (const auto parent = objects[slot]->GetParent())
+                    parent->RemoveChild(objects[slot], false);
+                objects[slot] = MakePositioned("Node", {unit(rng), unit(rng), unit(rng)});
+                break;
+            }
+            case 3:
+                a->GetPositionable()->SetLocalRotation(Quaternion::FromEulerAngles(unit(rng), unit(rng), unit(rng)));
+                break;
+            default:
+                a->GetPositionable()->SetLocalPosition({unit(rng), unit(rng), unit(rng)});
+                break;
+            }
+        }
+
+        // Alternate lazy reads with the threaded pass
+        if (round % 2)
+        {
+            TransformHierarchy::Detached().UpdateWorldTransforms(4);
+            EXPECT_TRUE(TransformHierarchy::Detached().IsOrdered());
+        }
+        for (const auto &object : objects)
+        {
+            ExpectNear(object->GetPositionable()->GetPosition(), ReferenceWorld(*object).GetPosition());
+        }
+    }
+}
+
+TEST_F(TransformHierarchyTest, TransformsMoveWithTheirGameObjectsBetweenScenes)
+{
+    auto first = Scene::Create("First");
+    auto second = Scene::Create("Second");
+    auto root = MakePositioned("Root", {1.f, 0.f, 0.f});
+    auto child = MakePositioned("Child", {0.f, 2.f, 0.f});
+    root->AddChild(child, false);
+    first->AddRootGameObject(root);
+    EXPECT_EQ(first->GetTransformHierarchy().GetNodeCount(), 2u);
+    EXPECT_EQ(second->GetTransformHierarchy().GetNodeCount(), 0u);
+
+    // Freezing one scene's transforms leaves the other's writable
+    auto other = MakePositioned("Other", {});
+    second->AddRootGameObject(other);
+    first->GetTransformHierarchy().BeginParallelReads();
+    other->GetPositionable()->SetLocalPosition({0.f, 0.f, 5.f});
+    EXPECT_FALSE(second->GetTransformHierarchy().IsInParallelReads());
+    first->GetTransformHierarchy().EndParallelReads();
+
+    first->RemoveRootGameObject(root);
+    second->AddRootGameObject(root);
+    EXPECT_EQ(first->GetTransformHierarchy().GetNodeCount(), 0u);
+    EXPECT_EQ(second->GetTransformHierarchy().GetNodeCount(), 3u);
+    root->GetPositionable()->SetLocalPosition({4.f, 0.f, 0.f});
+    ExpectNear(child->GetPositionable()->GetPosition(), {4.f, 2.f, 0.f});
+
+    // GameObjects held past their scene keep their transforms
+    second.reset();
+    root->GetPositionable()->SetLocalPosition({6.f, 0.f, 0.f});
+    ExpectNear(child->GetPositionable()->GetPosition(), {6.f, 2.f, 0.f});
+}
+
+TEST_F(TransformHierarchyTest, NotifiesPhysicsBoundDescendantsOfUnboundNodesOnTheNextPass)
+{
+    auto scene = Scene::Create("Physics");
+    auto root = MakePositioned("Root", {});
+    auto body = MakePositioned("Body", {0.f, 1.f, 0.f});
+    root->AddChild(body, false);
+    scene->AddRootGameObject(root);
+    body->GetPositionable()->MarkPhysicsBound();
+    TransformHierarchy &transforms = scene->GetTransformHierarchy();
+    transforms.UpdateWorldTransforms();
+
+    // Moving an unbound node only flags the bound one below it
+    root->GetPositionable()->SetLocalPosition({3.f, 0.f, 0.f});
+    EXPECT_TRUE(body->GetPositionable()->IsGlobalTransformDirty());
+    EXPECT_EQ(transforms.UpdateWorldTransforms(), 1u);
+    EXPECT_FALSE(body->GetPositionable()->IsGlobalTransformDirty());
+    ExpectNear(body->GetPositionable()->GetPosition(), {3.f, 1.f, 0.f});
+    EXPECT_EQ(transforms.UpdateWorldTransforms(), 0u);
+
+    // Moving the bound node itself notifies it at once
+    body->GetPositionable()->SetLocalPosition({0.f, 2.f, 0.f});
+    EXPECT_FALSE(body->GetPositionable()->IsGlobalTransformDirty());
+    EXPECT_EQ(transforms.UpdateWorldTransforms(), 0u);
+}
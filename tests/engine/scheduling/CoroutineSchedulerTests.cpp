@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "engine/GameObjectScene.hpp"
+#include "engine/scheduling/CoroutineScheduler.hpp"
+
+using namespace N2Engine;
+using namespace N2Engine::Scheduling;
+
+namespace
+{
+    // Records the scheduler frame each step resumed on
+    std::generator<ICoroutineWait> Timed(std::vector<int> &log, const int &frame)
+    {
+        log.push_back(frame);
+        co_yield WaitForSeconds(1.f);
+        log.push_back(frame);
+        co_yield WaitForFrames(3);
+        log.push_back(frame);
+        co_yield WaitForNextFrame();
+        log.push_back(frame);
+    }
+
+    std::generator<ICoroutineWait> Gated(int &steps, const bool &open)
+    {
+        ++steps;
+        co_yield WaitUntil([&open] { return open; });
+        ++steps;
+    }
+
+    std::generator<ICoroutineWait> Counting(int &steps)
+    {
+        while (true)
+        {
+            ++steps;
+            co_yield WaitForSeconds(0.5f);
+        }
+    }
+
+    std::generator<ICoroutineWait> StopsItself(int &steps, GameObject &gameObject)
+    {
+        ++steps;
+        gameObject.GetScene()->GetCoroutineScheduler()->StopAllCoroutines(&gameObject);
+        co_yield WaitForNextFrame();
+        ++steps;
+    }
+
+    GameObject::Ptr Spawn(Scene &scene)
+    {
+        auto gameObject = GameObject::Create("Runner");
+        scene.AddRootGameObject(gameObject);
+        scene.ProcessAttachQueue();
+        return gameObject;
+    }
+}
+
+TEST(CoroutineSchedulerTest, TimedWaitsResumeOnTheFrameTheyAreDue)
+{
+    auto scene = Scene::Create("Coroutines");
+    auto gameObject = Spawn(*scene);
+    CoroutineScheduler &scheduler = *scene->GetCoroutineScheduler();
+
+    std::vector<int> log;
+    int frame = 0;
+    scheduler.StartCoroutine(gameObject.get(), Timed(log, frame));
+    for (frame = 1; frame <= 12; ++frame)
+    {
+        scheduler.Update(0.25);
+        EXPECT_EQ(scheduler.GetPolledCount(), 0u);
+    }
+
+    // One second is four frames of 0.25, then three frames, then one
+    EXPECT_EQ(log, (std::vector<int>{1, 5, 8, 9}));
+    EXPECT_EQ(scheduler.GetCoroutineCount(), 0u);
+}
+
+TEST(CoroutineSchedulerTest, PredicateWaitsArePolledUntilTheyPass)
+{
+    auto scene = Scene::Create("Coroutines");
+    auto gameObject = Spawn(*scene);
+    CoroutineScheduler &scheduler = *scene->GetCoroutineScheduler();
+
+    int steps = 0;
+    bool open = false;
+    scheduler.StartCoroutine(gameObject.get(), Gated(steps, open));
+    scheduler.Update(0.1);
+    scheduler.Update(0.1);
+    EXPECT_EQ(steps, 1);
+    EXPECT_EQ(scheduler.GetPolledCount(), 1u);
+
+    open = true;
+    scheduler.Update(0.1);
+    EXPECT_EQ(steps, 2);
+    EXPECT_EQ(scheduler.GetPolledCount(), 0u);
+    EXPECT_EQ(scheduler.GetCoroutineCount(), 0u);
+}
+
+TEST(CoroutineSchedulerTest, StoppedCoroutinesNeverResume)
+{
+    auto scene = Scene::Create("Coroutines");
+    auto first = Spawn(*scene);
+    auto second = Spawn(*scene);
+    CoroutineScheduler &scheduler = *scene->GetCoroutineScheduler();
+
+    int kept = 0;
+    int stopped = 0;
+    int removed = 0;
+    scheduler.StartCoroutine(first.get(), Counting(kept));
+    Coroutine *doomed = scheduler.StartCoroutine(first.get(), Counting(stopped));
+    scheduler.StartCoroutine(second.get(), Counting(removed));
+    scheduler.Update(0.5);
+    EXPECT_EQ(scheduler.GetCoroutineCount(), 3u);
+
+    // Parked in the timer heap: stopping leaves a stale entry that is skipped when due
+    EXPECT_TRUE(scheduler.StopCoroutine(first.get(), doomed));
+    EXPECT_FALSE(scheduler.StopCoroutine(first.get(), doomed));
+    EXPECT_TRUE(scheduler.RemoveGameObject(second.get()));
+    EXPECT_FALSE(scheduler.RemoveGameObject(second.get()));
+    for (int i = 0; i < 4; ++i)
+    {
+        scheduler.Update(0.5);
+    }
+    EXPECT_EQ(kept, 5);
+    EXPECT_EQ(stopped, 1);
+    EXPECT_EQ(removed, 1);
+    EXPECT_EQ(scheduler.GetCoroutineCount(), 1u);
+
+    // The freed slots are reused
+    int restarted = 0;
+    scheduler.StartCoroutine(second.get(), Counting(restarted));
+    scheduler.Update(0.5);
+    EXPECT_EQ(restarted, 1);
+    EXPECT_EQ(kept, 6);
+
+    scheduler.StopAllCoroutines(first.get());
+    scheduler.Update(0.5);
+    EXPECT_EQ(kept, 6);
+    EXPECT_EQ(restarted, 2);
+}
+
+TEST(CoroutineSchedulerTest, InactiveOwnersAndSelfStopsEndCoroutines)
+{
+    auto scene = Scene::Create("Coroutines");
+    auto sleeper = Spawn(*scene);
+    auto quitter = Spawn(*scene);
+    CoroutineScheduler &scheduler = *scene->GetCoroutineScheduler();
+
+    int slept = 0;
+    int quit = 0;
+    scheduler.StartCoroutine(sleeper.get(), Counting(slept));
+    scheduler.StartCoroutine(quitter.get(), StopsItself(quit, *quitter));
+    scheduler.Update(0.5);
+    EXPECT_EQ(slept, 1);
+    EXPECT_EQ(quit, 1);
+    EXPECT_EQ(scheduler.GetCoroutineCount(), 1u);
+
+    sleeper->SetActive(false);
+    scheduler.Update(0.5);
+    EXPECT_EQ(slept, 1);
+    EXPECT_EQ(quit, 1);
+    EXPECT_EQ(scheduler.GetCoroutineCount(), 0u);
+    EXPECT_EQ(scheduler.StartCoroutine(sleeper.get(), Counting(slept)), nullptr);
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+#include "engine/scheduling/JobSystem.hpp"
+
+using namespace N2Engine::Scheduling;
+
+TEST(JobSystemTest, ParallelForCoversEveryIndexOnce)
+{
+    JobSystem &jobs = JobSystem::Instance();
+    jobs.Initialize(4);
+    EXPECT_EQ(jobs.GetThreadCount(), 4u);
+
+    std::vector<int> hits(10007, 0);
+    jobs.ParallelFor(hits.size(), 64, [&](const size_t begin, const size_t end)
+    {
+        EXPECT_LT(begin, end);
+        for (size_t i = begin; i < end; ++i)
+        {
+            ++hits[i];
+        }
+    });
+    EXPECT_EQ(std::ranges::count(hits, 1), static_cast<long>(hits.size()));
+
+    std::vector<int> values(1000);
+    std::iota(values.begin(), values.end(), 0);
+    jobs.ParallelForEach(std::span<int>{values}, 1, [](int &value) { value *= 2; });
+    EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0), 999 * 1000);
+}
+
+TEST(JobSystemTest, DependentJobsStartAfterTheirCounter)
+{
+    JobSystem &jobs = JobSystem::Instance();
+    jobs.Initialize(3);
+
+    std::atomic<int> produced{0};
+    std::atomic<int> seenByConsumers{0};
+    JobCounter producers;
+    JobCounter consumers;
+    for (int i = 0; i < 64; ++i)
+    {
+        jobs.Submit([&] { produced.fetch_add(1); }, &producers);
+    }
+    for (int i = 0; i < 8; ++i)
+    {
+        jobs.SubmitAfter(producers, [&] { seenByConsumers.fetch_add(produced.load()); }, &consumers);
+    }
+    jobs.Wait(consumers);
+    EXPECT_TRUE(producers.IsDone());
+    EXPECT_EQ(seenByConsumers.load(), 8 * 64);
+
+    // A finished counter lets its dependents through straight away
+    JobCounter late;
+    jobs.SubmitAfter(producers, [&] { produced.fetch_add(1); }, &late);
+    jobs.Wait(late);
+    EXPECT_EQ(produced.load(), 65);
+}
+
+TEST(JobSystemTest, JobsWaitingOnNestedJobsDoNotDeadlock)
+{
+    JobSystem &jobs = JobSystem::Instance();
+    jobs.Initialize(2);
+
+    std::atomic<int> leaves{0};
+    JobCounter outer;
+    for (int i = 0; i < 16; ++i)
+    {
+        jobs.Submit([&]
+        {
+            // Waiting inside a job runs other jobs instead of blocking a worker
+            JobCounter inner;
+            for (int j = 0; j < 16; ++j)
+            {
+                jobs.Submit([&] { leaves.fetch_add(1); }, &inner);
+            }
+            jobs.Wait(inner);
+        }, &outer);
+    }
+    jobs.Wait(outer);
+    EXPECT_EQ(leaves.load(), 256);
+
+    // Without workers every job runs on the waiting thread
+    jobs.Initialize(1);
+    JobCounter single;
+    jobs.Submit([&] { leaves.fetch_add(1); }, &single);
+    EXPECT_FALSE(single.IsDone());
+    jobs.Wait(single);
+    EXPECT_EQ(leaves.load(), 257);
+}
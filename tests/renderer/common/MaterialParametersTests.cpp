@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+
+#include <renderer/common/MaterialParameters.hpp>
+#include <renderer/software/SoftwareRenderer.hpp>
+
+using namespace Renderer::Common;
+
+TEST(MaterialParametersTest, NamesResolveToStableIds)
+{
+    EXPECT_EQ(ResolveMaterialProperty("uAlbedo"), MaterialProperty::Albedo);
+    EXPECT_EQ(ResolveMaterialProperty("uHasTexture"), MaterialProperty::HasTexture);
+
+    const MaterialPropertyId custom = ResolveMaterialProperty("uRimPower");
+    EXPECT_GE(custom, MaterialProperty::BuiltinCount);
+    EXPECT_EQ(ResolveMaterialProperty("uRimPower"), custom);
+    EXPECT_EQ(GetMaterialPropertyName(custom), "uRimPower");
+}
+
+TEST(MaterialParametersTest, BlockStoresTypedValuesById)
+{
+    MaterialParameterBlock block;
+    EXPECT_EQ(block.Find(MaterialProperty::Albedo), nullptr);
+    EXPECT_EQ(block.GetFloat(MaterialProperty::Smoothness, 0.5f), 0.5f);
+
+    const MaterialPropertyId custom = ResolveMaterialProperty("uTiling");
+    block.SetVec2(custom, 2.f, 3.f);
+    block.SetInt(MaterialProperty::HasTexture, 1);
+    ASSERT_NE(block.Find(custom), nullptr);
+    EXPECT_EQ(block.Find(custom)->type, MaterialParameterType::Vec2);
+    EXPECT_EQ(block.Find(custom)->value[1], 3.f);
+    EXPECT_EQ(block.GetInt(MaterialProperty::HasTexture), 1);
+    EXPECT_GT(block.GetParameters().size(), custom);
+}
+
+TEST(MaterialParametersTest, StringSettersWriteTheSameBlock)
+{
+    Renderer::Software::SoftwareRenderer renderer;
+    ASSERT_TRUE(renderer.Initialize(nullptr, 16, 16));
+
+    IMaterial *material = renderer.CreateMaterial(renderer.GetStandardLitShader());
+    material->SetColor("uAlbedo", 0.1f, 0.2f, 0.3f, 1.f);
+    material->GetParameters().SetFloat(MaterialProperty::Smoothness, 0.25f);
+
+    EXPECT_EQ(material->GetParameters().GetVec4(MaterialProperty::Albedo), (std::array<float, 4>{0.1f, 0.2f, 0.3f, 1.f}));
+    EXPECT_EQ(dynamic_cast<Renderer::Software::SWMaterial *>(material)->GetFloat("uSmoothness"), 0.25f);
+    renderer.Shutdown();
+}
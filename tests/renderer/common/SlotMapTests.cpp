@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <renderer/common/SlotMap.hpp>
+#include <renderer/software/SoftwareRenderer.hpp>
+
+using namespace Renderer::Common;
+
+namespace
+{
+    struct Resource : SlotResident<Resource>
+    {
+        explicit Resource(int v) : value(v) {}
+        int value;
+    };
+}
+
+TEST(SlotMapTest, StaleHandlesDoNotResolveToReusedSlots)
+{
+    SlotMap<Resource> map;
+    Resource *a = map.Insert(std::make_unique<Resource>(1));
+    const SlotHandle oldHandle = a->GetHandle().slot;
+    EXPECT_EQ(map.Get(oldHandle), a);
+
+    EXPECT_TRUE(map.Erase(oldHandle));
+    EXPECT_EQ(map.Size(), 0u);
+    EXPECT_EQ(map.Get(oldHandle), nullptr);
+
+    Resource *b = map.Insert(std::make_unique<Resource>(2));
+    EXPECT_EQ(b->GetHandle().slot.index, oldHandle.index);
+    EXPECT_NE(b->GetHandle().slot.generation, oldHandle.generation);
+    EXPECT_EQ(map.Get(oldHandle), nullptr);
+    EXPECT_FALSE(map.Erase(oldHandle));
+    EXPECT_EQ(map.Get(b->GetHandle().slot)->value, 2);
+}
+
+TEST(SlotMapTest, RejectsNullAndOutOfRangeHandles)
+{
+    SlotMap<Resource> map;
+    Resource *own = map.Insert(std::make_unique<Resource>(1));
+
+    EXPECT_FALSE(map.Contains(SlotHandle{}));
+    EXPECT_FALSE(map.Contains(SlotHandle{5, 0}));
+    EXPECT_FALSE(map.Erase(SlotHandle{}));
+    EXPECT_EQ(map.Find(SlotHandle{5, 0}), nullptr);
+    EXPECT_TRUE(map.Contains(own->GetHandle().slot));
+
+    map.Clear();
+    EXPECT_EQ(map.Size(), 0u);
+    EXPECT_FALSE(map.Contains(own->GetHandle().slot));
+    EXPECT_EQ(map.Insert(std::make_unique<Resource>(3))->GetHandle().slot.index, 0u);
+}
+
+TEST(SlotMapTest, StaleHandlesMissEvenWhenTheAddressIsReused)
+{
+    SlotMap<Resource> map;
+    Resource *erased = map.Insert(std::make_unique<Resource>(1));
+    const SlotHandle stale = erased->GetHandle().slot;
+    ASSERT_TRUE(map.Erase(stale));
+
+    // The allocator is free to hand the same address back; only the generation tells them apart
+    Resource *reused = map.Insert(std::make_unique<Resource>(2));
+    EXPECT_FALSE(map.Contains(stale));
+    EXPECT_FALSE(map.Erase(stale));
+    EXPECT_TRUE(map.Contains(reused->GetHandle().slot));
+    EXPECT_EQ(map.Size(), 1u);
+}
+
+TEST(SlotMapTest, SoftwareRendererValidatesDestroyedResources)
+{
+    Renderer::Software::SoftwareRenderer renderer;
+    ASSERT_TRUE(renderer.Initialize(nullptr, 16, 16));
+
+    const ShaderHandle shader = renderer.CreateShaderProgram("", "")->GetHandle();
+    EXPECT_TRUE(renderer.IsValidShader(shader));
+    EXPECT_TRUE(renderer.DestroyShaderProgram(shader));
+    EXPECT_FALSE(renderer.IsValidShader(shader));
+    EXPECT_FALSE(renderer.DestroyShaderProgram(shader));
+    EXPECT_FALSE(renderer.IsValidShader(ShaderHandle{}));
+    EXPECT_TRUE(renderer.IsValidShader(renderer.GetStandardLitShader()->GetHandle()));
+
+    // A new shader reusing the slot is not what the stale handle names
+    const ShaderHandle reused = renderer.CreateShaderProgram("", "")->GetHandle();
+    EXPECT_FALSE(renderer.DestroyShaderProgram(shader));
+    EXPECT_TRUE(renderer.IsValidShader(reused));
+
+    MeshData data;
+    data.vertices.resize(3);
+    data.indices = {0, 1, 2};
+    const MeshHandle mesh = renderer.CreateMesh(data)->GetHandle();
+    renderer.DestroyMesh(mesh);
+    // A second destroy is a no-op
+    renderer.DestroyMesh(mesh);
+    renderer.Shutdown();
+}
+
+TEST(SlotMapTest, SoftwareRendererDestroysResourcesOutOfOrder)
+{
+    Renderer::Software::SoftwareRenderer renderer;
+    ASSERT_TRUE(renderer.Initialize(nullptr, 16, 16));
+
+    MeshData data;
+    data.vertices.resize(3);
+    data.indices = {0, 1, 2};
+    IMesh *meshes[4];
+    for (IMesh *&mesh : meshes)
+        mesh = renderer.CreateMesh(data);
+
+    const SlotHandle freed = meshes[3]->GetHandle().slot;
+    renderer.DestroyMesh(meshes[1]->GetHandle());
+    renderer.DestroyMesh(meshes[3]->GetHandle());
+
+    // The most recently freed slot is reused, under a new generation.
+    const SlotHandle reused = renderer.CreateMesh(data)->GetHandle().slot;
+    EXPECT_EQ(reused.index, freed.index);
+    EXPECT_NE(reused.generation, freed.generation);
+    EXPECT_EQ(meshes[2]->GetVertexCount(), 3u);
+
+    IShader *shader = renderer.CreateShaderProgram("", "");
+    EXPECT_TRUE(renderer.DestroyShaderProgram(shader->GetHandle()));
+    EXPECT_TRUE(renderer.DestroyShaderProgram(renderer.GetStandardUnlitShader()->GetHandle()));
+    EXPECT_TRUE(renderer.IsValidShader(renderer.GetStandardUnlitShader()->GetHandle()));
+    renderer.Shutdown();
+}
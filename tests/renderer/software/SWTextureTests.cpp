@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <vector>
+
+#include <renderer/software/SWTexture.hpp>
+
+using namespace Renderer::Software;
+
+namespace
+{
+    uint8_t Channel(uint32_t texel, int c)
+    {
+        return (uint8_t)(texel >> (c * 8));
+    }
+
+    // size x size RGBA checkerboard of single-texel black and white squares.
+    SWTexture MakeCheckerboard(uint32_t size)
+    {
+        std::vector<uint8_t> pixels(size * size * 4);
+        for (uint32_t i = 0; i < size * size; ++i)
+        {
+            const uint8_t c = ((i % size + i / size) & 1) ? 255 : 0;
+            pixels[i * 4 + 0] = pixels[i * 4 + 1] = pixels[i * 4 + 2] = c;
+            pixels[i * 4 + 3] = 255;
+        }
+        SWTexture texture;
+        texture.Build(pixels.data(), size, size, 4);
+        return texture;
+    }
+}
+
+TEST(SWTextureTest, BuildsFullMipChainAsRGBA8)
+{
+    // 4x2 RGB: left half red, right half blue.
+    const uint8_t rgb[] = {
+        255, 0, 0,  255, 0, 0,  0, 0, 255,  0, 0, 255,
+        255, 0, 0,  255, 0, 0,  0, 0, 255,  0, 0, 255,
+    };
+    SWTexture texture;
+    texture.Build(rgb, 4, 2, 3);
+
+    ASSERT_TRUE(texture.IsValid());
+    ASSERT_EQ(texture.levels.size(), 3u);
+    EXPECT_EQ(texture.levels[1].width, 2u);
+    EXPECT_EQ(texture.levels[1].height, 1u);
+    EXPECT_EQ(texture.levels[2].width, 1u);
+    EXPECT_EQ(texture.levels[2].height, 1u);
+    EXPECT_EQ(texture.texels.size(), 8u + 2u + 1u);
+
+    // Missing alpha is opaque; each level averages the one above it.
+    EXPECT_EQ(texture.texels[0], 0xFF0000FFu);
+    EXPECT_EQ(texture.texels[texture.levels[1].offset + 0], 0xFF0000FFu);
+    EXPECT_EQ(texture.texels[texture.levels[1].offset + 1], 0xFFFF0000u);
+    const uint32_t last = texture.texels[texture.levels[2].offset];
+    EXPECT_EQ(Channel(last, 0), 128);
+    EXPECT_EQ(Channel(last, 1), 0);
+    EXPECT_EQ(Channel(last, 2), 128);
+    EXPECT_EQ(Channel(last, 3), 255);
+}
+
+TEST(SWTextureTest, BilinearBlendsNeighbouringTexels)
+{
+    const uint8_t gray[] = {0, 255};
+    SWTexture texture;
+    texture.Build(gray, 2, 1, 1);
+
+    // Texel centers sit at u = 0.25 and 0.75.
+    EXPECT_EQ(Channel(texture.SampleFiltered(0.25f, 0.5f, 0.f, SWTextureFilter::Bilinear), 0), 0);
+    EXPECT_EQ(Channel(texture.SampleFiltered(0.75f, 0.5f, 0.f, SWTextureFilter::Bilinear), 0), 255);
+    EXPECT_NEAR(Channel(texture.SampleFiltered(0.5f, 0.5f, 0.f, SWTextureFilter::Bilinear), 0), 127, 1);
+}
+
+TEST(SWTextureTest, MinifiedCheckerboardAveragesOut)
+{
+    const SWTexture texture = MakeCheckerboard(64);
+
+    // Sixteen texels per screen pixel.
+    const float lod = texture.ComputeLod(16.f / 64.f, 0.f, 0.f, 16.f / 64.f);
+    EXPECT_NEAR(lod, 4.f, 0.05f);
+
+    for (const SWTextureFilter filter : {SWTextureFilter::Bilinear, SWTextureFilter::Trilinear})
+    {
+        for (int i = 0; i < 32; ++i)
+        {
+            const float u = (float)i * 0.0371f, v = (float)i * 0.0533f;
+            const uint32_t texel = texture.SampleFiltered(u, v, lod, filter);
+            EXPECT_NEAR(Channel(texel, 0), 128, 2) << "filter = " << (int)filter << ", i = " << i;
+        }
+    }
+
+    // Without mips the same footprint aliases to pure black or white.
+    const uint32_t nearest = texture.SampleFiltered(0.3f, 0.6f, lod, SWTextureFilter::Nearest);
+    EXPECT_TRUE(Channel(nearest, 0) == 0 || Channel(nearest, 0) == 255);
+}
+
+TEST(SWTextureTest, TrilinearBlendsAdjacentLevels)
+{
+    const SWTexture texture = MakeCheckerboard(4);
+
+    // Level 0 at the center of texel (1, 0) is white; level 1 is flat gray.
+    const float u = 0.375f, v = 0.125f;
+    const uint8_t level0 = Channel(texture.SampleFiltered(u, v, 0.f, SWTextureFilter::Trilinear), 0);
+    const uint8_t halfway = Channel(texture.SampleFiltered(u, v, 0.5f, SWTextureFilter::Trilinear), 0);
+    const uint8_t level1 = Channel(texture.SampleFiltered(u, v, 1.f, SWTextureFilter::Trilinear), 0);
+    EXPECT_EQ(level0, 255);
+    EXPECT_NEAR(halfway, (level0 + level1) / 2, 2);
+}
+
+TEST(SWTextureTest, TiledLayoutSamplesLikeLinear)
+{
+    // Odd sizes, so every level has partial 4x4 tiles.
+    constexpr uint32_t w = 13, h = 7;
+    std::vector<uint8_t> pixels(w * h * 3);
+    for (size_t i = 0; i < pixels.size(); ++i) pixels[i] = (uint8_t)(i * 73 + 11);
+
+    SWTexture linear, tiled;
+    linear.Build(pixels.data(), w, h, 3, SWTextureLayout::Linear);
+    tiled.Build(pixels.data(), w, h, 3, SWTextureLayout::Tiled);
+    ASSERT_EQ(tiled.levels.size(), linear.levels.size());
+
+    for (size_t l = 0; l < linear.levels.size(); ++l)
+    {
+        const auto &a = linear.levels[l], &b = tiled.levels[l];
+        for (uint32_t y = 0; y < a.height; ++y)
+            for (uint32_t x = 0; x < a.width; ++x)
+                ASSERT_EQ(tiled.texels[tiled.TexelIndex(b, x, y)], linear.texels[linear.TexelIndex(a, x, y)])
+                    << "level = " << l << ", x = " << x << ", y = " << y;
+    }
+
+    for (const SWTextureFilter filter : {SWTextureFilter::Nearest, SWTextureFilter::Bilinear, SWTextureFilter::Trilinear})
+    {
+        for (int i = 0; i < 64; ++i)
+        {
+            const float u = (float)i * 0.173f - 3.f, v = (float)i * 0.091f, lod = (float)(i % 9) * 0.4f;
+            EXPECT_EQ(tiled.SampleFiltered(u, v, lod, filter), linear.SampleFiltered(u, v, lod, filter))
+                << "filter = " << (int)filter << ", i = " << i;
+        }
+    }
+}
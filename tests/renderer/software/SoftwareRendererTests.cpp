@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include <renderer/software/SoftwareRenderer.hpp>
+
+using namespace Renderer::Common;
+using namespace Renderer::Software;
+
+namespace
+{
+    constexpr uint32_t kWidth = 320;
+    constexpr uint32_t kHeight = 240;
+
+    MeshData MakeSphere(int latSegments, int lonSegments, float radius)
+    {
+        constexpr float pi = 3.14159265358979f;
+        MeshData data;
+        for (int lat = 0; lat <= latSegments; ++lat)
+        {
+            const float theta = (float)lat * pi / (float)latSegments;
+            for (int lon = 0; lon <= lonSegments; ++lon)
+            {
+                const float phi = (float)lon * 2.f * pi / (float)lonSegments;
+                Vertex v{};
+                v.normal[0] = std::cos(phi) * std::sin(theta);
+                v.normal[1] = std::cos(theta);
+                v.normal[2] = std::sin(phi) * std::sin(theta);
+                for (int i = 0; i < 3; ++i) v.position[i] = v.normal[i] * radius;
+                v.texCoord[0] = (float)lon / (float)lonSegments;
+                v.texCoord[1] = (float)lat / (float)latSegments;
+                data.vertices.push_back(v);
+            }
+        }
+        for (int lat = 0; lat < latSegments; ++lat)
+        {
+            for (int lon = 0; lon < lonSegments; ++lon)
+            {
+                const uint32_t a = lat * (lonSegments + 1) + lon;
+                const uint32_t b = a + lonSegments + 1;
+                data.indices.insert(data.indices.end(), {a, a + 1, b, b, a + 1, b + 1});
+            }
+        }
+        return data;
+    }
+
+    std::array<float, 16> Translation(float x, float y, float z)
+    {
+        return {1, 0, 0, x, 0, 1, 0, y, 0, 0, 1, z, 0, 0, 0, 1};
+    }
+}
+
+class SoftwareRendererTest : public ::testing::Test
+{
+protected:
+    // Headless: no display or GL context needed.
+    void SetUp() override
+    {
+        ASSERT_TRUE(renderer.Initialize(nullptr, kWidth, kHeight));
+        ASSERT_TRUE(renderer.IsHeadless());
+    }
+
+    void TearDown() override
+    {
+        renderer.Shutdown();
+    }
+
+    // Overlapping lit, unlit and textured spheres, some of them crossing the
+    // near plane and the edges of the screen. Instanced: one DrawMeshInstanced
+    // per material instead of a DrawMesh per sphere.
+    std::vector<uint8_t> RenderScene(bool instanced = false)
+    {
+        if (!sphere)
+        {
+            sphere = renderer.CreateMesh(MakeSphere(12, 24, 1.f));
+            std::vector<uint8_t> texels(16 * 16 * 4);
+            for (size_t i = 0; i < texels.size(); ++i) texels[i] = (uint8_t)(i * 37);
+            texture = renderer.CreateTexture(texels.data(), 16, 16, 4);
+            unlit = renderer.CreateMaterial(renderer.GetStandardUnlitShader());
+            unlit->SetColor("uAlbedo", 1.f, 0.4f, 0.1f, 1.f);
+            lit = renderer.CreateMaterial(renderer.GetStandardLitShader(), texture);
+        }
+
+        const std::array<float, 16> view = Translation(0.f, 0.f, -2.f);
+        const float f = 1.f / std::tan(0.5f);
+        const std::array<float, 16> proj = {f * kHeight / kWidth, 0, 0, 0, 0, f, 0, 0,
+                                            0, 0, -100.1f / 99.9f, -20.f / 99.9f, 0, 0, -1, 0};
+
+        SceneLightingData lighting;
+        lighting.ambientColor = N2Engine::Math::Vector3(0.2f, 0.2f, 0.2f);
+        DirectionalLightData sun{};
+        sun.direction = N2Engine::Math::Vector3(0.f, -1.f, -1.f);
+        sun.color = N2Engine::Math::Vector3(1.f, 1.f, 1.f);
+        sun.intensity = 1.f;
+        lighting.directionalLights.push_back(sun);
+
+        renderer.Clear(0.f, 0.f, 0.f, 1.f);
+        renderer.BeginFrame();
+        renderer.SetViewProjection(view.data(), proj.data());
+        renderer.UpdateSceneLighting(lighting, N2Engine::Math::Vector3(0.f, 0.f, 2.f));
+        float models[2][30][16];
+        for (int i = 0; i < 60; ++i)
+        {
+            const auto model = Translation((float)(i % 10) - 4.5f, (float)(i / 10) - 2.5f, -0.5f - (float)(i % 7));
+            if (instanced)
+                std::memcpy(models[i % 2][i / 2], model.data(), sizeof(models[0][0]));
+            else
+                renderer.DrawMesh(sphere, model.data(), (i % 2) ? lit : unlit);
+        }
+        if (instanced)
+        {
+            renderer.DrawMeshInstanced(sphere, unlit, models[0]);
+            renderer.DrawMeshInstanced(sphere, lit, models[1]);
+        }
+        renderer.EndFrame();
+        renderer.Present();
+
+        std::vector<uint8_t> pixels(kWidth * kHeight * 4);
+        renderer.ReadFramebuffer(pixels.data(), kWidth, kHeight);
+        return pixels;
+    }
+
+    SoftwareRenderer renderer;
+    IMesh *sphere = nullptr;
+    ITexture *texture = nullptr;
+    IMaterial *unlit = nullptr;
+    IMaterial *lit = nullptr;
+};
+
+TEST_F(SoftwareRendererTest, TileBinnedOutputMatchesSingleThreaded)
+{
+    renderer.SetRasterThreadCount(1);
+    const auto reference = RenderScene();
+
+    for (const uint32_t threads : {2u, 3u, 8u})
+    {
+        renderer.SetRasterThreadCount(threads);
+        EXPECT_EQ(renderer.GetRasterThreadCount(), threads);
+        EXPECT_EQ(RenderScene(), reference) << "threads = " << threads;
+    }
+}
+
+TEST_F(SoftwareRendererTest, SimdRasterPathsMatchScalar)
+{
+    ASSERT_TRUE(renderer.SetRasterPath(SWRasterPath::Scalar));
+    renderer.SetRasterThreadCount(1);
+    const auto reference = RenderScene();
+
+    for (const SWRasterPath path : {SWRasterPath::SSE41, SWRasterPath::AVX2})
+    {
+        if (!SoftwareRenderer::IsRasterPathSupported(path))
+        {
+            EXPECT_FALSE(renderer.SetRasterPath(path));
+            continue;
+        }
+        ASSERT_TRUE(renderer.SetRasterPath(path));
+        for (const uint32_t threads : {1u, 4u})
+        {
+            renderer.SetRasterThreadCount(threads);
+            EXPECT_EQ(RenderScene(), reference) << "path = " << (int)path << ", threads = " << threads;
+        }
+    }
+}
+
+TEST_F(SoftwareRendererTest, OcclusionCullingPreservesImage)
+{
+    renderer.SetRasterThreadCount(1);
+    renderer.SetOcclusionCulling(false);
+    const auto reference = RenderScene();
+    const SWFrameStats unculled = renderer.GetFrameStats();
+    EXPECT_EQ(unculled.drawsSubmitted, 60u);
+    EXPECT_EQ(unculled.drawsOccluded, 0u);
+    EXPECT_EQ(unculled.trianglesOccluded, 0u);
+
+    renderer.SetOcclusionCulling(true);
+    for (const uint32_t threads : {1u, 4u})
+    {
+        renderer.SetRasterThreadCount(threads);
+        EXPECT_EQ(RenderScene(), reference) << "threads = " << threads;
+
+        const SWFrameStats stats = renderer.GetFrameStats();
+        EXPECT_EQ(stats.drawsSubmitted, unculled.drawsSubmitted);
+        EXPECT_EQ(stats.drawsOutsideFrustum, unculled.drawsOutsideFrustum);
+        EXPECT_EQ(stats.trianglesSubmitted, unculled.trianglesSubmitted);
+        EXPECT_GT(stats.drawsOccluded + stats.trianglesOccluded, 0u) << "threads = " << threads;
+        EXPECT_LT(stats.trianglesRasterized, unculled.trianglesRasterized) << "threads = " << threads;
+    }
+}
+
+TEST_F(SoftwareRendererTest, HeadlessColorBufferIsTheFramebuffer)
+{
+    const auto pixels = RenderScene();
+    const std::span<const uint32_t> color = renderer.GetColorBuffer();
+    ASSERT_EQ(color.size(), (size_t)renderer.GetWidth() * renderer.GetHeight());
+    EXPECT_EQ(renderer.GetWidth(), kWidth);
+    EXPECT_EQ(renderer.GetHeight(), kHeight);
+
+    // Rows are stored bottom first; ReadFramebuffer returns them top first.
+    for (uint32_t y = 0; y < kHeight; ++y)
+    {
+        for (uint32_t x = 0; x < kWidth; ++x)
+        {
+            const uint32_t packed = color[(size_t)(kHeight - 1 - y) * kWidth + x];
+            uint32_t expected;
+            std::memcpy(&expected, &pixels[((size_t)y * kWidth + x) * 4], 4);
+            ASSERT_EQ(packed, expected) << "x = " << x << ", y = " << y;
+        }
+    }
+
+    // Zero-copy: the span keeps pointing at the same storage across frames.
+    const uint32_t *data = color.data();
+    RenderScene();
+    EXPECT_EQ(renderer.GetColorBuffer().data(), data);
+}
+
+TEST_F(SoftwareRendererTest, InstancedDrawsMatchIndividualDraws)
+{
+    for (const uint32_t threads : {1u, 4u})
+    {
+        renderer.SetRasterThreadCount(threads);
+        const auto reference = RenderScene();
+        const SWFrameStats individual = renderer.GetFrameStats();
+
+        EXPECT_EQ(RenderScene(true), reference) << "threads = " << threads;
+        const SWFrameStats instanced = renderer.GetFrameStats();
+        EXPECT_EQ(instanced.drawsSubmitted, individual.drawsSubmitted);
+        EXPECT_EQ(instanced.trianglesRasterized, individual.trianglesRasterized);
+    }
+}